@@ -0,0 +1,102 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef ALIGNEDALLOCATORHEADERDEF  // only if the macro
+                                   // ALIGNEDALLOCATORHEADERDEF is not defined
+                                   // execute these lines of code
+#define ALIGNEDALLOCATORHEADERDEF  // define the macro
+
+/* This file contains an allocator that can be used with standard containers
+   to align the start of the allocated storage to a given boundary (a cache
+   line by default). This allows the data in multiArray3d to start on a cache
+   line so that vector loads of the first element in a line are aligned.
+ */
+
+#include <cstddef>   // size_t
+#include <cstdlib>   // malloc, free
+#include <new>       // bad_alloc
+#include "macros.hpp"
+
+#ifdef _WIN32
+#include <malloc.h>  // _aligned_malloc, _aligned_free
+#endif
+
+template <typename T, std::size_t Alignment = CACHELINESIZE>
+class alignedAllocator {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <typename U>
+  struct rebind {
+    using other = alignedAllocator<U, Alignment>;
+  };
+
+  // constructor
+  alignedAllocator() noexcept {}
+  template <typename U>
+  alignedAllocator(const alignedAllocator<U, Alignment> &) noexcept {}
+
+  // member functions
+  T * allocate(const size_type num) {
+    if (num == 0) {
+      return nullptr;
+    }
+    void *ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(num * sizeof(T), Alignment);
+#else
+    if (posix_memalign(&ptr, Alignment, num * sizeof(T)) != 0) {
+      ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, const size_type) noexcept {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+  }
+
+  // destructor
+  ~alignedAllocator() noexcept {}
+};
+
+// all aligned allocators of the same alignment are interchangeable
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const alignedAllocator<T, Alignment> &,
+                const alignedAllocator<U, Alignment> &) {
+  return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const alignedAllocator<T, Alignment> &,
+                const alignedAllocator<U, Alignment> &) {
+  return false;
+}
+
+#endif
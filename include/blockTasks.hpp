@@ -0,0 +1,79 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef BLOCKTASKSHEADERDEF  // only if the macro BLOCKTASKSHEADERDEF is not
+                             // defined execute these lines of code
+#define BLOCKTASKSHEADERDEF  // define the macro
+
+/* This file contains functions to run the work on the procBlocks of a
+   processor as OpenMP tasks. The tasks are created in the same order as the
+   serial loops over the blocks and connections, and each task names the
+   blocks (or per block data) that it modifies. A task does not start until
+   all earlier tasks that modify the same data have finished, so the result is
+   the same as the serial loops, but work on different blocks runs at the same
+   time. Idle threads take ready tasks from the task pool, so a large block
+   does not hold up the small ones.
+
+   The tasks are created by the main thread. Only the main thread makes MPI
+   calls, so tasks that communicate are run by the main thread as soon as the
+   blocks they depend on are ready. When there is only one block on the
+   processor the tasks run one at a time, and the loops within the block use
+   all of the threads instead.
+ */
+
+// function to run the tasks created by gen
+template <typename T>
+void RunBlockTasks(const int &numBlocks, const T &gen) {
+  // numBlocks -- number of blocks on processor
+  // gen -- function that creates the tasks
+#pragma omp parallel if (numBlocks > 1)
+  {
+#pragma omp master
+    gen();
+  }  // all tasks are complete at end of parallel region
+}
+
+// function to create a task that modifies one block
+template <typename T, typename F>
+void BlockTask(T &blk, F fn) {
+  // blk -- data modified by task
+  // fn -- work for task
+#pragma omp task firstprivate(fn) depend(inout: blk)
+  fn();
+}
+
+// function to create a task that modifies two blocks
+template <typename T, typename F>
+void BlockPairTask(T &blk1, T &blk2, F fn) {
+  // blk1 -- first data modified by task
+  // blk2 -- second data modified by task
+  // fn -- work for task
+#pragma omp task firstprivate(fn) depend(inout: blk1, blk2)
+  fn();
+}
+
+// function to create a task that modifies one block and must run on the main
+// thread (e.g. because it makes MPI calls); the main thread waits for the
+// task to finish before creating more tasks
+template <typename T, typename F>
+void MainThreadBlockTask(T &blk, F fn) {
+  // blk -- data modified by task
+  // fn -- work for task
+#pragma omp task if (0) firstprivate(fn) depend(inout: blk)
+  fn();
+}
+
+#endif
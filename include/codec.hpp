@@ -0,0 +1,46 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef CODECHEADERDEF  // only if the macro CODECHEADERDEF is not defined
+                        // execute these lines of code
+#define CODECHEADERDEF  // define the macro
+
+/* This header contains the function declarations for the checksums and the
+lossless compression used in the restart files.
+
+The checksum is the CRC-32 used by zlib and gzip, so a chunk of a restart file
+can be checked with standard tools. The compression is made for smooth fields
+of doubles. Each value is XORed with the value before it, and since
+neighboring cells of a smooth field share their sign, exponent, and leading
+bits of mantissa, the result has leading zero bytes. Only the remaining bytes
+are stored, with a 4 bit count for each value. Two counts are packed into a
+control byte that comes before the bytes of the pair of values. Constant fields
+compress to 1/16 of their size.
+*/
+
+#include <cstdint>  // uint32_t
+#include <cstddef>  // size_t
+#include <vector>   // vector
+
+using std::vector;
+
+// function declarations
+uint32_t Crc32(const char *, const size_t &, uint32_t = 0);
+vector<char> CompressDoubles(const double *, const size_t &);
+bool DecompressDoubles(const char *, const size_t &, double *,
+                       const size_t &);
+
+#endif
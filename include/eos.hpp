@@ -21,6 +21,7 @@
 // This header file contains the equation of state classes
 
 #include <memory>
+#include <cmath>  // sqrt
 #include "vector3d.hpp"
 #include "thermodynamic.hpp"
 
@@ -42,15 +43,15 @@ class eos {
   eos& operator=(const eos&) = default;
 
   // Member functions for abstract base class
-  virtual double PressFromEnergy(const unique_ptr<thermodynamic> &thermo,
+  virtual double PressFromEnergy(const thermodynamic &thermo,
                                  const double &rho, const double &energy,
                                  const double &vel) const = 0;
   virtual double PressureRT(const double &rho,
                             const double &temperature) const = 0;
-  virtual double SpecEnergy(const unique_ptr<thermodynamic> &thermo,
+  virtual double SpecEnergy(const thermodynamic &thermo,
                             const double &t) const = 0;
   virtual double Energy(const double &specEn, const double &vel) const = 0;
-  virtual double Enthalpy(const unique_ptr<thermodynamic> &thermo,
+  virtual double Enthalpy(const thermodynamic &thermo,
                           const double &t, const double &vel) const = 0;
   virtual double SoS(const double &pressure, const double &rho) const = 0;
   virtual double Temperature(const double &pressure,
@@ -68,7 +69,7 @@ class eos {
 // The ideal gas equation of state is P = rho * R * T. In 
 // nondimensional from it is P = rho * T / gammaRef
 
-class idealGas : public eos {
+class idealGas final : public eos {
   const double gammaRef_;
   const double gasConst_;
 
@@ -87,20 +88,54 @@ class idealGas : public eos {
   idealGas& operator=(const idealGas&) = default;
 
   // Member functions
-  double PressFromEnergy(const unique_ptr<thermodynamic> &thermo,
-                         const double &rho, const double &energy,
-                         const double &vel) const override;
+  // the functions that take a thermodynamic model are templated so that when
+  // the concrete model type is known the calls to it are statically dispatched;
+  // the overrides forward to them with the abstract base class
+  template <typename T>
+  double PressFromEnergy(const T &thermo, const double &rho,
+                         const double &energy, const double &vel) const {
+    const auto specEnergy = energy - 0.5 * vel *vel;
+    const auto temperature = thermo.TemperatureFromSpecEnergy(specEnergy);
+    return this->PressureRT(rho, temperature);
+  }
+  double PressFromEnergy(const thermodynamic &thermo, const double &rho,
+                         const double &energy,
+                         const double &vel) const override {
+    return this->PressFromEnergy<thermodynamic>(thermo, rho, energy, vel);
+  }
   double PressureRT(const double &rho,
-                    const double &temperature) const override;
-  double SpecEnergy(const unique_ptr<thermodynamic> &thermo,
-                    const double &t) const override;
-  double Energy(const double &specEn, const double &vel) const override;
-  double Enthalpy(const unique_ptr<thermodynamic> &thermo, const double &t,
-                  const double &vel) const override;
-  double SoS(const double &pressure, const double &rho) const override;
-  double Temperature(const double &pressure, const double &rho) const override;
+                    const double &temperature) const override {
+    return temperature * rho / gammaRef_;
+  }
+  template <typename T>
+  double SpecEnergy(const T &thermo, const double &t) const {
+    return thermo.SpecEnergy(t);
+  }
+  double SpecEnergy(const thermodynamic &thermo,
+                    const double &t) const override {
+    return this->SpecEnergy<thermodynamic>(thermo, t);
+  }
+  double Energy(const double &specEn, const double &vel) const override {
+    return specEn + 0.5 * vel * vel;
+  }
+  template <typename T>
+  double Enthalpy(const T &thermo, const double &t, const double &vel) const {
+    return thermo.SpecEnthalpy(t) + 0.5 * vel * vel;
+  }
+  double Enthalpy(const thermodynamic &thermo, const double &t,
+                  const double &vel) const override {
+    return this->Enthalpy<thermodynamic>(thermo, t, vel);
+  }
+  double SoS(const double &pressure, const double &rho) const override {
+    return sqrt(gammaRef_ * pressure / rho);
+  }
+  double Temperature(const double &pressure,
+                     const double &rho) const override {
+    return pressure * gammaRef_ / rho;
+  }
   double PressureDim(const double &rho,
                      const double &temperature) const override;
+  double GammaRef() const { return gammaRef_; }
   // nondimensional version (R=1/gamma)
   double DensityTP(const double &temp, const double &press) const override {
     return press * gammaRef_ / temp;
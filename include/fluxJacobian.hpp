@@ -43,13 +43,13 @@ class genArray;
 
 class fluxJacobian {
   squareMatrix flowJacobian_;
-  squareMatrix turbJacobian_;
+  turbSquareMatrix turbJacobian_;
 
  public:
   // constructors
   fluxJacobian(const double &flow, const double &turb);
   fluxJacobian(const int &flowSize, const int &turbSize);
-  fluxJacobian(const squareMatrix &flow, const squareMatrix &turb)
+  fluxJacobian(const squareMatrix &flow, const turbSquareMatrix &turb)
       : flowJacobian_(flow), turbJacobian_(turb) {}
   fluxJacobian() : fluxJacobian(0.0, 0.0) {}
   explicit fluxJacobian(const uncoupledScalar &specRad) :
@@ -65,12 +65,14 @@ class fluxJacobian {
 
   // member functions
   squareMatrix FlowJacobian() const {return flowJacobian_;}
-  squareMatrix TurbulenceJacobian() const {return turbJacobian_;}
+  turbSquareMatrix TurbulenceJacobian() const {return turbJacobian_;}
 
   void AddToFlowJacobian(const squareMatrix &jac) {flowJacobian_ += jac;}
-  void AddToTurbJacobian(const squareMatrix &jac) {turbJacobian_ += jac;}
+  void AddToTurbJacobian(const turbSquareMatrix &jac) {turbJacobian_ += jac;}
   void SubtractFromFlowJacobian(const squareMatrix &jac) {flowJacobian_ -= jac;}
-  void SubtractFromTurbJacobian(const squareMatrix &jac) {turbJacobian_ -= jac;}
+  void SubtractFromTurbJacobian(const turbSquareMatrix &jac) {
+    turbJacobian_ -= jac;
+  }
 
   void MultiplyOnDiagonal(const double &, const bool &);
   void AddOnDiagonal(const double &, const bool &);
@@ -105,8 +107,9 @@ class fluxJacobian {
   }
 
   genArray ArrayMult(genArray) const;
+  genArray Solve(genArray) const;
   bool IsScalar() const;
-  void Inverse(const bool &);
+  void Factor(const bool &);
 
   inline fluxJacobian & operator+=(const fluxJacobian &);
   inline fluxJacobian & operator-=(const fluxJacobian &);
@@ -241,7 +244,22 @@ inline const fluxJacobian operator/(const double &lhs, fluxJacobian rhs) {
 
 ostream &operator<<(ostream &os, const fluxJacobian &jacobian);
 
+uncoupledScalar RusanovScalarSpecRad(const primVars &,
+                                     const unitVec3dMag<double> &,
+                                     const double &, const double &,
+                                     const double &, const double &,
+                                     const unique_ptr<eos> &,
+                                     const unique_ptr<thermodynamic> &,
+                                     const unique_ptr<transport> &,
+                                     const unique_ptr<turbModel> &,
+                                     const bool &, const bool &);
 genArray RusanovScalarOffDiagonal(const primVars &, const genArray &,
+                                  const unitVec3dMag<double> &,
+                                  const uncoupledScalar &,
+                                  const unique_ptr<eos> &,
+                                  const unique_ptr<thermodynamic> &,
+                                  const unique_ptr<turbModel> &, const bool &);
+fluxJacobian RusanovBlockJacobian(const primVars &,
                                   const unitVec3dMag<double> &,
                                   const double &, const double &,
                                   const double &, const double &,
@@ -249,28 +267,40 @@ genArray RusanovScalarOffDiagonal(const primVars &, const genArray &,
                                   const unique_ptr<thermodynamic> &,
                                   const unique_ptr<transport> &,
                                   const unique_ptr<turbModel> &,
-                                  const bool &, const bool &);
-genArray RusanovBlockOffDiagonal(const primVars &, const genArray &,
-                                 const unitVec3dMag<double> &,
-                                 const double &, const double &,
-                                 const double &, const double &,
-                                 const unique_ptr<eos> &,
-                                 const unique_ptr<thermodynamic> &,
-                                 const unique_ptr<transport> &,
-                                 const unique_ptr<turbModel> &,
-                                 const input &, const bool &,
-                                 const tensor<double> &);
+                                  const input &, const bool &,
+                                  const tensor<double> &);
 
+uncoupledScalar RoeViscousSpecRad(const primVars &,
+                                  const unitVec3dMag<double> &,
+                                  const double &, const double &,
+                                  const double &, const double &,
+                                  const unique_ptr<eos> &,
+                                  const unique_ptr<thermodynamic> &,
+                                  const unique_ptr<transport> &,
+                                  const unique_ptr<turbModel> &, const bool &,
+                                  const bool &);
 genArray RoeOffDiagonal(const primVars &, const primVars &,
-                        const genArray &,
-                        const unitVec3dMag<double> &, const double &,
-                        const double &, const double &,
-                        const double &, const unique_ptr<eos> &,
+                        const genArray &, const unitVec3dMag<double> &,
+                        const uncoupledScalar &, const unique_ptr<eos> &,
                         const unique_ptr<thermodynamic> &,
-                        const unique_ptr<transport> &,
-                        const unique_ptr<turbModel> &, const bool &,
-                        const bool &, const bool &);
-
+                        const unique_ptr<turbModel> &, const bool &);
+
+bool IsBlockOffDiagonal(const input &);
+uncoupledScalar OffDiagonalSpecRad(const primVars &,
+                                   const unitVec3dMag<double> &,
+                                   const double &, const double &,
+                                   const double &, const double &,
+                                   const unique_ptr<eos> &,
+                                   const unique_ptr<thermodynamic> &,
+                                   const unique_ptr<transport> &,
+                                   const unique_ptr<turbModel> &,
+                                   const input &, const bool &);
+genArray OffDiagonal(const primVars &, const primVars &, const genArray &,
+                     const unitVec3dMag<double> &, const uncoupledScalar &,
+                     const unique_ptr<eos> &,
+                     const unique_ptr<thermodynamic> &,
+                     const unique_ptr<turbModel> &, const input &,
+                     const bool &);
 genArray OffDiagonal(const primVars &, const primVars &, const genArray &,
                      const unitVec3dMag<double> &, const double &,
                      const double &, const double &, const double &,
@@ -0,0 +1,370 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef HALOEXCHANGEHEADERDEF  // only if the macro HALOEXCHANGEHEADERDEF is not
+                               // defined execute these lines of code
+#define HALOEXCHANGEHEADERDEF  // define the macro
+
+/* This file contains a class to exchange the ghost cells at connection
+   boundaries with other processors. All of the connections between this
+   processor and a neighboring processor are sent as one message, and the
+   messages use persistent requests and buffers that are sized once and
+   reused every time a field is exchanged. Fields that are exchanged together
+   are packed into the same message, so the whole set costs one message per
+   neighboring processor instead of one per field. Within a message the slice
+   of each connection holds each of the fields in turn.
+
+   The cells sent and received across each connection are found once, in the
+   form of index maps into the block arrays that include the orientation of
+   the connection. The cells are gathered from the block straight into the
+   send buffer and scattered from the receive buffer straight into the ghost
+   cells.
+
+   The slice sent across a connection extends into the ghost cells at its
+   edges, and those edge ghost cells may be filled by an earlier connection
+   of the same block. To get the same result as swapping the connections one
+   at a time in order, the connections are grouped into rounds. A connection
+   is put in a later round than any earlier connection that writes cells it
+   reads or writes. All messages of a round are sent at once, and a round is
+   finished before the next one starts. Most grids need only one or two
+   rounds.
+ */
+
+#include <vector>                  // vector
+#include <array>                   // array
+#include <map>                     // map
+#include <iostream>                // cerr
+#include <algorithm>               // copy_n
+#include "mpi.h"                   // parallelism
+#include "multiArray3d.hpp"        // multiArray3d
+#include "boundaryConditions.hpp"  // connection
+#include "blockTasks.hpp"          // MainThreadBlockTask, BlockPairTask
+
+using std::vector;
+using std::array;
+using std::map;
+using std::cerr;
+using std::endl;
+
+// fields that are exchanged at connection boundaries
+enum class haloField {
+  state,            // primative variables
+  update,           // implicit update
+  f1,               // turbulence model blending function f1
+  f2,               // turbulence model blending function f2
+  wallDist,         // wall distance
+  eddyViscosity,    // eddy viscosity
+  velocityGrad,     // velocity gradient
+  temperatureGrad,  // temperature gradient
+  tkeGrad,          // tke gradient
+  omegaGrad,        // omega gradient
+  numFields         // number of fields; not a field
+};
+
+// indices of the cells of an array that are sent and received across a
+// connection
+struct haloIndexMap {
+  int arrSize = -1;    // size of array the maps were found for
+  vector<int> pack;    // array index of each cell sent, in send order
+  vector<int> unpack;  // array index of each cell received, -1 if not used
+};
+
+// buffers and persistent requests for a set of fields exchanged together;
+// there is one entry for each message in each vector
+struct haloPacket {
+  vector<haloField> fields;  // fields in packet
+  vector<int> fieldOffset;   // offset of each field in a cell (doubles)
+  int cellSize = 0;          // number of doubles in each cell for all fields
+  vector<vector<double>> send;
+  vector<vector<double>> recv;
+  vector<MPI_Request> sendReq;
+  vector<MPI_Request> recvReq;
+  vector<int> packed;  // number of doubles packed into send buffer
+};
+
+class haloExchange {
+  vector<connection> connections_;  // all connections in domain
+  int rank_;                        // processor rank
+  int numGhosts_;                   // number of ghost cell layers
+  vector<int> round_;               // round of each connection
+  vector<vector<int>> roundConns_;  // connections on processor in each round
+  // messages to other processors; one per neighboring processor per round
+  vector<int> msgPeer_;   // rank of processor message is exchanged with
+  vector<int> msgRound_;  // round of message
+  vector<int> msgCells_;  // number of cells in message
+  vector<int> connMsg_;   // message of each connection (-1 if not sent)
+  vector<int> connOffset_;  // offset of connection slice in message (cells)
+  vector<haloPacket> packets_;  // buffers for each set of fields exchanged
+  int active_;                   // packet being exchanged (-1 if none)
+  map<array<int, 2>, haloIndexMap> maps_;  // maps for each field, connection
+
+  // private member functions
+  void SideCells(const connection &, const bool &, array<int, 6> &,
+                 array<int, 6> &) const;
+  void InitializePacket(haloPacket &) const;
+  void PartnerSliceSize(const int &, int &, int &, int &) const;
+  double * FieldBuffer(const haloField &, const int &, const int &,
+                       const int &, const bool &);
+  template <typename T>
+  const haloIndexMap & IndexMap(const haloField &, const int &,
+                                const multiArray3d<T> &);
+
+ public:
+  // constructor
+  haloExchange(const vector<connection> &, const int &, const int &);
+  haloExchange() : haloExchange(vector<connection>(), 0, 0) {}
+
+  // move constructor and assignment operator
+  haloExchange(haloExchange&&) noexcept = default;
+  haloExchange& operator=(haloExchange&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  // persistent requests are tied to the buffers, so no copying
+  haloExchange(const haloExchange&) = delete;
+  haloExchange& operator=(const haloExchange&) = delete;
+
+  // member functions
+  int NumRounds() const { return roundConns_.size(); }
+  int NumMessages() const { return msgPeer_.size(); }
+  int Round(const int &cc) const { return round_[cc]; }
+  const vector<int> & RoundConnections(const int &rr) const {
+    return roundConns_[rr];
+  }
+  const connection & Connection(const int &cc) const {
+    return connections_[cc];
+  }
+  bool IsLocal(const int &cc) const {
+    return connections_[cc].RankFirst() == connections_[cc].RankSecond();
+  }
+  int LocalBlock(const int &cc) const {
+    return connections_[cc].RankFirst() == rank_
+        ? connections_[cc].LocalBlockFirst()
+        : connections_[cc].LocalBlockSecond();
+  }
+
+  void Start(const vector<haloField> &);
+  void Finish();
+  template <typename T>
+  void Pack(const haloField &, const int &, const multiArray3d<T> &);
+  template <typename T>
+  void Unpack(const haloField &, const int &, multiArray3d<T> &);
+  void FreeRequests();
+
+  // destructor
+  // requests must be freed with FreeRequests before MPI_Finalize
+  ~haloExchange() noexcept {}
+};
+
+// ----------------------------------------------------------------------------
+// member function to get the index maps of a field for a connection; they are
+// found the first time the field is exchanged across the connection
+template <typename T>
+const haloIndexMap & haloExchange::IndexMap(const haloField &field,
+                                            const int &cc,
+                                            const multiArray3d<T> &arr) {
+  // field -- field to exchange
+  // cc -- connection index
+  // arr -- array for field in block on this processor
+
+  auto &maps = maps_[{static_cast<int>(field), cc}];
+  if (maps.arrSize == arr.Size()) {
+    return maps;
+  }
+  maps.arrSize = arr.Size();
+
+  const auto &conn = connections_[cc];
+  const auto numGhosts = arr.GhostLayers();
+  const auto base = &(*arr.begin());
+
+  // cells sent are the slice of the local block in its i, j, k order
+  auto is = 0, ie = 0;
+  auto js = 0, je = 0;
+  auto ks = 0, ke = 0;
+  if (rank_ == conn.RankFirst()) {
+    conn.FirstSliceIndices(is, ie, js, je, ks, ke, numGhosts);
+  } else {
+    conn.SecondSliceIndices(is, ie, js, je, ks, ke, numGhosts);
+  }
+  maps.pack.clear();
+  maps.pack.reserve((ie - is) * (je - js) * (ke - ks));
+  for (auto kk = ks; kk < ke; kk++) {
+    for (auto jj = js; jj < je; jj++) {
+      for (auto ii = is; ii < ie; ii++) {
+        maps.pack.push_back(&arr(ii, jj, kk) - base);
+      }
+    }
+  }
+
+  // cells received are the slice of the partner block in its i, j, k order;
+  // they are inserted into the ghost cells in the same way as PutSlice
+  auto ni = 0, nj = 0, nk = 0;
+  this->PartnerSliceSize(cc, ni, nj, nk);
+  auto connAdj = conn;
+  connAdj.AdjustForSlice(rank_ == conn.RankFirst(), numGhosts);
+  if (connAdj.Dir1LenFirst() * connAdj.Dir2LenFirst() * numGhosts !=
+      ni * nj * nk) {
+    cerr << "ERROR: Error in haloExchange::IndexMap(). Number of cells "
+         << "received across connection " << cc << " does not match ghost "
+         << "cells to insert into." << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // edges that border another connection are not inserted
+  const auto adjS1 = connAdj.Dir1StartInterBorderFirst() ? numGhosts : 0;
+  const auto adjE1 = connAdj.Dir1EndInterBorderFirst() ? numGhosts : 0;
+  const auto adjS2 = connAdj.Dir2StartInterBorderFirst() ? numGhosts : 0;
+  const auto adjE2 = connAdj.Dir2EndInterBorderFirst() ? numGhosts : 0;
+
+  maps.unpack.assign(ni * nj * nk, -1);
+  for (auto l3 = 0; l3 < numGhosts; l3++) {
+    for (auto l2 = adjS2; l2 < connAdj.Dir2LenFirst() - adjE2; l2++) {
+      for (auto l1 = adjS1; l1 < connAdj.Dir1LenFirst() - adjE1; l1++) {
+        const auto indA = GetSwapLoc(l1, l2, l3, numGhosts, connAdj,
+                                     numGhosts, true);
+        const auto indI = GetSwapLoc(l1, l2, l3, 0, connAdj, numGhosts, false);
+        maps.unpack[indI[0] + ni * (indI[1] + nj * indI[2])] =
+            &arr(indA[0], indA[1], indA[2]) - base;
+      }
+    }
+  }
+  return maps;
+}
+
+// member function to gather the slice of an array that is sent across a
+// connection into the send buffer for its message; the message is sent once
+// all fields of all of its connections are packed
+template <typename T>
+void haloExchange::Pack(const haloField &field, const int &cc,
+                        const multiArray3d<T> &arr) {
+  // field -- field to pack
+  // cc -- connection index
+  // arr -- array for field in block on this processor
+
+  constexpr auto cellSize = static_cast<int>(sizeof(T) / sizeof(double));
+  const auto &pack = this->IndexMap(field, cc, arr).pack;
+  const auto buf = this->FieldBuffer(field, cc, pack.size(), sizeof(T), true);
+  const auto data = reinterpret_cast<const double *>(&(*arr.begin()));
+  for (auto nn = 0U; nn < pack.size(); nn++) {
+    std::copy_n(data + pack[nn] * cellSize, cellSize, buf + nn * cellSize);
+  }
+
+  // send message once all of its connections are packed
+  const auto msg = connMsg_[cc];
+  auto &pkt = packets_[active_];
+  pkt.packed[msg] += pack.size() * cellSize;
+  if (pkt.packed[msg] == msgCells_[msg] * pkt.cellSize) {
+    MPI_Start(&pkt.sendReq[msg]);
+  }
+}
+
+// member function to wait for the message holding the slice of a connection
+// and scatter the slice of one field into the ghost cells of an array
+template <typename T>
+void haloExchange::Unpack(const haloField &field, const int &cc,
+                          multiArray3d<T> &arr) {
+  // field -- field to unpack
+  // cc -- connection index
+  // arr -- array for field in block on this processor
+
+  constexpr auto cellSize = static_cast<int>(sizeof(T) / sizeof(double));
+  const auto &unpack = this->IndexMap(field, cc, arr).unpack;
+  const auto buf = this->FieldBuffer(field, cc, unpack.size(), sizeof(T),
+                                     false);
+  MPI_Wait(&packets_[active_].recvReq[connMsg_[cc]], MPI_STATUS_IGNORE);
+
+  auto data = reinterpret_cast<double *>(&(*arr.begin()));
+  for (auto nn = 0U; nn < unpack.size(); nn++) {
+    if (unpack[nn] >= 0) {
+      std::copy_n(buf + nn * cellSize, cellSize, data + unpack[nn] * cellSize);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+/* Function to create the tasks to exchange fields at the connection
+   boundaries. For each round the slices sent to other processors are packed,
+   the connections with both blocks on this processor are swapped, and then
+   the slices received from other processors are unpacked. The packing and
+   unpacking tasks make MPI calls, so they run on the main thread. This must be
+   called from within RunBlockTasks.
+
+   The overlap function is called once the messages of the first round are
+   sent and before any are waited on. The tasks it creates run while the
+   messages are in flight, so they must not use the ghost cells at connection
+   boundaries.
+ */
+template <typename T, typename FP, typename FS, typename FU, typename FO>
+void HaloExchangeTasks(vector<T> &blks, haloExchange &halo,
+                       const vector<haloField> &fields, const FP &pack,
+                       const FS &swap, const FU &unpack, const FO &overlap) {
+  // blks -- data for each block on processor that the tasks modify
+  // halo -- exchange for connection boundaries
+  // fields -- fields to exchange together
+  // pack -- function to pack slices of a connection and local block
+  // swap -- function to swap slices of a connection and two local blocks
+  // unpack -- function to unpack slices of a connection into a local block
+  // overlap -- function to create tasks to run during the exchange
+
+  halo.Start(fields);
+
+  for (auto rr = 0; rr < halo.NumRounds(); rr++) {
+    // pack slices to send to other processors
+    for (const auto &cc : halo.RoundConnections(rr)) {
+      if (!halo.IsLocal(cc)) {
+        const auto bb = halo.LocalBlock(cc);
+        MainThreadBlockTask(blks[bb], [=]() { pack(cc, bb); });
+      }
+    }
+
+    // swap slices between blocks on this processor
+    for (const auto &cc : halo.RoundConnections(rr)) {
+      if (halo.IsLocal(cc)) {
+        const auto first = halo.Connection(cc).LocalBlockFirst();
+        const auto second = halo.Connection(cc).LocalBlockSecond();
+        BlockPairTask(blks[first], blks[second],
+                      [=]() { swap(cc, first, second); });
+      }
+    }
+
+    if (rr == 0) {
+      overlap();
+    }
+
+    // unpack slices received from other processors
+    for (const auto &cc : halo.RoundConnections(rr)) {
+      if (!halo.IsLocal(cc)) {
+        const auto bb = halo.LocalBlock(cc);
+        MainThreadBlockTask(blks[bb], [=]() { unpack(cc, bb); });
+      }
+    }
+  }
+  if (halo.NumRounds() == 0) {
+    overlap();
+  }
+
+  halo.Finish();
+}
+
+// function to create the tasks to exchange fields at the connection
+// boundaries with no other work during the exchange
+template <typename T, typename FP, typename FS, typename FU>
+void HaloExchangeTasks(vector<T> &blks, haloExchange &halo,
+                       const vector<haloField> &fields, const FP &pack,
+                       const FS &swap, const FU &unpack) {
+  HaloExchangeTasks(blks, halo, fields, pack, swap, unpack, []() {});
+}
+
+#endif
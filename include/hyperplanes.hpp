@@ -0,0 +1,64 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef HYPERPLANESHEADERDEF  // only if the macro HYPERPLANESHEADERDEF is not
+                              // defined execute these lines of code
+#define HYPERPLANESHEADERDEF  // define the macro
+
+/* This file contains a class to store the cells of a block ordered by
+   hyperplane. A hyperplane is a plane of i+j+k=constant within a block. The
+   cells of each hyperplane are stored contiguously, and the hyperplanes are
+   in order of increasing i+j+k. Within a hyperplane the cells are in k, j, i
+   loop order. The ordering only depends on the block dimensions, so it is
+   calculated once per block.
+ */
+
+#include <vector>          // vector
+#include "vector3d.hpp"    // vector3d
+
+using std::vector;
+
+class hyperplanes {
+  vector<vector3d<int>> cells_;  // cells ordered by hyperplane
+  vector<int> start_;  // index of first cell in each hyperplane, and the
+                       // total number of cells at the end
+
+ public:
+  // constructors
+  hyperplanes(const int &, const int &, const int &);
+  hyperplanes() : start_(1, 0) {}
+
+  // move constructor and assignment operator
+  hyperplanes(hyperplanes&&) noexcept = default;
+  hyperplanes& operator=(hyperplanes&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  hyperplanes(const hyperplanes&) = default;
+  hyperplanes& operator=(const hyperplanes&) = default;
+
+  // member functions
+  int NumPlanes() const { return start_.size() - 1; }
+  int NumCells() const { return cells_.size(); }
+  // cells on hyperplane pp are in [PlaneStart(pp), PlaneEnd(pp))
+  int PlaneStart(const int &pp) const { return start_[pp]; }
+  int PlaneEnd(const int &pp) const { return start_[pp + 1]; }
+  const vector3d<int> & operator[](const int &nn) const { return cells_[nn]; }
+
+  // destructor
+  ~hyperplanes() noexcept {}
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef IMPLICITDIAGONALHEADERDEF  // only if the macro IMPLICITDIAGONALHEADERDEF
+                                   // is not defined execute these lines of code
+#define IMPLICITDIAGONALHEADERDEF  // define the macro
+
+/* This file contains a class to store the main diagonal of the implicit matrix
+   for each cell of a block. Block matrix solvers store a full flux jacobian in
+   each cell. Scalar solvers only need the flow and turbulence spectral radii,
+   so they store an uncoupledScalar in each cell instead of a flux jacobian
+   with fixed size matrices that would go unused. Only one of the two arrays is
+   allocated, depending on the solver in use.
+ */
+
+#include <iostream>            // cerr
+#include <cstdlib>             // exit
+#include "multiArray3d.hpp"    // multiArray3d
+#include "fluxJacobian.hpp"    // fluxJacobian
+#include "uncoupledScalar.hpp"  // uncoupledScalar
+#include "genArray.hpp"        // genArray
+
+using std::cerr;
+using std::endl;
+
+class implicitDiagonal {
+  multiArray3d<fluxJacobian> block_;      // block matrix solvers
+  multiArray3d<uncoupledScalar> scalar_;  // scalar solvers
+
+ public:
+  // constructor
+  implicitDiagonal() {}
+
+  // move constructor and assignment operator
+  implicitDiagonal(implicitDiagonal&&) noexcept = default;
+  implicitDiagonal& operator=(implicitDiagonal&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  implicitDiagonal(const implicitDiagonal&) = default;
+  implicitDiagonal& operator=(const implicitDiagonal&) = default;
+
+  // member functions
+  // allocate the diagonal for a block with the given number of cells; the
+  // type of the initial value determines which storage is used
+  void ClearResize(const int &ni, const int &nj, const int &nk,
+                   const fluxJacobian &init) {
+    block_.ClearResize(ni, nj, nk, 0, init);
+    scalar_.ClearResize(0, 0, 0, 0);
+  }
+  void ClearResize(const int &ni, const int &nj, const int &nk,
+                   const uncoupledScalar &init) {
+    scalar_.ClearResize(ni, nj, nk, 0, init);
+    block_.ClearResize(0, 0, 0, 0);
+  }
+  bool IsBlock() const { return block_.Size() > 0; }
+
+  void Zero() {
+    block_.Zero();
+    scalar_.Zero();
+  }
+
+  fluxJacobian & Block(const int &ii, const int &jj, const int &kk) {
+    return block_(ii, jj, kk);
+  }
+  uncoupledScalar & Scalar(const int &ii, const int &jj, const int &kk) {
+    return scalar_(ii, jj, kk);
+  }
+
+  inline void Factor(const int &, const int &, const int &, const double &,
+                     const double &, const bool &);
+  inline genArray Solve(const int &, const int &, const int &,
+                        const genArray &) const;
+
+  // destructor
+  ~implicitDiagonal() noexcept {}
+};
+
+// ----------------------------------------------------------------------------
+// member function to relax the diagonal of a cell, add the time term, and
+// factor it so that it can be used in Solve; a factored scalar diagonal holds
+// its reciprocal
+void implicitDiagonal::Factor(const int &ii, const int &jj, const int &kk,
+                              const double &relax, const double &diagVolTime,
+                              const bool &isRANS) {
+  // ii -- i-location of cell
+  // jj -- j-location of cell
+  // kk -- k-location of cell
+  // relax -- matrix relaxation factor
+  // diagVolTime -- time term to add to the diagonal
+  // isRANS -- flag identifying if simulation is turbulent
+
+  if (this->IsBlock()) {
+    block_(ii, jj, kk).MultiplyOnDiagonal(relax, isRANS);
+    block_(ii, jj, kk).AddOnDiagonal(diagVolTime, isRANS);
+    block_(ii, jj, kk).Factor(isRANS);
+  } else {
+    auto &diag = scalar_(ii, jj, kk);
+    auto flow = diag.FlowVariable() * relax + diagVolTime;
+    auto turb = diag.TurbVariable();
+    if (isRANS) {
+      turb = turb * relax + diagVolTime;
+    }
+    if (flow == 0.0 || (isRANS && turb == 0.0)) {
+      cerr << "ERROR: Singular main diagonal at cell " << ii << ", " << jj
+           << ", " << kk << endl;
+      exit(EXIT_FAILURE);
+    }
+    flow = 1.0 / flow;
+    if (isRANS) {
+      turb = 1.0 / turb;
+    }
+    diag = uncoupledScalar(flow, turb);
+  }
+}
+
+// member function to solve the system given by the factored diagonal of a cell
+// with a genArray as the right hand side
+genArray implicitDiagonal::Solve(const int &ii, const int &jj, const int &kk,
+                                 const genArray &arr) const {
+  // ii -- i-location of cell
+  // jj -- j-location of cell
+  // kk -- k-location of cell
+  // arr -- right hand side
+  return this->IsBlock() ? block_(ii, jj, kk).Solve(arr) :
+      scalar_(ii, jj, kk).ArrayMult(arr);
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include "boundaryConditions.hpp"
 #include "inputStates.hpp"
 #include "fluid.hpp"
+#include "inputEnums.hpp"
 #include "macros.hpp"
 
 using std::vector;
@@ -79,12 +80,36 @@ class input {
   double dualTimeCFL_;  // cfl_ number for dual time
   string inviscidFlux_;  // scheme for inviscid flux calculation
   string decompMethod_;  // method of decomposition for parallel problems
+  string startupMethod_;  // set up blocks on root or on their own processors
   string turbModel_;  // turbulence model
   string thermodynamicModel_;  // model for thermodynamics
   string equationOfState_;  // model for equation of state
   string transportModel_;  // model for viscous transport
+  double thermoTableTolerance_;  // tolerance for tabulated tpg properties
+  double thermoTableTemperatureMin_;  // minimum temperature in tpg tables
+  double thermoTableTemperatureMax_;  // maximum temperature in tpg tables
+  int thermoTableNewtonIterations_;  // Newton iterations to polish T(e)
   int restartFrequency_;  // how often to output restart data
+  string outputMethod_;  // write output blocking or asynchronously
+  string restartCompression_;  // codec for restart file data
   int iterationStart_;  // starting number for iterations
+  int arrayPadding_;  // extra elements at end of i-lines in block arrays
+  string faceFluxPasses_;  // fused or separate inviscid/viscous face passes
+  string viscousGradients_;  // face or cell based viscous gradients
+  int numThreads_;  // threads per processor for block loops
+  string matrixOffDiagonals_;  // recompute or stored off diagonal operators
+  int inviscidFluxCheck_;  // faces in startup check of line flux kernels
+
+  // string options resolved to enumerations after the input file is read
+  reconstruction reconstruction_;  // inviscid face reconstruction family
+  limiterType limiterType_;  // limiter for MUSCL reconstruction
+  inviscidFluxScheme inviscidFluxScheme_;  // inviscid flux scheme
+  timeIntegrator timeIntegrator_;  // time integration method
+  viscousReconstruction viscousReconstruction_;  // viscous face reconstruction
+  fluxPasses fluxPasses_;  // fused or separate inviscid/viscous face passes
+  gradientLocation gradientLocation_;  // face or cell based viscous gradients
+  bool isImplicit_;  // flag for implicit time integration
+  bool isBlockMatrix_;  // flag for block matrix on main diagonal
 
   set<string> outputVariables_;  // variables to output
   set<string> wallOutputVariables_;  // wall variables to output
@@ -98,6 +123,7 @@ class input {
   void CheckWallOutputVariables();
   void CheckTurbulenceModel() const;
   void CheckSpecies() const;
+  void ResolveOptions();
 
  public:
   // constructor
@@ -112,11 +138,11 @@ class input {
   input& operator=(const input&) = default;
 
   // member functions
-  string SimName() const {return simName_;}
+  const string & SimName() const {return simName_;}
   string SimNameRoot() const;
-  string RestartName() const {return restartName_;}
+  const string & RestartName() const {return restartName_;}
   bool IsRestart() const {return restartName_ != "none";}
-  string GridName() const {return gName_;}
+  const string & GridName() const {return gName_;}
 
   double Dt() const {return dt_;}
 
@@ -135,18 +161,27 @@ class input {
   vector<boundaryConditions> AllBC() const { return bc_; }
   int NumBC() const { return bc_.size(); }
 
-  string TimeIntegration() const { return timeIntegration_; }
-  bool IsMultilevelInTime() const { return timeIntegration_ == "bdf2"; }
+  const string & TimeIntegration() const { return timeIntegration_; }
+  timeIntegrator TimeIntegrator() const { return timeIntegrator_; }
+  bool IsMultilevelInTime() const {
+    return timeIntegrator_ == timeIntegrator::bdf2;
+  }
   bool NeedToStoreTimeN() const {
-    return this->IsImplicit() || this->TimeIntegration() == "rk4";
+    return this->IsImplicit() || timeIntegrator_ == timeIntegrator::rk4;
   }
 
   double CFL() const {return cfl_;}
   void CalcCFL(const int &i);
 
   double Kappa() const {return kappa_;}
-  string FaceReconstruction() const {return faceReconstruction_;}
-  string ViscousFaceReconstruction() const {return viscousFaceReconstruction_;}
+  const string & FaceReconstruction() const {return faceReconstruction_;}
+  const string & ViscousFaceReconstruction() const {
+    return viscousFaceReconstruction_;
+  }
+  reconstruction Reconstruction() const { return reconstruction_; }
+  viscousReconstruction ViscousReconstruction() const {
+    return viscousReconstruction_;
+  }
   bool UsingConstantReconstruction() const {
     return faceReconstruction_ == "constant";
   }
@@ -155,24 +190,31 @@ class input {
     return faceReconstruction_ == "weno" || faceReconstruction_ == "wenoZ";
   }
 
-  string Limiter() const {return limiter_;}
+  const string & Limiter() const {return limiter_;}
+  limiterType LimiterType() const {return limiterType_;}
 
   int OutputFrequency() const {return outputFrequency_;}
   int RestartFrequency() const {return restartFrequency_;}
-  set<string> OutputVariables() const {return outputVariables_;}
-  set<string> WallOutputVariables() const {return wallOutputVariables_;}
+  const string & OutputMethod() const {return outputMethod_;}
+  bool IsAsynchronousOutput() const {return outputMethod_ == "asynchronous";}
+  const string & RestartCompression() const {return restartCompression_;}
+  const set<string> & OutputVariables() const {return outputVariables_;}
+  const set<string> & WallOutputVariables() const {
+    return wallOutputVariables_;
+  }
 
   bool WriteOutput(const int &nn) const {return (nn + 1) % outputFrequency_ == 0;}
   bool WriteRestart(const int &nn) const {
     return (restartFrequency_ == 0) ? false : (nn + 1) % restartFrequency_ == 0;
   }
 
-  string EquationSet() const {return equationSet_;}
+  const string & EquationSet() const {return equationSet_;}
 
-  string MatrixSolver() const {return matrixSolver_;}
+  const string & MatrixSolver() const {return matrixSolver_;}
   int MatrixSweeps() const {return matrixSweeps_;}
   double MatrixRelaxation() const {return matrixRelaxation_;}
   bool MatrixRequiresInitialization() const;
+  bool MatrixUsesHyperplanes() const;
 
   double Theta() const {return timeIntTheta_;}
   double Zeta() const {return timeIntZeta_;}
@@ -183,17 +225,46 @@ class input {
   double CFLStep() const {return cflStep_;}
   double CFLStart() const {return cflStart_;}
 
-  string InvFluxJac() const {return invFluxJac_;}
+  const string & InvFluxJac() const {return invFluxJac_;}
 
   double DualTimeCFL() const {return dualTimeCFL_;}
 
-  string InviscidFlux() const {return inviscidFlux_;}
+  const string & InviscidFlux() const {return inviscidFlux_;}
+  inviscidFluxScheme InviscidFluxScheme() const {return inviscidFluxScheme_;}
+
+  const string & DecompMethod() const {return decompMethod_;}
+  const string & StartupMethod() const {return startupMethod_;}
+  bool IsDistributedStartup() const {return startupMethod_ == "distributed";}
+  const string & TurbulenceModel() const {return turbModel_;}
+  const string & ThermodynamicModel() const {return thermodynamicModel_;}
+  const string & EquationOfState() const {return equationOfState_;}
+  const string & TransportModel() const {return transportModel_;}
+  double ThermoTableTolerance() const {return thermoTableTolerance_;}
+  double ThermoTableTemperatureMin() const {
+    return thermoTableTemperatureMin_;
+  }
+  double ThermoTableTemperatureMax() const {
+    return thermoTableTemperatureMax_;
+  }
+  int ThermoTableNewtonIterations() const {
+    return thermoTableNewtonIterations_;
+  }
 
-  string DecompMethod() const {return decompMethod_;}
-  string TurbulenceModel() const {return turbModel_;}
-  string ThermodynamicModel() const {return thermodynamicModel_;}
-  string EquationOfState() const {return equationOfState_;}
-  string TransportModel() const {return transportModel_;}
+  int ArrayPadding() const {return arrayPadding_;}
+  const string & FaceFluxPasses() const {return faceFluxPasses_;}
+  fluxPasses FluxPasses() const {return fluxPasses_;}
+  bool IsFusedFaceFlux() const {return fluxPasses_ == fluxPasses::fused;}
+  const string & ViscousGradients() const {return viscousGradients_;}
+  gradientLocation GradientLocation() const {return gradientLocation_;}
+  bool IsCellGradients() const {
+    return gradientLocation_ == gradientLocation::cell;
+  }
+  int NumThreads() const {return numThreads_;}
+  const string & MatrixOffDiagonals() const {return matrixOffDiagonals_;}
+  bool StoreOffDiagonals() const {
+    return isImplicit_ && matrixOffDiagonals_ == "stored";
+  }
+  int InviscidFluxCheck() const {return inviscidFluxCheck_;}
 
   int NumVars() const {return vars_.size();}
   int NumVarsOutput() const {return outputVariables_.size();}
@@ -204,12 +275,12 @@ class input {
 
   void ReadInput(const int &);
 
-  bool IsImplicit() const;
+  bool IsImplicit() const {return isImplicit_;}
   bool IsViscous() const;
   bool IsTurbulent() const;
   bool IsRANS() const;
   bool IsLES() const;
-  bool IsBlockMatrix() const;
+  bool IsBlockMatrix() const {return isBlockMatrix_;}
 
   string OrderOfAccuracy() const;
 
@@ -226,7 +297,7 @@ class input {
   const shared_ptr<inputState> & BCData(const int &) const;
   fluid Fluid(const int = 0) const;
 
-  bool IsWenoZ() const {return this->FaceReconstruction() == "wenoZ";}
+  bool IsWenoZ() const {return reconstruction_ == reconstruction::wenoZ;}
 
   // destructor
   ~input() noexcept {}
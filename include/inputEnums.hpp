@@ -0,0 +1,76 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef INPUTENUMSHEADERDEF  // only if the macro INPUTENUMSHEADERDEF is not
+                             // defined execute these lines of code
+#define INPUTENUMSHEADERDEF  // define the macro
+
+/* This file contains enumerations for the string options in the input file
+   that are queried inside of the cell and face loops. The input class resolves
+   each string to its enumeration once after the input file is read so that the
+   kernels can switch (or be specialized) on an integer instead of comparing
+   strings.
+ */
+
+// face reconstruction family for the inviscid flux
+enum class reconstruction {
+  constant,  // first order
+  muscl,     // upwind, fromm, quick, central, thirdOrder
+  weno,
+  wenoZ
+};
+
+// limiter for MUSCL reconstruction
+enum class limiterType {
+  none,
+  vanAlbada,
+  minmod
+};
+
+// scheme for inviscid flux calculation
+enum class inviscidFluxScheme {
+  roe,
+  ausm
+};
+
+// time integration method
+enum class timeIntegrator {
+  explicitEuler,
+  rk4,
+  implicitEuler,
+  crankNicholson,
+  bdf2
+};
+
+// face reconstruction for the viscous flux
+enum class viscousReconstruction {
+  central,
+  centralFourth
+};
+
+// passes over the faces for the inviscid and viscous fluxes
+enum class fluxPasses {
+  separate,
+  fused
+};
+
+// control volume used for the gradients in the viscous flux
+enum class gradientLocation {
+  face,
+  cell
+};
+
+#endif
@@ -23,7 +23,10 @@
 #include <iostream>      // cout
 #include <memory>        // unique_ptr
 #include "vector3d.hpp"  // vector3d
+#include "inputEnums.hpp"  // inviscidFluxScheme
+#include "lineArray.hpp"   // lineArray
 #include "macros.hpp"
+#include "matrix.hpp"      // squareMatrix
 
 using std::vector;
 using std::string;
@@ -38,8 +41,9 @@ class eos;
 class thermodynamic;
 class primVars;
 class genArray;
-class squareMatrix;
 class turbModel;
+class idealGas;
+class caloricallyPerfect;
 
 class inviscidFlux {
   double data_[NUMVARS];  // rho dot velocity vector
@@ -49,8 +53,8 @@ class inviscidFlux {
   // rho dot velocity vector * enthalpy
 
   // private member functions
-  void ConstructFromPrim(const primVars &, const unique_ptr<eos> &,
-                         const unique_ptr<thermodynamic> &,
+  template <typename E, typename T>
+  void ConstructFromPrim(const primVars &, const E &, const T &,
                          const vector3d<double> &);
 
  public:
@@ -58,6 +62,9 @@ class inviscidFlux {
   inviscidFlux() : data_{0.0} {}
   inviscidFlux(const primVars &, const unique_ptr<eos> &,
                const unique_ptr<thermodynamic> &, const vector3d<double> &);
+  template <typename E, typename T>
+  inviscidFlux(const primVars &, const E &, const T &,
+               const vector3d<double> &);
   inviscidFlux(const genArray &, const unique_ptr<eos> &,
                const unique_ptr<thermodynamic> &,
                const unique_ptr<turbModel> &, const vector3d<double> &);
@@ -71,6 +78,8 @@ class inviscidFlux {
   inviscidFlux& operator=(const inviscidFlux&) = default;
 
   // member functions
+  const double & operator[](const int &r) const { return data_[r]; }
+  double & operator[](const int &r) { return data_[r]; }
   double RhoVel() const { return data_[0]; }
   double RhoVelU() const { return data_[1]; }
   double RhoVelV() const { return data_[2]; }
@@ -80,10 +89,10 @@ class inviscidFlux {
   double RhoVelO() const { return data_[6]; }
 
   void RoeFlux(const inviscidFlux&, const genArray&);
-  void AUSMFlux(const primVars &, const primVars &, const unique_ptr<eos> &,
-                const unique_ptr<thermodynamic> &, const vector3d<double> &,
-                const double &, const double &, const double &, const double &,
-                const double &);
+  template <typename E, typename T>
+  void AUSMFlux(const primVars &, const primVars &, const E &, const T &,
+                const vector3d<double> &, const double &, const double &,
+                const double &, const double &, const double &);
 
   inline inviscidFlux & operator+=(const inviscidFlux &);
   inline inviscidFlux & operator-=(const inviscidFlux &);
@@ -132,10 +141,41 @@ inviscidFlux AUSMFlux(const primVars &, const primVars &,
                       const unique_ptr<eos> &,
                       const unique_ptr<thermodynamic> &,
                       const vector3d<double> &);
+// versions of the flux functions taking the models by reference; these are
+// instantiated in inviscidFlux.cpp for the abstract models and for each
+// combination of concrete models, where the model calls are statically
+// dispatched
+template <typename E, typename T>
+inviscidFlux RoeFlux(const primVars &, const primVars &, const E &, const T &,
+                     const vector3d<double> &);
+template <typename E, typename T>
+inviscidFlux AUSMFlux(const primVars &, const primVars &, const E &,
+                      const T &, const vector3d<double> &);
+// versions of the flux functions for a line of faces; the left and right
+// states, unit area vectors, and fluxes are stored by field in lineArrays.
+// The calorically perfect ideal gas versions are specialized to calculate the
+// flux for several faces at once with SIMD instructions.
+template <typename E, typename T>
+void RoeFluxLine(const lineArray &, const lineArray &, const lineArray &,
+                 const E &, const T &, lineArray &);
+template <typename E, typename T>
+void AUSMFluxLine(const lineArray &, const lineArray &, const lineArray &,
+                  const E &, const T &, lineArray &);
+template <>
+void RoeFluxLine(const lineArray &, const lineArray &, const lineArray &,
+                 const idealGas &, const caloricallyPerfect &, lineArray &);
+template <>
+void AUSMFluxLine(const lineArray &, const lineArray &, const lineArray &,
+                  const idealGas &, const caloricallyPerfect &, lineArray &);
 inviscidFlux InviscidFlux(const primVars &, const primVars &,
                           const unique_ptr<eos> &,
                           const unique_ptr<thermodynamic> &,
-                          const vector3d<double> &, const string &);
+                          const vector3d<double> &,
+                          const inviscidFluxScheme &);
+// check the line flux functions against the face by face flux functions
+void CheckInviscidFluxLine(const unique_ptr<eos> &,
+                           const unique_ptr<thermodynamic> &,
+                           const inviscidFluxScheme &, const int &);
 inviscidFlux RusanovFlux(const primVars &, const primVars &,
                          const unique_ptr<eos> &,
                          const unique_ptr<thermodynamic> &,
@@ -256,4 +296,82 @@ inline const inviscidFlux operator/(const double &lhs, inviscidFlux rhs) {
 
 ostream &operator<<(ostream &os, const inviscidFlux &);
 
+// ---------------------------------------------------------------------------
+// function definitions
+
+// function to calculate the inviscid flux with the scheme known at compile
+// time, so the face loops call the flux function directly
+template <inviscidFluxScheme F, typename E, typename T>
+inviscidFlux InviscidFlux(const primVars &left, const primVars &right,
+                          const E &eqnState, const T &thermo,
+                          const vector3d<double> &area) {
+  return (F == inviscidFluxScheme::roe) ?
+      RoeFlux(left, right, eqnState, thermo, area) :
+      AUSMFlux(left, right, eqnState, thermo, area);
+}
+
+// function to calculate the inviscid flux for a line of faces with the scheme
+// known at compile time
+template <inviscidFluxScheme F, typename E, typename T>
+void InviscidFluxLine(const lineArray &left, const lineArray &right,
+                      const lineArray &area, const E &eqnState,
+                      const T &thermo, lineArray &flux) {
+  if (F == inviscidFluxScheme::roe) {
+    RoeFluxLine(left, right, area, eqnState, thermo, flux);
+  } else {
+    AUSMFluxLine(left, right, area, eqnState, thermo, flux);
+  }
+}
+
+// class to hold the face states, unit area vectors, and fluxes for a line of
+// faces
+class inviscidFluxLine {
+  lineArray lower_;  // reconstructed states from lower side of faces
+  lineArray upper_;  // reconstructed states from upper side of faces
+  lineArray area_;   // unit area vectors of faces
+  lineArray flux_;   // inviscid fluxes at faces
+
+ public:
+  // constructor
+  explicit inviscidFluxLine(const int &len)
+      : lower_(NUMVARS, len),
+        upper_(NUMVARS, len),
+        area_(3, len),
+        flux_(NUMVARS, len) {}
+
+  // member functions
+  int Length() const { return lower_.Length(); }
+  void Resize(const int &len) {
+    lower_.Resize(len);
+    upper_.Resize(len);
+    area_.Resize(len);
+    flux_.Resize(len);
+  }
+  template <typename T>
+  void Insert(const int &ff, const T &lower, const T &upper,
+              const vector3d<double> &area) {
+    lower_.Insert(ff, lower);
+    upper_.Insert(ff, upper);
+    area_.Insert(ff, area);
+  }
+  template <typename T>
+  T Lower(const int &ff) const { return lower_.Get<T>(ff); }
+  template <typename T>
+  T Upper(const int &ff) const { return upper_.Get<T>(ff); }
+  template <typename T>
+  T Flux(const int &ff) const { return flux_.Get<T>(ff); }
+
+  // calculate fluxes at all faces in line
+  template <inviscidFluxScheme F, typename E, typename T>
+  void CalcFlux(const E &eqnState, const T &thermo) {
+    lower_.FillPadding();
+    upper_.FillPadding();
+    area_.FillPadding();
+    InviscidFluxLine<F>(lower_, upper_, area_, eqnState, thermo, flux_);
+  }
+
+  // destructor
+  ~inviscidFluxLine() noexcept {}
+};
+
 #endif
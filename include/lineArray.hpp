@@ -0,0 +1,116 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef LINEARRAYHEADERDEF  // only if the macro LINEARRAYHEADERDEF is not
+                            // defined execute these lines of code
+#define LINEARRAYHEADERDEF  // define the macro
+
+/* This file contains a class to store fixed size records (primVars,
+   inviscidFlux, unit vectors) for a line of cells or faces in a field major
+   (structure of arrays) layout. Each field is padded to a multiple of the
+   SIMD width so that kernels can process the line simdDouble::width entries
+   at a time without a remainder loop. The padding is filled with copies of
+   the last entry so that it holds valid data.
+ */
+
+#include <vector>                 // vector
+#include <algorithm>              // fill
+#include "alignedAllocator.hpp"   // alignedAllocator
+#include "simdDouble.hpp"         // simdDouble
+
+using std::vector;
+
+class lineArray {
+  vector<double, alignedAllocator<double>> data_;
+  int numFields_;
+  int length_;  // number of entries in line
+  int stride_;  // padded length of each field
+
+ public:
+  // constructor
+  lineArray(const int &nf, const int &len)
+      : numFields_(nf),
+        length_(len),
+        stride_((len + simdDouble::width - 1) / simdDouble::width *
+                simdDouble::width) {
+    data_.resize(numFields_ * stride_, 0.0);
+  }
+  lineArray() : lineArray(0, 0) {}
+
+  // move constructor and assignment operator
+  lineArray(lineArray&&) noexcept = default;
+  lineArray& operator=(lineArray&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  lineArray(const lineArray&) = default;
+  lineArray& operator=(const lineArray&) = default;
+
+  // member functions
+  int NumFields() const { return numFields_; }
+  int Length() const { return length_; }
+  int PaddedLength() const { return stride_; }
+
+  double * Field(const int &vv) { return data_.data() + vv * stride_; }
+  const double * Field(const int &vv) const {
+    return data_.data() + vv * stride_;
+  }
+  double & operator()(const int &vv, const int &ii) {
+    return data_[vv * stride_ + ii];
+  }
+  const double & operator()(const int &vv, const int &ii) const {
+    return data_[vv * stride_ + ii];
+  }
+
+  // store/retrieve a full record
+  template <typename T>
+  void Insert(const int &ii, const T &rec) {
+    for (auto vv = 0; vv < numFields_; ++vv) {
+      (*this)(vv, ii) = rec[vv];
+    }
+  }
+  template <typename T>
+  T Get(const int &ii) const {
+    T rec;
+    for (auto vv = 0; vv < numFields_; ++vv) {
+      rec[vv] = (*this)(vv, ii);
+    }
+    return rec;
+  }
+
+  // change length of line; storage is only reallocated if it grows
+  void Resize(const int &len) {
+    length_ = len;
+    stride_ = (len + simdDouble::width - 1) / simdDouble::width *
+        simdDouble::width;
+    data_.resize(numFields_ * stride_);
+  }
+
+  // copy last entry into padding
+  void FillPadding() {
+    if (length_ == 0) {
+      return;
+    }
+    for (auto vv = 0; vv < numFields_; ++vv) {
+      std::fill(this->Field(vv) + length_, this->Field(vv) + stride_,
+                (*this)(vv, length_ - 1));
+    }
+  }
+
+  // destructor
+  ~lineArray() noexcept {}
+};
+
+#endif
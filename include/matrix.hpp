@@ -18,49 +18,80 @@
                          // execute these lines of code
 #define MATRIXHEADERDEF  // define the macro
 
-#include <iostream>
-#include <vector>
+/* This file contains a class to store a square matrix of up to N x N
+   entries. The entries are held in a fixed size array within the class, so
+   matrices do not allocate memory and arrays of them (e.g. the main diagonal
+   of the implicit operator) are contiguous. The size of the matrix can be
+   set at run time up to N, which allows the same type to hold the scalar
+   (1 x 1) and block (N x N) jacobians.
+
+   Matrices that must be inverted are factored in place into L and U with
+   partial pivoting. The factorization is done once, and the factored matrix
+   is used to solve as many systems as needed.
+ */
+
+#include <iostream>      // ostream
+#include <cmath>         // fabs
+#include <cstdlib>       // exit
+#include <algorithm>     // swap, max
 #include "macros.hpp"
+#include "genArray.hpp"  // genArray
 
 using std::ostream;
-using std::vector;
-
-// forward class declarations
-class genArray;
+using std::cerr;
+using std::endl;
 
 // class to store a square matrix
-class squareMatrix {
+template <int N>
+class fixedSquareMatrix {
   int size_;
-  vector<double> data_;
+  double data_[N * N];
+  int pivot_[N];  // row swapped with each row during LU factorization
 
   // private member functions
   int GetLoc(const int &r, const int &c) const {
     return r * size_ + c;
   }
+  int NumEntries() const { return size_ * size_; }
 
  public:
   // constructor
-  explicit squareMatrix(const int &a) : size_(a), data_(a * a, 0.0) {}
-  squareMatrix() : squareMatrix(0) {}
+  explicit fixedSquareMatrix(const int &a) : size_(a), data_(), pivot_() {
+    if (a > N) {
+      cerr << "ERROR: Matrix size " << a << " is larger than maximum size "
+           << N << "!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  fixedSquareMatrix() : fixedSquareMatrix(0) {}
+
+  // construct from matrix with different maximum size
+  template <int M>
+  fixedSquareMatrix(const fixedSquareMatrix<M> &mat)
+      : fixedSquareMatrix(mat.Size()) {
+    for (auto rr = 0; rr < size_; rr++) {
+      for (auto cc = 0; cc < size_; cc++) {
+        (*this)(rr, cc) = mat(rr, cc);
+      }
+    }
+  }
 
   // move constructor and assignment operator
-  squareMatrix(squareMatrix &&) noexcept = default;
-  squareMatrix& operator=(squareMatrix &&) = default;
+  fixedSquareMatrix(fixedSquareMatrix &&) noexcept = default;
+  fixedSquareMatrix& operator=(fixedSquareMatrix &&) = default;
 
   // copy constructor and assignment operator
-  squareMatrix(const squareMatrix &) = default;
-  squareMatrix& operator=(const squareMatrix &) = default;
+  fixedSquareMatrix(const fixedSquareMatrix &) = default;
+  fixedSquareMatrix& operator=(const fixedSquareMatrix &) = default;
 
   // member functions
   int Size() const {return size_;}
   void SwapRows(const int &, const int &);
-  void Inverse();
-  int FindMaxInCol(const int &, const int &, const int &) const;
-  void RowMultiply(const int &, const int &, const double &);
-  void LinCombRow(const int &, const double &, const int &);
+  void Factor();
+  genArray Solve(genArray, const int = 0) const;
   void Zero();
   void Identity();
-  squareMatrix MatMult(const squareMatrix &) const;
+  fixedSquareMatrix MatMult(const fixedSquareMatrix &) const;
   genArray ArrayMult(const genArray &, const int = 0) const;
   double MaxAbsValOnDiagonal() const;
 
@@ -72,127 +103,328 @@ class squareMatrix {
     return data_[this->GetLoc(r, c)];
   }
 
-  inline squareMatrix & operator+=(const squareMatrix &);
-  inline squareMatrix & operator-=(const squareMatrix &);
-  inline squareMatrix & operator*=(const squareMatrix &);
-  inline squareMatrix & operator/=(const squareMatrix &);
+  inline fixedSquareMatrix & operator+=(const fixedSquareMatrix &);
+  inline fixedSquareMatrix & operator-=(const fixedSquareMatrix &);
+  inline fixedSquareMatrix & operator*=(const fixedSquareMatrix &);
+  inline fixedSquareMatrix & operator/=(const fixedSquareMatrix &);
 
-  inline squareMatrix & operator+=(const double &);
-  inline squareMatrix & operator-=(const double &);
-  inline squareMatrix & operator*=(const double &);
-  inline squareMatrix & operator/=(const double &);
+  inline fixedSquareMatrix & operator+=(const double &);
+  inline fixedSquareMatrix & operator-=(const double &);
+  inline fixedSquareMatrix & operator*=(const double &);
+  inline fixedSquareMatrix & operator/=(const double &);
 
-  inline squareMatrix operator+(const double &s) const {
+  inline fixedSquareMatrix operator+(const double &s) const {
     auto lhs = *this;
     return lhs += s;
   }
-  inline squareMatrix operator-(const double &s) const {
+  inline fixedSquareMatrix operator-(const double &s) const {
     auto lhs = *this;
     return lhs -= s;
   }
-  inline squareMatrix operator*(const double &s) const {
+  inline fixedSquareMatrix operator*(const double &s) const {
     auto lhs = *this;
     return lhs *= s;
   }
-  inline squareMatrix operator/(const double &s) const {
+  inline fixedSquareMatrix operator/(const double &s) const {
     auto lhs = *this;
     return lhs /= s;
   }
 
   // destructor
-  ~squareMatrix() noexcept {}
+  ~fixedSquareMatrix() noexcept {}
 };
 
+// matrix types for the flow and turbulence equations
+using squareMatrix = fixedSquareMatrix<NUMFLOWVARS>;
+using turbSquareMatrix = fixedSquareMatrix<NUMVARS - NUMFLOWVARS>;
 
 // function declarations
-ostream &operator<<(ostream &os, const squareMatrix &);
+template <int N>
+ostream &operator<<(ostream &os, const fixedSquareMatrix<N> &);
+
+// ----------------------------------------------------------------------------
+// member function to swap rows of matrix
+template <int N>
+void fixedSquareMatrix<N>::SwapRows(const int &r1, const int &r2) {
+  if (r1 != r2) {
+    for (auto cc = 0; cc < size_; cc++) {
+      std::swap((*this)(r1, cc), (*this)(r2, cc));
+    }
+  }
+}
+
+/* Member function to factor the matrix in place into lower and upper
+triangular matrices using partial pivoting.
+
+  P * A = L * U
+
+L has ones on its diagonal, so only the entries below the diagonal are
+stored. The reciprocals of the diagonal entries of U are stored so that the
+solve does not need to divide. The row swaps are stored in pivot_.
+ */
+template <int N>
+void fixedSquareMatrix<N>::Factor() {
+  for (auto cc = 0; cc < size_; cc++) {
+    // find pivot row
+    auto rPivot = cc;
+    for (auto rr = cc + 1; rr < size_; rr++) {
+      if (fabs((*this)(rr, cc)) > fabs((*this)(rPivot, cc))) {
+        rPivot = rr;
+      }
+    }
+    pivot_[cc] = rPivot;
+    this->SwapRows(cc, rPivot);
+
+    if ((*this)(cc, cc) == 0.0) {
+      cerr << "ERROR: Singular matrix in LU factorization! Matrix (mid "
+              "factorization) is" << endl << *this << endl;
+      exit(EXIT_FAILURE);
+    }
+    const auto pivotInv = 1.0 / (*this)(cc, cc);
+    (*this)(cc, cc) = pivotInv;
+
+    // eliminate entries below pivot
+    for (auto rr = cc + 1; rr < size_; rr++) {
+      const auto factor = (*this)(rr, cc) * pivotInv;
+      (*this)(rr, cc) = factor;
+      for (auto ii = cc + 1; ii < size_; ii++) {
+        (*this)(rr, ii) -= factor * (*this)(cc, ii);
+      }
+    }
+  }
+}
+
+// member function to solve A * x = b using the LU factorization of A;
+// the portion of b starting at pos is replaced with x
+template <int N>
+genArray fixedSquareMatrix<N>::Solve(genArray vec, const int pos) const {
+  // vec -- right hand side b
+  // pos -- position in vec where system starts
+
+  // apply row swaps
+  for (auto rr = 0; rr < size_; rr++) {
+    std::swap(vec[pos + rr], vec[pos + pivot_[rr]]);
+  }
+
+  // forward substitution with L
+  for (auto rr = 1; rr < size_; rr++) {
+    for (auto cc = 0; cc < rr; cc++) {
+      vec[pos + rr] -= (*this)(rr, cc) * vec[pos + cc];
+    }
+  }
+
+  // back substitution with U
+  for (auto rr = size_ - 1; rr >= 0; rr--) {
+    for (auto cc = rr + 1; cc < size_; cc++) {
+      vec[pos + rr] -= (*this)(rr, cc) * vec[pos + cc];
+    }
+    vec[pos + rr] *= (*this)(rr, rr);
+  }
+  return vec;
+}
+
+// operator overload for multiplication
+// using cache efficient implimentation
+template <int N>
+fixedSquareMatrix<N> fixedSquareMatrix<N>::MatMult(
+    const fixedSquareMatrix<N> &s2) const {
+  fixedSquareMatrix<N> s1(s2.Size());
+  for (auto cc = 0; cc < s2.Size(); cc++) {
+    for (auto rr = 0; rr < s2.Size(); rr++) {
+      for (auto ii = 0; ii < s2.Size(); ii++) {
+        s1(rr, ii) += (*this)(rr, cc) * s2(cc, ii);
+      }
+    }
+  }
+  return s1;
+}
+
+// operation overload for << - allows use of cout, cerr, etc.
+template <int N>
+ostream &operator<<(ostream &os, const fixedSquareMatrix<N> &m) {
+  for (auto rr = 0; rr < m.Size(); rr++) {
+    for (auto cc = 0; cc < m.Size(); cc++) {
+      os << m(rr, cc);
+      if (cc != (m.Size() - 1)) {
+        os << ", ";
+      } else {
+        os << endl;
+      }
+    }
+  }
+  return os;
+}
+
+// member function to zero the matrix
+template <int N>
+void fixedSquareMatrix<N>::Zero() {
+  for (auto ii = 0; ii < this->NumEntries(); ii++) {
+    data_[ii] = 0.0;
+  }
+}
+
+// member function to set matrix to Identity
+template <int N>
+void fixedSquareMatrix<N>::Identity() {
+  for (auto rr = 0; rr < this->Size(); rr++) {
+    for (auto cc = 0; cc < this->Size(); cc++) {
+      if (rr == cc) {
+        (*this)(rr, cc) = 1.0;
+      } else {
+        (*this)(rr, cc) = 0.0;
+      }
+    }
+  }
+}
+
+// member function to do matrix/vector multplication
+template <int N>
+genArray fixedSquareMatrix<N>::ArrayMult(const genArray &vec,
+                                         const int pos) const {
+  // vec -- vector to multiply with
+
+  auto product = vec;
+
+  // zero out portion of genArray that will be written over
+  if (pos == 0) {
+    for (auto ii = 0; ii < NUMFLOWVARS; ii++) {
+      product[ii] = 0.0;
+    }
+  } else {
+    for (auto ii = pos; ii < NUMVARS; ii++) {
+      product[ii] = 0.0;
+    }
+  }
+
+  for (auto rr = 0; rr < size_; rr++) {
+    for (auto cc = 0; cc < size_; cc++) {
+      product[pos + rr] += (*this)(rr, cc) * vec[pos + cc];
+    }
+  }
+  return product;
+}
+
+// member function to find maximum absolute value on diagonal
+// this can be used to find the spectral radius of a diagoanl matrix
+template <int N>
+double fixedSquareMatrix<N>::MaxAbsValOnDiagonal() const {
+  auto maxVal = 0.0;
+  for (auto ii = 0; ii < size_; ii++) {
+    maxVal = std::max(fabs((*this)(ii, ii)), maxVal);
+  }
+  return maxVal;
+}
 
 // operator overload for addition
-squareMatrix & squareMatrix::operator+=(const squareMatrix &mat) {
-  for (auto ii = 0U; ii < mat.data_.size(); ii++) {
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator+=(
+    const fixedSquareMatrix<N> &mat) {
+  for (auto ii = 0; ii < mat.NumEntries(); ii++) {
     data_[ii] += mat.data_[ii];
   }
   return *this;
 }
 
 // operator overload for subtraction
-squareMatrix & squareMatrix::operator-=(const squareMatrix &mat) {
-  for (auto ii = 0U; ii < mat.data_.size(); ii++) {
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator-=(
+    const fixedSquareMatrix<N> &mat) {
+  for (auto ii = 0; ii < mat.NumEntries(); ii++) {
     data_[ii] -= mat.data_[ii];
   }
   return *this;
 }
 
 // operator overload for elementwise multiplication
-squareMatrix & squareMatrix::operator*=(const squareMatrix &mat) {
-  for (auto ii = 0U; ii < mat.data_.size(); ii++) {
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator*=(
+    const fixedSquareMatrix<N> &mat) {
+  for (auto ii = 0; ii < mat.NumEntries(); ii++) {
     data_[ii] *= mat.data_[ii];
   }
   return *this;
 }
 
 // operator overload for elementwise multiplication
-squareMatrix & squareMatrix::operator/=(const squareMatrix &mat) {
-  for (auto ii = 0U; ii < mat.data_.size(); ii++) {
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator/=(
+    const fixedSquareMatrix<N> &mat) {
+  for (auto ii = 0; ii < mat.NumEntries(); ii++) {
     data_[ii] /= mat.data_[ii];
   }
   return *this;
 }
 
-inline const squareMatrix operator+(squareMatrix lhs, const squareMatrix &rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator+(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
   return lhs += rhs;
 }
 
-inline const squareMatrix operator-(squareMatrix lhs, const squareMatrix &rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator-(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
   return lhs -= rhs;
 }
 
-inline const squareMatrix operator*(squareMatrix lhs, const squareMatrix &rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator*(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
   return lhs *= rhs;
 }
 
-inline const squareMatrix operator/(squareMatrix lhs, const squareMatrix &rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator/(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
   return lhs /= rhs;
 }
 
 // operator overloads for double --------------------------------------------
 // operator overload for addition
-squareMatrix & squareMatrix::operator+=(const double &scalar) {
-  for (auto &val : data_) {
-    val += scalar;
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator+=(const double &scalar) {
+  for (auto ii = 0; ii < this->NumEntries(); ii++) {
+    data_[ii] += scalar;
   }
   return *this;
 }
 
 // operator overload for subtraction
-squareMatrix & squareMatrix::operator-=(const double &scalar) {
-  for (auto &val : data_) {
-    val -= scalar;
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator-=(const double &scalar) {
+  for (auto ii = 0; ii < this->NumEntries(); ii++) {
+    data_[ii] -= scalar;
   }
   return *this;
 }
 
 // operator overload for multiplication
-squareMatrix & squareMatrix::operator*=(const double &scalar) {
-  for (auto &val : data_) {
-    val *= scalar;
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator*=(const double &scalar) {
+  for (auto ii = 0; ii < this->NumEntries(); ii++) {
+    data_[ii] *= scalar;
   }
   return *this;
 }
 
 // operator overload for division
-squareMatrix & squareMatrix::operator/=(const double &scalar) {
-  for (auto &val : data_) {
-    val /= scalar;
+template <int N>
+fixedSquareMatrix<N> & fixedSquareMatrix<N>::operator/=(const double &scalar) {
+  for (auto ii = 0; ii < this->NumEntries(); ii++) {
+    data_[ii] /= scalar;
   }
   return *this;
 }
 
-inline const squareMatrix operator+(const double &lhs, squareMatrix rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator+(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
   return rhs += lhs;
 }
 
-inline const squareMatrix operator-(const double &lhs, squareMatrix rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator-(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
   for (auto rr = 0; rr < rhs.Size(); rr++) {
     for (auto cc = 0; cc < rhs.Size(); cc++) {
       rhs(rr, cc) = lhs - rhs(rr, cc);
@@ -201,11 +433,15 @@ inline const squareMatrix operator-(const double &lhs, squareMatrix rhs) {
   return rhs;
 }
 
-inline const squareMatrix operator*(const double &lhs, squareMatrix rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator*(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
   return rhs *= lhs;
 }
 
-inline const squareMatrix operator/(const double &lhs, squareMatrix rhs) {
+template <int N>
+inline const fixedSquareMatrix<N> operator/(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
   for (auto rr = 0; rr < rhs.Size(); rr++) {
     for (auto cc = 0; cc < rhs.Size(); cc++) {
       rhs(rr, cc) = lhs / rhs(rr, cc);
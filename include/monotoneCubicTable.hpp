@@ -0,0 +1,124 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef MONOTONECUBICTABLEHEADERDEF  // only if the macro
+                                     // MONOTONECUBICTABLEHEADERDEF is not
+                                     // defined execute these lines of code
+#define MONOTONECUBICTABLEHEADERDEF  // define the macro
+
+/* This file contains a class for a table of a function of one variable. The
+   function and its derivative are sampled at uniformly spaced points and are
+   interpolated with a piecewise cubic Hermite polynomial. Because the samples
+   are uniformly spaced, the interval containing a point is found without a
+   search. The slopes are limited with the Fritsch-Carlson conditions so that
+   the interpolant is monotone wherever the samples are.
+ */
+
+#include <vector>     // vector
+#include <cmath>      // sqrt
+#include <algorithm>  // min, max
+
+using std::vector;
+
+class monotoneCubicTable {
+  double xMin_;
+  double xMax_;
+  double invDx_;
+  vector<double> f_;   // function values at samples
+  vector<double> df_;  // derivatives at samples scaled by sample spacing
+
+ public:
+  // constructor
+  // fn -- function to tabulate
+  // dfn -- derivative of function to tabulate
+  template <typename T1, typename T2>
+  monotoneCubicTable(const double &xMin, const double &xMax,
+                     const int &numInt, const T1 &fn, const T2 &dfn);
+  // empty table contains no points
+  monotoneCubicTable() : xMin_(0.0), xMax_(-1.0), invDx_(0.0) {}
+
+  // move constructor and assignment operator
+  monotoneCubicTable(monotoneCubicTable&&) noexcept = default;
+  monotoneCubicTable& operator=(monotoneCubicTable&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  monotoneCubicTable(const monotoneCubicTable&) = default;
+  monotoneCubicTable& operator=(const monotoneCubicTable&) = default;
+
+  // member functions
+  bool InRange(const double &x) const { return x >= xMin_ && x <= xMax_; }
+  int NumIntervals() const { return std::max(static_cast<int>(f_.size()) - 1,
+                                             0); }
+  double XMin() const { return xMin_; }
+  double XMax() const { return xMax_; }
+
+  // interpolate function at x; x must be in range of table
+  double Value(const double &x) const {
+    const auto s = (x - xMin_) * invDx_;
+    const auto ii = std::min(static_cast<int>(s), this->NumIntervals() - 1);
+    const auto t = s - ii;
+    const auto t2 = t * t;
+    const auto t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * f_[ii] +
+        (t3 - 2.0 * t2 + t) * df_[ii] + (3.0 * t2 - 2.0 * t3) * f_[ii + 1] +
+        (t3 - t2) * df_[ii + 1];
+  }
+
+  // destructor
+  ~monotoneCubicTable() noexcept {}
+};
+
+// ---------------------------------------------------------------------------
+// member function definitions
+
+template <typename T1, typename T2>
+monotoneCubicTable::monotoneCubicTable(const double &xMin, const double &xMax,
+                                       const int &numInt, const T1 &fn,
+                                       const T2 &dfn)
+    : xMin_(xMin), xMax_(xMax), invDx_(numInt / (xMax - xMin)) {
+  const auto dx = (xMax - xMin) / numInt;
+  f_.resize(numInt + 1);
+  df_.resize(numInt + 1);
+  for (auto ii = 0; ii <= numInt; ++ii) {
+    // use end point exactly to avoid roundoff outside of range
+    const auto x = (ii == numInt) ? xMax : xMin + ii * dx;
+    f_[ii] = fn(x);
+    df_[ii] = dfn(x) * dx;
+  }
+
+  // limit slopes so interpolant is monotone on each interval (Fritsch-Carlson)
+  for (auto ii = 0; ii < numInt; ++ii) {
+    const auto delta = f_[ii + 1] - f_[ii];
+    if (delta == 0.0) {
+      df_[ii] = 0.0;
+      df_[ii + 1] = 0.0;
+      continue;
+    }
+    // slopes with the wrong sign are set to zero
+    auto alpha = std::max(df_[ii] / delta, 0.0);
+    auto beta = std::max(df_[ii + 1] / delta, 0.0);
+    const auto mag = alpha * alpha + beta * beta;
+    if (mag > 9.0) {
+      const auto tau = 3.0 / sqrt(mag);
+      alpha *= tau;
+      beta *= tau;
+    }
+    df_[ii] = alpha * delta;
+    df_[ii + 1] = beta * delta;
+  }
+}
+
+#endif
@@ -21,7 +21,10 @@
 
 /* This file contains the header and implementation for a multidimensional (3D)
    array class. The class is to act as a container to store all data types,
-   and provide easy access to elements with i, j, k indexing.
+   and provide easy access to elements with i, j, k indexing. The data is
+   allocated on a cache line boundary, and each i-line can optionally be
+   padded with extra elements (see PadI) so that the j and k strides are not
+   powers of two and lines stay aligned.
  */
 
 #include <iostream>  // ostream
@@ -32,6 +35,7 @@
 #include "vector3d.hpp"
 #include "boundaryConditions.hpp"  // connection
 #include "range.hpp"  // range
+#include "alignedAllocator.hpp"  // alignedAllocator
 
 using std::ostream;
 using std::endl;
@@ -43,16 +47,21 @@ using std::unique_ptr;
 
 template <typename T>
 class multiArray3d {
-  vector<T> data_;
+  vector<T, alignedAllocator<T>> data_;
   int numI_;
   int numJ_;
   int numK_;
   int numGhosts_;
+  int padI_;  // extra elements at end of each i-line
 
   // private member functions
   int GetLoc1D(const int &ii, const int &jj, const int &kk) const {
-    return (ii + numGhosts_) + (jj + numGhosts_) * numI_ +
-        (kk + numGhosts_) * numI_ * numJ_;
+    return (ii + numGhosts_) + (jj + numGhosts_) * this->StrideJ() +
+        (kk + numGhosts_) * this->StrideK();
+  }
+  bool SameLayout(const multiArray3d<T> &arr) const {
+    return numI_ == arr.numI_ && numJ_ == arr.numJ_ && numK_ == arr.numK_ &&
+        padI_ == arr.padI_;
   }
 
  public:
@@ -61,11 +70,11 @@ class multiArray3d {
                const T &init) :
       data_((ii + 2 * ng) * (jj + 2 * ng) * (kk + 2 * ng), init),
       numI_(ii + 2 * ng), numJ_(jj + 2 * ng), numK_(kk + 2 * ng),
-      numGhosts_(ng) {}
+      numGhosts_(ng), padI_(0) {}
   multiArray3d(const int &ii, const int &jj, const int &kk, const int &ng) :
       data_((ii + 2 * ng) * (jj + 2 * ng) * (kk + 2 * ng)),
       numI_(ii + 2 * ng), numJ_(jj + 2 * ng), numK_(kk + 2 * ng),
-      numGhosts_(ng) {}
+      numGhosts_(ng), padI_(0) {}
   multiArray3d() : multiArray3d(0, 0, 0, 0) {}
 
   // move constructor and assignment operator
@@ -77,7 +86,14 @@ class multiArray3d {
   multiArray3d& operator=(const multiArray3d&) = default;
 
   // member functions
+  // Size is the number of stored elements (including any padding) and should
+  // be used for linear access and MPI transfers of the underlying data
   int Size() const {return data_.size();}
+  int NumCells() const {return numI_ * numJ_ * numK_;}
+  int PaddingI() const {return padI_;}
+  int StrideJ() const {return numI_ + padI_;}
+  int StrideK() const {return (numI_ + padI_) * numJ_;}
+  void PadI(const int &);
   int NumI() const {return numI_;}
   int NumJ() const {return numJ_;}
   int NumK() const {return numK_;}
@@ -141,8 +157,6 @@ class multiArray3d {
 
   void Fill(const multiArray3d<T> &);
   void PutSlice(const multiArray3d<T> &, const connection &, const int &);
-  void SwapSliceMPI(const connection &, const int &, const MPI_Datatype &,
-                    const int = 1);
   void SwapSlice(const connection &, multiArray3d<T> &);
 
   void Zero(const T &);
@@ -152,9 +166,6 @@ class multiArray3d {
   multiArray3d<T> GrowJ() const;
   multiArray3d<T> GrowK() const;
 
-  void PackSwapUnpackMPI(const connection &, const MPI_Datatype &, const int &,
-                         const int = 1);
-
   T GetElem(const int &ii, const int &jj, const int &kk) const;
 
   // operator overloads
@@ -286,12 +297,17 @@ class multiArray3d {
     return lhs /= s;
   }
 
+  // padding of the array is kept when it is resized
   void ClearResize(const int &ii, const int &jj, const int &kk, const int &ng) {
+    const auto pad = padI_;
     *this = multiArray3d<T>(ii, jj, kk, ng);
+    this->PadI(pad);
   }
   void ClearResize(const int &ii, const int &jj, const int &kk,
                    const int &ng, const T &val) {
+    const auto pad = padI_;
     *this = multiArray3d<T>(ii, jj, kk, ng, val);
+    this->PadI(pad);
   }
 
   void SameSizeResize(const int &ii, const int &jj, const int &kk);
@@ -385,8 +401,18 @@ T multiArray3d<T>::GetElem(const int &ii, const int &jj, const int &kk) const {
 // operator overload for addition
 template <typename T>
 multiArray3d<T> & multiArray3d<T>::operator+=(const multiArray3d<T> &arr) {
-  for (auto rr = 0; rr < this->Size(); rr++) {
-    data_[rr] += arr.data_[rr];
+  if (this->SameLayout(arr)) {
+    for (auto rr = 0; rr < this->Size(); rr++) {
+      data_[rr] += arr.data_[rr];
+    }
+  } else {
+    for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+      for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+        for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+          (*this)(ii, jj, kk) += arr(ii, jj, kk);
+        }
+      }
+    }
   }
   return *this;
 }
@@ -394,8 +420,18 @@ multiArray3d<T> & multiArray3d<T>::operator+=(const multiArray3d<T> &arr) {
 // operator overload for subtraction with a scalar
 template <typename T>
 multiArray3d<T> & multiArray3d<T>::operator-=(const multiArray3d<T> &arr) {
-  for (auto rr = 0; rr < this->Size(); rr++) {
-    data_[rr] -= arr.data_[rr];
+  if (this->SameLayout(arr)) {
+    for (auto rr = 0; rr < this->Size(); rr++) {
+      data_[rr] -= arr.data_[rr];
+    }
+  } else {
+    for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+      for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+        for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+          (*this)(ii, jj, kk) -= arr(ii, jj, kk);
+        }
+      }
+    }
   }
   return *this;
 }
@@ -403,8 +439,18 @@ multiArray3d<T> & multiArray3d<T>::operator-=(const multiArray3d<T> &arr) {
 // operator overload for elementwise multiplication
 template <typename T>
 multiArray3d<T> & multiArray3d<T>::operator*=(const multiArray3d<T> &arr) {
-  for (auto rr = 0; rr < this->Size(); rr++) {
-    data_[rr] *= arr.data_[rr];
+  if (this->SameLayout(arr)) {
+    for (auto rr = 0; rr < this->Size(); rr++) {
+      data_[rr] *= arr.data_[rr];
+    }
+  } else {
+    for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+      for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+        for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+          (*this)(ii, jj, kk) *= arr(ii, jj, kk);
+        }
+      }
+    }
   }
   return *this;
 }
@@ -412,8 +458,18 @@ multiArray3d<T> & multiArray3d<T>::operator*=(const multiArray3d<T> &arr) {
 // operator overload for elementwise division
 template <typename T>
 multiArray3d<T> & multiArray3d<T>::operator/=(const multiArray3d<T> &arr) {
-  for (auto rr = 0; rr < this->Size(); rr++) {
-    data_[rr] /= arr.data_[rr];
+  if (this->SameLayout(arr)) {
+    for (auto rr = 0; rr < this->Size(); rr++) {
+      data_[rr] /= arr.data_[rr];
+    }
+  } else {
+    for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+      for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+        for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+          (*this)(ii, jj, kk) /= arr(ii, jj, kk);
+        }
+      }
+    }
   }
   return *this;
 }
@@ -919,21 +975,36 @@ void multiArray3d<T>::Fill(const multiArray3d<T> &arr) {
   // arr -- array to insert into this one
 
   // check that given array is same size
-  if (this->Size() != arr.Size()) {
+  if (this->NumCells() != arr.NumCells()) {
     cerr << "ERROR: Error in multiArray3d::Fill. Size of given array " <<
         "does not match size of array to fill!" << endl;
     cerr << "Size of given array is " << arr.NumI() << ", " << arr.NumJ()
          << ", " << arr.NumK() << endl;
     cerr << "With " << arr.GhostLayers() << " ghost cell layers" << endl;
-    cerr << "Resulting in a total size of " << arr.Size() << endl;
+    cerr << "Resulting in a total size of " << arr.NumCells() << endl;
     cerr << "Size of array to fill is " << numI_ << ", " << numJ_ <<
         ", " << numK_ << endl;
     cerr << "With " << numGhosts_ << " ghost cell layers" << endl;
-    cerr << "Resulting in a total size of " << this->Size() << endl;
+    cerr << "Resulting in a total size of " << this->NumCells() << endl;
     exit(EXIT_FAILURE);
   }
 
-  data_ = arr.data_;
+  if (padI_ == 0 && arr.padI_ == 0) {
+    data_ = arr.data_;
+  } else {
+    // copy line by line, skipping padding in both arrays
+    for (auto kk = 0; kk < numK_; kk++) {
+      for (auto jj = 0; jj < numJ_; jj++) {
+        const auto line = jj + kk * numJ_;
+        for (auto ii = 0; ii < numI_; ii++) {
+          const auto loc = line * numI_ + ii;
+          data_[ii + jj * this->StrideJ() + kk * this->StrideK()] =
+              arr.data_[(loc % arr.numI_) +
+                        (loc / arr.numI_) * arr.StrideJ()];
+        }
+      }
+    }
+  }
 }
 
 template <typename T>
@@ -984,6 +1055,11 @@ multiArray3d<T> multiArray3d<T>::GrowK() const {
 template <typename T>
 void multiArray3d<T>::SameSizeResize(const int &ii, const int&jj,
                                      const int &kk) {
+  if (padI_ != 0) {
+    cerr << "ERROR: Error in multiArray3d<T>::SameSizeResize. Cannot resize "
+         << "an array with padded i-lines." << endl;
+    exit(EXIT_FAILURE);
+  }
   if (this->PhysicalSize() != (ii * jj * kk)) {
     cerr << "ERROR: Error in multiArray3d<T>::SameSizeResize. Attempting to "
          << "resize array of " << this->PhysicalSize() << " cells to " <<
@@ -998,6 +1074,11 @@ void multiArray3d<T>::SameSizeResize(const int &ii, const int&jj,
 template <typename T>
 void multiArray3d<T>::SameSizeResizeGhosts(const int &ii, const int&jj,
                                            const int &kk, const int &ng) {
+  if (padI_ != 0) {
+    cerr << "ERROR: Error in multiArray3d<T>::SameSizeResizeGhosts. Cannot "
+         << "resize an array with padded i-lines." << endl;
+    exit(EXIT_FAILURE);
+  }
   if (this->Size() != ((ii + 2 * ng) * (jj + 2 * ng) * (kk + 2 * ng))) {
     cerr << "ERROR: Error in multiArray3d<T>::SameSizeResizeGhosts. Attempting "
          << "to resize array of " << this->Size() << " cells to " <<
@@ -1011,6 +1092,35 @@ void multiArray3d<T>::SameSizeResizeGhosts(const int &ii, const int&jj,
 }
 
 
+// member function to change the number of extra elements at the end of each
+// i-line; the data in the array is preserved
+template <typename T>
+void multiArray3d<T>::PadI(const int &pad) {
+  // pad -- number of elements to add to each i-line
+  if (pad < 0) {
+    cerr << "ERROR: Error in multiArray3d<T>::PadI. Padding must be "
+         << "non-negative, but " << pad << " was given." << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (pad == padI_) {
+    return;
+  }
+
+  multiArray3d<T> padded(numI_ - 2 * numGhosts_, numJ_ - 2 * numGhosts_,
+                         numK_ - 2 * numGhosts_, numGhosts_);
+  padded.padI_ = pad;
+  padded.data_.assign((numI_ + pad) * numJ_ * numK_, T());
+  for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+    for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+      for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+        padded(ii, jj, kk) = (*this)(ii, jj, kk);
+      }
+    }
+  }
+  data_ = std::move(padded.data_);
+  padI_ = pad;
+}
+
 // member function to "zero out" the container with a supplied "zero"
 template <typename T>
 void multiArray3d<T>::Zero(const T &zero) {
@@ -1087,127 +1197,6 @@ void multiArray3d<T>::PutSlice(const multiArray3d<T> &array,
   }
 }
 
-/*Member function to pack an array into a buffer, swap it with its
-  connection partner, and then unpack it into an array.*/
-template <typename T>
-void multiArray3d<T>::PackSwapUnpackMPI(const connection &inter,
-                                        const MPI_Datatype &MPI_arrData,
-                                        const int &rank, const int tag) {
-  // inter -- connection boundary for the swap
-  // MPI_arrData -- MPI datatype to pass data type in array
-  // rank -- processor rank
-  // tag -- id to send data with (default 1)
-
-  // swap with mpi_send_recv_replace
-  // pack data into buffer, but first get size
-  auto bufSize = 0;
-  auto tempSize = 0;
-  // add size for states
-  MPI_Pack_size(this->Size(), MPI_arrData, MPI_COMM_WORLD, &tempSize);
-  bufSize += tempSize;
-  // add size for 4 ints for multiArray3d dims and num ghosts
-  MPI_Pack_size(4, MPI_INT, MPI_COMM_WORLD,
-                &tempSize);
-  bufSize += tempSize;
-
-  // allocate buffer to pack data into
-  // use unique_ptr to manage memory; use underlying pointer for MPI calls
-  auto unqBuffer = unique_ptr<char>(new char[bufSize]);
-  auto *buffer = unqBuffer.get();  
-
-  // pack data into buffer
-  auto numI = this->NumI();
-  auto numJ = this->NumJ();
-  auto numK = this->NumK();
-  auto numGhosts = this->GhostLayers();
-  auto position = 0;
-  MPI_Pack(&numI, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numJ, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numK, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numGhosts, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(data_)), this->Size(), MPI_arrData, buffer,
-           bufSize, &position, MPI_COMM_WORLD);
-
-  MPI_Status status;
-  if (rank == inter.RankFirst()) {  // send/recv with second entry in connection
-    MPI_Sendrecv_replace(buffer, bufSize, MPI_PACKED, inter.RankSecond(), tag,
-                         inter.RankSecond(), tag, MPI_COMM_WORLD, &status);
-  } else {  // send/recv with first entry in connection
-    MPI_Sendrecv_replace(buffer, bufSize, MPI_PACKED, inter.RankFirst(), tag,
-                         inter.RankFirst(), tag, MPI_COMM_WORLD, &status);
-  }
-
-  // put slice back into multiArray3d
-  position = 0;
-  MPI_Unpack(buffer, bufSize, &position, &numI, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(buffer, bufSize, &position, &numJ, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(buffer, bufSize, &position, &numK, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(buffer, bufSize, &position, &numGhosts, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  // resize slice
-  this->SameSizeResize(numI, numJ, numK);
-
-  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(data_)),
-             this->Size(), MPI_arrData, MPI_COMM_WORLD);
-}
-
-/* Function to swap slice using MPI. This is similar to the SwapSlice
-   function, but is called when the neighboring procBlocks are on different
-   processors.
-*/
-template <typename T>
-void multiArray3d<T>::SwapSliceMPI(const connection &conn, const int &rank,
-                                   const MPI_Datatype &MPI_arrData,
-                                   const int tag) {
-  // conn -- connection boundary information
-  // rank -- processor rank
-  // MPI_arrData -- MPI datatype for passing data in *this
-  // tag -- id for MPI swap (default 1)
-
-  // Get indices for slice coming from block to swap
-  auto is = 0, ie = 0;
-  auto js = 0, je = 0;
-  auto ks = 0, ke = 0;
-
-  if (rank == conn.RankFirst()) {  // local block first in connection
-    conn.FirstSliceIndices(is, ie, js, je, ks, ke, numGhosts_);
-  } else if (rank == conn.RankSecond()) {  // local block second in connection
-    conn.SecondSliceIndices(is, ie, js, je, ks, ke, numGhosts_);
-  } else {
-    cerr << "ERROR: Error in procBlock::SwapSliceMPI(). Processor rank does "
-            "not match either of connection ranks!" << endl;
-    exit(EXIT_FAILURE);
-  }
-
-  // get local state slice to swap
-  auto slice = this->Slice({is, ie}, {js, je}, {ks, ke});
-
-  // swap state slices with partner block
-  slice.PackSwapUnpackMPI(conn, MPI_arrData, rank, tag);
-
-  // change connections to work with slice and ghosts
-  auto connAdj = conn;
-
-  // change connections to work with slice and ghosts
-  // block to insert into is first in connection
-  if (rank == conn.RankFirst()) {
-    connAdj.AdjustForSlice(true, numGhosts_);
-  } else {  // block to insert into is second in connection, so pass swapped
-            // version
-    connAdj.AdjustForSlice(false, numGhosts_);
-  }
-
-  // insert state slice into procBlock
-  this->PutSlice(slice, connAdj, numGhosts_);
-}
-
 /* Function to swap ghost cells between two blocks at an connection
 boundary. Slices are removed from the physical cells (extending into ghost cells
 at the edges) of one block and inserted into the ghost cells of its partner
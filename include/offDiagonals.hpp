@@ -0,0 +1,95 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef OFFDIAGONALSHEADERDEF  // only if the macro OFFDIAGONALSHEADERDEF is not
+                               // defined execute these lines of code
+#define OFFDIAGONALSHEADERDEF  // define the macro
+
+/* This file contains a class to store the off diagonal operators of the
+   implicit matrix at each face of a block. Each face has two operators. The
+   lower operator acts on the update of the cell on the lower side of the face
+   and contributes to the cell on the upper side of the face. The upper
+   operator acts on the update of the cell on the upper side of the face and
+   contributes to the cell on the lower side of the face. The operators only
+   depend on the state and geometry, so they can be calculated once per
+   nonlinear iteration and reused for every matrix sweep.
+ */
+
+#include "multiArray3d.hpp"    // multiArray3d
+
+template <typename T>
+class offDiagonals {
+  multiArray3d<T> lowerI_;
+  multiArray3d<T> upperI_;
+  multiArray3d<T> lowerJ_;
+  multiArray3d<T> upperJ_;
+  multiArray3d<T> lowerK_;
+  multiArray3d<T> upperK_;
+
+ public:
+  // constructor
+  offDiagonals() {}
+
+  // move constructor and assignment operator
+  offDiagonals(offDiagonals&&) noexcept = default;
+  offDiagonals& operator=(offDiagonals&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  offDiagonals(const offDiagonals&) = default;
+  offDiagonals& operator=(const offDiagonals&) = default;
+
+  // member functions
+  // allocate operators for the faces of a block with the given number of cells
+  void ClearResize(const int &ni, const int &nj, const int &nk, const T &init) {
+    lowerI_.ClearResize(ni + 1, nj, nk, 0, init);
+    upperI_.ClearResize(ni + 1, nj, nk, 0, init);
+    lowerJ_.ClearResize(ni, nj + 1, nk, 0, init);
+    upperJ_.ClearResize(ni, nj + 1, nk, 0, init);
+    lowerK_.ClearResize(ni, nj, nk + 1, 0, init);
+    upperK_.ClearResize(ni, nj, nk + 1, 0, init);
+  }
+  bool IsEmpty() const { return lowerI_.Size() == 0; }
+  // total number of operators stored
+  int Size() const {
+    return lowerI_.Size() + upperI_.Size() + lowerJ_.Size() + upperJ_.Size() +
+        lowerK_.Size() + upperK_.Size();
+  }
+
+  // operator at face (ii, jj, kk) in direction dir (0 = i, 1 = j, 2 = k)
+  T & Lower(const int &dir, const int &ii, const int &jj, const int &kk) {
+    return dir == 0 ? lowerI_(ii, jj, kk) :
+        (dir == 1 ? lowerJ_(ii, jj, kk) : lowerK_(ii, jj, kk));
+  }
+  const T & Lower(const int &dir, const int &ii, const int &jj,
+                  const int &kk) const {
+    return dir == 0 ? lowerI_(ii, jj, kk) :
+        (dir == 1 ? lowerJ_(ii, jj, kk) : lowerK_(ii, jj, kk));
+  }
+  T & Upper(const int &dir, const int &ii, const int &jj, const int &kk) {
+    return dir == 0 ? upperI_(ii, jj, kk) :
+        (dir == 1 ? upperJ_(ii, jj, kk) : upperK_(ii, jj, kk));
+  }
+  const T & Upper(const int &dir, const int &ii, const int &jj,
+                  const int &kk) const {
+    return dir == 0 ? upperI_(ii, jj, kk) :
+        (dir == 1 ? upperJ_(ii, jj, kk) : upperK_(ii, jj, kk));
+  }
+
+  // destructor
+  ~offDiagonals() noexcept {}
+};
+
+#endif
@@ -23,6 +23,18 @@
 It contains function headers to write out the grid at the cell centers in Plot3D
 format, as well as the Plot3D function files.
 It also writes out a master file in Ensight format to name the Plot3D functions.
+
+The grid, function, and restart files are written with collective MPI-IO. Each
+processor writes the cells of its own blocks directly into their place in the
+original (parent) blocks, so the solution is never gathered on ROOT. The writes
+can be left to finish in the background while the solver continues.
+
+Restart files are self-describing and split into chunks. The header holds the
+iteration, residuals, block sizes, variable names, and an index with the
+location, size, and checksum of every chunk. Each chunk holds the variables of
+a range of k-planes of one block, stored one variable after another, and may be
+compressed. Any processor can read just the chunks that overlap its own blocks,
+so a restart does not need to use the decomposition that wrote it.
 */
 
 #include <fstream>
@@ -30,7 +42,11 @@ It also writes out a master file in Ensight format to name the Plot3D functions.
 #include <vector>        // vector
 #include <string>        // string
 #include <memory>        // unique_ptr
+#include <cstdint>       // int64_t, uint32_t
+#include "mpi.h"          // parallelism
 #include "multiArray3d.hpp"
+#include "vector3d.hpp"
+#include "boundaryConditions.hpp"  // boundarySurface
 
 using std::vector;
 using std::string;
@@ -55,27 +71,166 @@ class input;
 class turbModel;
 class primVars;
 
+// class to locate the split procBlocks and their wall data within the
+// original blocks and walls that are written to file. This replays the joins
+// done to recombine the split blocks, but only on the boundary conditions, so
+// every processor can find where its blocks go in a file without having the
+// solution of any other block.
+class outputLayout {
+  vector<vector3d<int>> blkStart_;     // start of split block in parent
+  vector<vector3d<int>> parentDims_;   // number of cells in parent blocks
+  vector<boundarySurface> viscSurfs_;  // viscous surfaces of parent blocks
+  vector<int> viscSurfParent_;         // parent block of viscous surface
+  vector<vector3d<int>> wallDims_;     // size of joined wall data
+  vector<vector<int>> wallIndex_;      // joined wall of split block wall data
+  vector<vector<vector3d<int>>> wallStart_;  // start of split wall in joined
+
+ public:
+  // constructor
+  outputLayout(const vector<boundaryConditions> &, const decomposition &);
+  outputLayout() {}
+
+  // move constructor and assignment operator
+  outputLayout(outputLayout &&) noexcept = default;
+  outputLayout &operator=(outputLayout &&) noexcept = default;
+
+  // copy constructor and assignment operator
+  outputLayout(const outputLayout &) = default;
+  outputLayout &operator=(const outputLayout &) = default;
+
+  // member functions
+  int NumBlocks() const { return parentDims_.size(); }
+  const vector<vector3d<int>> &BlockDims() const { return parentDims_; }
+  vector3d<int> BlockStart(const int &ii) const { return blkStart_[ii]; }
+  int NumViscousSurfaces() const { return viscSurfs_.size(); }
+  const boundarySurface &ViscousSurface(const int &ii) const {
+    return viscSurfs_[ii];
+  }
+  int ViscousSurfaceParent(const int &ii) const { return viscSurfParent_[ii]; }
+  int NumWalls() const { return wallDims_.size(); }
+  const vector<vector3d<int>> &WallDims() const { return wallDims_; }
+  int WallIndex(const int &blk, const int &ii) const {
+    return wallIndex_[blk][ii];
+  }
+  vector3d<int> WallStart(const int &blk, const int &ii) const {
+    return wallStart_[blk][ii];
+  }
+
+  // destructor
+  ~outputLayout() noexcept {}
+};
+
+// struct for a hyperslab of an array in a plot3d file that is written by this
+// processor
+struct fileSlab {
+  MPI_Offset disp_;      // byte offset of start of whole array in file
+  vector3d<int> dims_;   // number of cells in whole array
+  vector3d<int> start_;  // start of slab in whole array
+  vector3d<int> size_;   // number of cells in slab
+  int numVars_;          // number of values stored together for each cell
+  vector<double> data_;  // slab values in i, j, k order
+
+  fileSlab(const MPI_Offset &disp, const vector3d<int> &dims,
+           const vector3d<int> &start, const vector3d<int> &size,
+           const int &numVars)
+      : disp_(disp), dims_(dims), start_(start), size_(size),
+        numVars_(numVars) {
+    data_.reserve(size_[0] * size_[1] * size_[2] * numVars_);
+  }
+};
+
+// struct for the index entry of a chunk of a restart file
+struct restartChunk {
+  int sol_;              // solution (time level) in chunk
+  int block_;            // parent block of chunk
+  vector3d<int> start_;  // start of chunk in parent block
+  vector3d<int> size_;   // number of cells in chunk
+  int codec_;            // compression of data (0 - none, 1 - xor)
+  int64_t disp_;         // byte offset of data in file
+  int64_t bytes_;        // number of bytes of data in file
+  uint32_t crc_;         // checksum of data in file
+};
+
+// class to write files with collective MPI-IO. The data each processor writes
+// to a file is copied into a staging buffer, and the whole file is written
+// with a single nonblocking collective write. With asynchronous output the
+// files of a checkpoint are left to finish while the solver continues; they
+// are only waited on when the next checkpoint is ready to be written, or at
+// the end of the run. At most two checkpoints are staged at once.
+class outputWriter {
+  // file being written, and the buffer that must live until it is done
+  struct pendingFile {
+    MPI_File file_;
+    vector<char> buffer_;
+    MPI_Request request_;
+  };
+
+  bool isAsync_;                       // flag to leave writes to finish later
+  vector<pendingFile> previous_;       // files of earlier checkpoints
+  vector<pendingFile> current_;        // files of current checkpoint
+
+  // private member functions
+  void Complete(vector<pendingFile> &) const;
+  void AddRun(vector<int> &, vector<MPI_Aint> &, const MPI_Offset &,
+              MPI_Offset) const;
+  void WriteStaged(const string &, pendingFile &, const vector<int> &,
+                   const vector<MPI_Aint> &);
+
+ public:
+  // constructor
+  explicit outputWriter(const bool &isAsync) : isAsync_(isAsync) {}
+
+  // move constructor and assignment operator
+  outputWriter(outputWriter &&) noexcept = default;
+  outputWriter &operator=(outputWriter &&) noexcept = default;
+
+  // copy constructor and assignment operator
+  outputWriter(const outputWriter &) = delete;
+  outputWriter &operator=(const outputWriter &) = delete;
+
+  // member functions
+  bool IsAsynchronous() const { return isAsync_; }
+  void StartCheckpoint();
+  void Write(const string &, const vector<char> &, const vector<fileSlab> &);
+  void Write(const string &, const vector<char> &, const MPI_Offset &,
+             vector<char> &&);
+  void Complete();
+
+  // destructor
+  ~outputWriter() noexcept {}
+};
+
 // function definitions
-template<typename T>
-void WriteBlockDims(ofstream &, const vector<T> &, int = 0);
+void WriteBlockDims(vector<char> &, const vector<vector3d<int>> &, int = 0);
+vector<MPI_Offset> BlockDisplacements(const vector<vector3d<int>> &,
+                                      const MPI_Offset &, const int &);
 
 void WriteCellCenter(const string &, const vector<procBlock> &,
-                     const decomposition &, const input &);
+                     const outputLayout &, const input &, outputWriter &);
 void WriteWallFaceCenter(const string &, const vector<procBlock> &,
-                         const double &);
+                         const outputLayout &, const double &,
+                         outputWriter &);
 void WriteFun(const vector<procBlock> &, const unique_ptr<eos> &,
               const unique_ptr<thermodynamic> &thermo,
-              const unique_ptr<transport> &, const int &, const decomposition &,
-              const input &, const unique_ptr<turbModel> &);
+              const unique_ptr<transport> &, const int &, const outputLayout &,
+              const input &, const unique_ptr<turbModel> &, outputWriter &);
 void WriteWallFun(const vector<procBlock> &, const unique_ptr<eos> &,
-                  const unique_ptr<transport> &, const int &, const input &,
-                  const unique_ptr<turbModel> &);
+                  const unique_ptr<transport> &, const int &,
+                  const outputLayout &, const input &,
+                  const unique_ptr<turbModel> &, outputWriter &);
 void WriteMeta(const input &, const int &);
 void WriteWallMeta(const input &, const int &);
 
 void WriteRestart(const vector<procBlock> &, const unique_ptr<eos> &,
                   const unique_ptr<transport> &, const int &,
-                  const decomposition &, const input &, const genArray &);
+                  const outputLayout &, const input &, const genArray &,
+                  outputWriter &);
+void ReadRestartChunks(vector<procBlock> &, const string &,
+                       const outputLayout &, input &, const unique_ptr<eos> &,
+                       const unique_ptr<thermodynamic> &,
+                       const unique_ptr<transport> &,
+                       const unique_ptr<turbModel> &, genArray &);
+bool IsChunkedRestart(const string &);
 void ReadRestart(vector<procBlock> &, const string &, const decomposition &,
                  input &, const unique_ptr<eos> &,
                  const unique_ptr<thermodynamic> &,
@@ -100,8 +255,4 @@ void PrintResiduals(const input &, genArray &, const genArray &, const resid &,
                     const double &, const int &, const int &, ostream &);
 void PrintHeaders(const input &, ostream &);
 
-vector<procBlock> Recombine(const vector<procBlock> &, const decomposition &);
-int SplitBlockNumber(const vector<procBlock> &, const decomposition &,
-                     const int &, const int &, const int &, const int &);
-
 #endif
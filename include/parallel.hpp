@@ -105,6 +105,8 @@ class decomposition {
   string SplitHistDir(const int &a) const {return splitHistDir_[a];}
   template <typename T>
   void DecompArray(vector<multiArray3d<T>> &) const;
+  void DecompGrid(vector<plot3dBlock> &) const;
+  void Broadcast();
   void PrintDiagnostics(const vector<plot3dBlock>&) const;
 
   // Destructor
@@ -143,6 +145,7 @@ void MaxLinf(resid*, resid*, int*, MPI_Datatype*);
 void BroadcastString(string& str);
 
 void BroadcastViscFaces(const MPI_Datatype&, vector<vector3d<double>> &);
+void BroadcastBCs(vector<boundaryConditions> &);
 
 
 template <typename T>
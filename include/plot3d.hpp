@@ -24,11 +24,49 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
+#include <memory>
 #include "vector3d.hpp"
 #include "multiArray3d.hpp"
 
 using std::vector;
 using std::string;
+using std::ifstream;
+using std::shared_ptr;
+
+//-------------------------------------------------------------------------
+// Class to read parts of a binary plot3d grid file. Only the header is read
+// when the file is opened. Nodes are read from the file as they are needed by
+// seeking to them, so a processor only reads the part of the grid it uses.
+class plot3dGridFile {
+  string fileName_;                  // name of grid file
+  double lRef_;                      // reference length to scale nodes by
+  vector<vector3d<int>> blkSize_;    // number of nodes in each block
+  vector<std::streamoff> blkStart_;  // file offset of each block
+  mutable ifstream file_;            // grid file
+
+  std::streamoff NodeOffset(const int &, const int &, const int &,
+                            const int &, const int &) const;
+
+ public:
+  // constructor
+  plot3dGridFile(const string &, const double &);
+
+  // copying would share the file position, so no copying
+  plot3dGridFile(const plot3dGridFile&) = delete;
+  plot3dGridFile& operator=(const plot3dGridFile&) = delete;
+
+  // member functions
+  int NumBlocks() const { return blkSize_.size(); }
+  vector3d<int> BlockSize(const int &bb) const { return blkSize_[bb]; }
+  vector3d<double> Coords(const int &, const int &, const int &,
+                          const int &) const;
+  multiArray3d<vector3d<double>> ReadNodes(const int &, const vector3d<int> &,
+                                           const vector3d<int> &) const;
+
+  // destructor
+  ~plot3dGridFile() noexcept {}
+};
 
 //-------------------------------------------------------------------------
 // Class for an individual plot3d block
@@ -36,13 +74,23 @@ class plot3dBlock {
   // by default everything above the public: declaration is private
   multiArray3d<vector3d<double>> coords_;  // coordinates of nodes in block
 
+  // blocks that have not been read yet only store where they are in the grid
+  // file; coords_ is empty for these blocks
+  shared_ptr<const plot3dGridFile> file_;  // grid file (nullptr if read)
+  int fileBlock_;                          // block in grid file
+  vector3d<int> fileStart_;                // first node in file block
+  vector3d<int> fileNum_;                  // number of nodes
+
  public:
   // constructor -- create a plot3d block by passing the above quantities
   explicit plot3dBlock(const multiArray3d<vector3d<double>> &coordinates) :
-      coords_(coordinates) {}
+      coords_(coordinates), file_(nullptr), fileBlock_(-1) {}
   plot3dBlock(const int &ii, const int &jj, const int &kk) :
-      coords_(ii, jj, kk, 0) {}
-  plot3dBlock() : coords_(0, 0, 0, 0) {}
+      coords_(ii, jj, kk, 0), file_(nullptr), fileBlock_(-1) {}
+  plot3dBlock(const shared_ptr<const plot3dGridFile> &file, const int &blk) :
+      coords_(0, 0, 0, 0), file_(file), fileBlock_(blk), fileStart_(0, 0, 0),
+      fileNum_(file->BlockSize(blk)) {}
+  plot3dBlock() : plot3dBlock(0, 0, 0) {}
 
   // move constructor and assignment operator
   plot3dBlock(plot3dBlock&&) noexcept = default;
@@ -64,30 +112,35 @@ class plot3dBlock {
 
   vector3d<double> Centroid(const int &, const int &, const int &) const;
 
-  int NumI() const { return coords_.NumI(); }
-  int NumJ() const { return coords_.NumJ(); }
-  int NumK() const { return coords_.NumK(); }
-  int NumCellsI() const { return coords_.NumI() - 1; }
-  int NumCellsJ() const { return coords_.NumJ() - 1; }
-  int NumCellsK() const { return coords_.NumK() - 1; }
+  bool IsRead() const { return file_ == nullptr; }
+  int NumI() const { return this->IsRead() ? coords_.NumI() : fileNum_[0]; }
+  int NumJ() const { return this->IsRead() ? coords_.NumJ() : fileNum_[1]; }
+  int NumK() const { return this->IsRead() ? coords_.NumK() : fileNum_[2]; }
+  int NumCellsI() const { return this->NumI() - 1; }
+  int NumCellsJ() const { return this->NumJ() - 1; }
+  int NumCellsK() const { return this->NumK() - 1; }
   int NumCells() const {
     return this->NumCellsI() * this->NumCellsJ() * this->NumCellsK();
   }
   double X(const int &ii, const int &jj, const int &kk) const {
-    return coords_(ii, jj, kk)[0];
+    return this->Coords(ii, jj, kk)[0];
   }
   double Y(const int &ii, const int &jj, const int &kk) const {
-    return coords_(ii, jj, kk)[1];
+    return this->Coords(ii, jj, kk)[1];
   }
   double Z(const int &ii, const int &jj, const int &kk) const {
-    return coords_(ii, jj, kk)[2];
+    return this->Coords(ii, jj, kk)[2];
   }
   vector3d<double> Coords(const int &ii, const int &jj, const int &kk) const {
-    return coords_(ii, jj, kk);
+    return this->IsRead()
+        ? coords_(ii, jj, kk)
+        : file_->Coords(fileBlock_, fileStart_[0] + ii, fileStart_[1] + jj,
+                        fileStart_[2] + kk);
   }
 
   void Split(const string &, const int &, plot3dBlock &, plot3dBlock &) const;
   void Join(const plot3dBlock &, const string &);
+  plot3dBlock Read() const;
 
   // destructor
   ~plot3dBlock() noexcept {}
@@ -96,6 +149,7 @@ class plot3dBlock {
 //-------------------------------------------------------------------------
 // function declarations
 vector<plot3dBlock> ReadP3dGrid(const string &, const double &, double &);
+vector<plot3dBlock> OpenP3dGrid(const string &, const double &);
 double PyramidVolume(const vector3d<double> &, const vector3d<double> &,
                      const vector3d<double> &, const vector3d<double> &,
                      const vector3d<double> &);
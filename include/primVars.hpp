@@ -38,6 +38,8 @@ supply a ghost state given a boundary condition and boundary cell.  */
 #include "thermodynamic.hpp"       // thermodynamic model
 #include "multiArray3d.hpp"        // multiArray3d
 #include "genArray.hpp"            // genArray
+#include "inputEnums.hpp"          // limiterType
+#include "reconCoeffs.hpp"         // wenoCoeffs
 #include "macros.hpp"
 
 using std::vector;
@@ -75,6 +77,9 @@ class primVars {
       : primVars(r, v.X(), v.Y(), v.Z(), p) {}
   primVars(const genArray &, const bool &, const unique_ptr<eos> &,
            const unique_ptr<thermodynamic> &, const unique_ptr<turbModel> &);
+  template <typename E, typename T>
+  primVars(const genArray &, const bool &, const E &, const T &,
+           const unique_ptr<turbModel> &);
 
   // move constructor and assignment operator
   primVars(primVars&&) noexcept = default;
@@ -84,6 +89,10 @@ class primVars {
   primVars(const primVars&) = default;
   primVars& operator=(const primVars&) = default;
 
+  // access to individual variables
+  const double & operator[](const int &r) const { return data_[r]; }
+  double & operator[](const int &r) { return data_[r]; }
+
   // member functions
   double Rho() const { return data_[0]; }
   double U() const { return data_[1]; }
@@ -117,6 +126,23 @@ class primVars {
                               const genArray &,
                               const unique_ptr<turbModel> &) const;
 
+  // versions of the above taking the models by reference; when called with
+  // the concrete (final) model types the model calls are statically
+  // dispatched and can be inlined
+  template <typename E, typename T>
+  double Energy(const E &, const T &) const;
+  template <typename E, typename T>
+  double Enthalpy(const E &, const T &) const;
+  template <typename E>
+  double Temperature(const E &) const;
+  template <typename T, typename E>
+  double SoS(const T &, const E &) const;
+  template <typename E, typename T>
+  genArray ConsVars(const E &, const T &) const;
+  template <typename E, typename T>
+  primVars UpdateWithConsVars(const E &, const T &, const genArray &,
+                              const unique_ptr<turbModel> &) const;
+
   void ApplyFarfieldTurbBC(const vector3d<double> &, const double &,
                            const double &, const unique_ptr<transport> &,
                            const unique_ptr<eos> &,
@@ -127,6 +153,10 @@ class primVars {
                                const unitVec3dMag<double> &,
                                const unique_ptr<thermodynamic> &,
                                const unique_ptr<eos> &) const;
+  template <typename T, typename E>
+  double InvCellSpectralRadius(const unitVec3dMag<double> &,
+                               const unitVec3dMag<double> &, const T &,
+                               const E &) const;
   double InvFaceSpectralRadius(const unitVec3dMag<double> &,
                                const unique_ptr<thermodynamic> &,
                                const unique_ptr<eos> &) const;
@@ -199,7 +229,7 @@ class primVars {
   // center to cell face this function uses muscle extrapolation resulting in
   // higher order accuracy
   primVars FaceReconMUSCL(const primVars &, const primVars &, const double &,
-                          const string &, const double &,
+                          const limiterType &, const double &,
                           const double &, const double &) const;
 
   // calculate face reconstruction using 5th order weno scheme
@@ -207,6 +237,10 @@ class primVars {
                          const primVars &, const double &, const double &,
                          const double &, const double &, const double &,
                          const bool &) const;
+  primVars FaceReconWENO(const primVars &, const primVars &, const primVars &,
+                         const primVars &, const wenoCoeffs &, const double &,
+                         const double &, const double &, const double &,
+                         const double &, const bool &) const;
 
   // member function to calculate Van Albada limiter function
   primVars LimiterVanAlbada(const primVars &) const;
@@ -228,10 +262,45 @@ class primVars {
 };
 
 // function definitions
+// constructor from conserved or primative variables
+template <typename E, typename T>
+primVars::primVars(const genArray &a, const bool &prim, const E &eqnState,
+                   const T &thermo, const unique_ptr<turbModel> &turb) {
+  // a -- array of conservative or primative variables
+  // prim -- flag that is true if variable a is primative variables
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // turb -- turbulence model
+
+  if (prim) {  // genArray is primative variables
+    for (auto ii = 0; ii < NUMVARS; ii++) {
+      data_[ii] = a[ii];
+    }
+  } else {  // genArray is conserved variables
+    data_[0] = a[0];
+    data_[1] = a[1] / a[0];
+    data_[2] = a[2] / a[0];
+    data_[3] = a[3] / a[0];
+    const auto energy = a[4] / a[0];
+    data_[4] = eqnState.PressFromEnergy(thermo, data_[0], energy,
+                                        this->Velocity().Mag());
+    data_[5] = a[5] / a[0];
+    data_[6] = a[6] / a[0];
+  }
+
+  // Adjust turbulence variables to be above minimum if necessary
+  this->LimitTurb(turb);
+}
+
 // member function to calculate temperature from conserved variables and
 // equation of state
+template <typename E>
+double primVars::Temperature(const E &eqnState) const {
+  return eqnState.Temperature(data_[4], data_[0]);
+}
+
 double primVars::Temperature(const unique_ptr<eos> &eqnState) const {
-  return eqnState->Temperature(data_[4], data_[0]);
+  return this->Temperature(*eqnState);
 }
 
 // member function to calculate velocity from conserved variables
@@ -241,36 +310,105 @@ vector3d<double> primVars::Velocity() const {
 }
 
 // member function to calculate total energy from conserved variables
+template <typename E, typename T>
+double primVars::Energy(const E &eqnState, const T &thermo) const {
+  const auto t = this->Temperature(eqnState);
+  return eqnState.Energy(eqnState.SpecEnergy(thermo, t),
+                         (*this).Velocity().Mag());
+}
+
 double primVars::Energy(const unique_ptr<eos> &eqnState,
                         const unique_ptr<thermodynamic> &thermo) const {
-  const auto t = this->Temperature(eqnState);
-  return eqnState->Energy(eqnState->SpecEnergy(thermo, t),
-                          (*this).Velocity().Mag());
+  return this->Energy(*eqnState, *thermo);
 }
 
 // member function to calculate speed of sound from primative varialbes
+template <typename T, typename E>
+double primVars::SoS(const T &thermo, const E &eqnState) const {
+  return sqrt(thermo.Gamma(this->Temperature(eqnState)) * data_[4] / data_[0]);
+}
+
 double primVars::SoS(const unique_ptr<thermodynamic> &thermo,
                      const unique_ptr<eos> &eqnState) const {
-  return sqrt(thermo->Gamma(this->Temperature(eqnState)) * data_[4] / data_[0]);
+  return this->SoS(*thermo, *eqnState);
 }
 
 // member function to calculate enthalpy from conserved variables and equation
 // of state
+template <typename E, typename T>
+double primVars::Enthalpy(const E &eqnState, const T &thermo) const {
+  const auto t = this->Temperature(eqnState);
+  return eqnState.Enthalpy(thermo, t, this->Velocity().Mag());
+}
+
 double primVars::Enthalpy(const unique_ptr<eos> &eqnState,
                           const unique_ptr<thermodynamic> &thermo) const {
-  const auto t = this->Temperature(eqnState);
-  return eqnState->Enthalpy(thermo, t, this->Velocity().Mag());
+  return this->Enthalpy(*eqnState, *thermo);
 }
 
 // member function to calculate conserved variables from primative variables
-genArray primVars::ConsVars(const unique_ptr<eos> &eqnState,
-                            const unique_ptr<thermodynamic> &thermo) const {
+template <typename E, typename T>
+genArray primVars::ConsVars(const E &eqnState, const T &thermo) const {
   genArray cv(data_[0], data_[0] * data_[1], data_[0] * data_[2],
               data_[0] * data_[3], data_[0] * this->Energy(eqnState, thermo),
               data_[0] * data_[5], data_[0] * data_[6]);
   return cv;
 }
 
+genArray primVars::ConsVars(const unique_ptr<eos> &eqnState,
+                            const unique_ptr<thermodynamic> &thermo) const {
+  return this->ConsVars(*eqnState, *thermo);
+}
+
+// member function to take in a genArray of updates to the conservative
+// variables, and update the primative variables with it.
+// this is used in the implicit solver
+template <typename E, typename T>
+primVars primVars::UpdateWithConsVars(const E &eqnState, const T &thermo,
+                                      const genArray &du,
+                                      const unique_ptr<turbModel> &turb) const {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // du -- updates to conservative variables
+  // turb -- turbulence model
+
+  // convert primative to conservative and update
+  const auto consUpdate = this->ConsVars(eqnState, thermo) + du;
+
+  return primVars(consUpdate, false, eqnState, thermo, turb);
+}
+
+/*Function to return the inviscid spectral radius for one direction (i, j, or k)
+given a cell state, equation of state, and 2 face area vectors
+
+L = 0.5 * (A1 + A2) * (|Vn| + SoS)
+
+In the above equation L is the spectral radius in either the i, j, or k
+direction. A1 and A2 are the two face areas in that direction. Vn is the
+cell velocity normal to that direction. SoS is the speed of sound at the cell
+ */
+template <typename T, typename E>
+double primVars::InvCellSpectralRadius(const unitVec3dMag<double> &fAreaL,
+                                       const unitVec3dMag<double> &fAreaR,
+                                       const T &thermo,
+                                       const E &eqnState) const {
+  // fAreaL -- face area of lower face in either i, j, or k direction
+  // fAreaR -- face area of upper face in either i, j, or k direction
+  // thermo -- thermodynamic model
+  // eqnState -- equation of state
+
+  // normalize face areas
+  const auto normAvg = (0.5 * (fAreaL.UnitVector() +
+                               fAreaR.UnitVector())).Normalize();
+  // average area magnitude
+  const auto fMag = 0.5 * (fAreaL.Mag() + fAreaR.Mag());
+
+  // return spectral radius
+  return (fabs(this->Velocity().DotProd(normAvg)) +
+          this->SoS(thermo, eqnState)) *
+         fMag;
+}
+
 // operator overload for addition
 primVars & primVars::operator+=(const primVars &arr) {
   for (auto rr = 0; rr < NUMVARS; rr++) {
@@ -376,6 +514,29 @@ inline const primVars operator/(const double &lhs, primVars rhs) {
 
 ostream &operator<<(ostream &os, const primVars &);
 
-primVars RoeAveragedState(const primVars&, const primVars&);
+// function to calculate the Roe averaged state; this is inline so that the
+// flux functions in inviscidFlux.cpp are compiled with the same floating point
+// contraction as the line flux kernels there
+inline primVars RoeAveragedState(const primVars &left, const primVars &right) {
+  // compute Rho averaged quantities
+  // density ratio
+  const auto denRatio = sqrt(right.Rho() / left.Rho());
+  // Roe averaged density
+  const auto rhoR = left.Rho() * denRatio;
+  // Roe averaged velocities - u, v, w
+  const auto uR = (left.U() + denRatio * right.U()) / (1.0 + denRatio);
+  const auto vR = (left.V() + denRatio * right.V()) / (1.0 + denRatio);
+  const auto wR = (left.W() + denRatio * right.W()) / (1.0 + denRatio);
+
+  // Roe averaged pressure
+  const auto pR = (left.P() + denRatio * right.P()) / (1.0 + denRatio);
+
+  // Roe averaged tke
+  const auto kR = (left.Tke() + denRatio * right.Tke()) / (1.0 + denRatio);
+  // Roe averaged specific dissipation (omega)
+  const auto omR = (left.Omega() + denRatio * right.Omega()) / (1.0 + denRatio);
+
+  return primVars(rhoR, uR, vR, wR, pR, kR, omR);
+}
 
 #endif
@@ -31,6 +31,13 @@
 #include "primVars.hpp"            // primVars
 #include "genArray.hpp"            // genArray
 #include "boundaryConditions.hpp"  // connection, patch
+#include "inputEnums.hpp"          // reconstruction, timeIntegrator
+#include "reconCoeffs.hpp"         // wenoCoeffs, central4thCoeffs
+#include "hyperplanes.hpp"         // hyperplanes
+#include "offDiagonals.hpp"        // offDiagonals
+#include "fluxJacobian.hpp"        // fluxJacobian
+#include "implicitDiagonal.hpp"    // implicitDiagonal
+#include "haloExchange.hpp"        // haloExchange
 #include "macros.hpp"
 #include "uncoupledScalar.hpp"     // uncoupledScalar
 #include "wallData.hpp"
@@ -50,6 +57,7 @@ class eos;
 class transport;
 class thermodynamic;
 class inviscidFlux;
+class inviscidFluxLine;
 class viscousFlux;
 class input;
 class geomSlice;
@@ -57,9 +65,30 @@ class source;
 class turbModel;
 class plot3dBlock;
 class resid;
-class fluxJacobian;
 class kdtree;
 
+// faces and fluxes calculated in a pass over the faces of a procBlock
+// interior faces are those whose inviscid flux stencil only uses physical
+// cells; the boundary passes skip them because they have already been done
+enum class facePass {
+  inviscid,          // inviscid fluxes on all faces
+  inviscidWall,      // inviscid fluxes on faces using viscous wall ghost cells
+  fused,             // inviscid fluxes on all other faces, and viscous fluxes
+  interior,          // inviscid fluxes on interior faces
+  inviscidBoundary,  // inviscid fluxes on all non-interior faces
+  fusedBoundary      // inviscid fluxes on non-interior faces not using
+                     // viscous wall ghost cells, and viscous fluxes
+};
+
+// viscous wall surfaces on the lower and upper boundaries in the direction of
+// a set of faces; the inviscid flux stencils of the faces near these surfaces
+// use the slip wall ghost cells of the walls
+struct viscousWalls {
+  vector<boundarySurface> lower_;
+  vector<boundarySurface> upper_;
+  bool Empty() const { return lower_.empty() && upper_.empty(); }
+};
+
 class procBlock {
   multiArray3d<primVars> state_;  // primative variables at cell center
   multiArray3d<genArray> consVarsN_;  // conserved variables at time n
@@ -80,6 +109,27 @@ class procBlock {
   multiArray3d<double> cellWidthJ_;  // j-width of cell
   multiArray3d<double> cellWidthK_;  // k-width of cell
 
+  // face reconstruction coefficients for lower and upper states at physical
+  // faces; only allocated if used by reconstruction method
+  multiArray3d<wenoCoeffs> wenoLowerI_;
+  multiArray3d<wenoCoeffs> wenoUpperI_;
+  multiArray3d<wenoCoeffs> wenoLowerJ_;
+  multiArray3d<wenoCoeffs> wenoUpperJ_;
+  multiArray3d<wenoCoeffs> wenoLowerK_;
+  multiArray3d<wenoCoeffs> wenoUpperK_;
+  multiArray3d<central4thCoeffs> central4thI_;
+  multiArray3d<central4thCoeffs> central4thJ_;
+  multiArray3d<central4thCoeffs> central4thK_;
+
+  // cells ordered by hyperplane for implicit sweeps; only calculated if used
+  // by matrix solver
+  hyperplanes hyperplanes_;
+
+  // off diagonal operators for implicit sweeps; only allocated if stored,
+  // jacobians for block rusanov matrix and spectral radii otherwise
+  offDiagonals<fluxJacobian> offDiagJacobian_;
+  offDiagonals<uncoupledScalar> offDiagSpecRad_;
+
   multiArray3d<uncoupledScalar> specRadius_;  // maximum wave speed for cell
   multiArray3d<double> vol_;  // cell volume
   multiArray3d<double> dt_;  // cell time step
@@ -103,6 +153,7 @@ class procBlock {
   vector<wallData> wallData_;  // wall variables at viscous walls
 
   int numGhosts_;  // number of layers of ghost cells surrounding block
+  int arrayPadding_;  // extra elements at end of i-lines of arrays
   int parBlock_;  // parent block number
   int rank_;  // processor rank
   int localPos_;  // position on local processor
@@ -114,42 +165,127 @@ class procBlock {
   bool storeTimeN_;
   bool isMultiLevelTime_;
 
+  vector3d<double> faceFluxTime_;  // seconds spent on i, j, k face fluxes
+
   // private member functions
-  void CalcInvFluxI(const unique_ptr<eos> &, const unique_ptr<thermodynamic> &,
-                    const input &, const unique_ptr<turbModel> &,
-                    multiArray3d<fluxJacobian> &);
-  void CalcInvFluxJ(const unique_ptr<eos> &, const unique_ptr<thermodynamic> &,
-                    const input &, const unique_ptr<turbModel> &,
-                    multiArray3d<fluxJacobian> &);
-  void CalcInvFluxK(const unique_ptr<eos> &, const unique_ptr<thermodynamic> &,
-                    const input &, const unique_ptr<turbModel> &,
-                    multiArray3d<fluxJacobian> &);
+  void CalcFaceFlux(const unique_ptr<eos> &,
+                    const unique_ptr<thermodynamic> &,
+                    const unique_ptr<transport> &, const input &,
+                    const unique_ptr<turbModel> &, const facePass &,
+                    implicitDiagonal &);
+  template <reconstruction R>
+  void CalcFaceFlux(const unique_ptr<eos> &,
+                    const unique_ptr<thermodynamic> &,
+                    const unique_ptr<transport> &, const input &,
+                    const unique_ptr<turbModel> &, const facePass &,
+                    implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F>
+  void CalcFaceFlux(const unique_ptr<eos> &,
+                    const unique_ptr<thermodynamic> &,
+                    const unique_ptr<transport> &, const input &,
+                    const unique_ptr<turbModel> &, const facePass &,
+                    implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcFaceFluxIJK(const unique_ptr<eos> &,
+                       const unique_ptr<thermodynamic> &,
+                       const unique_ptr<transport> &, const input &,
+                       const unique_ptr<turbModel> &, const facePass &,
+                       implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcFaceFluxI(const unique_ptr<eos> &,
+                     const unique_ptr<thermodynamic> &,
+                     const unique_ptr<transport> &, const input &,
+                     const unique_ptr<turbModel> &, const facePass &,
+                     implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcFaceFluxJ(const unique_ptr<eos> &,
+                     const unique_ptr<thermodynamic> &,
+                     const unique_ptr<transport> &, const input &,
+                     const unique_ptr<turbModel> &, const facePass &,
+                     implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcFaceFluxK(const unique_ptr<eos> &,
+                     const unique_ptr<thermodynamic> &,
+                     const unique_ptr<transport> &, const input &,
+                     const unique_ptr<turbModel> &, const facePass &,
+                     implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcInvFluxLineI(const int &, const int &, const int &, const int &,
+                        const unique_ptr<eos> &,
+                        const unique_ptr<thermodynamic> &, const input &,
+                        const unique_ptr<turbModel> &, const facePass &,
+                        const viscousWalls &, inviscidFluxLine &,
+                        implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcInvFluxLineJ(const int &, const int &, const int &, const int &,
+                        const unique_ptr<eos> &,
+                        const unique_ptr<thermodynamic> &, const input &,
+                        const unique_ptr<turbModel> &, const facePass &,
+                        const viscousWalls &, inviscidFluxLine &,
+                        implicitDiagonal &);
+  template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+  void CalcInvFluxLineK(const int &, const int &, const int &, const int &,
+                        const unique_ptr<eos> &,
+                        const unique_ptr<thermodynamic> &, const input &,
+                        const unique_ptr<turbModel> &, const facePass &,
+                        const viscousWalls &, inviscidFluxLine &,
+                        implicitDiagonal &);
+  viscousWalls ViscousWalls(const int &) const;
 
   void CalcViscFluxI(const unique_ptr<transport> &,
                      const unique_ptr<thermodynamic> &, const unique_ptr<eos> &,
                      const input &, const unique_ptr<turbModel> &,
-                     multiArray3d<fluxJacobian> &);
+                     implicitDiagonal &);
+  void CalcViscFluxLineI(const int &, const int &,
+                         const unique_ptr<transport> &,
+                         const unique_ptr<thermodynamic> &,
+                         const unique_ptr<eos> &, const input &,
+                         const unique_ptr<turbModel> &,
+                         implicitDiagonal &);
   void CalcViscFluxJ(const unique_ptr<transport> &,
                      const unique_ptr<thermodynamic> &, const unique_ptr<eos> &,
                      const input &, const unique_ptr<turbModel> &,
-                     multiArray3d<fluxJacobian> &);
+                     implicitDiagonal &);
+  void CalcViscFluxLineJ(const int &, const int &, const int &,
+                         const int &, const unique_ptr<transport> &,
+                         const unique_ptr<thermodynamic> &,
+                         const unique_ptr<eos> &, const input &,
+                         const unique_ptr<turbModel> &,
+                         implicitDiagonal &);
   void CalcViscFluxK(const unique_ptr<transport> &,
                      const unique_ptr<thermodynamic> &, const unique_ptr<eos> &,
                      const input &, const unique_ptr<turbModel> &,
-                     multiArray3d<fluxJacobian> &);
+                     implicitDiagonal &);
+  void CalcViscFluxLineK(const int &, const int &, const int &,
+                         const int &, const unique_ptr<transport> &,
+                         const unique_ptr<thermodynamic> &,
+                         const unique_ptr<eos> &, const input &,
+                         const unique_ptr<turbModel> &,
+                         implicitDiagonal &);
 
   void CalcCellDt(const int &, const int &, const int &, const double &);
 
-  void ExplicitEulerTimeAdvance(const unique_ptr<eos> &,
-                                const unique_ptr<thermodynamic> &,
+  template <typename E, typename T>
+  void UpdateCells(const input &, const unique_ptr<eos> &,
+                   const unique_ptr<thermodynamic> &,
+                   const multiArray3d<genArray> &,
+                   const unique_ptr<turbModel> &, const int &, genArray &,
+                   resid &);
+  template <timeIntegrator TI, typename E, typename T>
+  void AdvanceCells(const unique_ptr<eos> &, const unique_ptr<thermodynamic> &,
+                    const multiArray3d<genArray> &,
+                    const unique_ptr<turbModel> &, const int &, genArray &,
+                    resid &);
+  template <typename E, typename T>
+  void ExplicitEulerTimeAdvance(const E &, const T &,
                                 const unique_ptr<turbModel> &, const int &,
                                 const int &, const int &);
-  void ImplicitTimeAdvance(const genArray &, const unique_ptr<eos> &,
-                           const unique_ptr<thermodynamic> &,
+  template <typename E, typename T>
+  void ImplicitTimeAdvance(const genArray &, const E &, const T &,
                            const unique_ptr<turbModel> &, const int &,
                            const int &, const int &);
-  void RK4TimeAdvance(const genArray &, const unique_ptr<eos> &,
-                      const unique_ptr<thermodynamic> &,
+  template <typename E, typename T>
+  void RK4TimeAdvance(const genArray &, const E &, const T &,
                       const unique_ptr<turbModel> &, const int &, const int &,
                       const int &, const int &);
 
@@ -163,7 +299,28 @@ class procBlock {
                             const int &);
   void SubtractFromResidual(const source &, const int &, const int &,
                             const int &);
+  genArray FaceOffDiagonal(const int &, const int &, const int &,
+                           const int &, const bool &,
+                           const multiArray3d<genArray> &,
+                           const unique_ptr<eos> &, const input &,
+                           const unique_ptr<thermodynamic> &,
+                           const unique_ptr<transport> &,
+                           const unique_ptr<turbModel> &) const;
+  genArray LowerOffDiagonal(const int &, const int &, const int &,
+                            const multiArray3d<genArray> &,
+                            const unique_ptr<eos> &, const input &,
+                            const unique_ptr<thermodynamic> &,
+                            const unique_ptr<transport> &,
+                            const unique_ptr<turbModel> &) const;
+  genArray UpperOffDiagonal(const int &, const int &, const int &,
+                            const multiArray3d<genArray> &,
+                            const unique_ptr<eos> &, const input &,
+                            const unique_ptr<thermodynamic> &,
+                            const unique_ptr<transport> &,
+                            const unique_ptr<turbModel> &) const;
+
   vector<wallData> SplitWallData(const string &, const int &);
+  void PadArrays();
   void JoinWallData(const vector<wallData> &, const string &);
 
  public:
@@ -183,8 +340,8 @@ class procBlock {
   procBlock& operator=(const procBlock&) = default;
 
   // member functions
-  int NumCells() const { return residual_.Size(); }
-  int NumCellsGhosts() const { return state_.Size(); }
+  int NumCells() const { return residual_.NumCells(); }
+  int NumCellsGhosts() const { return state_.NumCells(); }
   int NumI() const { return residual_.NumI(); }
   int NumJ() const { return residual_.NumJ(); }
   int NumK() const { return residual_.NumK(); }
@@ -229,6 +386,7 @@ class procBlock {
   int ParentBlock() const {return parBlock_;}
   int LocalPosition() const {return localPos_;}
   int Rank() const {return rank_;}
+  const vector3d<double> & FaceFluxTime() const {return faceFluxTime_;}
   int GlobalPos() const {return globalPos_;}
   bool IsViscous() const {return isViscous_;}
   bool IsTurbulent() const {return isTurbulent_;}
@@ -389,18 +547,24 @@ class procBlock {
                    const unique_ptr<turbModel> &, const int &, genArray &,
                    resid &);
 
+  void CalcResidualInterior(const unique_ptr<transport> &,
+                            const unique_ptr<thermodynamic> &,
+                            const unique_ptr<eos> &, const input &,
+                            const unique_ptr<turbModel> &,
+                            implicitDiagonal &);
   void CalcResidualNoSource(const unique_ptr<transport> &,
                             const unique_ptr<thermodynamic> &,
                             const unique_ptr<eos> &, const input &,
                             const unique_ptr<turbModel> &,
-                            multiArray3d<fluxJacobian> &);
+                            implicitDiagonal &, const bool &);
   void CalcSrcTerms(const unique_ptr<transport> &,
                     const unique_ptr<turbModel> &, const input &,
-                    multiArray3d<fluxJacobian> &);
+                    implicitDiagonal &);
 
   void ResetResidWS();
   void ResetGradients();
   void ResetTurbVars();
+  void ResetResidualVars();
   void CleanResizeVecs(const int &, const int &, const int &, const int &);
 
   void InitializeStates(const input &, const unique_ptr<eos> &,
@@ -443,6 +607,11 @@ class procBlock {
   void CalcGradsK(const int &, const int &, const int &,
                   tensor<double> &, vector3d<double> &, vector3d<double> &,
                   vector3d<double> &) const;
+  void CalcCellGrads();
+  void FaceGradsFromCells(const int &, const int &, const int &, const int &,
+                          const int &, const int &, tensor<double> &,
+                          vector3d<double> &, vector3d<double> &,
+                          vector3d<double> &) const;
 
   void CalcWallDistance(const kdtree &);
 
@@ -452,29 +621,35 @@ class procBlock {
   multiArray3d<genArray> SolTimeMMinusN(const multiArray3d<genArray> &,
                                         const unique_ptr<eos> &, const input &,
                                         const int &) const;
-  void InvertDiagonal(multiArray3d<fluxJacobian> &, const input &) const;
+  void FactorDiagonal(implicitDiagonal &, const input &) const;
 
   multiArray3d<genArray> InitializeMatrixUpdate(
       const input &, const unique_ptr<eos> &eos,
       const unique_ptr<thermodynamic> &,
-      const multiArray3d<fluxJacobian> &) const;
-  void LUSGS_Forward(const vector<vector3d<int>> &, multiArray3d<genArray> &,
-                     const unique_ptr<eos> &, const input &,
+      const implicitDiagonal &) const;
+  void LUSGS_Forward(multiArray3d<genArray> &, const unique_ptr<eos> &,
+                     const input &,
                      const unique_ptr<thermodynamic> &,
                      const unique_ptr<transport> &,
                      const unique_ptr<turbModel> &,
-                     const multiArray3d<fluxJacobian> &, const int &) const;
-  double LUSGS_Backward(const vector<vector3d<int>> &, multiArray3d<genArray> &,
-                        const unique_ptr<eos> &, const input &,
+                     const implicitDiagonal &, const int &) const;
+  double LUSGS_Backward(multiArray3d<genArray> &, const unique_ptr<eos> &,
+                        const input &,
                         const unique_ptr<thermodynamic> &,
                         const unique_ptr<transport> &,
                         const unique_ptr<turbModel> &,
-                        const multiArray3d<fluxJacobian> &, const int &) const;
+                        const implicitDiagonal &, const int &) const;
+  double MulticolorGS(multiArray3d<genArray> &, const unique_ptr<eos> &,
+                      const input &,
+                      const unique_ptr<thermodynamic> &,
+                      const unique_ptr<transport> &,
+                      const unique_ptr<turbModel> &,
+                      const implicitDiagonal &) const;
 
   double DPLUR(multiArray3d<genArray> &, const unique_ptr<eos> &, const input &,
                const unique_ptr<thermodynamic> &, const unique_ptr<transport> &,
                const unique_ptr<turbModel> &,
-               const multiArray3d<fluxJacobian> &) const;
+               const implicitDiagonal &) const;
 
   bool IsPhysical(const int &, const int &, const int &) const;
   bool AtCorner(const int &, const int &, const int &) const;
@@ -492,21 +667,21 @@ class procBlock {
   void Join(const procBlock &, const string &, vector<boundarySurface> &);
 
   void SwapStateSlice(const connection &, procBlock &);
-  void SwapStateSliceMPI(const connection &, const int &, const MPI_Datatype &);
-  void SwapTurbSlice(const connection &, procBlock &);
-  void SwapTurbSliceMPI(const connection &, const int &);
+  void PackStateSlice(haloExchange &, const int &) const;
+  void UnpackStateSlice(haloExchange &, const int &);
   void SwapWallDistSlice(const connection &, procBlock &);
-  void SwapWallDistSliceMPI(const connection &, const int &);
+  void PackWallDistSlice(haloExchange &, const int &) const;
+  void UnpackWallDistSlice(haloExchange &, const int &);
   void SwapEddyViscAndGradientSlice(const connection &, procBlock &);
-  void SwapEddyViscAndGradientSliceMPI(const connection &, const int &,
-                                       const MPI_Datatype &,
-                                       const MPI_Datatype &);
+  void PackEddyViscAndGradientSlice(haloExchange &, const int &) const;
+  void UnpackEddyViscAndGradientSlice(haloExchange &, const int &);
 
   void PackSendGeomMPI(const MPI_Datatype &, const MPI_Datatype &,
-                       const MPI_Datatype &, const MPI_Datatype &) const;
+                       const MPI_Datatype &, const MPI_Datatype &,
+                       const int &) const;
   void RecvUnpackGeomMPI(const MPI_Datatype &, const MPI_Datatype &,
                          const MPI_Datatype &, const MPI_Datatype &,
-                         const input &);
+                         const input &, const int &);
   void PackSendSolMPI(const MPI_Datatype &, const MPI_Datatype &,
                       const MPI_Datatype &, const MPI_Datatype &,
                       const MPI_Datatype &) const;
@@ -521,9 +696,19 @@ class procBlock {
 
   double ProjC2CDist(const int &, const int &, const int &,
                      const string &) const;
+  double ProjC2CDist(const int &, const int &, const int &,
+                     const int &) const;
 
   void DumpToFile(const string &, const string &) const;
   void CalcCellWidths();
+  void CalcReconCoeffs(const input &);
+  void CalcHyperplanes(const input &);
+  void AllocateOffDiagonals(const input &);
+  double OffDiagonalMemory() const;
+  void CalcOffDiagonals(const unique_ptr<eos> &, const input &,
+                        const unique_ptr<thermodynamic> &,
+                        const unique_ptr<transport> &,
+                        const unique_ptr<turbModel> &);
   void GetStatesFromRestart(const multiArray3d<primVars> &);
   void GetSolNm1FromRestart(const multiArray3d<genArray> &);
 
@@ -0,0 +1,98 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef RECONCOEFFSHEADERDEF  // only if the macro RECONCOEFFSHEADERDEF is not
+                              // defined execute these lines of code
+#define RECONCOEFFSHEADERDEF  // define the macro
+
+/* This file contains classes for the coefficients of the higher order face
+   reconstructions. The coefficients only depend on the widths of the cells in
+   the stencil, so they can be calculated once for a static grid and stored
+   for each face. When all cells in the stencil have the same width, the
+   uniform spacing coefficients are used directly.
+ */
+
+#include <vector>  // vector
+
+using std::vector;
+
+// coefficients for 5th order WENO reconstruction to a face from the upwind
+// side; candidate stencil 0 is the most upwind, and stencil 2 is the most
+// downwind
+class wenoCoeffs {
+  double stencil_[3][3];  // coefficients of the three candidate stencils
+  double linearWeights_[3];  // linear weights of the candidate stencils
+
+ public:
+  // constructors
+  wenoCoeffs(const double &, const double &, const double &, const double &,
+             const double &);
+  // uniform spacing
+  wenoCoeffs() : stencil_{{1.0 / 3.0, -7.0 / 6.0, 11.0 / 6.0},
+                          {-1.0 / 6.0, 5.0 / 6.0, 1.0 / 3.0},
+                          {1.0 / 3.0, 5.0 / 6.0, -1.0 / 6.0}},
+                 linearWeights_{0.1, 0.3, 0.6} {}
+
+  // move constructor and assignment operator
+  wenoCoeffs(wenoCoeffs&&) noexcept = default;
+  wenoCoeffs& operator=(wenoCoeffs&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  wenoCoeffs(const wenoCoeffs&) = default;
+  wenoCoeffs& operator=(const wenoCoeffs&) = default;
+
+  // member functions
+  // coefficient of cell cc in candidate stencil ss
+  double Stencil(const int &ss, const int &cc) const {
+    return stencil_[ss][cc];
+  }
+  double LinearWeight(const int &ss) const { return linearWeights_[ss]; }
+
+  // destructor
+  ~wenoCoeffs() noexcept {}
+};
+
+// coefficients for 4th order central reconstruction to a face
+class central4thCoeffs {
+  double coeffs_[4];  // coefficients from most upwind to most downwind cell
+
+ public:
+  // constructors
+  central4thCoeffs(const double &, const double &, const double &,
+                   const double &);
+  // uniform spacing
+  central4thCoeffs()
+      : coeffs_{-1.0 / 12.0, 7.0 / 12.0, 7.0 / 12.0, -1.0 / 12.0} {}
+
+  // move constructor and assignment operator
+  central4thCoeffs(central4thCoeffs&&) noexcept = default;
+  central4thCoeffs& operator=(central4thCoeffs&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  central4thCoeffs(const central4thCoeffs&) = default;
+  central4thCoeffs& operator=(const central4thCoeffs&) = default;
+
+  // member functions
+  double operator[](const int &cc) const { return coeffs_[cc]; }
+
+  // destructor
+  ~central4thCoeffs() noexcept {}
+};
+
+// function declarations
+bool IsUniformStencil(const vector<double> &);
+
+#endif
@@ -0,0 +1,280 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef SIMDDOUBLEHEADERDEF  // only if the macro SIMDDOUBLEHEADERDEF is not
+                             // defined execute these lines of code
+#define SIMDDOUBLEHEADERDEF  // define the macro
+
+/* This file contains a small wrapper around the SIMD registers of the target
+   architecture. A simdDouble holds simdDouble::width doubles and supports the
+   arithmetic, comparison, and selection operations needed to write a kernel
+   once and have it operate on several values at a time. AVX-512 and AVX are
+   used when the compiler targets them (e.g. with -march=native); otherwise
+   the width is 1 and the operations are scalar. Comparisons return a
+   simdMask which is used with Select to replace branches.
+ */
+
+#include <cmath>  // sqrt, fabs
+#include <algorithm>  // min, max
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__)
+// ---------------------------------------------------------------------------
+// AVX-512 implementation
+class simdMask {
+  __mmask8 data_;
+
+ public:
+  explicit simdMask(const __mmask8 &m) : data_(m) {}
+  __mmask8 Native() const { return data_; }
+  friend simdMask operator&&(const simdMask &a, const simdMask &b) {
+    return simdMask(a.data_ & b.data_);
+  }
+  friend simdMask operator||(const simdMask &a, const simdMask &b) {
+    return simdMask(a.data_ | b.data_);
+  }
+};
+
+class simdDouble {
+  __m512d data_;
+
+ public:
+  static constexpr int width = 8;
+
+  // constructors
+  simdDouble() : data_(_mm512_setzero_pd()) {}
+  simdDouble(const double &val) : data_(_mm512_set1_pd(val)) {}
+  explicit simdDouble(const __m512d &v) : data_(v) {}
+
+  // member functions
+  static simdDouble Load(const double *ptr) {
+    return simdDouble(_mm512_loadu_pd(ptr));
+  }
+  void Store(double *ptr) const { _mm512_storeu_pd(ptr, data_); }
+  __m512d Native() const { return data_; }
+
+  friend simdDouble operator+(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm512_add_pd(a.data_, b.data_));
+  }
+  friend simdDouble operator-(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm512_sub_pd(a.data_, b.data_));
+  }
+  friend simdDouble operator*(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm512_mul_pd(a.data_, b.data_));
+  }
+  friend simdDouble operator/(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm512_div_pd(a.data_, b.data_));
+  }
+  friend simdMask operator<(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm512_cmp_pd_mask(a.data_, b.data_, _CMP_LT_OQ));
+  }
+  friend simdMask operator<=(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm512_cmp_pd_mask(a.data_, b.data_, _CMP_LE_OQ));
+  }
+  friend simdMask operator>(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm512_cmp_pd_mask(a.data_, b.data_, _CMP_GT_OQ));
+  }
+  friend simdMask operator>=(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm512_cmp_pd_mask(a.data_, b.data_, _CMP_GE_OQ));
+  }
+};
+
+// the zero masked forms are used because the unmasked forms trigger false
+// uninitialized warnings in some versions of gcc
+inline simdDouble Sqrt(const simdDouble &a) {
+  return simdDouble(_mm512_maskz_sqrt_pd(0xFF, a.Native()));
+}
+inline simdDouble Min(const simdDouble &a, const simdDouble &b) {
+  return simdDouble(_mm512_maskz_min_pd(0xFF, a.Native(), b.Native()));
+}
+inline simdDouble Max(const simdDouble &a, const simdDouble &b) {
+  return simdDouble(_mm512_maskz_max_pd(0xFF, a.Native(), b.Native()));
+}
+// select a where mask is true, and b otherwise
+inline simdDouble Select(const simdMask &m, const simdDouble &a,
+                         const simdDouble &b) {
+  return simdDouble(_mm512_mask_blend_pd(m.Native(), b.Native(), a.Native()));
+}
+
+#elif defined(__AVX__)
+// ---------------------------------------------------------------------------
+// AVX implementation
+class simdMask {
+  __m256d data_;
+
+ public:
+  explicit simdMask(const __m256d &m) : data_(m) {}
+  __m256d Native() const { return data_; }
+  friend simdMask operator&&(const simdMask &a, const simdMask &b) {
+    return simdMask(_mm256_and_pd(a.data_, b.data_));
+  }
+  friend simdMask operator||(const simdMask &a, const simdMask &b) {
+    return simdMask(_mm256_or_pd(a.data_, b.data_));
+  }
+};
+
+class simdDouble {
+  __m256d data_;
+
+ public:
+  static constexpr int width = 4;
+
+  // constructors
+  simdDouble() : data_(_mm256_setzero_pd()) {}
+  simdDouble(const double &val) : data_(_mm256_set1_pd(val)) {}
+  explicit simdDouble(const __m256d &v) : data_(v) {}
+
+  // member functions
+  static simdDouble Load(const double *ptr) {
+    return simdDouble(_mm256_loadu_pd(ptr));
+  }
+  void Store(double *ptr) const { _mm256_storeu_pd(ptr, data_); }
+  __m256d Native() const { return data_; }
+
+  friend simdDouble operator+(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm256_add_pd(a.data_, b.data_));
+  }
+  friend simdDouble operator-(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm256_sub_pd(a.data_, b.data_));
+  }
+  friend simdDouble operator*(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm256_mul_pd(a.data_, b.data_));
+  }
+  friend simdDouble operator/(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(_mm256_div_pd(a.data_, b.data_));
+  }
+  friend simdMask operator<(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm256_cmp_pd(a.data_, b.data_, _CMP_LT_OQ));
+  }
+  friend simdMask operator<=(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm256_cmp_pd(a.data_, b.data_, _CMP_LE_OQ));
+  }
+  friend simdMask operator>(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm256_cmp_pd(a.data_, b.data_, _CMP_GT_OQ));
+  }
+  friend simdMask operator>=(const simdDouble &a, const simdDouble &b) {
+    return simdMask(_mm256_cmp_pd(a.data_, b.data_, _CMP_GE_OQ));
+  }
+};
+
+inline simdDouble Sqrt(const simdDouble &a) {
+  return simdDouble(_mm256_sqrt_pd(a.Native()));
+}
+inline simdDouble Min(const simdDouble &a, const simdDouble &b) {
+  return simdDouble(_mm256_min_pd(a.Native(), b.Native()));
+}
+inline simdDouble Max(const simdDouble &a, const simdDouble &b) {
+  return simdDouble(_mm256_max_pd(a.Native(), b.Native()));
+}
+// select a where mask is true, and b otherwise
+inline simdDouble Select(const simdMask &m, const simdDouble &a,
+                         const simdDouble &b) {
+  return simdDouble(_mm256_blendv_pd(b.Native(), a.Native(), m.Native()));
+}
+
+#else
+// ---------------------------------------------------------------------------
+// scalar implementation
+class simdMask {
+  bool data_;
+
+ public:
+  explicit simdMask(const bool &m) : data_(m) {}
+  bool Native() const { return data_; }
+  friend simdMask operator&&(const simdMask &a, const simdMask &b) {
+    return simdMask(a.data_ && b.data_);
+  }
+  friend simdMask operator||(const simdMask &a, const simdMask &b) {
+    return simdMask(a.data_ || b.data_);
+  }
+};
+
+class simdDouble {
+  double data_;
+
+ public:
+  static constexpr int width = 1;
+
+  // constructors
+  simdDouble() : data_(0.0) {}
+  simdDouble(const double &val) : data_(val) {}
+
+  // member functions
+  static simdDouble Load(const double *ptr) { return simdDouble(*ptr); }
+  void Store(double *ptr) const { *ptr = data_; }
+  double Native() const { return data_; }
+
+  friend simdDouble operator+(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(a.data_ + b.data_);
+  }
+  friend simdDouble operator-(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(a.data_ - b.data_);
+  }
+  friend simdDouble operator*(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(a.data_ * b.data_);
+  }
+  friend simdDouble operator/(const simdDouble &a, const simdDouble &b) {
+    return simdDouble(a.data_ / b.data_);
+  }
+  friend simdMask operator<(const simdDouble &a, const simdDouble &b) {
+    return simdMask(a.data_ < b.data_);
+  }
+  friend simdMask operator<=(const simdDouble &a, const simdDouble &b) {
+    return simdMask(a.data_ <= b.data_);
+  }
+  friend simdMask operator>(const simdDouble &a, const simdDouble &b) {
+    return simdMask(a.data_ > b.data_);
+  }
+  friend simdMask operator>=(const simdDouble &a, const simdDouble &b) {
+    return simdMask(a.data_ >= b.data_);
+  }
+};
+
+inline simdDouble Sqrt(const simdDouble &a) {
+  return simdDouble(sqrt(a.Native()));
+}
+inline simdDouble Min(const simdDouble &a, const simdDouble &b) {
+  return simdDouble(std::min(a.Native(), b.Native()));
+}
+inline simdDouble Max(const simdDouble &a, const simdDouble &b) {
+  return simdDouble(std::max(a.Native(), b.Native()));
+}
+// select a where mask is true, and b otherwise
+inline simdDouble Select(const simdMask &m, const simdDouble &a,
+                         const simdDouble &b) {
+  return m.Native() ? a : b;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+// operations common to all implementations
+inline simdDouble operator-(const simdDouble &a) { return 0.0 - a; }
+inline simdDouble & operator+=(simdDouble &a, const simdDouble &b) {
+  return a = a + b;
+}
+inline simdDouble & operator-=(simdDouble &a, const simdDouble &b) {
+  return a = a - b;
+}
+inline simdDouble & operator*=(simdDouble &a, const simdDouble &b) {
+  return a = a * b;
+}
+inline simdDouble Abs(const simdDouble &a) { return Max(a, -a); }
+
+#endif
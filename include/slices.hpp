@@ -73,6 +73,9 @@ class geomSlice {
   int NumK() const { return vol_.NumK(); }
   int GhostLayers() const { return vol_.GhostLayers(); }
   int ParentBlock() const { return parBlock_; }
+  int PackSize() const;
+  void PackGeomSlice(char *(&), const int &, int &) const;
+  void UnpackGeomSlice(char *(&), const int &, int &);
 
   double Vol(const int &ii, const int &jj, const int &kk) const {
     return vol_(ii, jj, kk);
@@ -28,6 +28,7 @@
 #include "macros.hpp"
 #include "vector3d.hpp"
 #include "tensor.hpp"
+#include "matrix.hpp"
 
 using std::cout;
 using std::endl;
@@ -39,7 +40,6 @@ using std::unique_ptr;
 class primVars;
 class turbModel;
 class transport;
-class squareMatrix;
 
 class source {
   double data_[NUMVARS];  // source variables at cell center
@@ -20,6 +20,7 @@
 // This header file contains the thermodynamic model classes
 #include <iostream>
 #include <cmath>
+#include "monotoneCubicTable.hpp"
 
 using std::cout;
 using std::cerr;
@@ -55,7 +56,9 @@ class thermodynamic {
 
 // thermodynamic model for calorically perfect gas.
 // Cp and Cv are constants
-class caloricallyPerfect : public thermodynamic {
+// the concrete models are final so that calls through a reference of the
+// concrete type are statically dispatched and can be inlined
+class caloricallyPerfect final : public thermodynamic {
   const double gamma_;
 
  public:
@@ -83,7 +86,10 @@ class caloricallyPerfect : public thermodynamic {
 
   double SpecEnergy(const double& t) const override {return this->Cv(t) * t;}
   double SpecEnthalpy(const double& t) const override {return this->Cp(t) * t;}
-  double TemperatureFromSpecEnergy(const double& e) const override;
+  double TemperatureFromSpecEnergy(const double& e) const override {
+    const auto t = 1.0;  // cpg has constant Cv, so value of t is meaningless
+    return e / this->Cv(t);
+  }
 
   // Destructor
   ~caloricallyPerfect() noexcept {}
@@ -91,18 +97,31 @@ class caloricallyPerfect : public thermodynamic {
 
 // thermodynamic model for thermally perfect gas
 // Cp and Cv are functions of T
-class thermallyPerfect : public thermodynamic {
+// T(e) and Cv(T) can be tabulated to avoid root finding and transcendental
+// function evaluations in the cell loops; outside of the tables, or if they
+// are not built, the functions are evaluated directly
+class thermallyPerfect final : public thermodynamic {
   const double n_;
   const double vibTemp_;
   const double nonDimR_;
+  monotoneCubicTable tFromE_;  // temperature as a function of energy
+  monotoneCubicTable cv_;  // Cv as a function of temperature
+  int newtonIterations_;  // Newton iterations to polish tabulated T(e)
 
   // private member functions
   double ThetaV(const double& t) const { return vibTemp_ / (2.0 * t); }
+  double CvExact(const double& t) const {
+    const auto tv = this->ThetaV(t);
+    return nonDimR_ * (n_ + pow(tv / sinh(tv), 2.0));
+  }
+  double CvDerivative(const double& t) const;
+  double TemperatureFromSpecEnergyRoot(const double& e) const;
+  double TemperatureFromSpecEnergyNewton(const double& e, double t) const;
 
  public:
   // Constructor
   thermallyPerfect(const double& n, const double& vt)
-      : n_(n), vibTemp_(vt), nonDimR_(n / (n + 1.0)) {}
+      : n_(n), vibTemp_(vt), nonDimR_(n / (n + 1.0)), newtonIterations_(0) {}
   thermallyPerfect() : thermallyPerfect(1.4, 3056.0) {}
 
   // move constructor and assignment operator
@@ -114,6 +133,9 @@ class thermallyPerfect : public thermodynamic {
   thermallyPerfect& operator=(const thermallyPerfect&) = default;
 
   // Member functions
+  void BuildTables(const double&, const double&, const double&, const int&);
+  int TableIntervals() const { return tFromE_.NumIntervals(); }
+
   double Gamma(const double& t) const override {
     return this->Cp(t) / this->Cv(t);
   }
@@ -121,12 +143,15 @@ class thermallyPerfect : public thermodynamic {
     return (4.0 * this->Gamma(t)) / (9.0 * this->Gamma(t) - 5.0);
   }
   double Cp(const double& t) const override {
+    // Cp - Cv = R for a thermally perfect gas
+    if (cv_.InRange(t)) {
+      return cv_.Value(t) + nonDimR_;
+    }
     const auto tv = this->ThetaV(t);
     return nonDimR_ * ((n_ + 1.0) + pow(tv / sinh(tv), 2.0));
   }
   double Cv(const double& t) const override {
-    const auto tv = this->ThetaV(t);
-    return nonDimR_ * (n_ + pow(tv / sinh(tv), 2.0));
+    return cv_.InRange(t) ? cv_.Value(t) : this->CvExact(t);
   }
 
   double SpecEnergy(const double& t) const override {
@@ -135,8 +160,17 @@ class thermallyPerfect : public thermodynamic {
   double SpecEnthalpy(const double& t) const override {
     return nonDimR_ * ((n_ + 1) * t + vibTemp_ / (exp(vibTemp_ / t) - 1.0));
   }
-  
-  double TemperatureFromSpecEnergy(const double& e) const override;
+
+  double TemperatureFromSpecEnergy(const double& e) const override {
+    if (!tFromE_.InRange(e)) {
+      return this->TemperatureFromSpecEnergyRoot(e);
+    }
+    auto t = tFromE_.Value(e);
+    for (auto ii = 0; ii < newtonIterations_; ++ii) {
+      t -= (this->SpecEnergy(t) - e) / this->Cv(t);
+    }
+    return t;
+  }
 
   // Destructor
   ~thermallyPerfect() noexcept {}
@@ -66,7 +66,7 @@ class transport {
 
 
 // this class models viscous transport using Sutherland's law
-class sutherland : public transport {
+class sutherland final : public transport {
   const double cOne_;
   const double S_;
   const double tRef_;
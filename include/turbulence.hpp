@@ -27,6 +27,7 @@
 #include <algorithm>
 #include "vector3d.hpp"  // vector3d
 #include "tensor.hpp"  // tensor
+#include "matrix.hpp"  // squareMatrix
 
 using std::string;
 using std::unique_ptr;
@@ -34,7 +35,6 @@ using std::unique_ptr;
 // forward class declaration
 class primVars;
 class transport;
-class squareMatrix;
 
 class turbModel {
   const string eddyViscMethod_;
@@ -21,14 +21,17 @@
 #include <vector>                  // vector
 #include <memory>
 #include <cmath>
+#include <functional>              // function
 #include "mpi.h"                   // parallelism
 #include "vector3d.hpp"            // vector3d
 #include "multiArray3d.hpp"        // multiArray3d
 #include "tensor.hpp"              // tensor
+#include "reconCoeffs.hpp"         // central4thCoeffs
 #include "macros.hpp"
 
 using std::vector;
 using std::unique_ptr;
+using std::function;
 
 // forward class declarations
 class procBlock;
@@ -38,10 +41,11 @@ class thermodynamic;
 class input;
 class genArray;
 class turbModel;
-class fluxJacobian;
+class implicitDiagonal;
 class kdtree;
 class resid;
 class primVars;
+class haloExchange;
 
 // function definitions
 template <typename T>
@@ -49,6 +53,9 @@ inline T FaceReconCentral(const T &, const T &, const vector<double> &);
 template <typename T>
 inline T FaceReconCentral4th(const T &, const T &, const T &, const T&,
                              const vector<double> &);
+template <typename T>
+inline T FaceReconCentral4th(const T &, const T &, const T &, const T&,
+                             const central4thCoeffs &);
 
 tensor<double> VectorGradGG(const vector3d<double> &, const vector3d<double> &,
                             const vector3d<double> &, const vector3d<double> &,
@@ -66,15 +73,19 @@ vector3d<double> ScalarGradGG(
     const vector3d<double> &, const double &);
 
 void SwapGeomSlice(connection &, procBlock &, procBlock &);
+void SwapGeomSlices(vector<connection> &, vector<procBlock> &, const int &,
+                    const int &);
 
 void GetBoundaryConditions(vector<procBlock> &, const input &,
                            const unique_ptr<eos> &,
                            const unique_ptr<thermodynamic> &,
                            const unique_ptr<transport> &,
-                           const unique_ptr<turbModel> &, vector<connection> &,
-                           const int &, const MPI_Datatype &);
+                           const unique_ptr<turbModel> &, haloExchange &,
+                           const function<void()> &);
 
 vector<vector3d<double>> GetViscousFaceCenters(const vector<procBlock> &);
+vector<vector3d<double>> GatherViscousFaceCenters(const vector<procBlock> &,
+                                                  const int &);
 void CalcWallDistance(vector<procBlock> &, const kdtree &);
 
 void AssignSolToTimeN(vector<procBlock> &, const unique_ptr<eos> &,
@@ -86,31 +97,25 @@ void ExplicitUpdate(vector<procBlock> &, const input &, const unique_ptr<eos> &,
                     const unique_ptr<transport> &,
                     const unique_ptr<turbModel> &, const int &, genArray &,
                     resid &);
-double ImplicitUpdate(vector<procBlock> &, vector<multiArray3d<fluxJacobian>> &,
+double ImplicitUpdate(vector<procBlock> &, vector<implicitDiagonal> &,
                       const input &, const unique_ptr<eos> &,
                       const unique_ptr<thermodynamic> &,
                       const unique_ptr<transport> &,
                       const unique_ptr<turbModel> &, const int &, genArray &,
-                      resid &, const vector<connection> &, const int &,
-                      const MPI_Datatype &);
-
-void SwapImplicitUpdate(vector<multiArray3d<genArray>> &,
-                        const vector<connection> &, const int &,
-                        const MPI_Datatype &, const int &);
-void SwapTurbVars(vector<procBlock> &, const vector<connection> &, const int &,
-                  const int &);
-void SwapWallDist(vector<procBlock> &, const vector<connection> &, const int &,
-                  const int &);
-void SwapEddyViscAndGradients(vector<procBlock> &, const vector<connection> &,
-                              const int &, const MPI_Datatype &,
-                              const MPI_Datatype &, const int &);
-
-void CalcResidual(vector<procBlock> &, vector<multiArray3d<fluxJacobian>> &,
+                      resid &, haloExchange &);
+
+void CombineResiduals(const vector<genArray> &, const vector<resid> &,
+                      genArray &, resid &);
+void SwapImplicitUpdate(vector<multiArray3d<genArray>> &, haloExchange &);
+void SwapWallDist(vector<procBlock> &, haloExchange &);
+void SwapEddyViscAndGradients(vector<procBlock> &, const input &,
+                              haloExchange &);
+
+void CalcResidual(vector<procBlock> &, vector<implicitDiagonal> &,
                   const unique_ptr<transport> &,
                   const unique_ptr<thermodynamic> &, const unique_ptr<eos> &,
                   const input &, const unique_ptr<turbModel> &,
-                  const vector<connection> &, const int &, const MPI_Datatype &,
-                  const MPI_Datatype &);
+                  haloExchange &);
 
 void CalcTimeStep(vector<procBlock> &, const input &);
 
@@ -118,11 +123,9 @@ void CalcTimeStep(vector<procBlock> &, const input &);
 //                    const vector<multiArray3d<genArray>> &,
 //                    const unique_ptr<eos> &, const input &, const int &);
 
-// function to reorder block by hyperplanes
-vector<vector3d<int>> HyperplaneReorder(const int &, const int &, const int &);
-
 void ResizeArrays(const vector<procBlock> &, const input &,
-                  vector<multiArray3d<fluxJacobian>> &);
+                  vector<implicitDiagonal> &);
+void AllocateOffDiagonals(vector<procBlock> &, const input &, const int &);
 
 vector3d<double> TauNormal(const tensor<double> &, const vector3d<double> &,
                            const double &, const double &,
@@ -157,6 +160,10 @@ tensor<double> CalcVelGradTSL(const primVars&, const primVars&,
 kdtree CalcTreeFromCloud(const string &, const input &,
                          const unique_ptr<transport> &, vector<primVars> &);
 
+int MaxThreads();
+int ThreadNum();
+void ThreadRange(const int &, const int &, int &, int &);
+
 // ---------------------------------------------------------------------------
 // inline function definitions
 
@@ -188,9 +195,24 @@ T FaceReconCentral4th(const T &varU2, const T &varU1, const T &varD1,
   // cellWidth -- width of cells in stencil
 
   // get coefficients
-  const auto coeffs = LagrangeCoeff(cellWidth, 3, 1, 1);
+  const central4thCoeffs coeffs(cellWidth[0], cellWidth[1], cellWidth[2],
+                                cellWidth[3]);
 
   // reconstruct with central difference
+  return FaceReconCentral4th(varU2, varU1, varD1, varD2, coeffs);
+}
+
+// function to reconstruct cell variables to the face using central
+// differences (4th order) with precalculated coefficients
+template <typename T>
+T FaceReconCentral4th(const T &varU2, const T &varU1, const T &varD1,
+                      const T &varD2, const central4thCoeffs &coeffs) {
+  // varU2 -- variable at the cell center of the second upwind cell
+  // varU1 -- variable at the cell center of the first upwind cell
+  // varD1 -- variable at the cell center of the first downwind cell
+  // varD2 -- variable at the cell center of the second downwind cell
+  // coeffs -- reconstruction coefficients
+
   return coeffs[0] * varU2 + coeffs[1] * varU1 + coeffs[2] * varD1 +
       coeffs[3] * varD2;
 }
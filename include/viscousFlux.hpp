@@ -36,7 +36,6 @@ class eos;
 class transport;
 class thermodynamic;
 class turbModel;
-class squareMatrix;
 struct wallVars;
 
 class viscousFlux {
@@ -0,0 +1,118 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <cstdint>  // uint32_t, uint64_t
+#include <cstring>  // memcpy
+#include <array>    // array
+#include <vector>   // vector
+#include "codec.hpp"
+
+using std::vector;
+using std::array;
+
+// function to find the CRC-32 of a buffer; a running checksum can be passed in
+// to continue the checksum of earlier data
+uint32_t Crc32(const char *data, const size_t &size, uint32_t crc) {
+  // data -- bytes to find checksum of
+  // size -- number of bytes
+  // crc -- checksum of data that came before this
+
+  // table of checksums of each byte value (reflected polynomial 0xEDB88320)
+  static const auto table = [] {
+    array<uint32_t, 256> tab;
+    for (auto nn = 0U; nn < tab.size(); ++nn) {
+      auto cc = nn;
+      for (auto bb = 0; bb < 8; ++bb) {
+        cc = (cc & 1U) ? 0xEDB88320U ^ (cc >> 1) : cc >> 1;
+      }
+      tab[nn] = cc;
+    }
+    return tab;
+  }();
+
+  crc = ~crc;
+  for (size_t ii = 0; ii < size; ++ii) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[ii])) & 0xFFU] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+// function to compress an array of doubles; each value is XORed with the one
+// before it and only the bytes up to the highest nonzero byte are kept
+vector<char> CompressDoubles(const double *vals, const size_t &num) {
+  // vals -- values to compress
+  // num -- number of values
+
+  vector<char> packed;
+  packed.reserve(num * sizeof(double) + (num + 1) / 2);
+  uint64_t prev = 0;
+  for (size_t ii = 0; ii < num; ii += 2) {
+    // control byte holds the number of bytes stored for this pair of values
+    const auto control = packed.size();
+    packed.push_back(0);
+    auto counts = 0U;
+    for (size_t pp = 0; pp < 2 && ii + pp < num; ++pp) {
+      uint64_t bits;
+      std::memcpy(&bits, vals + ii + pp, sizeof(bits));
+      auto diff = bits ^ prev;
+      prev = bits;
+
+      // store low bytes first until the rest are zero
+      auto numBytes = 0U;
+      while (diff != 0) {
+        packed.push_back(static_cast<char>(diff & 0xFFU));
+        diff >>= 8;
+        numBytes++;
+      }
+      counts |= numBytes << (4 * pp);
+    }
+    packed[control] = static_cast<char>(counts);
+  }
+  return packed;
+}
+
+// function to decompress an array of doubles compressed with CompressDoubles;
+// returns false if the data does not hold the expected number of values
+bool DecompressDoubles(const char *packed, const size_t &size, double *vals,
+                       const size_t &num) {
+  // packed -- compressed data
+  // size -- number of bytes of compressed data
+  // vals -- values to decompress into
+  // num -- number of values expected
+
+  size_t pos = 0;
+  uint64_t prev = 0;
+  for (size_t ii = 0; ii < num; ii += 2) {
+    if (pos >= size) {
+      return false;
+    }
+    const auto counts = static_cast<uint8_t>(packed[pos++]);
+    for (size_t pp = 0; pp < 2 && ii + pp < num; ++pp) {
+      const auto numBytes = (counts >> (4 * pp)) & 0xFU;
+      if (numBytes > sizeof(uint64_t) || pos + numBytes > size) {
+        return false;
+      }
+      uint64_t diff = 0;
+      for (auto bb = 0U; bb < numBytes; ++bb) {
+        diff |= static_cast<uint64_t>(static_cast<uint8_t>(packed[pos++]))
+                << (8 * bb);
+      }
+      prev ^= diff;
+      std::memcpy(vals + ii + pp, &prev, sizeof(prev));
+    }
+  }
+  return pos == size;
+}
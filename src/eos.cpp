@@ -25,42 +25,6 @@ using std::cerr;
 // Member functions for idealGas class
 // These functions calculate values using the ideal gas equation of state
 // P = rho * R * T
-double idealGas::PressFromEnergy(const unique_ptr<thermodynamic> &thermo,
-                                 const double &rho, const double &energy,
-                                 const double &vel) const {
-  const auto specEnergy = energy - 0.5 * vel *vel;
-  const auto temperature = thermo->TemperatureFromSpecEnergy(specEnergy);
-  return this->PressureRT(rho, temperature);
-}
-
-double idealGas::PressureRT(const double &rho,
-                            const double &temperature) const {
-  return temperature * rho / gammaRef_;
-}
-
-double idealGas::SpecEnergy(const unique_ptr<thermodynamic> &thermo,
-                            const double &t) const {
-  return thermo->SpecEnergy(t);
-}
-
-double idealGas::Energy(const double &specEn, const double &vel) const {
-  return specEn + 0.5 * vel * vel;
-}
-
-double idealGas::Enthalpy(const unique_ptr<thermodynamic> &thermo,
-                          const double &t, const double &vel) const {
-  return thermo->SpecEnthalpy(t) + 0.5 * vel * vel;
-}
-
-double idealGas::SoS(const double &pressure, const double &rho) const {
-  return sqrt(gammaRef_ * pressure / rho);
-}
-
-double idealGas::Temperature(const double &pressure,
-                             const double &rho) const {
-  return pressure * gammaRef_ / rho;
-}
-
 double idealGas::PressureDim(const double &rho,
                              const double &temperature) const {
   return rho * gasConst_ * temperature;
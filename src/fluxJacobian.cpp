@@ -43,14 +43,14 @@ fluxJacobian::fluxJacobian(const double &flow, const double &turb) {
   flowJacobian_ = squareMatrix(1);
   flowJacobian_ += flow;
 
-  turbJacobian_ = squareMatrix(1);
+  turbJacobian_ = turbSquareMatrix(1);
   turbJacobian_ += turb;
 }
 
 // if constructed with two intss, create scalar squareMatrix with given size
 fluxJacobian::fluxJacobian(const int &flowSize, const int &turbSize) {
   flowJacobian_ = squareMatrix(flowSize);
-  turbJacobian_ = squareMatrix(turbSize);
+  turbJacobian_ = turbSquareMatrix(turbSize);
 }
 
 
@@ -77,12 +77,32 @@ bool fluxJacobian::IsScalar() const {
   return (flowJacobian_.Size() > 1) ? false : true;
 }
 
-// function to take the inverse of a flux jacobian
-void fluxJacobian::Inverse(const bool &isRANS) {
-  flowJacobian_.Inverse();
+// member function to solve the system given by the flux jacobians with a
+// genArray as the right hand side; the jacobians must have been factored
+genArray fluxJacobian::Solve(genArray arr) const {
+  if (this->IsScalar()) {
+    // factored scalar holds reciprocal
+    arr[0] *= flowJacobian_(0, 0);
+    arr[1] *= flowJacobian_(0, 0);
+    arr[2] *= flowJacobian_(0, 0);
+    arr[3] *= flowJacobian_(0, 0);
+    arr[4] *= flowJacobian_(0, 0);
+
+    arr[5] *= turbJacobian_(0, 0);
+    arr[6] *= turbJacobian_(0, 0);
+  } else {
+    arr = flowJacobian_.Solve(arr);
+    arr = turbJacobian_.Solve(arr, flowJacobian_.Size());
+  }
+  return arr;
+}
+
+// function to factor a flux jacobian so that it can be used in Solve
+void fluxJacobian::Factor(const bool &isRANS) {
+  flowJacobian_.Factor();
 
   if (isRANS) {
-    turbJacobian_.Inverse();
+    turbJacobian_.Factor();
   }
 }
 
@@ -157,7 +177,7 @@ void fluxJacobian::InvFluxJacobian(const primVars &state,
 
   // begin jacobian calculation
   flowJacobian_ = squareMatrix(inp.NumFlowEquations());
-  turbJacobian_ = squareMatrix(inp.NumTurbEquations());
+  turbJacobian_ = turbSquareMatrix(inp.NumTurbEquations());
 
   // calculate flux derivatives wrt left state
   // column zero
@@ -270,7 +290,7 @@ void fluxJacobian::DelPrimativeDelConservative(
   const auto invRho = 1.0 / state.Rho();
 
   flowJacobian_ = squareMatrix(inp.NumFlowEquations());
-  turbJacobian_ = squareMatrix(inp.NumTurbEquations());
+  turbJacobian_ = turbSquareMatrix(inp.NumTurbEquations());
 
   // assign column 0
   flowJacobian_(0, 0) = 1.0;
@@ -326,7 +346,7 @@ void fluxJacobian::ApproxTSLJacobian(const primVars &state,
   // vGrad -- velocity gradient
 
   flowJacobian_ = squareMatrix(inp.NumFlowEquations());
-  turbJacobian_ = squareMatrix(inp.NumTurbEquations());
+  turbJacobian_ = turbSquareMatrix(inp.NumTurbEquations());
 
   const auto t = state.Temperature(eqnState);
   const auto mu = trans->NondimScaling() * lamVisc;
@@ -399,17 +419,19 @@ ostream &operator<<(ostream &os, const fluxJacobian &jacobian) {
   return os;
 }
 
-genArray RusanovScalarOffDiagonal(const primVars &state, const genArray &update,
-                                  const unitVec3dMag<double> &fArea,
-                                  const double &mu, const double &mut,
-                                  const double &f1, const double &dist,
-                                  const unique_ptr<eos> &eqnState,
-                                  const unique_ptr<thermodynamic> &thermo,
-                                  const unique_ptr<transport> &trans,
-                                  const unique_ptr<turbModel> &turb,
-                                  const bool &isViscous, const bool &positive) {
+// function to calculate the spectral radius used in the scalar Rusanov off
+// diagonal contribution
+uncoupledScalar RusanovScalarSpecRad(const primVars &state,
+                                     const unitVec3dMag<double> &fArea,
+                                     const double &mu, const double &mut,
+                                     const double &f1, const double &dist,
+                                     const unique_ptr<eos> &eqnState,
+                                     const unique_ptr<thermodynamic> &thermo,
+                                     const unique_ptr<transport> &trans,
+                                     const unique_ptr<turbModel> &turb,
+                                     const bool &isViscous,
+                                     const bool &positive) {
   // state -- primative variables at off diagonal
-  // update -- conserved variable update at off diagonal
   // fArea -- face area vector on off diagonal boundary
   // mu -- laminar viscosity
   // mut -- turbulent viscosity
@@ -422,6 +444,30 @@ genArray RusanovScalarOffDiagonal(const primVars &state, const genArray &update,
   // isViscous -- flag to determine if simulation is viscous
   // positive -- flag to determine whether to add or subtract dissipation
 
+  // can't use stored cell spectral radius b/c it has contributions from i, j, k
+  return uncoupledScalar(
+      state.FaceSpectralRadius(fArea, thermo, eqnState, trans, dist, mu, mut,
+                               turb, isViscous),
+      turb->FaceSpectralRadius(state, fArea, mu, trans, dist, mut, f1,
+                               positive));
+}
+
+genArray RusanovScalarOffDiagonal(const primVars &state, const genArray &update,
+                                  const unitVec3dMag<double> &fArea,
+                                  const uncoupledScalar &specRad,
+                                  const unique_ptr<eos> &eqnState,
+                                  const unique_ptr<thermodynamic> &thermo,
+                                  const unique_ptr<turbModel> &turb,
+                                  const bool &positive) {
+  // state -- primative variables at off diagonal
+  // update -- conserved variable update at off diagonal
+  // fArea -- face area vector on off diagonal boundary
+  // specRad -- face spectral radius from RusanovScalarSpecRad
+  // eos -- equation of state
+  // thermo -- thermodynamic model
+  // turb -- turbulence model
+  // positive -- flag to determine whether to add or subtract dissipation
+
   // calculate updated state
   const auto stateUpdate =
       state.UpdateWithConsVars(eqnState, thermo, update, turb);
@@ -434,27 +480,18 @@ genArray RusanovScalarOffDiagonal(const primVars &state, const genArray &update,
   fluxChange[5] = 0.0;
   fluxChange[6] = 0.0;
 
-  // can't use stored cell spectral radius b/c it has contributions from i, j, k
-  const uncoupledScalar specRad(
-      state.FaceSpectralRadius(fArea, thermo, eqnState, trans, dist, mu, mut,
-                               turb, isViscous),
-      turb->FaceSpectralRadius(state, fArea, mu, trans, dist, mut, f1,
-                               positive));
-
   return positive ?
     fluxChange + specRad.ArrayMult(update) :
     fluxChange - specRad.ArrayMult(update);
 }
 
-genArray RusanovBlockOffDiagonal(
-    const primVars &state, const genArray &update,
-    const unitVec3dMag<double> &fArea, const double &mu, const double &mut,
-    const double &f1, const double &dist, const unique_ptr<eos> &eqnState,
-    const unique_ptr<thermodynamic> &thermo, const unique_ptr<transport> &trans,
-    const unique_ptr<turbModel> &turb, const input &inp, const bool &positive,
-    const tensor<double> &vGrad) {
+fluxJacobian RusanovBlockJacobian(
+    const primVars &state, const unitVec3dMag<double> &fArea, const double &mu,
+    const double &mut, const double &f1, const double &dist,
+    const unique_ptr<eos> &eqnState, const unique_ptr<thermodynamic> &thermo,
+    const unique_ptr<transport> &trans, const unique_ptr<turbModel> &turb,
+    const input &inp, const bool &positive, const tensor<double> &vGrad) {
   // state -- primative variables at off diagonal
-  // update -- conserved variable update at off diagonal
   // fArea -- face area vector on off diagonal boundary
   // mu -- laminar viscosity
   // mut -- turbulent viscosity
@@ -481,7 +518,87 @@ genArray RusanovBlockOffDiagonal(
                               fArea, dist, turb, inp, positive, vGrad);
     positive ? jacobian -= viscJac : jacobian += viscJac;
   }
-  return jacobian.ArrayMult(update);
+  return jacobian;
+}
+
+// function to determine if the off diagonal contributions are calculated with
+// a block jacobian, or with the flux change and a spectral radius
+bool IsBlockOffDiagonal(const input &inp) {
+  // roe method always uses flux change off diagonal
+  return inp.InvFluxJac() == "rusanov" && inp.IsBlockMatrix();
+}
+
+// function to calculate the spectral radius used in the scalar off diagonal
+// contribution; it only depends on the state and geometry, so it can be
+// stored and reused across matrix sweeps
+uncoupledScalar OffDiagonalSpecRad(const primVars &offDiag,
+                                   const unitVec3dMag<double> &fArea,
+                                   const double &mu, const double &mut,
+                                   const double &f1, const double &dist,
+                                   const unique_ptr<eos> &eqnState,
+                                   const unique_ptr<thermodynamic> &thermo,
+                                   const unique_ptr<transport> &trans,
+                                   const unique_ptr<turbModel> &turb,
+                                   const input &inp, const bool &positive) {
+  // offDiag -- primative variables at off diagonal
+  // fArea -- face area vector on off diagonal boundary
+  // mu -- laminar viscosity
+  // mut -- turbulent viscosity
+  // f1 -- first blending coefficient
+  // dist -- distance from cell center to cell center across face on diagonal
+  // eos -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // turb -- turbulence model
+  // input -- input variables
+  // positive -- flag to determine whether to add or subtract dissipation
+
+  if (inp.InvFluxJac() == "rusanov") {
+    return RusanovScalarSpecRad(offDiag, fArea, mu, mut, f1, dist, eqnState,
+                                thermo, trans, turb, inp.IsViscous(),
+                                positive);
+  } else if (inp.InvFluxJac() == "approximateRoe") {
+    return RoeViscousSpecRad(offDiag, fArea, mu, mut, f1, dist, eqnState,
+                             thermo, trans, turb, inp.IsViscous(),
+                             inp.IsRANS());
+  } else {
+    cerr << "ERROR: Error in OffDiagonalSpecRad(), inviscid flux jacobian "
+         << "method of " << inp.InvFluxJac() << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// function to calculate the scalar off diagonal contribution from a spectral
+// radius calculated with OffDiagonalSpecRad
+genArray OffDiagonal(const primVars &offDiag, const primVars &diag,
+                     const genArray &update, const unitVec3dMag<double> &fArea,
+                     const uncoupledScalar &specRad,
+                     const unique_ptr<eos> &eqnState,
+                     const unique_ptr<thermodynamic> &thermo,
+                     const unique_ptr<turbModel> &turb, const input &inp,
+                     const bool &positive) {
+  // offDiag -- primative variables at off diagonal
+  // diag -- primative variables at diagonal
+  // update -- conserved variable update at off diagonal
+  // fArea -- face area vector on off diagonal boundary
+  // specRad -- face spectral radius
+  // eos -- equation of state
+  // thermo -- thermodynamic model
+  // turb -- turbulence model
+  // input -- input variables
+  // positive -- flag to determine whether to add or subtract dissipation
+
+  if (inp.InvFluxJac() == "rusanov") {
+    return RusanovScalarOffDiagonal(offDiag, update, fArea, specRad, eqnState,
+                                    thermo, turb, positive);
+  } else if (inp.InvFluxJac() == "approximateRoe") {
+    return RoeOffDiagonal(offDiag, diag, update, fArea, specRad, eqnState,
+                          thermo, turb, positive);
+  } else {
+    cerr << "ERROR: Error in OffDiagonal(), inviscid flux jacobian method of "
+         << inp.InvFluxJac() << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
 }
 
 genArray OffDiagonal(const primVars &offDiag, const primVars &diag,
@@ -509,59 +626,73 @@ genArray OffDiagonal(const primVars &offDiag, const primVars &diag,
   // input -- input variables
   // positive -- flag to determine whether to add or subtract dissipation
 
-  genArray offDiagonal(0.0);
-
-  if (inp.InvFluxJac() == "rusanov") {
-    if (inp.IsBlockMatrix()) {
-      offDiagonal = RusanovBlockOffDiagonal(offDiag, update, fArea, mu, mut, f1,
-                                            dist, eqnState, thermo, trans, turb,
-                                            inp, positive, vGrad);
-    } else {
-      offDiagonal = RusanovScalarOffDiagonal(offDiag, update, fArea, mu, mut,
-                                             f1, dist, eqnState, thermo, trans,
-                                             turb, inp.IsViscous(), positive);
-    }
-  } else if (inp.InvFluxJac() == "approximateRoe") {
-    // always use flux change off diagonal with roe method
-    offDiagonal = RoeOffDiagonal(offDiag, diag, update, fArea, mu, mut,
-                                 f1, dist, eqnState, thermo, trans, turb,
-                                 inp.IsViscous(), inp.IsRANS(),
-                                 positive);
+  if (IsBlockOffDiagonal(inp)) {
+    return RusanovBlockJacobian(offDiag, fArea, mu, mut, f1, dist, eqnState,
+                                thermo, trans, turb, inp, positive, vGrad)
+        .ArrayMult(update);
   } else {
-    cerr << "ERROR: Error in OffDiagonal(), inviscid flux jacobian method of "
-         << inp.InvFluxJac() << " is not recognized!" << endl;
-    exit(EXIT_FAILURE);
+    const auto specRad = OffDiagonalSpecRad(offDiag, fArea, mu, mut, f1, dist,
+                                            eqnState, thermo, trans, turb, inp,
+                                            positive);
+    return OffDiagonal(offDiag, diag, update, fArea, specRad, eqnState, thermo,
+                       turb, inp, positive);
   }
-
-  return offDiagonal;
 }
 
+// function to calculate the viscous spectral radius used in the Roe off
+// diagonal contribution
+uncoupledScalar RoeViscousSpecRad(const primVars &offDiag,
+                                  const unitVec3dMag<double> &fArea,
+                                  const double &mu, const double &mut,
+                                  const double &f1, const double &dist,
+                                  const unique_ptr<eos> &eqnState,
+                                  const unique_ptr<thermodynamic> &thermo,
+                                  const unique_ptr<transport> &trans,
+                                  const unique_ptr<turbModel> &turb,
+                                  const bool &isViscous, const bool &isRANS) {
+  // offDiag -- primative variables at off diagonal
+  // fArea -- face area vector on off diagonal boundary
+  // mu -- laminar viscosity at off diagonal
+  // mut -- turbulent viscosity at off diagonal
+  // f1 -- first blending coefficient at off diagonal
+  // dist -- distance from cell center to cell center
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // turb -- turbulence model
+  // isViscous -- flag to determine if simulation is viscous
+  // isRANS -- flag to determine if simulation is turbulent
+
+  uncoupledScalar specRad(0.0, 0.0);
+  if (isViscous) {
+    specRad.AddToFlowVariable(
+        offDiag.ViscFaceSpectralRadius(fArea, thermo, eqnState, trans, dist, mu,
+                                        mut, turb));
+
+    if (isRANS) {
+      specRad.AddToTurbVariable(turb->ViscFaceSpecRad(offDiag, fArea, mu, trans,
+                                                      dist, mut, f1));
+    }
+  }
+  return specRad;
+}
 
 genArray RoeOffDiagonal(const primVars &offDiag, const primVars &diag,
                         const genArray &update,
                         const unitVec3dMag<double> &fArea,
-                        const double &mu, const double &mut,
-                        const double &dist, const double &f1,
+                        const uncoupledScalar &specRad,
                         const unique_ptr<eos> &eqnState,
                         const unique_ptr<thermodynamic> &thermo,
-                        const unique_ptr<transport> &trans,
                         const unique_ptr<turbModel> &turb,
-                        const bool &isViscous, const bool &isRANS,
                         const bool &positive) {
   // offDiag -- primative variables at off diagonal
   // diag -- primative variables at diagonal
   // update -- conserved variable update at off diagonal
   // fArea -- face area vector on off diagonal boundary
-  // dist -- distance from cell center to cell center
-  // mu -- laminar viscosity at off diagonal
-  // mut -- turbulent viscosity at off diagonal
-  // f1 -- first blending coefficient at off diagonal
+  // specRad -- viscous face spectral radius from RoeViscousSpecRad
   // eqnState -- equation of state
   // thermo -- thermodynamic model
-  // trans -- viscous transport model
   // turb -- turbulence model
-  // isViscous -- flag to determine if simulation is viscous
-  // isRANS -- flag to determine if simulation is turbulent
   // positive -- flag to determine whether to add or subtract dissipation
 
   // DEBUG -- redo this whole function to not use the flux change and instead
@@ -582,20 +713,8 @@ genArray RoeOffDiagonal(const primVars &offDiag, const primVars &diag,
 
   // don't need 0.5 factor on roe flux because RoeFlux function already does it
   const auto fluxChange = fArea.Mag() * (newFlux - oldFlux).ConvertToGenArray();
-  
-  // add contribution for viscous terms
-  uncoupledScalar specRad(0.0, 0.0);
-  if (isViscous) {
-    specRad.AddToFlowVariable(
-        offDiag.ViscFaceSpectralRadius(fArea, thermo, eqnState, trans, dist, mu,
-                                        mut, turb));
-
-    if (isRANS) {
-      specRad.AddToTurbVariable(turb->ViscFaceSpecRad(offDiag, fArea, mu, trans,
-                                                      dist, mut, f1));
-    }
-  }
 
+  // add contribution for viscous terms
   return positive ? fluxChange + specRad.ArrayMult(update) :
       fluxChange - specRad.ArrayMult(update);
 }
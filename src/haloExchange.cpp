@@ -0,0 +1,347 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <vector>                  // vector
+#include <array>                   // array
+#include <map>                     // map
+#include <algorithm>               // max, min, find
+#include <iostream>                // cerr
+#include <utility>                 // move
+#include "haloExchange.hpp"
+#include "primVars.hpp"            // primVars
+#include "genArray.hpp"            // genArray
+#include "tensor.hpp"              // tensor
+#include "vector3d.hpp"            // vector3d
+
+using std::vector;
+using std::array;
+using std::map;
+using std::max;
+using std::min;
+using std::cerr;
+using std::endl;
+
+// function to get the number of doubles in each cell of a field
+int HaloCellSize(const haloField &field) {
+  switch (field) {
+    case haloField::state:
+      return sizeof(primVars) / sizeof(double);
+    case haloField::update:
+      return sizeof(genArray) / sizeof(double);
+    case haloField::velocityGrad:
+      return sizeof(tensor<double>) / sizeof(double);
+    case haloField::temperatureGrad:
+    case haloField::tkeGrad:
+    case haloField::omegaGrad:
+      return sizeof(vector3d<double>) / sizeof(double);
+    default:  // f1, f2, wall distance, eddy viscosity
+      return 1;
+  }
+}
+
+// function to determine if two boxes of cells overlap
+bool CellsOverlap(const array<int, 6> &a, const array<int, 6> &b) {
+  // a -- first box of cells (is, ie, js, je, ks, ke)
+  // b -- second box of cells (is, ie, js, je, ks, ke)
+  for (auto dd = 0; dd < 3; dd++) {
+    if (max(a[2 * dd], b[2 * dd]) >= min(a[2 * dd + 1], b[2 * dd + 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Constructor to set up the exchange for the connections of a processor. The
+   connections are put into rounds, and the connections with the same
+   neighboring processor in a round are combined into one message. The rounds
+   only depend on the connections, so they are the same on all processors.
+ */
+haloExchange::haloExchange(const vector<connection> &connections,
+                           const int &rank, const int &numGhosts)
+    : connections_(connections),
+      rank_(rank),
+      numGhosts_(numGhosts),
+      round_(connections.size(), 0),
+      connMsg_(connections.size(), -1),
+      connOffset_(connections.size(), 0),
+      active_(-1) {
+  // connections -- all connections in domain
+  // rank -- processor rank
+  // numGhosts -- number of ghost cell layers
+
+  // cells read and written on each side of each connection
+  vector<array<array<int, 6>, 2>> sent(connections_.size());
+  vector<array<array<int, 6>, 2>> recvd(connections_.size());
+
+  // earlier connections of each block (connection index and side)
+  map<int, vector<array<int, 2>>> blockConns;
+
+  auto numRounds = 0;
+  for (auto cc = 0U; cc < connections_.size(); cc++) {
+    const auto &conn = connections_[cc];
+    const int blocks[2] = {conn.BlockFirst(), conn.BlockSecond()};
+    for (auto ss = 0; ss < 2; ss++) {
+      this->SideCells(conn, ss == 0, sent[cc][ss], recvd[cc][ss]);
+    }
+
+    // connection must come after an earlier connection that writes cells it
+    // reads or writes, and can't come before an earlier connection that reads
+    // cells it writes
+    for (auto ss = 0; ss < 2; ss++) {
+      for (const auto &prev : blockConns[blocks[ss]]) {
+        const auto &pc = prev[0];
+        const auto &ps = prev[1];
+        if (CellsOverlap(recvd[pc][ps], sent[cc][ss]) ||
+            CellsOverlap(recvd[pc][ps], recvd[cc][ss])) {
+          round_[cc] = max(round_[cc], round_[pc] + 1);
+        } else if (CellsOverlap(sent[pc][ps], recvd[cc][ss])) {
+          round_[cc] = max(round_[cc], round_[pc]);
+        }
+      }
+    }
+    for (auto ss = 0; ss < 2; ss++) {
+      blockConns[blocks[ss]].push_back({static_cast<int>(cc), ss});
+    }
+    numRounds = max(numRounds, round_[cc] + 1);
+  }
+
+  // group connections on this processor by round, and connections with the
+  // same neighboring processor in a round into a message
+  roundConns_.resize(numRounds);
+  for (auto rr = 0; rr < numRounds; rr++) {
+    map<int, int> peerMsg;
+    for (auto cc = 0U; cc < connections_.size(); cc++) {
+      const auto &conn = connections_[cc];
+      if (round_[cc] != rr ||
+          (conn.RankFirst() != rank_ && conn.RankSecond() != rank_)) {
+        continue;
+      }
+      roundConns_[rr].push_back(cc);
+      if (this->IsLocal(cc)) {
+        continue;
+      }
+
+      const auto peer = (conn.RankFirst() == rank_) ? conn.RankSecond()
+                                                    : conn.RankFirst();
+      if (peerMsg.find(peer) == peerMsg.end()) {
+        peerMsg[peer] = msgPeer_.size();
+        msgPeer_.push_back(peer);
+        msgRound_.push_back(rr);
+        msgCells_.push_back(0);
+      }
+      const auto msg = peerMsg[peer];
+      const auto &box = sent[cc][(conn.RankFirst() == rank_) ? 0 : 1];
+      connMsg_[cc] = msg;
+      connOffset_[cc] = msgCells_[msg];
+      msgCells_[msg] += (box[1] - box[0]) * (box[3] - box[2]) *
+          (box[5] - box[4]);
+    }
+  }
+}
+
+// member function to get the cells that are sent (slice) and the ghost cells
+// that are received on one side of a connection
+void haloExchange::SideCells(const connection &conn, const bool &first,
+                             array<int, 6> &sent, array<int, 6> &recvd) const {
+  // conn -- connection
+  // first -- flag for first side of connection
+  // sent -- box of cells sent (is, ie, js, je, ks, ke)
+  // recvd -- box of ghost cells received (is, ie, js, je, ks, ke)
+
+  if (first) {
+    conn.FirstSliceIndices(sent[0], sent[1], sent[2], sent[3], sent[4],
+                           sent[5], numGhosts_);
+  } else {
+    conn.SecondSliceIndices(sent[0], sent[1], sent[2], sent[3], sent[4],
+                            sent[5], numGhosts_);
+  }
+
+  const auto bnd = first ? conn.BoundaryFirst() : conn.BoundarySecond();
+  const auto surf = first ? conn.ConstSurfaceFirst() : conn.ConstSurfaceSecond();
+  const auto d1Start = first ? conn.Dir1StartFirst() : conn.Dir1StartSecond();
+  const auto d1End = first ? conn.Dir1EndFirst() : conn.Dir1EndSecond();
+  const auto d2Start = first ? conn.Dir2StartFirst() : conn.Dir2StartSecond();
+  const auto d2End = first ? conn.Dir2EndFirst() : conn.Dir2EndSecond();
+
+  // edges that border another connection are not received (see PutSlice)
+  const auto adjS1 = (first ? conn.Dir1StartInterBorderFirst()
+                      : conn.Dir1StartInterBorderSecond()) ? numGhosts_ : 0;
+  const auto adjE1 = (first ? conn.Dir1EndInterBorderFirst()
+                      : conn.Dir1EndInterBorderSecond()) ? numGhosts_ : 0;
+  const auto adjS2 = (first ? conn.Dir2StartInterBorderFirst()
+                      : conn.Dir2StartInterBorderSecond()) ? numGhosts_ : 0;
+  const auto adjE2 = (first ? conn.Dir2EndInterBorderFirst()
+                      : conn.Dir2EndInterBorderSecond()) ? numGhosts_ : 0;
+
+  // direction 3 is normal to boundary (0-i, 1-j, 2-k); directions 1 and 2
+  // follow in cyclic order
+  const auto dir3 = (bnd - 1) / 2;
+  const auto dir1 = (dir3 + 1) % 3;
+  const auto dir2 = (dir3 + 2) % 3;
+
+  recvd[2 * dir3] = (bnd % 2 == 0) ? surf : -numGhosts_;
+  recvd[2 * dir3 + 1] = recvd[2 * dir3] + numGhosts_;
+  recvd[2 * dir1] = d1Start - numGhosts_ + adjS1;
+  recvd[2 * dir1 + 1] = d1End + numGhosts_ - adjE1;
+  recvd[2 * dir2] = d2Start - numGhosts_ + adjS2;
+  recvd[2 * dir2 + 1] = d2End + numGhosts_ - adjE2;
+}
+
+// member function to get the size of the slice sent by the partner block of a
+// connection
+void haloExchange::PartnerSliceSize(const int &cc, int &ni, int &nj,
+                                    int &nk) const {
+  // cc -- connection index
+  // ni -- number of cells in i-direction
+  // nj -- number of cells in j-direction
+  // nk -- number of cells in k-direction
+
+  const auto &conn = connections_[cc];
+  auto is = 0, ie = 0;
+  auto js = 0, je = 0;
+  auto ks = 0, ke = 0;
+  if (rank_ == conn.RankFirst()) {
+    conn.SecondSliceIndices(is, ie, js, je, ks, ke, numGhosts_);
+  } else {
+    conn.FirstSliceIndices(is, ie, js, je, ks, ke, numGhosts_);
+  }
+  ni = ie - is;
+  nj = je - js;
+  nk = ke - ks;
+}
+
+// member function to allocate the buffers and create the persistent requests
+// for a set of fields the first time it is exchanged
+void haloExchange::InitializePacket(haloPacket &pkt) const {
+  // pkt -- packet to initialize; fields must be set
+
+  pkt.cellSize = 0;
+  auto mask = 0;
+  for (const auto &field : pkt.fields) {
+    pkt.fieldOffset.push_back(pkt.cellSize);
+    pkt.cellSize += HaloCellSize(field);
+    mask |= 1 << static_cast<int>(field);
+  }
+  pkt.send.resize(this->NumMessages());
+  pkt.recv.resize(this->NumMessages());
+  pkt.sendReq.resize(this->NumMessages());
+  pkt.recvReq.resize(this->NumMessages());
+  pkt.packed.resize(this->NumMessages());
+
+  for (auto mm = 0; mm < this->NumMessages(); mm++) {
+    // tag is unique for set of fields and round
+    const auto tag = (msgRound_[mm] << static_cast<int>(haloField::numFields))
+        + mask;
+    const auto count = msgCells_[mm] * pkt.cellSize;
+    pkt.send[mm].resize(count);
+    pkt.recv[mm].resize(count);
+    MPI_Send_init(pkt.send[mm].data(), count, MPI_DOUBLE, msgPeer_[mm], tag,
+                  MPI_COMM_WORLD, &pkt.sendReq[mm]);
+    MPI_Recv_init(pkt.recv[mm].data(), count, MPI_DOUBLE, msgPeer_[mm], tag,
+                  MPI_COMM_WORLD, &pkt.recvReq[mm]);
+  }
+}
+
+// member function to get the start of the slice of a field for a connection
+// in the send or receive buffer of the packet being exchanged
+double * haloExchange::FieldBuffer(const haloField &field, const int &cc,
+                                   const int &numCells, const int &cellBytes,
+                                   const bool &send) {
+  // field -- field of slice
+  // cc -- connection index
+  // numCells -- number of cells in slice
+  // cellBytes -- size of field in each cell (bytes)
+  // send -- flag to get send buffer instead of receive buffer
+
+  const auto msg = connMsg_[cc];
+  auto ff = -1;
+  if (active_ >= 0) {
+    const auto &fields = packets_[active_].fields;
+    const auto it = std::find(fields.begin(), fields.end(), field);
+    ff = (it == fields.end()) ? -1 : it - fields.begin();
+  }
+  if (msg < 0 || ff < 0 ||
+      cellBytes != HaloCellSize(field) * static_cast<int>(sizeof(double))) {
+    cerr << "ERROR: Error in haloExchange::FieldBuffer(). Field " <<
+        static_cast<int>(field) << " of connection " << cc <<
+        " does not match exchange." << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // slice of connection holds each field in turn
+  auto &pkt = packets_[active_];
+  const auto offset = connOffset_[cc] * pkt.cellSize +
+      numCells * pkt.fieldOffset[ff];
+  return (send ? pkt.send[msg].data() : pkt.recv[msg].data()) + offset;
+}
+
+// member function to start an exchange of a set of fields by posting all
+// receives
+void haloExchange::Start(const vector<haloField> &fields) {
+  // fields -- fields to exchange together
+
+  if (active_ >= 0 || fields.empty()) {
+    cerr << "ERROR: Error in haloExchange::Start(). Exchange is already in "
+         << "progress or has no fields." << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // find packet for set of fields, or create it if this is the first time
+  // they are exchanged
+  for (auto pp = 0U; pp < packets_.size(); pp++) {
+    if (packets_[pp].fields == fields) {
+      active_ = pp;
+    }
+  }
+  if (active_ < 0) {
+    haloPacket pkt;
+    pkt.fields = fields;
+    this->InitializePacket(pkt);
+    active_ = packets_.size();
+    packets_.push_back(std::move(pkt));
+  }
+
+  auto &pkt = packets_[active_];
+  std::fill(pkt.packed.begin(), pkt.packed.end(), 0);
+  if (this->NumMessages() > 0) {
+    MPI_Startall(this->NumMessages(), pkt.recvReq.data());
+  }
+}
+
+// member function to finish an exchange by waiting for all sends and receives
+// to complete
+void haloExchange::Finish() {
+  auto &pkt = packets_[active_];
+  if (this->NumMessages() > 0) {
+    MPI_Waitall(this->NumMessages(), pkt.sendReq.data(), MPI_STATUSES_IGNORE);
+    MPI_Waitall(this->NumMessages(), pkt.recvReq.data(), MPI_STATUSES_IGNORE);
+  }
+  active_ = -1;
+}
+
+// member function to free the persistent requests; this must be called before
+// MPI_Finalize
+void haloExchange::FreeRequests() {
+  for (auto &pkt : packets_) {
+    for (auto &req : pkt.sendReq) {
+      MPI_Request_free(&req);
+    }
+    for (auto &req : pkt.recvReq) {
+      MPI_Request_free(&req);
+    }
+  }
+  packets_.clear();
+}
@@ -0,0 +1,62 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <vector>   // vector
+#include "hyperplanes.hpp"
+
+using std::vector;
+
+// constructor to order the cells of a block by hyperplane; the cells are
+// bucketed by i+j+k so the cost is linear in the number of cells
+hyperplanes::hyperplanes(const int &imax, const int &jmax, const int &kmax)
+    : hyperplanes() {
+  // imax -- number of cells in i-direction
+  // jmax -- number of cells in j-direction
+  // kmax -- number of cells in k-direction
+
+  if (imax <= 0 || jmax <= 0 || kmax <= 0) {
+    return;
+  }
+
+  // total number of hyperplanes in block
+  const auto numPlanes = imax + jmax + kmax - 2;
+
+  // count cells on each hyperplane; count for hyperplane pp is stored at pp + 1
+  start_.assign(numPlanes + 1, 0);
+  for (auto kk = 0; kk < kmax; kk++) {
+    for (auto jj = 0; jj < jmax; jj++) {
+      for (auto ii = 0; ii < imax; ii++) {
+        start_[ii + jj + kk + 1]++;
+      }
+    }
+  }
+
+  // convert counts to starting index of each hyperplane
+  for (auto pp = 1; pp <= numPlanes; pp++) {
+    start_[pp] += start_[pp - 1];
+  }
+
+  // place each cell in its hyperplane
+  cells_.resize(imax * jmax * kmax);
+  auto next = start_;
+  for (auto kk = 0; kk < kmax; kk++) {
+    for (auto jj = 0; jj < jmax; jj++) {
+      for (auto ii = 0; ii < imax; ii++) {
+        cells_[next[ii + jj + kk]++] = vector3d<int>(ii, jj, kk);
+      }
+    }
+  }
+}
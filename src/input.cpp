@@ -84,12 +84,25 @@ input::input(const string &name, const string &resName) : simName_(name),
                        // stepping is not used
   inviscidFlux_ = "roe";  // default value is roe flux
   decompMethod_ = "cubic";  // default is cubic decomposition
+  startupMethod_ = "root";  // default is to set up all blocks on root
   turbModel_ = "none";  // default turbulence model is none
   thermodynamicModel_ = "caloricallyPerfect";  // default to cpg
   equationOfState_ = "idealGas";  // default to ideal gas
   transportModel_ = "sutherland";  // default to sutherland
+  thermoTableTolerance_ = 1.0e-10;  // default to tabulated tpg properties
+  thermoTableTemperatureMin_ = 10.0;  // default table range in K
+  thermoTableTemperatureMax_ = 30000.0;
+  thermoTableNewtonIterations_ = 0;  // default to no polishing of table
   restartFrequency_ = 0;  // default to not write restarts
+  outputMethod_ = "blocking";  // default to finish writes before continuing
+  restartCompression_ = "none";  // default to uncompressed restart data
   iterationStart_ = 0;  // default to start from iteration zero
+  arrayPadding_ = 0;  // default to no padding of i-lines
+  faceFluxPasses_ = "separate";  // default to separate inviscid/viscous passes
+  viscousGradients_ = "face";  // default to gradients on face control volume
+  numThreads_ = 1;  // default to one thread per processor
+  matrixOffDiagonals_ = "recompute";  // default to recompute every sweep
+  inviscidFluxCheck_ = 0;  // default to no check of line flux kernels
 
   // default to primative variables
   outputVariables_ = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
@@ -110,6 +123,8 @@ input::input(const string &name, const string &resName) : simName_(name),
            "limiter",
            "outputFrequency",
            "restartFrequency",
+           "outputMethod",
+           "restartCompression",
            "equationSet",
            "matrixSolver",
            "matrixSweeps",
@@ -122,15 +137,28 @@ input::input(const string &name, const string &resName) : simName_(name),
            "dualTimeCFL",
            "inviscidFlux",
            "decompositionMethod",
+           "startupMethod",
            "turbulenceModel",
            "thermodynamicModel",
            "equationOfState",
            "transportModel",
+           "thermoTableTolerance",
+           "thermoTableTemperatureMin",
+           "thermoTableTemperatureMax",
+           "thermoTableNewtonIterations",
+           "arrayPadding",
+           "faceFluxPasses",
+           "viscousGradients",
+           "numThreads",
+           "matrixOffDiagonals",
+           "inviscidFluxCheck",
            "outputVariables",
            "wallOutputVariables",
            "initialConditions",
            "boundaryStates",
            "boundaryConditions"};
+
+  this->ResolveOptions();
 }
 
 // function to print the time
@@ -307,6 +335,26 @@ void input::ReadInput(const int &rank) {
           if (rank == ROOTP) {
             cout << key << ": " << this->RestartFrequency() << endl;
           }
+        } else if (key == "outputMethod") {
+          outputMethod_ = tokens[1];
+          if (outputMethod_ != "blocking" && outputMethod_ != "asynchronous") {
+            cerr << "ERROR: outputMethod must be blocking or asynchronous, but "
+                 << outputMethod_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->OutputMethod() << endl;
+          }
+        } else if (key == "restartCompression") {
+          restartCompression_ = tokens[1];
+          if (restartCompression_ != "none" && restartCompression_ != "xor") {
+            cerr << "ERROR: restartCompression must be none or xor, but "
+                 << restartCompression_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->RestartCompression() << endl;
+          }
         } else if (key == "equationSet") {
           equationSet_ = tokens[1];
           if (rank == ROOTP) {
@@ -368,6 +416,16 @@ void input::ReadInput(const int &rank) {
           if (rank == ROOTP) {
             cout << key << ": " << this->DecompMethod() << endl;
           }
+        } else if (key == "startupMethod") {
+          startupMethod_ = tokens[1];
+          if (startupMethod_ != "root" && startupMethod_ != "distributed") {
+            cerr << "ERROR: startupMethod must be root or distributed, but "
+                 << startupMethod_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->StartupMethod() << endl;
+          }
         } else if (key == "turbulenceModel") {
           turbModel_ = tokens[1];
           if (rank == ROOTP) {
@@ -388,6 +446,93 @@ void input::ReadInput(const int &rank) {
           if (rank == ROOTP) {
             cout << key << ": " << this->TransportModel() << endl;
           }
+        } else if (key == "thermoTableTolerance") {
+          thermoTableTolerance_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ThermoTableTolerance() << endl;
+          }
+        } else if (key == "thermoTableTemperatureMin") {
+          thermoTableTemperatureMin_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ThermoTableTemperatureMin() << endl;
+          }
+        } else if (key == "thermoTableTemperatureMax") {
+          thermoTableTemperatureMax_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ThermoTableTemperatureMax() << endl;
+          }
+        } else if (key == "thermoTableNewtonIterations") {
+          thermoTableNewtonIterations_ = stoi(tokens[1]);
+          if (thermoTableNewtonIterations_ < 0) {
+            cerr << "ERROR: thermoTableNewtonIterations must be non-negative, "
+                 << "but " << thermoTableNewtonIterations_ << " was specified."
+                 << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ThermoTableNewtonIterations() << endl;
+          }
+        } else if (key == "arrayPadding") {
+          arrayPadding_ = stoi(tokens[1]);
+          if (arrayPadding_ < 0) {
+            cerr << "ERROR: arrayPadding must be non-negative, but "
+                 << arrayPadding_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ArrayPadding() << endl;
+          }
+        } else if (key == "faceFluxPasses") {
+          faceFluxPasses_ = tokens[1];
+          if (faceFluxPasses_ != "fused" && faceFluxPasses_ != "separate") {
+            cerr << "ERROR: faceFluxPasses must be fused or separate, but "
+                 << faceFluxPasses_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->FaceFluxPasses() << endl;
+          }
+        } else if (key == "viscousGradients") {
+          viscousGradients_ = tokens[1];
+          if (viscousGradients_ != "face" && viscousGradients_ != "cell") {
+            cerr << "ERROR: viscousGradients must be face or cell, but "
+                 << viscousGradients_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ViscousGradients() << endl;
+          }
+        } else if (key == "numThreads") {
+          numThreads_ = stoi(tokens[1]);
+          if (numThreads_ < 1) {
+            cerr << "ERROR: numThreads must be at least 1, but "
+                 << numThreads_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->NumThreads() << endl;
+          }
+        } else if (key == "matrixOffDiagonals") {
+          matrixOffDiagonals_ = tokens[1];
+          if (matrixOffDiagonals_ != "recompute" &&
+              matrixOffDiagonals_ != "stored") {
+            cerr << "ERROR: matrixOffDiagonals must be recompute or stored, "
+                 << "but " << matrixOffDiagonals_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->MatrixOffDiagonals() << endl;
+          }
+        } else if (key == "inviscidFluxCheck") {
+          inviscidFluxCheck_ = stoi(tokens[1]);
+          if (inviscidFluxCheck_ < 0) {
+            cerr << "ERROR: inviscidFluxCheck must be non-negative, but "
+                 << inviscidFluxCheck_ << " was specified." << endl;
+            exit(EXIT_FAILURE);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": " << this->InviscidFluxCheck() << endl;
+          }
         } else if (key == "outputVariables") {
           // clear default variables from set
           outputVariables_.clear();
@@ -527,6 +672,9 @@ void input::ReadInput(const int &rank) {
   }
 
 
+  // resolve string options used in cell and face loops to enumerations
+  this->ResolveOptions();
+
   // input file sanity checks
   this->CheckNonlinearIterations();
   this->CheckOutputVariables();
@@ -571,17 +719,6 @@ int input::NumEquations() const {
   return numEqns;
 }
 
-// member function to determine of method is implicit or explicit
-bool input::IsImplicit() const {
-  if (timeIntegration_ == "implicitEuler" ||
-      timeIntegration_ == "crankNicholson" ||
-      timeIntegration_ == "bdf2") {
-    return true;
-  } else {
-    return false;
-  }
-}
-
 // member function to determine of method is vicous or inviscid
 bool input::IsViscous() const {
   if (equationSet_ == "navierStokes" || this->IsTurbulent()) {
@@ -610,14 +747,98 @@ bool input::IsLES() const {
   return (equationSet_ == "largeEddySimulation") ? true : false;
 }
 
-// member function to determine if solution should use a block matrix
-bool input::IsBlockMatrix() const {
-  if (this->IsImplicit() && (matrixSolver_ == "bdplur" ||
-                             matrixSolver_ == "blusgs")) {
-    return true;
+// member function to convert the string options that are used inside of the
+// cell and face loops to enumerations; this is done once after the input file
+// is read so the solver does not compare strings in its inner loops
+void input::ResolveOptions() {
+  if (this->UsingConstantReconstruction()) {
+    reconstruction_ = reconstruction::constant;
+  } else if (this->UsingMUSCLReconstruction()) {
+    reconstruction_ = reconstruction::muscl;
+  } else if (faceReconstruction_ == "weno") {
+    reconstruction_ = reconstruction::weno;
+  } else if (faceReconstruction_ == "wenoZ") {
+    reconstruction_ = reconstruction::wenoZ;
   } else {
-    return false;
+    cerr << "ERROR: Face reconstruction " << faceReconstruction_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (limiter_ == "none") {
+    limiterType_ = limiterType::none;
+  } else if (limiter_ == "vanAlbada") {
+    limiterType_ = limiterType::vanAlbada;
+  } else if (limiter_ == "minmod") {
+    limiterType_ = limiterType::minmod;
+  } else {
+    cerr << "ERROR: Limiter " << limiter_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (inviscidFlux_ == "roe") {
+    inviscidFluxScheme_ = inviscidFluxScheme::roe;
+  } else if (inviscidFlux_ == "ausm") {
+    inviscidFluxScheme_ = inviscidFluxScheme::ausm;
+  } else {
+    cerr << "ERROR: inviscid flux type " << inviscidFlux_
+         << " is not recognized!" << endl;
+    cerr << "Choose 'roe' or 'ausm'" << endl;
+    exit(EXIT_FAILURE);
   }
+
+  if (timeIntegration_ == "explicitEuler") {
+    timeIntegrator_ = timeIntegrator::explicitEuler;
+  } else if (timeIntegration_ == "rk4") {
+    timeIntegrator_ = timeIntegrator::rk4;
+  } else if (timeIntegration_ == "implicitEuler") {
+    timeIntegrator_ = timeIntegrator::implicitEuler;
+  } else if (timeIntegration_ == "crankNicholson") {
+    timeIntegrator_ = timeIntegrator::crankNicholson;
+  } else if (timeIntegration_ == "bdf2") {
+    timeIntegrator_ = timeIntegrator::bdf2;
+  } else {
+    cerr << "ERROR: Time integration method " << timeIntegration_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (viscousFaceReconstruction_ == "central") {
+    viscousReconstruction_ = viscousReconstruction::central;
+  } else if (viscousFaceReconstruction_ == "centralFourth") {
+    viscousReconstruction_ = viscousReconstruction::centralFourth;
+  } else {
+    cerr << "ERROR: Viscous face reconstruction " << viscousFaceReconstruction_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (faceFluxPasses_ == "separate") {
+    fluxPasses_ = fluxPasses::separate;
+  } else if (faceFluxPasses_ == "fused") {
+    fluxPasses_ = fluxPasses::fused;
+  } else {
+    cerr << "ERROR: Face flux passes " << faceFluxPasses_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (viscousGradients_ == "face") {
+    gradientLocation_ = gradientLocation::face;
+  } else if (viscousGradients_ == "cell") {
+    gradientLocation_ = gradientLocation::cell;
+  } else {
+    cerr << "ERROR: Viscous gradients " << viscousGradients_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  isImplicit_ = timeIntegrator_ == timeIntegrator::implicitEuler ||
+      timeIntegrator_ == timeIntegrator::crankNicholson ||
+      timeIntegrator_ == timeIntegrator::bdf2;
+  isBlockMatrix_ = isImplicit_ && (matrixSolver_ == "bdplur" ||
+                                   matrixSolver_ == "blusgs" ||
+                                   matrixSolver_ == "bmcgs");
 }
 
 string input::OrderOfAccuracy() const {
@@ -706,8 +927,23 @@ unique_ptr<thermodynamic> input::AssignThermodynamicModel() const {
     thermo =
         unique_ptr<thermodynamic>{std::make_unique<caloricallyPerfect>(fl.N())};
   } else if (thermodynamicModel_ == "thermallyPerfect") {
-    thermo = unique_ptr<thermodynamic>{std::make_unique<thermallyPerfect>(
-        fl.N(), fl.VibrationalTemperature())};
+    auto tpg = std::make_unique<thermallyPerfect>(fl.N(),
+                                                  fl.VibrationalTemperature());
+    // tabulate properties over nondimensional temperature range
+    if (thermoTableTolerance_ > 0.0) {
+      if (thermoTableTemperatureMin_ <= 0.0 ||
+          thermoTableTemperatureMax_ <= thermoTableTemperatureMin_) {
+        cerr << "ERROR: Error in input::AssignThermodynamicModel(). "
+             << "Thermodynamic table temperature range ["
+             << thermoTableTemperatureMin_ << ", "
+             << thermoTableTemperatureMax_ << "] is not valid!" << endl;
+        exit(EXIT_FAILURE);
+      }
+      tpg->BuildTables(thermoTableTemperatureMin_ / tRef_,
+                       thermoTableTemperatureMax_ / tRef_,
+                       thermoTableTolerance_, thermoTableNewtonIterations_);
+    }
+    thermo = unique_ptr<thermodynamic>{std::move(tpg)};
   } else {
     cerr << "ERROR: Error in input::AssignThermodynamicModel(). Thermodynamic "
          << "model " << thermodynamicModel_ << " is not recognized!" << endl;
@@ -877,12 +1113,20 @@ double input::ViscousCFLCoefficient() const {
 }
 
 bool input::MatrixRequiresInitialization() const {
-  // initialize matrix if using DPLUR / BDPLUR, or if using LUSGS / BLUSGS with
-  // more than one sweep
+  // initialize matrix if using DPLUR / BDPLUR or MCGS / BMCGS, or if using
+  // LUSGS / BLUSGS with more than one sweep
   return (matrixSolver_ == "dplur" || matrixSolver_ == "bdplur" ||
+          matrixSolver_ == "mcgs" || matrixSolver_ == "bmcgs" ||
           matrixSweeps_ > 1) ? true : false;
 }
 
+bool input::MatrixUsesHyperplanes() const {
+  // LUSGS / BLUSGS sweep along hyperplanes, and MCGS / BMCGS color cells by
+  // hyperplane
+  return matrixSolver_ == "lusgs" || matrixSolver_ == "blusgs" ||
+      matrixSolver_ == "mcgs" || matrixSolver_ == "bmcgs";
+}
+
 int input::NumberGhostLayers() const {
   auto layers = 0;
   if (this->UsingConstantReconstruction()) {
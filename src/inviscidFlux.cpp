@@ -18,6 +18,10 @@
 #include <string>
 #include <memory>
 #include <algorithm>  // max
+#include <random>     // mt19937
+#include <chrono>     // steady_clock
+#include <cstring>    // memcmp
+#include <iomanip>    // setprecision
 #include "inviscidFlux.hpp"
 #include "eos.hpp"
 #include "thermodynamic.hpp"
@@ -65,9 +69,9 @@ class is not fully defined in the inviscidFlux.hpp header. This way both
 constructors (primVars version and genArray version) can call this function
 to avoid code duplication.
 */
-void inviscidFlux::ConstructFromPrim(const primVars &state,
-                                     const unique_ptr<eos> &eqnState,
-                                     const unique_ptr<thermodynamic> &thermo,
+template <typename E, typename T>
+void inviscidFlux::ConstructFromPrim(const primVars &state, const E &eqnState,
+                                     const T &thermo,
                                      const vector3d<double> &normArea) {
   // state -- primative variables
   // eqnState -- equation of state
@@ -86,17 +90,23 @@ void inviscidFlux::ConstructFromPrim(const primVars &state,
   data_[6] = state.Rho() * velNorm * state.Omega();
 }
 
-inviscidFlux::inviscidFlux(const primVars &state,
-                           const unique_ptr<eos> &eqnState,
-                           const unique_ptr<thermodynamic> &thermo,
-                           const vector3d<double> &normArea) {
+template <typename E, typename T>
+inviscidFlux::inviscidFlux(const primVars &state, const E &eqnState,
+                           const T &thermo, const vector3d<double> &normArea) {
   // state -- primative variables
   // eqnState -- equation of state
+  // thermo -- thermodynamic model
   // normArea -- unit area vector of face
 
   this->ConstructFromPrim(state, eqnState, thermo, normArea);
 }
 
+inviscidFlux::inviscidFlux(const primVars &state,
+                           const unique_ptr<eos> &eqnState,
+                           const unique_ptr<thermodynamic> &thermo,
+                           const vector3d<double> &normArea)
+    : inviscidFlux(state, *eqnState, *thermo, normArea) {}
+
 // constructor -- initialize flux from state vector using conservative variables
 // flux is a 3D flux in the normal direction of the given face
 inviscidFlux::inviscidFlux(const genArray &cons,
@@ -112,7 +122,7 @@ inviscidFlux::inviscidFlux(const genArray &cons,
   // convert conserved variables to primative variables
   const primVars state(cons, false, eqnState, thermo, turb);
 
-  this->ConstructFromPrim(state, eqnState, thermo, normArea);
+  this->ConstructFromPrim(state, *eqnState, *thermo, normArea);
 }
 
 /* Function to calculate inviscid flux using Roe's approximate Riemann solver.
@@ -160,9 +170,9 @@ characteristic waves, L represents the wave speeds, and (Cr - Cl) represents the
 wave strength across the face.
 
 */
+template <typename E, typename T>
 inviscidFlux RoeFlux(const primVars &left, const primVars &right,
-                     const unique_ptr<eos> &eqnState,
-                     const unique_ptr<thermodynamic> &thermo,
+                     const E &eqnState, const T &thermo,
                      const vector3d<double> &areaNorm) {
   // left -- primative variables from left
   // right -- primative variables from right
@@ -292,10 +302,10 @@ inviscidFlux RoeFlux(const primVars &left, const primVars &right,
 
    F = M^+_l * c * F_cl + M^-_r * c * F_cr + P^+_l * P_l + P^-_r * P_r
 */
+template <typename E, typename T>
 inviscidFlux AUSMFlux(const primVars &left, const primVars &right,
-                     const unique_ptr<eos> &eqnState,
-                     const unique_ptr<thermodynamic> &thermo,
-                     const vector3d<double> &area) {
+                      const E &eqnState, const T &thermo,
+                      const vector3d<double> &area) {
   // left -- primative variables from left
   // right -- primative variables from right
   // eqnState -- equation of state
@@ -305,14 +315,14 @@ inviscidFlux AUSMFlux(const primVars &left, const primVars &right,
   // calculate average specific enthalpy on face
   const auto tl = left.Temperature(eqnState);
   const auto tr = right.Temperature(eqnState);
-  const auto hl = thermo->SpecEnthalpy(tl);
-  const auto hr = thermo->SpecEnthalpy(tr);
+  const auto hl = thermo.SpecEnthalpy(tl);
+  const auto hr = thermo.SpecEnthalpy(tr);
   const auto h = 0.5 * (hl + hr);
 
   // calculate c* from Kim, Kim, Rho 1998
   const auto t = 0.5 * (tl + tr);
   const auto sosStar =
-      sqrt(2.0 * h * (thermo->Gamma(t) - 1.0) / (thermo->Gamma(t) + 1.0));
+      sqrt(2.0 * h * (thermo.Gamma(t) - 1.0) / (thermo.Gamma(t) + 1.0));
 
   // calculate left/right mach numbers
   const auto vell = left.Velocity().DotProd(area);
@@ -341,8 +351,8 @@ inviscidFlux AUSMFlux(const primVars &left, const primVars &right,
 
   // calculate pressure weighting terms
   const auto ps = pPlus * left.P() + pMinus * right.P();
-  const auto w =
-      1.0 - pow(std::min(left.P() / right.P(), right.P() / left.P()), 3.0);
+  const auto pRatio = std::min(left.P() / right.P(), right.P() / left.P());
+  const auto w = 1.0 - pRatio * pRatio * pRatio;
   const auto fl = fabs(ml) < 1.0 ? left.P() / ps - 1.0 : 0.0;
   const auto fr = fabs(mr) < 1.0 ? right.P() / ps - 1.0 : 0.0;
 
@@ -361,9 +371,9 @@ inviscidFlux AUSMFlux(const primVars &left, const primVars &right,
   return ausm;
 }
 
+template <typename E, typename T>
 void inviscidFlux::AUSMFlux(const primVars &left, const primVars &right,
-                            const unique_ptr<eos> &eqnState,
-                            const unique_ptr<thermodynamic> &thermo,
+                            const E &eqnState, const T &thermo,
                             const vector3d<double> &area,
                             const double &sos, const double &mPlusLBar,
                             const double &mMinusRBar, const double &pPlus,
@@ -389,22 +399,472 @@ void inviscidFlux::AUSMFlux(const primVars &left, const primVars &right,
   data_[6] += right.Rho() * vr * right.Omega();
 }
 
-inviscidFlux InviscidFlux(const primVars &left, const primVars &right,
-                          const unique_ptr<eos> &eqnState,
-                          const unique_ptr<thermodynamic> &thermo,
-                          const vector3d<double> &area, const string &flux) {
-  inviscidFlux invFlux;
-  if (flux == "roe") {
-    invFlux = RoeFlux(left, right, eqnState, thermo, area);
-  } else if (flux == "ausm") {
-    invFlux = AUSMFlux(left, right, eqnState, thermo, area);
+// versions of the flux functions using the abstract models
+inviscidFlux RoeFlux(const primVars &left, const primVars &right,
+                     const unique_ptr<eos> &eqnState,
+                     const unique_ptr<thermodynamic> &thermo,
+                     const vector3d<double> &areaNorm) {
+  return RoeFlux(left, right, *eqnState, *thermo, areaNorm);
+}
+
+inviscidFlux AUSMFlux(const primVars &left, const primVars &right,
+                      const unique_ptr<eos> &eqnState,
+                      const unique_ptr<thermodynamic> &thermo,
+                      const vector3d<double> &area) {
+  return AUSMFlux(left, right, *eqnState, *thermo, area);
+}
+
+// explicit instantiations of the flux functions for the abstract models and
+// for each combination of concrete models that input can assign
+template inviscidFlux RoeFlux(const primVars &, const primVars &,
+                              const eos &, const thermodynamic &,
+                              const vector3d<double> &);
+template inviscidFlux RoeFlux(const primVars &, const primVars &,
+                              const idealGas &, const caloricallyPerfect &,
+                              const vector3d<double> &);
+template inviscidFlux RoeFlux(const primVars &, const primVars &,
+                              const idealGas &, const thermallyPerfect &,
+                              const vector3d<double> &);
+template inviscidFlux AUSMFlux(const primVars &, const primVars &,
+                               const eos &, const thermodynamic &,
+                               const vector3d<double> &);
+template inviscidFlux AUSMFlux(const primVars &, const primVars &,
+                               const idealGas &, const caloricallyPerfect &,
+                               const vector3d<double> &);
+template inviscidFlux AUSMFlux(const primVars &, const primVars &,
+                               const idealGas &, const thermallyPerfect &,
+                               const vector3d<double> &);
+
+// line versions of the flux functions; the general versions calculate the
+// flux one face at a time
+template <typename E, typename T>
+void RoeFluxLine(const lineArray &left, const lineArray &right,
+                 const lineArray &area, const E &eqnState, const T &thermo,
+                 lineArray &flux) {
+  // left -- primative variables from left for each face in line
+  // right -- primative variables from right for each face in line
+  // area -- unit area vector for each face in line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // flux -- inviscid flux for each face in line
+
+  for (auto ff = 0; ff < left.Length(); ++ff) {
+    flux.Insert(ff, RoeFlux(left.Get<primVars>(ff), right.Get<primVars>(ff),
+                            eqnState, thermo,
+                            area.Get<vector3d<double>>(ff)));
+  }
+}
+
+template <typename E, typename T>
+void AUSMFluxLine(const lineArray &left, const lineArray &right,
+                  const lineArray &area, const E &eqnState, const T &thermo,
+                  lineArray &flux) {
+  // left -- primative variables from left for each face in line
+  // right -- primative variables from right for each face in line
+  // area -- unit area vector for each face in line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // flux -- inviscid flux for each face in line
+
+  for (auto ff = 0; ff < left.Length(); ++ff) {
+    flux.Insert(ff, AUSMFlux(left.Get<primVars>(ff), right.Get<primVars>(ff),
+                             eqnState, thermo,
+                             area.Get<vector3d<double>>(ff)));
+  }
+}
+
+/* Function to calculate the Roe flux for a line of faces for a calorically
+perfect ideal gas. This follows the same steps as RoeFlux, but operates on
+simdDouble::width faces at a time. Gamma and Cp are constant, so the enthalpy
+and speed of sound can be calculated directly from the primative variables.
+*/
+template <>
+void RoeFluxLine(const lineArray &left, const lineArray &right,
+                 const lineArray &area, const idealGas &eqnState,
+                 const caloricallyPerfect &thermo, lineArray &flux) {
+  // left -- primative variables from left for each face in line
+  // right -- primative variables from right for each face in line
+  // area -- unit area vector for each face in line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // flux -- inviscid flux for each face in line
+
+  constexpr auto tRef = 1.0;  // cpg properties do not depend on temperature
+  const simdDouble gammaRef = eqnState.GammaRef();
+  const simdDouble gamma = thermo.Gamma(tRef);
+  const simdDouble cp = thermo.Cp(tRef);
+  constexpr auto entropyFix = 0.1;
+
+  for (auto ff = 0; ff < left.PaddedLength(); ff += simdDouble::width) {
+    simdDouble lt[NUMVARS], rt[NUMVARS];
+    for (auto vv = 0; vv < NUMVARS; ++vv) {
+      lt[vv] = simdDouble::Load(left.Field(vv) + ff);
+      rt[vv] = simdDouble::Load(right.Field(vv) + ff);
+    }
+    const auto nx = simdDouble::Load(area.Field(0) + ff);
+    const auto ny = simdDouble::Load(area.Field(1) + ff);
+    const auto nz = simdDouble::Load(area.Field(2) + ff);
+
+    // total enthalpy
+    auto enthalpy = [&](const simdDouble (&st)[NUMVARS]) {
+      const auto t = st[4] * gammaRef / st[0];
+      const auto vel = Sqrt(st[1] * st[1] + st[2] * st[2] + st[3] * st[3]);
+      return cp * t + 0.5 * vel * vel;
+    };
+
+    // Roe averaged state
+    const auto denRatio = Sqrt(rt[0] / lt[0]);
+    simdDouble roe[NUMVARS];
+    roe[0] = lt[0] * denRatio;
+    for (auto vv = 1; vv < NUMVARS; ++vv) {
+      roe[vv] = (lt[vv] + denRatio * rt[vv]) / (1.0 + denRatio);
+    }
+
+    // Roe averaged total enthalpy and speed of sound
+    const auto hR = enthalpy(roe);
+    const auto aR = Sqrt(gamma * roe[4] / roe[0]);
+
+    // Roe velocity dotted with normalized area vector
+    const auto velRSum = roe[1] * nx + roe[2] * ny + roe[3] * nz;
+
+    // Delta between right and left states
+    simdDouble delta[NUMVARS];
+    for (auto vv = 0; vv < NUMVARS; ++vv) {
+      delta[vv] = rt[vv] - lt[vv];
+    }
+
+    // normal velocity difference between left and right states
+    const auto normVelDiff = delta[1] * nx + delta[2] * ny + delta[3] * nz;
+
+    // calculate wave strengths (Cr - Cl)
+    const auto aR2 = aR * aR;
+    const simdDouble waveStrength[NUMVARS - 1] = {
+      (delta[4] - roe[0] * aR * normVelDiff) / (2.0 * aR * aR),
+      delta[0] - delta[4] / aR2,
+      (delta[4] + roe[0] * aR * normVelDiff) / (2.0 * aR * aR),
+      roe[0],
+      roe[0] * delta[5] + roe[5] * delta[0] - delta[4] * roe[5] / aR2,
+      roe[0] * delta[6] + roe[6] * delta[0] - delta[4] * roe[6] / aR2};
+
+    // calculate absolute value of wave speeds with entropy fix (Harten)
+    auto EntropyFix = [&](const simdDouble &ws) {
+      return Select(ws < entropyFix,
+                    0.5 * (ws * ws / entropyFix + entropyFix), ws);
+    };
+    const auto lAcousticSpeed = EntropyFix(Abs(velRSum - aR));
+    const auto waveSpeed = Abs(velRSum);
+    const auto rAcousticSpeed = EntropyFix(Abs(velRSum + aR));
+
+    // calculate right eigenvectors (T)
+    const simdDouble lAcousticEigV[NUMVARS] = {
+      1.0, roe[1] - aR * nx, roe[2] - aR * ny, roe[3] - aR * nz,
+      hR - aR * velRSum, roe[5], roe[6]};
+    const simdDouble entropyEigV[NUMVARS] = {
+      1.0, roe[1], roe[2], roe[3],
+      0.5 * (roe[1] * roe[1] + roe[2] * roe[2] + roe[3] * roe[3]), 0.0, 0.0};
+    const simdDouble rAcousticEigV[NUMVARS] = {
+      1.0, roe[1] + aR * nx, roe[2] + aR * ny, roe[3] + aR * nz,
+      hR + aR * velRSum, roe[5], roe[6]};
+    const simdDouble shearEigV[NUMVARS] = {
+      0.0, delta[1] - normVelDiff * nx, delta[2] - normVelDiff * ny,
+      delta[3] - normVelDiff * nz,
+      roe[1] * delta[1] + roe[2] * delta[2] + roe[3] * delta[3] -
+      velRSum * normVelDiff, 0.0, 0.0};
+
+    // calculate left/right physical flux
+    const auto hl = enthalpy(lt);
+    const auto hr = enthalpy(rt);
+    const auto massL = lt[0] * (lt[1] * nx + lt[2] * ny + lt[3] * nz);
+    const auto massR = rt[0] * (rt[1] * nx + rt[2] * ny + rt[3] * nz);
+    const simdDouble leftFlux[NUMVARS] = {
+      massL, massL * lt[1] + lt[4] * nx, massL * lt[2] + lt[4] * ny,
+      massL * lt[3] + lt[4] * nz, massL * hl, massL * lt[5], massL * lt[6]};
+    const simdDouble rightFlux[NUMVARS] = {
+      massR, massR * rt[1] + rt[4] * nx, massR * rt[2] + rt[4] * ny,
+      massR * rt[3] + rt[4] * nz, massR * hr, massR * rt[5], massR * rt[6]};
+
+    // calculate numerical Roe flux; the turbulence eigenvectors are unit
+    // vectors, so they only contribute to their own equation
+    for (auto vv = 0; vv < NUMVARS; ++vv) {
+      auto dissipation = lAcousticSpeed * waveStrength[0] * lAcousticEigV[vv] +
+          waveSpeed * waveStrength[1] * entropyEigV[vv] +
+          rAcousticSpeed * waveStrength[2] * rAcousticEigV[vv] +
+          waveSpeed * waveStrength[3] * shearEigV[vv];
+      if (vv >= NUMFLOWVARS) {
+        dissipation += waveSpeed * waveStrength[vv - 1];
+      }
+      (0.5 * (leftFlux[vv] + rightFlux[vv] - dissipation))
+          .Store(flux.Field(vv) + ff);
+    }
+  }
+}
+
+/* Function to calculate the AUSMPW+ flux for a line of faces for a calorically
+perfect ideal gas. This follows the same steps as AUSMFlux, but operates on
+simdDouble::width faces at a time. The branches on the Mach number are
+replaced with selections.
+*/
+template <>
+void AUSMFluxLine(const lineArray &left, const lineArray &right,
+                  const lineArray &area, const idealGas &eqnState,
+                  const caloricallyPerfect &thermo, lineArray &flux) {
+  // left -- primative variables from left for each face in line
+  // right -- primative variables from right for each face in line
+  // area -- unit area vector for each face in line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // flux -- inviscid flux for each face in line
+
+  constexpr auto tRef = 1.0;  // cpg properties do not depend on temperature
+  const simdDouble gammaRef = eqnState.GammaRef();
+  const simdDouble gamma = thermo.Gamma(tRef);
+  const simdDouble cp = thermo.Cp(tRef);
+
+  for (auto ff = 0; ff < left.PaddedLength(); ff += simdDouble::width) {
+    simdDouble lt[NUMVARS], rt[NUMVARS];
+    for (auto vv = 0; vv < NUMVARS; ++vv) {
+      lt[vv] = simdDouble::Load(left.Field(vv) + ff);
+      rt[vv] = simdDouble::Load(right.Field(vv) + ff);
+    }
+    const auto nx = simdDouble::Load(area.Field(0) + ff);
+    const auto ny = simdDouble::Load(area.Field(1) + ff);
+    const auto nz = simdDouble::Load(area.Field(2) + ff);
+
+    // calculate average specific enthalpy on face
+    const auto tl = lt[4] * gammaRef / lt[0];
+    const auto tr = rt[4] * gammaRef / rt[0];
+    const auto h = 0.5 * (cp * tl + cp * tr);
+
+    // calculate c* from Kim, Kim, Rho 1998
+    const auto sosStar = Sqrt(2.0 * h * (gamma - 1.0) / (gamma + 1.0));
+
+    // calculate left/right mach numbers
+    const auto vell = lt[1] * nx + lt[2] * ny + lt[3] * nz;
+    const auto velr = rt[1] * nx + rt[2] * ny + rt[3] * nz;
+    const auto ml = vell / sosStar;
+    const auto mr = velr / sosStar;
+
+    // calculate speed of sound on face c_1/2 from Kim, Kim, Rho 1998
+    const auto vel = 0.5 * (vell + velr);
+    const auto sosStar2 = sosStar * sosStar;
+    const auto sos = Select(vel < 0.0, sosStar2 / Max(vell, sosStar),
+                            Select(vel > 0.0, sosStar2 / Max(velr, sosStar),
+                                   0.0));
+
+    // calculate split mach number and pressure terms
+    const auto subsonicL = Abs(ml) <= 1.0;
+    const auto subsonicR = Abs(mr) <= 1.0;
+    const auto mlp1Sq = (ml + 1.0) * (ml + 1.0);
+    const auto mrm1Sq = (mr - 1.0) * (mr - 1.0);
+    const auto mPlusL = Select(subsonicL, 0.25 * mlp1Sq, 0.5 * (ml + Abs(ml)));
+    const auto mMinusR = Select(subsonicR, -0.25 * mrm1Sq,
+                                0.5 * (mr - Abs(mr)));
+    const auto pPlus = Select(subsonicL, 0.25 * mlp1Sq * (2.0 - ml),
+                              Select(ml > 0.0, 1.0, 0.0));
+    const auto pMinus = Select(subsonicR, 0.25 * mrm1Sq * (2.0 + mr),
+                               Select(mr < 0.0, 1.0, 0.0));
+
+    // calculate pressure weighting terms
+    const auto ps = pPlus * lt[4] + pMinus * rt[4];
+    const auto pRatio = Min(lt[4] / rt[4], rt[4] / lt[4]);
+    const auto w = 1.0 - pRatio * pRatio * pRatio;
+    // ps is only zero when both sides are supersonic and moving apart; the
+    // divisions are not used then, but are done for every face in the vector
+    const auto psDiv = Select(ps > 0.0, ps, 1.0);
+    const auto fl = Select(Abs(ml) < 1.0, lt[4] / psDiv - 1.0, 0.0);
+    const auto fr = Select(Abs(mr) < 1.0, rt[4] / psDiv - 1.0, 0.0);
+
+    // calculate final split properties
+    const auto positive = (mPlusL + mMinusR) >= 0.0;
+    const auto mPlusLBar =
+        Select(positive, mPlusL + mMinusR * ((1.0 - w) * (1.0 + fr) - fl),
+               mPlusL * w * (1.0 + fl));
+    const auto mMinusRBar =
+        Select(positive, mMinusR * w * (1.0 + fr),
+               mMinusR + mPlusL * ((1.0 - w) * (1.0 + fl) - fr));
+
+    // calculate total enthalpy
+    auto enthalpy = [&](const simdDouble (&st)[NUMVARS], const simdDouble &t) {
+      const auto velMag = Sqrt(st[1] * st[1] + st[2] * st[2] + st[3] * st[3]);
+      return cp * t + 0.5 * velMag * velMag;
+    };
+
+    // calculate left and right contributions to flux
+    const auto massL = lt[0] * (mPlusLBar * sos);
+    const auto massR = rt[0] * (mMinusRBar * sos);
+    const auto pl = pPlus * lt[4];
+    const auto pr = pMinus * rt[4];
+    const simdDouble ausm[NUMVARS] = {
+      massL + massR,
+      (massL * lt[1] + pl * nx) + (massR * rt[1] + pr * nx),
+      (massL * lt[2] + pl * ny) + (massR * rt[2] + pr * ny),
+      (massL * lt[3] + pl * nz) + (massR * rt[3] + pr * nz),
+      massL * enthalpy(lt, tl) + massR * enthalpy(rt, tr),
+      massL * lt[5] + massR * rt[5],
+      massL * lt[6] + massR * rt[6]};
+    for (auto vv = 0; vv < NUMVARS; ++vv) {
+      ausm[vv].Store(flux.Field(vv) + ff);
+    }
+  }
+}
+
+// explicit instantiations of the general line flux functions
+template void RoeFluxLine(const lineArray &, const lineArray &,
+                          const lineArray &, const eos &,
+                          const thermodynamic &, lineArray &);
+template void RoeFluxLine(const lineArray &, const lineArray &,
+                          const lineArray &, const idealGas &,
+                          const thermallyPerfect &, lineArray &);
+template void AUSMFluxLine(const lineArray &, const lineArray &,
+                           const lineArray &, const eos &,
+                           const thermodynamic &, lineArray &);
+template void AUSMFluxLine(const lineArray &, const lineArray &,
+                           const lineArray &, const idealGas &,
+                           const thermallyPerfect &, lineArray &);
+
+/* Function to check that the line flux kernels give the same fluxes as the
+face by face flux functions, and to time both. The left and right states have
+normal Mach numbers between -3 and 3, so subsonic and supersonic faces with
+flow in both directions are covered, and every fourth face has the same state
+on both sides. The fluxes must match bit for bit, so the program exits if any
+face differs. The compiler is not allowed to contract floating point operations
+in this file, so that the SIMD and scalar kernels round the same way.
+*/
+template <inviscidFluxScheme F, typename E, typename T>
+void CheckInviscidFluxLine(const E &eqnState, const T &thermo,
+                           const int &numFaces) {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // numFaces -- number of faces to check
+
+  // generate states with a fixed seed so the check is repeatable
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  auto Rand = [&]() { return dist(gen); };
+
+  vector<primVars> left(numFaces), right(numFaces);
+  vector<vector3d<double>> area(numFaces);
+  inviscidFluxLine line(numFaces);
+  for (auto ff = 0; ff < numFaces; ++ff) {
+    const auto ax = Rand();
+    const auto ay = Rand();
+    const auto az = Rand();
+    area[ff] = vector3d<double>(ax, ay, az).Normalize();
+
+    auto State = [&]() {
+      const auto rho = 1.0 + 0.5 * Rand();
+      const auto p = (1.0 + 0.5 * Rand()) / 1.4;  // near free stream
+      const auto tke = 1.0e-4 * (1.0 + Rand());
+      const auto omega = 10.0 * (1.0 + Rand());
+      const auto sos = primVars(rho, 0.0, 0.0, 0.0, p).SoS(thermo, eqnState);
+      const auto mach = 3.0 * Rand();
+      const auto tx = Rand();
+      const auto ty = Rand();
+      const auto tz = Rand();
+      const auto vel = area[ff] * (mach * sos) +
+          vector3d<double>(tx, ty, tz) * (0.5 * sos);
+      return primVars(rho, vel, p, tke, omega);
+    };
+    left[ff] = State();
+    right[ff] = (ff % 4 == 0) ? left[ff] : State();
+    line.Insert(ff, left[ff], right[ff], area[ff]);
+  }
+
+  // compare line fluxes to face by face fluxes
+  line.CalcFlux<F>(eqnState, thermo);
+  for (auto ff = 0; ff < numFaces; ++ff) {
+    const auto faceFlux = InviscidFlux<F>(left[ff], right[ff], eqnState,
+                                          thermo, area[ff]);
+    const auto lineFlux = line.Flux<inviscidFlux>(ff);
+    for (auto vv = 0; vv < NUMVARS; ++vv) {
+      if (std::memcmp(&faceFlux[vv], &lineFlux[vv], sizeof(double)) != 0) {
+        cerr << "ERROR: Error in CheckInviscidFluxLine(). Line flux for "
+             << "variable " << vv << " at face " << ff << " is "
+             << std::setprecision(17) << lineFlux[vv]
+             << " but face by face flux is " << faceFlux[vv] << endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  // time both versions over about the same number of faces
+  const auto repeats = std::max(1, 2000000 / numFaces);
+  auto start = std::chrono::steady_clock::now();
+  for (auto rr = 0; rr < repeats; ++rr) {
+    line.CalcFlux<F>(eqnState, thermo);
+  }
+  const std::chrono::duration<double> lineTime =
+      std::chrono::steady_clock::now() - start;
+
+  vector<inviscidFlux> faceFlux(numFaces);
+  start = std::chrono::steady_clock::now();
+  for (auto rr = 0; rr < repeats; ++rr) {
+    for (auto ff = 0; ff < numFaces; ++ff) {
+      faceFlux[ff] = InviscidFlux<F>(left[ff], right[ff], eqnState, thermo,
+                                     area[ff]);
+    }
+  }
+  const std::chrono::duration<double> faceTime =
+      std::chrono::steady_clock::now() - start;
+
+  const auto numEvals = static_cast<double>(repeats) * numFaces;
+  cout << "Inviscid flux check: line fluxes match face by face fluxes at "
+       << numFaces << " faces" << endl;
+  cout << "Line fluxes: " << std::setprecision(4) << numEvals / lineTime.count()
+       << " faces/s; face by face fluxes: " << numEvals / faceTime.count()
+       << " faces/s; speedup: " << faceTime.count() / lineTime.count()
+       << endl << endl;
+}
+
+template <typename E, typename T>
+void CheckInviscidFluxLine(const inviscidFluxScheme &scheme,
+                           const E &eqnState, const T &thermo,
+                           const int &numFaces) {
+  if (scheme == inviscidFluxScheme::roe) {
+    CheckInviscidFluxLine<inviscidFluxScheme::roe>(eqnState, thermo, numFaces);
+  } else {
+    CheckInviscidFluxLine<inviscidFluxScheme::ausm>(eqnState, thermo,
+                                                    numFaces);
+  }
+}
+
+void CheckInviscidFluxLine(const unique_ptr<eos> &eqnState,
+                           const unique_ptr<thermodynamic> &thermo,
+                           const inviscidFluxScheme &scheme,
+                           const int &numFaces) {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // scheme -- inviscid flux scheme
+  // numFaces -- number of faces to check
+
+  const auto *gas = dynamic_cast<const idealGas *>(eqnState.get());
+  if (gas == nullptr) {
+    cerr << "ERROR: Error in CheckInviscidFluxLine(). Equation of state is "
+         << "not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  const auto *cpg = dynamic_cast<const caloricallyPerfect *>(thermo.get());
+  const auto *tpg = dynamic_cast<const thermallyPerfect *>(thermo.get());
+  if (cpg != nullptr) {
+    CheckInviscidFluxLine(scheme, *gas, *cpg, numFaces);
+  } else if (tpg != nullptr) {
+    CheckInviscidFluxLine(scheme, *gas, *tpg, numFaces);
   } else {
-    cerr << "ERROR: inviscid flux type " << flux << " is not recognized!"
-         << endl;
-    cerr << "Choose 'roe' or 'ausm'" << endl;
+    cerr << "ERROR: Error in CheckInviscidFluxLine(). Thermodynamic model is "
+         << "not recognized!" << endl;
     exit(EXIT_FAILURE);
   }
-  return invFlux;
+}
+
+inviscidFlux InviscidFlux(const primVars &left, const primVars &right,
+                          const unique_ptr<eos> &eqnState,
+                          const unique_ptr<thermodynamic> &thermo,
+                          const vector3d<double> &area,
+                          const inviscidFluxScheme &flux) {
+  return (flux == inviscidFluxScheme::roe) ?
+      RoeFlux(left, right, eqnState, thermo, area) :
+      AUSMFlux(left, right, eqnState, thermo, area);
 }
 
 inviscidFlux RusanovFlux(const primVars &left, const primVars &right,
@@ -20,6 +20,10 @@
 #include <string>        // stl string
 #include <memory>        // unique_ptr
 
+#ifdef _OPENMP
+#include <omp.h>         // omp_set_num_threads
+#endif
+
 #ifdef __linux__
 #include <cfenv>         // exceptions
 #elif __APPLE__
@@ -43,7 +47,10 @@
 #include "multiArray3d.hpp"
 #include "kdtree.hpp"
 #include "fluxJacobian.hpp"
+#include "implicitDiagonal.hpp"
+#include "inviscidFlux.hpp"
 #include "utility.hpp"
+#include "haloExchange.hpp"
 
 using std::cout;
 using std::cerr;
@@ -55,7 +62,9 @@ int main(int argc, char *argv[]) {
   // of processors and rank of each processor
   auto numProcs = 1;
   auto rank = 0;
-  MPI_Init(&argc, &argv);
+  // only the main thread makes MPI calls
+  int threadSupport = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
@@ -106,6 +115,37 @@ int main(int argc, char *argv[]) {
   // Parse input file
   inp.ReadInput(rank);
 
+  // Set number of threads used inside each block
+#ifdef _OPENMP
+  // threads are only safe if the MPI library supports a threaded process
+  auto numThreads = inp.NumThreads();
+  if (numThreads > 1 && threadSupport < MPI_THREAD_FUNNELED) {
+    if (rank == ROOTP) {
+      cerr << "WARNING: MPI library does not provide MPI_THREAD_FUNNELED "
+           << "support, so only 1 thread per processor is used" << endl;
+    }
+    numThreads = 1;
+  }
+  omp_set_num_threads(numThreads);
+#pragma omp parallel
+  {
+    // floating point exceptions are enabled per thread
+#ifdef __linux__
+    feenableexcept(FE_DIVBYZERO | FE_INVALID);
+#elif __APPLE__
+    _MM_SET_EXCEPTION_MASK(_MM_GET_EXCEPTION_MASK() & ~_MM_MASK_INVALID);
+#endif
+  }
+  if (rank == ROOTP) {
+    cout << "Using " << numThreads << " threads per processor" << endl;
+  }
+#else
+  if (rank == ROOTP && inp.NumThreads() > 1) {
+    cerr << "WARNING: aither was compiled without OpenMP, so numThreads is "
+         << "ignored" << endl;
+  }
+#endif
+
   // nondimensionalize fluid data
   inp.NondimensionalizeFluid();
 
@@ -122,17 +162,48 @@ int main(int argc, char *argv[]) {
   // Get turbulence model
   const auto turb = inp.AssignTurbulenceModel();
 
+  // Check line flux kernels against face by face flux functions
+  if (rank == ROOTP && inp.InviscidFluxCheck() > 0) {
+    CheckInviscidFluxLine(eqnState, thermo, inp.InviscidFluxScheme(),
+                          inp.InviscidFluxCheck());
+  }
+
   vector<plot3dBlock> mesh;
+  vector<boundaryConditions> bcs;
   vector<connection> connections;
   vector<procBlock> stateBlocks;
+  vector<procBlock> localStateBlocks;
   vector<vector3d<double>> viscFaces;
   genArray residL2First(0.0);  // l2 norm residuals to normalize by
 
+  // With distributed startup only the decomposition is done on root, and each
+  // processor reads and sets up its own blocks. Chunked restart files are read
+  // by each processor, but restart files in the original format are read on
+  // root, so those restarts set up all blocks on root.
+  const auto chunkedRestart =
+      inp.IsRestart() && IsChunkedRestart(restartFile);
+  const auto distributed =
+      inp.IsDistributedStartup() && (!inp.IsRestart() || chunkedRestart);
+  if (rank == ROOTP && inp.IsDistributedStartup() && !distributed) {
+    cerr << "WARNING: Distributed startup is not used for restart files in "
+         << "the original format; all blocks are set up on root" << endl;
+  }
+
   if (rank == ROOTP) {
     cout << "Number of equations: " << inp.NumEquations() << endl << endl;
 
     // Read grid
-    mesh = ReadP3dGrid(inp.GridName(), inp.LRef(), totalCells);
+    if (distributed) {
+      // only read block sizes; nodes are read as they are needed
+      mesh = OpenP3dGrid(inp.GridName(), inp.LRef());
+      for (auto &blk : mesh) {
+        totalCells += blk.NumCells();
+      }
+      cout << "Grid file opened with " << mesh.size() << " blocks" << endl;
+      cout << "Total number of cells is " << totalCells << endl;
+    } else {
+      mesh = ReadP3dGrid(inp.GridName(), inp.LRef(), totalCells);
+    }
     vector<vector3d<int>> gridSizes(mesh.size());
     for (auto ii = 0U; ii < mesh.size(); ++ii) {
       gridSizes[ii] = {mesh[ii].NumCellsI(), mesh[ii].NumCellsJ(),
@@ -140,7 +211,7 @@ int main(int argc, char *argv[]) {
     }
 
     // Get BCs for blocks
-    auto bcs = inp.AllBC();
+    bcs = inp.AllBC();
 
     // Decompose grid
     if (inp.DecompMethod() == "manual") {
@@ -156,35 +227,40 @@ int main(int argc, char *argv[]) {
     // Get connection BCs
     connections = GetConnectionBCs(bcs, mesh, decomp, inp);
 
-    // Initialize the whole mesh with ICs and assign ghost cells geometry
-    stateBlocks.resize(mesh.size());
-    for (auto ll = 0U; ll < mesh.size(); ll++) {
-      stateBlocks[ll] =
-          procBlock(mesh[ll], decomp.ParentBlock(ll), bcs[ll], ll,
-                    decomp.Rank(ll), decomp.LocalPosition(ll), inp);
-      stateBlocks[ll].InitializeStates(inp, eqnState, trans, turb);
-      stateBlocks[ll].AssignGhostCellsGeom();
-    }
-    // if restart, get data from restart file
-    if (inp.IsRestart()) {
-      ReadRestart(stateBlocks, restartFile, decomp, inp, eqnState, thermo,
-                  trans, turb, residL2First, gridSizes);
-    }
+    if (!distributed) {
+      // Initialize the whole mesh with ICs and assign ghost cells geometry
+      stateBlocks.resize(mesh.size());
+      for (auto ll = 0U; ll < mesh.size(); ll++) {
+        stateBlocks[ll] =
+            procBlock(mesh[ll], decomp.ParentBlock(ll), bcs[ll], ll,
+                      decomp.Rank(ll), decomp.LocalPosition(ll), inp);
+        stateBlocks[ll].InitializeStates(inp, eqnState, trans, turb);
+        stateBlocks[ll].AssignGhostCellsGeom();
+      }
+      // if restart, get data from restart file
+      if (chunkedRestart) {
+        ReadRestartChunks(stateBlocks, restartFile, outputLayout(bcs, decomp),
+                          inp, eqnState, thermo, trans, turb, residL2First);
+      } else if (inp.IsRestart()) {
+        ReadRestart(stateBlocks, restartFile, decomp, inp, eqnState, thermo,
+                    trans, turb, residL2First, gridSizes);
+      }
 
-    // Swap geometry for connection BCs
-    for (auto &conn : connections) {
-      SwapGeomSlice(conn, stateBlocks[conn.BlockFirst()],
-                    stateBlocks[conn.BlockSecond()]);
-    }
-    // Get ghost cell edge data
-    for (auto &block : stateBlocks) {
-      block.AssignGhostCellsGeomEdge();
-    }
+      // Swap geometry for connection BCs
+      for (auto &conn : connections) {
+        SwapGeomSlice(conn, stateBlocks[conn.BlockFirst()],
+                      stateBlocks[conn.BlockSecond()]);
+      }
+      // Get ghost cell edge data
+      for (auto &block : stateBlocks) {
+        block.AssignGhostCellsGeomEdge();
+      }
 
-    // Get face centers of faces with viscous wall BC
-    viscFaces = GetViscousFaceCenters(stateBlocks);
+      // Get face centers of faces with viscous wall BC
+      viscFaces = GetViscousFaceCenters(stateBlocks);
 
-    cout << "Solution Initialized" << endl << endl;
+      cout << "Solution Initialized" << endl << endl;
+    }
     //---------------------------------------------------------------------
   }
 
@@ -196,25 +272,94 @@ int main(int argc, char *argv[]) {
                   MPI_connection, MPI_DOUBLE_5INT, MPI_vec3dMag,
                   MPI_uncoupledScalar, MPI_tensorDouble, MPI_wallData);
 
-  // Send number of procBlocks to all processors
-  SendNumProcBlocks(decomp.NumBlocksOnAllProc(), numProcBlock);
+  // Send decomposition and BCs to all processors
+  decomp.Broadcast();
+  BroadcastBCs(bcs);
+
+  // Send iteration to start from to all processors; it is read from the
+  // restart file on ROOT, and all processors use it to name output files
+  auto iterStart = inp.IterationStart();
+  MPI_Bcast(&iterStart, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  inp.SetIterationStart(iterStart);
 
-  // Send procBlocks to appropriate processor
-  auto localStateBlocks = SendProcBlocks(stateBlocks, rank, numProcBlock,
-                                         MPI_cellData, MPI_vec3d, MPI_vec3dMag,
-                                         MPI_wallData, inp);
+  // Find where each block goes in the output and restart files
+  const outputLayout layout(bcs, decomp);
 
-  // Update auxillary variables (temperature, viscosity, etc), cell widths
+  if (distributed) {
+    // Send connections to all processors
+    SendConnections(connections, MPI_connection);
+    numProcBlock = decomp.NumBlocksOnProc(rank);
+
+    // Split grid blocks the same way they were split on root
+    if (rank != ROOTP) {
+      mesh = OpenP3dGrid(inp.GridName(), inp.LRef());
+      decomp.DecompGrid(mesh);
+    }
+
+    // Read the blocks on this processor, initialize them with ICs, and assign
+    // ghost cells geometry
+    localStateBlocks.resize(numProcBlock);
+    for (auto ll = 0; ll < decomp.NumBlocks(); ll++) {
+      if (decomp.Rank(ll) == rank) {
+        auto &block = localStateBlocks[decomp.LocalPosition(ll)];
+        block = procBlock(mesh[ll].Read(), decomp.ParentBlock(ll), bcs[ll], ll,
+                          rank, decomp.LocalPosition(ll), inp);
+        block.InitializeStates(inp, eqnState, trans, turb);
+        block.AssignGhostCellsGeom();
+      }
+    }
+    // if restart, each processor reads the data of its blocks
+    if (inp.IsRestart()) {
+      ReadRestartChunks(localStateBlocks, restartFile, layout, inp, eqnState,
+                        thermo, trans, turb, residL2First);
+    }
+
+    // Swap geometry for connection BCs
+    SwapGeomSlices(connections, localStateBlocks, rank,
+                   inp.NumberGhostLayers());
+    // Get ghost cell edge data
+    for (auto &block : localStateBlocks) {
+      block.AssignGhostCellsGeomEdge();
+    }
+
+    // Get face centers of faces with viscous wall BC from all processors
+    viscFaces = GatherViscousFaceCenters(localStateBlocks, decomp.NumBlocks());
+
+    if (rank == ROOTP) {
+      cout << "Solution Initialized" << endl << endl;
+    }
+  } else {
+    // Send number of procBlocks to all processors
+    SendNumProcBlocks(decomp.NumBlocksOnAllProc(), numProcBlock);
+
+    // Send procBlocks to appropriate processor
+    localStateBlocks = SendProcBlocks(stateBlocks, rank, numProcBlock,
+                                      MPI_cellData, MPI_vec3d, MPI_vec3dMag,
+                                      MPI_wallData, inp);
+    // all blocks are written out from their own processors, so ROOT does not
+    // need to keep them
+    vector<procBlock>().swap(stateBlocks);
+
+    // Send connections to all processors
+    SendConnections(connections, MPI_connection);
+
+    // Broadcast viscous face centers to all processors
+    BroadcastViscFaces(MPI_vec3d, viscFaces);
+  }
+
+  // Update auxillary variables (temperature, viscosity, etc), cell widths,
+  // reconstruction coefficients, and hyperplane ordering
   for (auto &block : localStateBlocks) {
     block.UpdateAuxillaryVariables(eqnState, trans, false);
     block.CalcCellWidths();
+    block.CalcReconCoeffs(inp);
+    block.CalcHyperplanes(inp);
   }
 
-  // Send connections to all processors
-  SendConnections(connections, MPI_connection);
+  // Set up exchange of ghost cells at connection boundaries
+  haloExchange halo(connections, rank, inp.NumberGhostLayers());
 
-  // Broadcast viscous face centers to all processors
-  BroadcastViscFaces(MPI_vec3d, viscFaces);
+  outputWriter writer(inp.IsAsynchronousOutput());
 
   // Create operation
   MPI_Op MPI_MAX_LINF;
@@ -243,7 +388,7 @@ int main(int argc, char *argv[]) {
 
   if (tree.Size() > 0) {
     CalcWallDistance(localStateBlocks, tree);
-    SwapWallDist(localStateBlocks, connections, rank, inp.NumberGhostLayers());
+    SwapWallDist(localStateBlocks, halo);
   }
 
   MPI_Barrier(MPI_COMM_WORLD);
@@ -256,15 +401,15 @@ int main(int argc, char *argv[]) {
 
   //-----------------------------------------------------------------------
   // Allocate array for flux jacobian
-  vector<multiArray3d<fluxJacobian>> mainDiagonal(numProcBlock);
+  vector<implicitDiagonal> mainDiagonal(numProcBlock);
   if (inp.IsImplicit()) {
     ResizeArrays(localStateBlocks, inp, mainDiagonal);
   }
 
-  // Send/recv solutions - necessary to get wall distances
-  GetProcBlocks(stateBlocks, localStateBlocks, rank, MPI_cellData,
-                MPI_uncoupledScalar, MPI_vec3d, MPI_tensorDouble, MPI_wallData,
-                inp);
+  // Allocate arrays for stored off diagonal operators
+  if (inp.StoreOffDiagonals()) {
+    AllocateOffDiagonals(localStateBlocks, inp, rank);
+  }
 
   ofstream resFile;
   if (rank == ROOTP) {
@@ -278,13 +423,15 @@ int main(int argc, char *argv[]) {
       cerr << "ERROR: Could not open residual file!" << endl;
       exit(EXIT_FAILURE);
     }
+  }
 
-    // Write out cell centers grid file
-    WriteCellCenter(inp.GridName(), stateBlocks, decomp, inp);
+  // Write out cell centers grid file
+  WriteCellCenter(inp.GridName(), localStateBlocks, layout, inp, writer);
 
-    // Write out initial results
-    WriteFun(stateBlocks, eqnState, thermo, trans, inp.IterationStart(), decomp,
-             inp, turb);
+  // Write out initial results
+  WriteFun(localStateBlocks, eqnState, thermo, trans, inp.IterationStart(),
+           layout, inp, turb, writer);
+  if (rank == ROOTP) {
     WriteMeta(inp, inp.IterationStart());
   }
 
@@ -308,13 +455,9 @@ int main(int argc, char *argv[]) {
 
     // loop over nonlinear iterations
     for (auto mm = 0; mm < inp.NonlinearIterations(); mm++) {
-      // Get boundary conditions for all blocks
-      GetBoundaryConditions(localStateBlocks, inp, eqnState, thermo, trans,
-                            turb, connections, rank, MPI_cellData);
-
-      // Calculate residual (RHS)
+      // Get boundary conditions for all blocks and calculate residual (RHS)
       CalcResidual(localStateBlocks, mainDiagonal, trans, thermo, eqnState, inp,
-                   turb, connections, rank, MPI_tensorDouble, MPI_vec3d);
+                   turb, halo);
 
       // Calculate time step
       CalcTimeStep(localStateBlocks, inp);
@@ -326,7 +469,7 @@ int main(int argc, char *argv[]) {
       if (inp.IsImplicit()) {
         matrixResid = ImplicitUpdate(
             localStateBlocks, mainDiagonal, inp, eqnState, thermo, trans, turb,
-            mm, residL2, residLinf, connections, rank, MPI_cellData);
+            mm, residL2, residLinf, halo);
       } else {  // explicit time integration
         ExplicitUpdate(localStateBlocks, inp, eqnState, thermo, trans, turb, mm,
                        residL2, residLinf);
@@ -361,30 +504,48 @@ int main(int argc, char *argv[]) {
 
     // write out function file
     if (inp.WriteOutput(nn) || inp.WriteRestart(nn)) {
-      // Send/recv solutions
-      GetProcBlocks(stateBlocks, localStateBlocks, rank, MPI_cellData,
-                    MPI_uncoupledScalar, MPI_vec3d, MPI_tensorDouble,
-                    MPI_wallData, inp);
-
-      if (rank == ROOTP && inp.WriteOutput(nn)) {
+      writer.StartCheckpoint();
+    }
+    if (inp.WriteOutput(nn)) {
+      if (rank == ROOTP) {
         cout << "writing out function file at iteration "
              << nn + inp.IterationStart()<< endl;
-        // Write out function file
-        WriteFun(stateBlocks, eqnState, thermo, trans,
-                 (nn + inp.IterationStart() + 1), decomp, inp, turb);
+      }
+      // Write out function file
+      WriteFun(localStateBlocks, eqnState, thermo, trans,
+               (nn + inp.IterationStart() + 1), layout, inp, turb, writer);
+      if (rank == ROOTP) {
         WriteMeta(inp, (nn + inp.IterationStart() + 1));
       }
-      if (rank == ROOTP && inp.WriteRestart(nn)) {
+    }
+    if (inp.WriteRestart(nn)) {
+      if (rank == ROOTP) {
         cout << "writing out restart file at iteration "
              << nn + inp.IterationStart()<< endl;
-        // Write out restart file
-        WriteRestart(stateBlocks, eqnState, trans,
-                     (nn + inp.IterationStart() + 1), decomp, inp,
-                     residL2First);
       }
+      // Write out restart file
+      WriteRestart(localStateBlocks, eqnState, trans,
+                   (nn + inp.IterationStart() + 1), layout, inp,
+                   residL2First, writer);
     }
   }  // loop for time step -----------------------------------------------------
 
+  // Wait for any output still being written
+  writer.Complete();
+
+  // face flux time on the slowest processor
+  vector3d<double> faceFluxTime;
+  for (const auto &blk : localStateBlocks) {
+    faceFluxTime += blk.FaceFluxTime();
+  }
+  if (rank == ROOTP) {
+    MPI_Reduce(MPI_IN_PLACE, &faceFluxTime[0], 3, MPI_DOUBLE, MPI_MAX, ROOTP,
+               MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(&faceFluxTime[0], &faceFluxTime[0], 3, MPI_DOUBLE, MPI_MAX,
+               ROOTP, MPI_COMM_WORLD);
+  }
+
   if (rank == ROOTP) {
     // close residual file
     resFile.close();
@@ -395,9 +556,12 @@ int main(int argc, char *argv[]) {
     const auto simEnd = std::chrono::high_resolution_clock::now();
     const std::chrono::duration<double> duration = simEnd - start;
     cout << "Total Time: " << duration.count() << " seconds" << endl;
+    cout << "Face Flux Time (i, j, k): " << faceFluxTime[0] << ", "
+         << faceFluxTime[1] << ", " << faceFluxTime[2] << " seconds" << endl;
   }
 
-  // Free datatypes previously created
+  // Free persistent requests and datatypes previously created
+  halo.FreeRequests();
   FreeDataTypesMPI(MPI_vec3d, MPI_cellData, MPI_procBlockInts,
                    MPI_connection, MPI_DOUBLE_5INT, MPI_vec3dMag,
                    MPI_uncoupledScalar, MPI_tensorDouble, MPI_wallData);
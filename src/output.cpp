@@ -20,7 +20,11 @@
 #include <vector>
 #include <string>
 #include <utility>  // pair
+#include <functional>  // function
+#include <algorithm>  // none_of, sort, find, equal
+#include <iterator>  // make_move_iterator
 #include <cmath>
+#include <cstdint>  // int64_t, uint32_t
 #include "output.hpp"
 #include "turbulence.hpp"
 #include "vector3d.hpp"  // vector3d
@@ -38,6 +42,7 @@
 #include "resid.hpp"               // resid
 #include "genArray.hpp"            // genArray
 #include "utility.hpp"
+#include "codec.hpp"               // Crc32, CompressDoubles
 
 using std::cout;
 using std::endl;
@@ -52,117 +57,496 @@ using std::pair;
 using std::setw;
 using std::setprecision;
 using std::unique_ptr;
+using std::function;
+
+// restart files start with these characters, followed by the format version
+constexpr char restartMagic[] = "aitherRS";
+constexpr int restartVersion = 1;
+// maximum number of cells in a chunk of a restart file, unless a single
+// k-plane of a block is larger
+constexpr int restartChunkCells = 262144;
+// number of bytes in a chunk index entry
+constexpr int restartChunkBytes = 9 * sizeof(int) + 2 * sizeof(int64_t) +
+                                  sizeof(uint32_t);
+// names of variables in each solution of a restart file
+const vector<vector<string>> restartFields = {
+    {"density", "vel_x", "vel_y", "vel_z", "pressure", "tke", "sdr"},
+    {"rho", "rhoU", "rhoV", "rhoW", "rhoE", "rhoTke", "rhoSdr"}};
+
+// function to append the bytes of a value to a buffer
+template <typename T>
+void AppendBytes(vector<char> &buffer, const T &val) {
+  const auto *bytes = reinterpret_cast<const char *>(&val);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(val));
+}
+
+// constructor for outputLayout
+outputLayout::outputLayout(const vector<boundaryConditions> &bcs,
+                           const decomposition &decomp) {
+  // bcs -- boundary conditions of all split blocks
+  // decomp -- decomposition of grid
+
+  // find start of split blocks in parent blocks by replaying the splits
+  blkStart_.assign(decomp.NumBlocks(), vector3d<int>(0, 0, 0));
+  for (auto ss = 0; ss < decomp.NumSplits(); ss++) {
+    const auto dir = decomp.SplitHistDir(ss);
+    const auto dd = (dir == "i") ? 0 : ((dir == "j") ? 1 : 2);
+    auto start = blkStart_[decomp.SplitHistBlkLower(ss)];
+    start[dd] += decomp.SplitHistIndex(ss);
+    blkStart_[decomp.SplitHistBlkUpper(ss)] = start;
+  }
+
+  parentDims_.assign(decomp.NumBlocks() - decomp.NumSplits(),
+                     vector3d<int>(0, 0, 0));
+  for (auto bb = 0; bb < decomp.NumBlocks(); bb++) {
+    auto &dims = parentDims_[decomp.ParentBlock(bb)];
+    dims[0] = std::max(dims[0], blkStart_[bb][0] + bcs[bb].BlockDimI());
+    dims[1] = std::max(dims[1], blkStart_[bb][1] + bcs[bb].BlockDimJ());
+    dims[2] = std::max(dims[2], blkStart_[bb][2] + bcs[bb].BlockDimK());
+  }
+
+  // wall data of each split block, stored as the wall surface and the pieces
+  // of split block wall data that make up the wall
+  struct wallPiece {
+    int blk_;              // split block
+    int wall_;             // wall data index in split block
+    vector3d<int> start_;  // start of piece in joined wall
+  };
+  vector<vector<boundarySurface>> walls(decomp.NumBlocks());
+  vector<vector<vector<wallPiece>>> pieces(decomp.NumBlocks());
+  wallIndex_.resize(decomp.NumBlocks());
+  wallStart_.resize(decomp.NumBlocks());
+  for (auto bb = 0; bb < decomp.NumBlocks(); bb++) {
+    for (auto ii = 0; ii < bcs[bb].NumSurfaces(); ii++) {
+      if (bcs[bb].GetBCTypes(ii) == "viscousWall") {
+        const auto ll = static_cast<int>(walls[bb].size());
+        walls[bb].push_back(bcs[bb].GetSurface(ii));
+        pieces[bb].push_back({{bb, ll, vector3d<int>(0, 0, 0)}});
+      }
+    }
+    wallIndex_[bb].resize(walls[bb].size());
+    wallStart_[bb].resize(walls[bb].size());
+  }
+
+  // join boundary conditions and walls in reverse order of the splits, in the
+  // same way that procBlock::Join and procBlock::JoinWallData join them
+  auto joinedBCs = bcs;
+  vector<boundarySurface> dumSurf;
+  for (auto ss = decomp.NumSplits() - 1; ss >= 0; ss--) {
+    const auto lower = decomp.SplitHistBlkLower(ss);
+    const auto upper = decomp.SplitHistBlkUpper(ss);
+    const auto dir = decomp.SplitHistDir(ss);
+    const auto dd = (dir == "i") ? 0 : ((dir == "j") ? 1 : 2);
+    joinedBCs[lower].Join(joinedBCs[upper], dir, dumSurf);
+
+    vector<int> joinedData;
+    for (auto ll = 0U; ll < walls[lower].size(); ll++) {
+      for (auto uu = 0U; uu < walls[upper].size(); uu++) {
+        auto upSurfMod = walls[upper][uu];
+        upSurfMod.IncrementDirection(dir, walls[lower][ll].Max(dir));
+        // upper wall data goes after lower wall data in joined wall
+        const vector3d<int> lowerSize(walls[lower][ll].NumI(),
+                                      walls[lower][ll].NumJ(),
+                                      walls[lower][ll].NumK());
+        auto joined = false;
+        walls[lower][ll].Join(upSurfMod, dir, joined);
+        if (joined) {
+          for (auto piece : pieces[upper][uu]) {
+            piece.start_[dd] += lowerSize[dd];
+            pieces[lower][ll].push_back(piece);
+          }
+          joinedData.push_back(uu);
+        }
+      }
+    }
+
+    // add in unjoined upper walls
+    for (auto uu = 0; uu < static_cast<int>(walls[upper].size()); uu++) {
+      if (std::none_of(std::begin(joinedData), std::end(joinedData),
+                       [&uu](const int &val) { return uu == val; })) {
+        walls[lower].push_back(walls[upper][uu]);
+        pieces[lower].push_back(pieces[upper][uu]);
+      }
+    }
+  }
+
+  // walls are written out in order of parent block
+  for (auto pp = 0; pp < this->NumBlocks(); pp++) {
+    for (auto ii = 0; ii < joinedBCs[pp].NumSurfaces(); ii++) {
+      if (joinedBCs[pp].GetBCTypes(ii) == "viscousWall") {
+        viscSurfs_.push_back(joinedBCs[pp].GetSurface(ii));
+        viscSurfParent_.push_back(pp);
+      }
+    }
+    for (auto ww = 0U; ww < walls[pp].size(); ww++) {
+      for (auto &piece : pieces[pp][ww]) {
+        wallIndex_[piece.blk_][piece.wall_] = wallDims_.size();
+        wallStart_[piece.blk_][piece.wall_] = piece.start_;
+      }
+      wallDims_.emplace_back(walls[pp][ww].NumI(), walls[pp][ww].NumJ(),
+                             walls[pp][ww].NumK());
+    }
+  }
+}
 
 //-----------------------------------------------------------------------
 // function declarations
+// member function to start a new checkpoint; files written after this are
+// part of the new checkpoint
+void outputWriter::StartCheckpoint() {
+  previous_.insert(previous_.end(), std::make_move_iterator(current_.begin()),
+                   std::make_move_iterator(current_.end()));
+  current_.clear();
+}
+
+// member function to wait for files to finish writing and close them
+void outputWriter::Complete(vector<pendingFile> &files) const {
+  for (auto &file : files) {
+    MPI_Wait(&file.request_, MPI_STATUS_IGNORE);
+    MPI_File_close(&file.file_);
+  }
+  files.clear();
+}
+
+// member function to wait for all files to finish writing
+void outputWriter::Complete() {
+  this->Complete(previous_);
+  this->Complete(current_);
+}
+
+/* Member function to write out a file with collective MPI-IO. The header
+(written by ROOT) and the hyperslabs of this processor are copied into a
+staging buffer in the order they are found in the file. The file view is made
+of the contiguous runs of bytes this processor writes, so the whole file is
+written with one collective call and the MPI library is free to combine the
+data of all processors into large writes. Any files of earlier checkpoints that
+are still being written are waited on here, after this file has been staged.
+*/
+void outputWriter::Write(const string &fileName, const vector<char> &header,
+                         const vector<fileSlab> &slabs) {
+  // fileName -- name of file to write
+  // header -- bytes at start of file, written by ROOT
+  // slabs -- hyperslabs of arrays in file to write from this processor
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // find contiguous runs of bytes in file; arrays are stored with i varying
+  // fastest, and all variables of a cell stored together
+  struct fileRun {
+    MPI_Offset disp_;    // byte offset in file
+    MPI_Aint size_;      // number of bytes
+    const char *data_;   // values to write
+  };
+  vector<fileRun> runs;
+  if (rank == ROOTP) {
+    runs.push_back({0, static_cast<MPI_Aint>(header.size()), header.data()});
+  }
+  for (auto &slab : slabs) {
+    const MPI_Aint rowSize = slab.size_[0] * slab.numVars_ * sizeof(double);
+    auto *data = reinterpret_cast<const char *>(slab.data_.data());
+    for (auto kk = 0; kk < slab.size_[2]; kk++) {
+      for (auto jj = 0; jj < slab.size_[1]; jj++) {
+        const auto cell = (static_cast<MPI_Offset>(slab.start_[2] + kk) *
+                               slab.dims_[1] + slab.start_[1] + jj) *
+                              slab.dims_[0] + slab.start_[0];
+        runs.push_back(
+            {static_cast<MPI_Offset>(
+                 slab.disp_ + cell * slab.numVars_ * sizeof(double)),
+             rowSize, data});
+        data += rowSize;
+      }
+    }
+  }
+  std::sort(std::begin(runs), std::end(runs),
+            [](const fileRun &r1, const fileRun &r2) {
+              return r1.disp_ < r2.disp_;
+            });
+
+  // stage data in file order and join runs that are next to each other
+  pendingFile file;
+  vector<int> blockLengths;
+  vector<MPI_Aint> blockDisps;
+  for (auto &run : runs) {
+    file.buffer_.insert(file.buffer_.end(), run.data_, run.data_ + run.size_);
+    this->AddRun(blockLengths, blockDisps, run.disp_, run.size_);
+  }
+  this->WriteStaged(fileName, file, blockLengths, blockDisps);
+}
+
+/* Member function to write out a file with collective MPI-IO where each
+processor writes one contiguous range of bytes. The header is written by ROOT
+at the start of the file, and the data of this processor is written starting
+at the given byte offset. The data is moved into the staging buffer so it is
+not copied.
+*/
+void outputWriter::Write(const string &fileName, const vector<char> &header,
+                         const MPI_Offset &disp, vector<char> &&data) {
+  // fileName -- name of file to write
+  // header -- bytes at start of file, written by ROOT
+  // disp -- byte offset in file of data from this processor
+  // data -- bytes to write from this processor
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const MPI_Offset dataSize = data.size();
+  pendingFile file;
+  vector<int> blockLengths;
+  vector<MPI_Aint> blockDisps;
+  if (rank == ROOTP) {
+    file.buffer_.reserve(header.size() + data.size());
+    file.buffer_.insert(file.buffer_.end(), header.begin(), header.end());
+    file.buffer_.insert(file.buffer_.end(), data.begin(), data.end());
+    this->AddRun(blockLengths, blockDisps, 0, header.size());
+  } else {
+    file.buffer_ = std::move(data);
+  }
+  this->AddRun(blockLengths, blockDisps, disp, dataSize);
+  this->WriteStaged(fileName, file, blockLengths, blockDisps);
+}
+
+// member function to add a run of bytes to the file view; runs are joined
+// with the one before if they are next to each other in the file, and are
+// split so that no run is too big for an int
+void outputWriter::AddRun(vector<int> &blockLengths,
+                          vector<MPI_Aint> &blockDisps,
+                          const MPI_Offset &disp, MPI_Offset size) const {
+  // blockLengths -- number of bytes in each run
+  // blockDisps -- byte offset in file of each run
+  // disp -- byte offset in file of run to add
+  // size -- number of bytes in run to add
+
+  constexpr MPI_Offset maxRun = 1 << 30;
+  auto runDisp = disp;
+  while (size > 0) {
+    if (!blockDisps.empty() &&
+        blockDisps.back() + blockLengths.back() == runDisp &&
+        blockLengths.back() + size < maxRun) {
+      blockLengths.back() += size;
+      return;
+    }
+    const auto runSize = std::min(size, maxRun - 1);
+    blockLengths.push_back(runSize);
+    blockDisps.push_back(runDisp);
+    runDisp += runSize;
+    size -= runSize;
+  }
+}
+
+/* Member function to write a staged buffer with collective MPI-IO. The file
+view is made of the runs of bytes written by this processor, and the buffer
+holds the bytes of the runs in order. Any files of earlier checkpoints that are
+still being written are waited on here.
+*/
+void outputWriter::WriteStaged(const string &fileName, pendingFile &file,
+                               const vector<int> &blockLengths,
+                               const vector<MPI_Aint> &blockDisps) {
+  // fileName -- name of file to write
+  // file -- file with staged buffer to write
+  // blockLengths -- number of bytes in each run
+  // blockDisps -- byte offset in file of each run
+
+  // earlier checkpoints must finish before this one is written
+  this->Complete(previous_);
+
+  const auto err = MPI_File_open(MPI_COMM_WORLD, fileName.c_str(),
+                                 MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                 MPI_INFO_NULL, &file.file_);
+
+  // check to see if file opened correctly
+  if (err != MPI_SUCCESS) {
+    cerr << "ERROR: File " << fileName << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // remove contents of any older file with the same name
+  MPI_File_set_size(file.file_, 0);
+
+  if (blockLengths.empty()) {
+    // nothing to write, but still need to take part in collective calls
+    MPI_File_set_view(file.file_, 0, MPI_BYTE, MPI_BYTE, "native",
+                      MPI_INFO_NULL);
+  } else {
+    MPI_Datatype MPI_fileRuns;
+    MPI_Type_create_hindexed(blockLengths.size(), blockLengths.data(),
+                             blockDisps.data(), MPI_BYTE, &MPI_fileRuns);
+    MPI_Type_commit(&MPI_fileRuns);
+    MPI_File_set_view(file.file_, 0, MPI_BYTE, MPI_fileRuns, "native",
+                      MPI_INFO_NULL);
+    MPI_Type_free(&MPI_fileRuns);
+  }
+
+  // the count of a write is an int, so buffers larger than that are written as
+  // one datatype made of large blocks of bytes and the remaining bytes
+  constexpr size_t blockSize = 1 << 30;
+  const auto numBlocks = file.buffer_.size() / blockSize;
+  if (numBlocks == 0) {
+    MPI_File_iwrite_all(file.file_, file.buffer_.data(),
+                        static_cast<int>(file.buffer_.size()), MPI_BYTE,
+                        &file.request_);
+  } else {
+    MPI_Datatype MPI_block, MPI_buffer;
+    MPI_Type_contiguous(blockSize, MPI_BYTE, &MPI_block);
+    int lengths[] = {static_cast<int>(numBlocks),
+                     static_cast<int>(file.buffer_.size() % blockSize)};
+    MPI_Aint disps[] = {0, static_cast<MPI_Aint>(numBlocks * blockSize)};
+    MPI_Datatype types[] = {MPI_block, MPI_BYTE};
+    MPI_Type_create_struct(2, lengths, disps, types, &MPI_buffer);
+    MPI_Type_commit(&MPI_buffer);
+    MPI_File_iwrite_all(file.file_, file.buffer_.data(), 1, MPI_buffer,
+                        &file.request_);
+    // types are only released once the pending write is done with them
+    MPI_Type_free(&MPI_buffer);
+    MPI_Type_free(&MPI_block);
+  }
+  current_.push_back(std::move(file));
+
+  if (!isAsync_) {
+    this->Complete(current_);
+  }
+}
+
 // function to write out cell centers of grid in plot3d format
 void WriteCellCenter(const string &gridName, const vector<procBlock> &vars,
-                     const decomposition &decomp, const input &inp) {
-  // recombine procblocks into original configuration
-  auto recombVars = Recombine(vars, decomp);
+                     const outputLayout &layout, const input &inp,
+                     outputWriter &writer) {
+  // gridName -- name of grid file
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks in original blocks
+  // inp -- input variables
+  // writer -- writer for output files
 
-  // open binary output file
   const string fEnd = "_center";
   const string fPostfix = ".xyz";
   const auto writeName = gridName + fEnd + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
 
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Grid file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
-
-  WriteBlockDims(outFile, recombVars);
+  vector<char> header;
+  WriteBlockDims(header, layout.BlockDims());
+  const auto disp = BlockDisplacements(layout.BlockDims(), header.size(), 3);
 
   // write out x, y, z coordinates of cell centers
-  for (auto &blk : recombVars) {  // loop over all blocks
+  vector<fileSlab> slabs;
+  slabs.reserve(vars.size() * 3);
+  for (auto &blk : vars) {  // loop over all blocks
+    const auto &dims = layout.BlockDims()[blk.ParentBlock()];
+    const auto blkSize = disp[blk.ParentBlock() + 1] - disp[blk.ParentBlock()];
     for (auto nn = 0; nn < 3; nn++) {  // loop over dimensions (3)
+      // for a given block, first write out all x coordinates, then all y
+      // coordinates, then all z coordinates
+      slabs.emplace_back(disp[blk.ParentBlock()] + nn * blkSize / 3, dims,
+                         layout.BlockStart(blk.GlobalPos()),
+                         vector3d<int>(blk.NumI(), blk.NumJ(), blk.NumK()), 1);
+      auto &slab = slabs.back();
       for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
         for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
           for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
             // get the cell center coordinates (dimensionalized)
             auto dumVec = blk.Center(ii, jj, kk) * inp.LRef();
-
-            // for a given block, first write out all x coordinates, then all y
-            // coordinates, then all z coordinates
-            auto dumDouble = dumVec[nn];
-            // write to file
-            outFile.write(reinterpret_cast<char *>(&dumDouble),
-                          sizeof(dumDouble));
+            slab.data_.push_back(dumVec[nn]);
           }
         }
       }
     }
   }
-  // close output file
-  outFile.close();
+
+  writer.Write(writeName, header, slabs);
 
   if (inp.NumWallVarsOutput() > 0) {
-    WriteWallFaceCenter(gridName, recombVars, inp.LRef());
+    WriteWallFaceCenter(gridName, vars, layout, inp.LRef(), writer);
   }
 }
 
 // function to write out wall face centers of grid in plot3d format
 void WriteWallFaceCenter(const string &gridName, const vector<procBlock> &vars,
-                         const double &LRef) {
-  // open binary output file
+                         const outputLayout &layout, const double &LRef,
+                         outputWriter &writer) {
+  // gridName -- name of grid file
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks in original blocks
+  // LRef -- reference length
+  // writer -- writer for output files
+
   const string fEnd = "_wall_center";
   const string fPostfix = ".xyz";
   const auto writeName = gridName + fEnd + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
 
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Grid file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
+  vector<vector3d<int>> wallDims;
+  wallDims.reserve(layout.NumViscousSurfaces());
+  for (auto ww = 0; ww < layout.NumViscousSurfaces(); ww++) {
+    const auto &surf = layout.ViscousSurface(ww);
+    wallDims.emplace_back(surf.NumI(), surf.NumJ(), surf.NumK());
   }
 
-  // get wall face centers
-  auto numWallSurfs = 0;
-  for (auto &var : vars) {
-    numWallSurfs += var.BC().NumViscousSurfaces();
-  }
-  vector<multiArray3d<vector3d<double>>> wallCenters;
-  wallCenters.reserve(numWallSurfs);
+  vector<char> header;
+  WriteBlockDims(header, wallDims);
+  const auto disp = BlockDisplacements(wallDims, header.size(), 3);
+
+  // write out x, y, z coordinates of wall face centers
+  vector<fileSlab> slabs;
+  for (auto ww = 0; ww < layout.NumViscousSurfaces(); ww++) {
+    const auto &surf = layout.ViscousSurface(ww);
+    const auto wallSize = disp[ww + 1] - disp[ww];
+    // direction normal to wall
+    const auto normal = (surf.SurfaceType() <= 2)
+                            ? 0
+                            : ((surf.SurfaceType() <= 4) ? 1 : 2);
+    const vector3d<int> surfMin(surf.IMin(), surf.JMin(), surf.KMin());
+    const vector3d<int> surfMax(surf.IMax(), surf.JMax(), surf.KMax());
 
-  for (auto &var : vars) {
-    const auto bc = var.BC();
-    for (auto jj = 0; jj < bc.NumSurfaces(); ++jj) {
-      if (bc.GetBCTypes(jj) == "viscousWall") {
-        auto wall = var.SliceBoundaryCenters(jj);
-        wallCenters.push_back(wall);
+    for (auto &blk : vars) {  // loop over all blocks
+      if (blk.ParentBlock() != layout.ViscousSurfaceParent(ww)) {
+        continue;
       }
-    }
-  }
 
-  WriteBlockDims(outFile, wallCenters);
+      // find part of wall on this block; faces on a split plane are taken
+      // from the lower block
+      const auto blkStart = layout.BlockStart(blk.GlobalPos());
+      const vector3d<int> blkEnd(blkStart[0] + blk.NumI(),
+                                 blkStart[1] + blk.NumJ(),
+                                 blkStart[2] + blk.NumK());
+      vector3d<int> lower, upper;
+      auto onBlock = true;
+      for (auto dd = 0; dd < 3; dd++) {
+        if (dd == normal) {
+          lower[dd] = surfMin[dd];
+          upper[dd] = surfMin[dd] + 1;
+          onBlock = onBlock && surfMin[dd] <= blkEnd[dd] &&
+                    (surfMin[dd] > blkStart[dd] ||
+                     (surfMin[dd] == 0 && blkStart[dd] == 0));
+        } else {
+          lower[dd] = std::max(surfMin[dd], blkStart[dd]);
+          upper[dd] = std::min(surfMax[dd], blkEnd[dd]);
+          onBlock = onBlock && lower[dd] < upper[dd];
+        }
+      }
+      if (!onBlock) {
+        continue;
+      }
 
-  // write out x, y, z coordinates of cell centers
-  for (auto &wBlk : wallCenters) {  // loop over all blocks
-    for (auto nn = 0; nn < 3; nn++) {  // loop over dimensions (3)
-      for (auto kk = wBlk.StartK(); kk < wBlk.EndK(); kk++) {
-        for (auto jj = wBlk.StartJ(); jj < wBlk.EndJ(); jj++) {
-          for (auto ii = wBlk.StartI(); ii < wBlk.EndI(); ii++) {
-            // get the cell center coordinates (dimensionalized)
-            auto dumVec = wBlk(ii, jj, kk) * LRef;
-
-            // for a given block, first write out all x coordinates, then all y
-            // coordinates, then all z coordinates
-            auto dumDouble = dumVec[nn];
-            // write to file
-            outFile.write(reinterpret_cast<char *>(&dumDouble),
-                          sizeof(dumDouble));
+      for (auto nn = 0; nn < 3; nn++) {  // loop over dimensions (3)
+        slabs.emplace_back(disp[ww] + nn * wallSize / 3, wallDims[ww],
+                           lower - surfMin, upper - lower, 1);
+        auto &slab = slabs.back();
+        for (auto kk = lower[2]; kk < upper[2]; kk++) {
+          for (auto jj = lower[1]; jj < upper[1]; jj++) {
+            for (auto ii = lower[0]; ii < upper[0]; ii++) {
+              const auto il = ii - blkStart[0];
+              const auto jl = jj - blkStart[1];
+              const auto kl = kk - blkStart[2];
+              // get the face center coordinates (dimensionalized)
+              auto dumVec = ((normal == 0) ? blk.FCenterI(il, jl, kl)
+                             : (normal == 1) ? blk.FCenterJ(il, jl, kl)
+                             : blk.FCenterK(il, jl, kl)) * LRef;
+              slab.data_.push_back(dumVec[nn]);
+            }
           }
         }
       }
     }
   }
 
-  // close output file
-  outFile.close();
+  writer.Write(writeName, header, slabs);
 }
 
 
@@ -171,197 +555,256 @@ void WriteWallFaceCenter(const string &gridName, const vector<procBlock> &vars,
 void WriteFun(const vector<procBlock> &vars, const unique_ptr<eos> &eqnState,
               const unique_ptr<thermodynamic> &thermo,
               const unique_ptr<transport> &trans, const int &solIter,
-              const decomposition &decomp, const input &inp,
-              const unique_ptr<turbModel> &turb) {
-  // recombine blocks into original structure
-  auto recombVars = Recombine(vars, decomp);
-
-  // open binary plot3d function file
+              const outputLayout &layout, const input &inp,
+              const unique_ptr<turbModel> &turb, outputWriter &writer) {
+  // plot3d function file name
   const string fEnd = "_center";
   const string fPostfix = ".fun";
   const auto writeName = inp.SimNameRoot() + "_" + to_string(solIter) + fEnd +
       fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
-
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Function file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
 
-  WriteBlockDims(outFile, recombVars, inp.NumVarsOutput());
+  vector<char> header;
+  WriteBlockDims(header, layout.BlockDims(), inp.NumVarsOutput());
+  const auto disp = BlockDisplacements(layout.BlockDims(), header.size(),
+                                       inp.NumVarsOutput());
 
   // write out variables
-  auto ll = 0;
-  for (auto &blk : recombVars) {  // loop over all blocks
+  vector<fileSlab> slabs;
+  slabs.reserve(vars.size() * inp.NumVarsOutput());
+  for (auto &blk : vars) {  // loop over all blocks
+    const auto &dims = layout.BlockDims()[blk.ParentBlock()];
+    const auto varSize = (disp[blk.ParentBlock() + 1] -
+                          disp[blk.ParentBlock()]) / inp.NumVarsOutput();
+    auto vv = 0;
     // loop over the number of variables to write out
     for (auto &var : inp.OutputVariables()) {
+      // resolve the variable to a function once so the cell loop does not
+      // compare strings
+      function<double(const int &, const int &, const int &)> calcValue;
+      if (var == "density") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).Rho() * inp.RRef();
+        };
+      } else if (var == "vel_x") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).U() * inp.ARef();
+        };
+      } else if (var == "vel_y") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).V() * inp.ARef();
+        };
+      } else if (var == "vel_z") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).W() * inp.ARef();
+        };
+      } else if (var == "pressure") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).P() *
+              (inp.RRef() * inp.ARef() * inp.ARef());
+        };
+      } else if (var == "mach") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          auto vel = blk.State(ii, jj, kk).Velocity();
+          return vel.Mag() / blk.State(ii, jj, kk).SoS(thermo, eqnState);
+        };
+      } else if (var == "sos") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).SoS(thermo, eqnState) * inp.ARef();
+        };
+      } else if (var == "dt") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Dt(ii, jj, kk) / (inp.ARef() * inp.LRef());
+        };
+      } else if (var == "temperature") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Temperature(ii, jj, kk) * inp.TRef();
+        };
+      } else if (var == "rank") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Rank();
+        };
+      } else if (var == "globalPosition") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.GlobalPos();
+        };
+      } else if (var == "viscosityRatio") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.IsTurbulent() ?
+              blk.EddyViscosity(ii, jj, kk) / blk.Viscosity(ii, jj, kk)
+              : 0.0;
+        };
+      } else if (var == "turbulentViscosity") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.EddyViscosity(ii, jj, kk) * trans->MuRef();
+        };
+      } else if (var == "viscosity") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Viscosity(ii, jj, kk) * trans->MuRef();
+        };
+      } else if (var == "tke") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).Tke() * (inp.ARef() * inp.ARef());
+        };
+      } else if (var == "sdr") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.State(ii, jj, kk).Omega() *
+              (inp.ARef() * inp.ARef() * inp.RRef() / trans->MuRef());
+        };
+      } else if (var == "f1") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.F1(ii, jj, kk);
+        };
+      } else if (var == "f2") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.F2(ii, jj, kk);
+        };
+      } else if (var == "wallDistance") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.WallDist(ii, jj, kk) * inp.LRef();
+        };
+      } else if (var == "velGrad_ux") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).XX() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_vx") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).XY() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_wx") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).XZ() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_uy") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).YX() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_vy") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).YY() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_wy") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).YZ() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_uz") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).ZX() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_vz") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).ZY() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "velGrad_wz") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.VelGrad(ii, jj, kk).ZZ() * (inp.ARef() / inp.LRef());
+        };
+      } else if (var == "tempGrad_x") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.TempGrad(ii, jj, kk).X() * (inp.TRef() / inp.LRef());
+        };
+      } else if (var == "tempGrad_y") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.TempGrad(ii, jj, kk).Y() * (inp.TRef() / inp.LRef());
+        };
+      } else if (var == "tempGrad_z") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.TempGrad(ii, jj, kk).Z() * (inp.TRef() / inp.LRef());
+        };
+      } else if (var == "tkeGrad_x") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.TkeGrad(ii, jj, kk).X() *
+              (inp.ARef() * inp.ARef() / inp.LRef());
+        };
+      } else if (var == "tkeGrad_y") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.TkeGrad(ii, jj, kk).Y() *
+              (inp.ARef() * inp.ARef() / inp.LRef());
+        };
+      } else if (var == "tkeGrad_z") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.TkeGrad(ii, jj, kk).Z() *
+              (inp.ARef() * inp.ARef() / inp.LRef());
+        };
+      } else if (var == "omegaGrad_x") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.OmegaGrad(ii, jj, kk).X() *
+              (inp.ARef() * inp.ARef() * inp.RRef() /
+               (trans->MuRef() * inp.LRef()));
+        };
+      } else if (var == "omegaGrad_y") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.OmegaGrad(ii, jj, kk).Y() *
+              (inp.ARef() * inp.ARef() * inp.RRef() /
+               (trans->MuRef() * inp.LRef()));
+        };
+      } else if (var == "omegaGrad_z") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.OmegaGrad(ii, jj, kk).Z() *
+              (inp.ARef() * inp.ARef() * inp.RRef() /
+               (trans->MuRef() * inp.LRef()));
+        };
+      } else if (var == "resid_mass") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 0) *
+              (inp.RRef() * inp.ARef() * inp.LRef() * inp.LRef());
+        };
+      } else if (var == "resid_mom_x") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 1) *
+              (inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() * inp.LRef());
+        };
+      } else if (var == "resid_mom_y") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 2) *
+              (inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() * inp.LRef());
+        };
+      } else if (var == "resid_mom_z") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 3) *
+              (inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() * inp.LRef());
+        };
+      } else if (var == "resid_energy") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 4) *
+              (inp.RRef() * pow(inp.ARef(), 3.0) * inp.LRef() * inp.LRef());
+        };
+      } else if (var == "resid_tke") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 5) *
+              (inp.RRef() * pow(inp.ARef(), 3.0) * inp.LRef() * inp.LRef());
+        };
+      } else if (var == "resid_sdr") {
+        calcValue = [&](const int &ii, const int &jj, const int &kk) {
+          return blk.Residual(ii, jj, kk, 6) *
+              (inp.RRef() * inp.RRef() * pow(inp.ARef(), 4.0) * inp.LRef() *
+               inp.LRef() / trans->MuRef());
+        };
+      } else {
+        cerr << "ERROR: Variable " << var
+             << " to write to function file is not defined!" << endl;
+        exit(EXIT_FAILURE);
+      }
+
       // write out dimensional variables -- loop over physical cells
+      slabs.emplace_back(disp[blk.ParentBlock()] + vv * varSize, dims,
+                         layout.BlockStart(blk.GlobalPos()),
+                         vector3d<int>(blk.NumI(), blk.NumJ(), blk.NumK()), 1);
+      auto &slab = slabs.back();
       for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
         for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
           for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
-            auto value = 0.0;
-            if (var == "density") {
-              value = blk.State(ii, jj, kk).Rho();
-              value *= inp.RRef();
-            } else if (var == "vel_x") {
-              value = blk.State(ii, jj, kk).U();
-              value *= inp.ARef();
-            } else if (var == "vel_y") {
-              value = blk.State(ii, jj, kk).V();
-              value *= inp.ARef();
-            } else if (var == "vel_z") {
-              value = blk.State(ii, jj, kk).W();
-              value *= inp.ARef();
-            } else if (var == "pressure") {
-              value = blk.State(ii, jj, kk).P();
-              value *= inp.RRef() * inp.ARef() * inp.ARef();
-            } else if (var == "mach") {
-              auto vel = blk.State(ii, jj, kk).Velocity();
-              value = vel.Mag() / blk.State(ii, jj, kk).SoS(thermo, eqnState);
-            } else if (var == "sos") {
-              value = blk.State(ii, jj, kk).SoS(thermo, eqnState);
-              value *= inp.ARef();
-            } else if (var == "dt") {
-              value = blk.Dt(ii, jj, kk);
-              value /= inp.ARef() * inp.LRef();
-            } else if (var == "temperature") {
-              value = blk.Temperature(ii, jj, kk);
-              value *= inp.TRef();
-            } else if (var == "rank") {
-              value = vars[SplitBlockNumber(recombVars, decomp,
-                                            ll, ii, jj, kk)].Rank();
-            } else if (var == "globalPosition") {
-              value = vars[SplitBlockNumber(recombVars, decomp,
-                                            ll, ii, jj, kk)].GlobalPos();
-            } else if (var == "viscosityRatio") {
-              value = blk.IsTurbulent() ?
-                  blk.EddyViscosity(ii, jj, kk) /
-                  blk.Viscosity(ii, jj, kk)
-                  : 0.0;
-            } else if (var == "turbulentViscosity") {
-              value = blk.EddyViscosity(ii, jj, kk);
-              value *= trans->MuRef();
-            } else if (var == "viscosity") {
-              value = blk.Viscosity(ii, jj, kk);
-              value *= trans->MuRef();
-            } else if (var == "tke") {
-              value = blk.State(ii, jj, kk).Tke();
-              value *= inp.ARef() * inp.ARef();
-            } else if (var == "sdr") {
-              value = blk.State(ii, jj, kk).Omega();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() / trans->MuRef();
-            } else if (var == "f1") {
-              value = blk.F1(ii, jj, kk);
-            } else if (var == "f2") {
-              value = blk.F2(ii, jj, kk);
-            } else if (var == "wallDistance") {
-              value = blk.WallDist(ii, jj, kk);
-              value *= inp.LRef();
-            } else if (var == "velGrad_ux") {
-              value = blk.VelGrad(ii, jj, kk).XX();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_vx") {
-              value = blk.VelGrad(ii, jj, kk).XY();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_wx") {
-              value = blk.VelGrad(ii, jj, kk).XZ();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_uy") {
-              value = blk.VelGrad(ii, jj, kk).YX();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_vy") {
-              value = blk.VelGrad(ii, jj, kk).YY();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_wy") {
-              value = blk.VelGrad(ii, jj, kk).YZ();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_uz") {
-              value = blk.VelGrad(ii, jj, kk).ZX();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_vz") {
-              value = blk.VelGrad(ii, jj, kk).ZY();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_wz") {
-              value = blk.VelGrad(ii, jj, kk).ZZ();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "tempGrad_x") {
-              value = blk.TempGrad(ii, jj, kk).X();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tempGrad_y") {
-              value = blk.TempGrad(ii, jj, kk).Y();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tempGrad_z") {
-              value = blk.TempGrad(ii, jj, kk).Z();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tkeGrad_x") {
-              value = blk.TkeGrad(ii, jj, kk).X();
-              value *= inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "tkeGrad_y") {
-              value = blk.TkeGrad(ii, jj, kk).Y();
-              value *= inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "tkeGrad_z") {
-              value = blk.TkeGrad(ii, jj, kk).Z();
-              value *= inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "omegaGrad_x") {
-              value = blk.OmegaGrad(ii, jj, kk).X();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                  (trans->MuRef() * inp.LRef());
-            } else if (var == "omegaGrad_y") {
-              value = blk.OmegaGrad(ii, jj, kk).Y();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                  (trans->MuRef() * inp.LRef());
-            } else if (var == "omegaGrad_z") {
-              value = blk.OmegaGrad(ii, jj, kk).Z();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                  (trans->MuRef() * inp.LRef());
-            } else if (var == "resid_mass") {
-              value = blk.Residual(ii, jj, kk, 0);
-              value *= inp.RRef() * inp.ARef() * inp.LRef() * inp.LRef();
-            } else if (var == "resid_mom_x") {
-              value = blk.Residual(ii, jj, kk, 1);
-              value *= inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_mom_y") {
-              value = blk.Residual(ii, jj, kk, 2);
-              value *= inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_mom_z") {
-              value = blk.Residual(ii, jj, kk, 3);
-              value *= inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_energy") {
-              value = blk.Residual(ii, jj, kk, 4);
-              value *= inp.RRef() * pow(inp.ARef(), 3.0) * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_tke") {
-              value = blk.Residual(ii, jj, kk, 5);
-              value *= inp.RRef() * pow(inp.ARef(), 3.0) * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_sdr") {
-              value = blk.Residual(ii, jj, kk, 6);
-              value *= inp.RRef() * inp.RRef() * pow(inp.ARef(), 4.0) *
-                  inp.LRef() * inp.LRef() / trans->MuRef();
-            } else {
-              cerr << "ERROR: Variable " << var
-                   << " to write to function file is not defined!" << endl;
-              exit(EXIT_FAILURE);
-            }
-
-            outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+            slab.data_.push_back(calcValue(ii, jj, kk));
           }
         }
       }
+      vv++;
     }
-    ll++;
   }
 
-  // close plot3d function file
-  outFile.close();
+  writer.Write(writeName, header, slabs);
 
   if (inp.NumWallVarsOutput() > 0) {
-    WriteWallFun(recombVars, eqnState, trans, solIter, inp, turb);
+    WriteWallFun(vars, eqnState, trans, solIter, layout, inp, turb, writer);
   }
 }
 
@@ -369,243 +812,655 @@ void WriteFun(const vector<procBlock> &vars, const unique_ptr<eos> &eqnState,
 void WriteWallFun(const vector<procBlock> &vars,
                   const unique_ptr<eos> &eqnState,
                   const unique_ptr<transport> &trans, const int &solIter,
-                  const input &inp, const unique_ptr<turbModel> &turb) {
-  // open binary plot3d function file
+                  const outputLayout &layout, const input &inp,
+                  const unique_ptr<turbModel> &turb, outputWriter &writer) {
+  // plot3d function file name
   const string fEnd = "_wall_center";
   const string fPostfix = ".fun";
   const auto writeName =
       inp.SimNameRoot() + "_" + to_string(solIter) + fEnd + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
 
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Function file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
-
-  // get wall surfaces to write out dimensions
-  auto numWallSurfs = 0;
-  for (auto &blk : vars) {
-    numWallSurfs += blk.WallDataSize();
-  }
-  vector<boundarySurface> wallSurfs;
-  wallSurfs.reserve(numWallSurfs);
-  for (auto &blk : vars) {
-    for (auto jj = 0; jj < blk.WallDataSize(); ++jj) {
-      const auto surf = blk.WallSurface(jj);
-      wallSurfs.push_back(surf);
-    }
-  }
-
-  WriteBlockDims(outFile, wallSurfs, inp.NumWallVarsOutput());
+  vector<char> header;
+  WriteBlockDims(header, layout.WallDims(), inp.NumWallVarsOutput());
+  const auto disp = BlockDisplacements(layout.WallDims(), header.size(),
+                                       inp.NumWallVarsOutput());
 
   // write out variables
+  vector<fileSlab> slabs;
   for (auto &blk : vars) {  // loop over all blocks
+    auto vv = 0;
     // loop over the number of variables to write out
     for (auto &var : inp.WallOutputVariables()) {
+      // resolve the variable to a function once so the cell loop does not
+      // compare strings
+      function<double(const int &, const int &, const int &, const int &)>
+          calcValue;
+      if (var == "yplus") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallYplus(ll, ii, jj, kk);
+        };
+      } else if (var == "shearStress") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallShearStress(ll, ii, jj, kk).Mag() *
+              (trans->InvNondimScaling() * trans->MuRef() * inp.ARef() /
+               inp.LRef());
+        };
+      } else if (var == "viscosityRatio") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallEddyVisc(ll, ii, jj, kk) /
+              (blk.WallViscosity(ll, ii, jj, kk) + EPS);
+        };
+      } else if (var == "heatFlux") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallHeatFlux(ll, ii, jj, kk) *
+              (trans->MuRef() * inp.TRef() / inp.LRef());
+        };
+      } else if (var == "frictionVelocity") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallFrictionVelocity(ll, ii, jj, kk) * inp.ARef();
+        };
+      } else if (var == "density") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallDensity(ll, ii, jj, kk) * inp.RRef();
+        };
+      } else if (var == "pressure") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallPressure(ll, ii, jj, kk, eqnState) *
+              (inp.RRef() * inp.ARef() * inp.ARef());
+        };
+      } else if (var == "temperature") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallTemperature(ll, ii, jj, kk) * inp.TRef();
+        };
+      } else if (var == "viscosity") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallViscosity(ll, ii, jj, kk) *
+              (trans->MuRef() * trans->InvNondimScaling());
+        };
+      } else if (var == "tke") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallTke(ll, ii, jj, kk) * (inp.ARef() * inp.ARef());
+        };
+      } else if (var == "sdr") {
+        calcValue = [&](const int &ll, const int &ii, const int &jj,
+                        const int &kk) {
+          return blk.WallSdr(ll, ii, jj, kk) *
+              (inp.ARef() * inp.ARef() * inp.RRef() / trans->MuRef());
+        };
+      } else {
+        cerr << "ERROR: Variable " << var
+             << " to write to wall function file is not defined!" << endl;
+        exit(EXIT_FAILURE);
+      }
+
       // loop over wall boundaries
       for (auto ll = 0; ll < blk.WallDataSize(); ++ll) {
         const auto surf = blk.WallSurface(ll);
+        const auto ww = layout.WallIndex(blk.GlobalPos(), ll);
+        const auto varSize =
+            (disp[ww + 1] - disp[ww]) / inp.NumWallVarsOutput();
+        slabs.emplace_back(disp[ww] + vv * varSize, layout.WallDims()[ww],
+                           layout.WallStart(blk.GlobalPos(), ll),
+                           vector3d<int>(surf.NumI(), surf.NumJ(), surf.NumK()),
+                           1);
+        auto &slab = slabs.back();
         // write out dimensional variables -- loop over physical cells
         for (auto kk = surf.RangeK().Start(); kk < surf.RangeK().End(); kk++) {
           for (auto jj = surf.RangeJ().Start(); jj < surf.RangeJ().End();
                jj++) {
             for (auto ii = surf.RangeI().Start(); ii < surf.RangeI().End();
                  ii++) {
-              // now calculate wall variables
-              auto value = 0.0;
-              if (var == "yplus") {
-                value = blk.WallYplus(ll, ii, jj, kk);
-              } else if (var == "shearStress") {
-                value = blk.WallShearStress(ll, ii, jj, kk).Mag();
-                value *= trans->InvNondimScaling() * trans->MuRef() * inp.ARef() /
-                         inp.LRef();
-              } else if (var == "viscosityRatio") {
-                value = blk.WallEddyVisc(ll, ii, jj, kk) /
-                        (blk.WallViscosity(ll, ii, jj, kk) + EPS);
-              } else if (var == "heatFlux") {
-                value = blk.WallHeatFlux(ll, ii, jj, kk);
-                value *= trans->MuRef() * inp.TRef() / inp.LRef();
-              } else if (var == "frictionVelocity") {
-                value = blk.WallFrictionVelocity(ll, ii, jj, kk);
-                value *= inp.ARef();
-              } else if (var == "density") {
-                value = blk.WallDensity(ll, ii, jj, kk);
-                value *= inp.RRef();
-              } else if (var == "pressure") {
-                value = blk.WallPressure(ll, ii, jj, kk, eqnState);
-                value *= inp.RRef() * inp.ARef() * inp.ARef();
-              } else if (var == "temperature") {
-                value = blk.WallTemperature(ll, ii, jj, kk);
-                value *= inp.TRef();
-              } else if (var == "viscosity") {
-                value = blk.WallViscosity(ll, ii, jj, kk);
-                value *= trans->MuRef() * trans->InvNondimScaling();
-              } else if (var == "tke") {
-                value = blk.WallTke(ll, ii, jj, kk);
-                value *= inp.ARef() * inp.ARef();
-              } else if (var == "sdr") {
-                value = blk.WallSdr(ll, ii, jj, kk);
-                value *= inp.ARef() * inp.ARef() * inp.RRef() / trans->MuRef();
-              } else {
-                cerr << "ERROR: Variable " << var
-                     << " to write to wall function file is not defined!"
-                     << endl;
-                exit(EXIT_FAILURE);
-              }
-
-              outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+              slab.data_.push_back(calcValue(ll, ii, jj, kk));
             }
           }
         }
       }
+      vv++;
     }
   }
 
-  // close plot3d function file
-  outFile.close();
+  writer.Write(writeName, header, slabs);
+}
+
+// function to find the factors to make the restart variables dimensional; the
+// 1st solution is primative variables, and the 2nd is conserved variables
+vector<vector<double>> RestartScales(const input &inp,
+                                     const unique_ptr<transport> &trans) {
+  // inp -- input variables
+  // trans -- transport model
+
+  // density, vel_x, vel_y, vel_z, pressure, tke, sdr
+  const vector<double> stateScale = {
+      inp.RRef(), inp.ARef(), inp.ARef(), inp.ARef(),
+      inp.RRef() * inp.ARef() * inp.ARef(), inp.ARef() * inp.ARef(),
+      inp.ARef() * inp.ARef() * inp.RRef() / trans->MuRef()};
+  // rho, rho-u, rho-v, rho-w, rho-E, rho-tke, rho-sdr
+  const vector<double> consScale = {
+      inp.RRef(), inp.ARef() * inp.RRef(), inp.ARef() * inp.RRef(),
+      inp.ARef() * inp.RRef(), inp.ARef() * inp.ARef() * inp.RRef(),
+      inp.ARef() * inp.ARef() * inp.RRef(),
+      inp.ARef() * inp.ARef() * inp.RRef() * inp.RRef() / trans->MuRef()};
+  return {stateScale, consScale};
+}
+
+// function to add an entry of the chunk index to a restart file header
+void AppendRestartChunk(vector<char> &buffer, const restartChunk &chunk) {
+  AppendBytes(buffer, chunk.sol_);
+  AppendBytes(buffer, chunk.block_);
+  for (auto dd = 0; dd < 3; dd++) {
+    AppendBytes(buffer, chunk.start_[dd]);
+  }
+  for (auto dd = 0; dd < 3; dd++) {
+    AppendBytes(buffer, chunk.size_[dd]);
+  }
+  AppendBytes(buffer, chunk.codec_);
+  AppendBytes(buffer, chunk.disp_);
+  AppendBytes(buffer, chunk.bytes_);
+  AppendBytes(buffer, chunk.crc_);
+}
+
+// function to read a value from a binary file, and add its bytes to a running
+// checksum
+template <typename T>
+void ReadBytes(ifstream &file, T &val, uint32_t &crc) {
+  file.read(reinterpret_cast<char *>(&val), sizeof(val));
+  crc = Crc32(reinterpret_cast<const char *>(&val), sizeof(val), crc);
 }
 
-// function to write out restart variables
-void WriteRestart(const vector<procBlock> &splitVars,
+/* Function to write out restart variables. The file starts with a header that
+describes the data, followed by the chunks of data.
+
+  char[8]  "aitherRS"
+  int      format version
+  int      number of solutions (time levels), iteration, number of equations
+  int      number of residuals, followed by the residuals (double)
+  int      number of blocks, followed by imax, jmax, kmax, numVars of each block
+  per solution, per variable: int length of name, followed by the name
+  int64    number of chunks
+  per chunk: int solution, block, start (3), size (3), codec;
+             int64 byte offset, number of bytes; uint32 checksum of bytes
+  uint32   checksum of header
+
+Each processor splits its blocks into chunks of k-planes, and stores the
+variables of a chunk one after another, with i varying fastest. With
+compression each chunk is compressed on its own, and is stored uncompressed if
+that is smaller. The chunks of each processor are written one after another
+after those of the lower ranks, so only the chunk index is gathered on ROOT.
+*/
+void WriteRestart(const vector<procBlock> &vars,
                   const unique_ptr<eos> &eqnState,
                   const unique_ptr<transport> &trans, const int &solIter,
-                  const decomposition &decomp, const input &inp,
-                  const genArray &residL2First) {
-  // recombine blocks into original structure
-  auto vars = Recombine(splitVars, decomp);
-
-  // open binary restart file
+                  const outputLayout &layout, const input &inp,
+                  const genArray &residL2First, outputWriter &writer) {
+  // restart file name
   const string fPostfix = ".rst";
   const auto writeName = inp.SimNameRoot() + "_" + to_string(solIter) + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
 
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Restart file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  vector<char> header(restartMagic, restartMagic + sizeof(restartMagic) - 1);
+  AppendBytes(header, restartVersion);
 
   // write number of time steps contained in file
-  auto numSols = inp.IsMultilevelInTime() ? 2 : 1;
-  outFile.write(reinterpret_cast<char *>(&numSols), sizeof(numSols));
+  const auto numSols = inp.IsMultilevelInTime() ? 2 : 1;
+  AppendBytes(header, numSols);
 
   // write iteration number
-  outFile.write(const_cast<char *>(reinterpret_cast<const char *>(&solIter)),
-                sizeof(solIter));
+  AppendBytes(header, solIter);
 
   // write number of equations
-  auto numEqns = inp.NumEquations();
-  outFile.write(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
+  AppendBytes(header, inp.NumEquations());
 
   // write residual values
-  outFile.write(const_cast<char *>(reinterpret_cast<const char *>(&residL2First)),
-                sizeof(residL2First));
-
-  // variables to write to restart file
-  vector<string> restartVars = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
-  if (inp.IsRANS()) {
-    restartVars.push_back("tke");
-    restartVars.push_back("sdr");
+  AppendBytes(header, NUMVARS);
+  AppendBytes(header, residL2First);
+
+  // variables to write to restart file are stored in the same order as the
+  // primative and conserved variables, so the factors to make them dimensional
+  // are found once here instead of comparing variable names for every cell
+  const auto scale = RestartScales(inp, trans);
+  const auto numRestartVars = inp.IsRANS() ? 7 : 5;
+
+  WriteBlockDims(header, layout.BlockDims(), numRestartVars);
+  for (auto ss = 0; ss < numSols; ss++) {
+    for (auto vv = 0; vv < numRestartVars; vv++) {
+      const auto &name = restartFields[ss][vv];
+      AppendBytes(header, static_cast<int>(name.size()));
+      header.insert(header.end(), name.begin(), name.end());
+    }
   }
 
-  WriteBlockDims(outFile, vars, restartVars.size());
-
-  // write out variables
+  // split blocks into chunks of k-planes
+  const auto compress = inp.RestartCompression() == "xor";
+  vector<restartChunk> chunks;
+  vector<char> data;
+  vector<double> values;
   for (auto &blk : vars) {  // loop over all blocks
-    // write out dimensional variables -- loop over physical cells
-    for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
-      for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
-        for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
-          // loop over the number of variables to write out
-          for (auto &var : restartVars) {
-            auto value = 0.0;
-            if (var == "density") {
-              value = blk.State(ii, jj, kk).Rho();
-              value *= inp.RRef();
-            } else if (var == "vel_x") {
-              value = blk.State(ii, jj, kk).U();
-              value *= inp.ARef();
-            } else if (var == "vel_y") {
-              value = blk.State(ii, jj, kk).V();
-              value *= inp.ARef();
-            } else if (var == "vel_z") {
-              value = blk.State(ii, jj, kk).W();
-              value *= inp.ARef();
-            } else if (var == "pressure") {
-              value = blk.State(ii, jj, kk).P();
-              value *= inp.RRef() * inp.ARef() * inp.ARef();
-            } else if (var == "tke") {
-              value = blk.State(ii, jj, kk).Tke();
-              value *= inp.ARef() * inp.ARef();
-            } else if (var == "sdr") {
-              value = blk.State(ii, jj, kk).Omega();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() / trans->MuRef();
-            } else {
-              cerr << "ERROR: Variable " << var
-                   << " to write to restart file is not defined!" << endl;
-              exit(EXIT_FAILURE);
+    const auto kPerChunk =
+        std::max(1, restartChunkCells / (blk.NumI() * blk.NumJ()));
+    for (auto ss = 0; ss < numSols; ss++) {
+      for (auto kc = 0; kc < blk.NumK(); kc += kPerChunk) {
+        restartChunk chunk;
+        chunk.sol_ = ss;
+        chunk.block_ = blk.ParentBlock();
+        chunk.start_ = layout.BlockStart(blk.GlobalPos());
+        chunk.start_[2] += kc;
+        chunk.size_ = vector3d<int>(blk.NumI(), blk.NumJ(),
+                                    std::min(kPerChunk, blk.NumK() - kc));
+        const auto numCells = chunk.size_[0] * chunk.size_[1] * chunk.size_[2];
+        values.resize(numCells * numRestartVars);
+
+        // write out dimensional variables -- loop over physical cells
+        auto cc = 0;
+        for (auto kk = blk.StartK() + kc;
+             kk < blk.StartK() + kc + chunk.size_[2]; kk++) {
+          for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+            for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
+              if (ss == 0) {
+                const auto state = blk.State(ii, jj, kk);
+                for (auto vv = 0; vv < numRestartVars; vv++) {
+                  values[vv * numCells + cc] = state[vv] * scale[ss][vv];
+                }
+              } else {  // 2nd solution is conserved variables
+                const auto consVars = blk.ConsVarsNm1(ii, jj, kk);
+                for (auto vv = 0; vv < numRestartVars; vv++) {
+                  values[vv * numCells + cc] = consVars[vv] * scale[ss][vv];
+                }
+              }
+              cc++;
             }
+          }
+        }
 
-            outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+        // offset is from start of data on this processor until the header
+        // size is known
+        chunk.disp_ = data.size();
+        chunk.codec_ = 0;
+        chunk.bytes_ = values.size() * sizeof(double);
+        if (compress) {
+          const auto packed = CompressDoubles(values.data(), values.size());
+          if (static_cast<int64_t>(packed.size()) < chunk.bytes_) {
+            chunk.codec_ = 1;
+            chunk.bytes_ = packed.size();
+            data.insert(data.end(), packed.begin(), packed.end());
           }
         }
+        if (chunk.codec_ == 0) {
+          const auto *bytes = reinterpret_cast<const char *>(values.data());
+          data.insert(data.end(), bytes, bytes + chunk.bytes_);
+        }
+        chunk.crc_ = Crc32(data.data() + chunk.disp_, chunk.bytes_);
+        chunks.push_back(chunk);
       }
     }
   }
 
-  // write out 2nd solution
-  if (numSols == 2) {
-    // these variables are conserved variables
-    for (auto &blk : vars) {  // loop over all blocks
-      // write out dimensional variables -- loop over physical cells
-      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
-        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
-          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
-            // loop over the number of variables to write out
-            for (auto &var : restartVars) {
-              auto value = 0.0;
-              if (var == "density") {
-                value = blk.ConsVarsNm1(ii, jj, kk)[0];
-                value *= inp.RRef();
-              } else if (var == "vel_x") {  // conserved var is rho-u
-                value = blk.ConsVarsNm1(ii, jj, kk)[1];
-                value *= inp.ARef() * inp.RRef();
-              } else if (var == "vel_y") {  // conserved var is rho-v
-                value = blk.ConsVarsNm1(ii, jj, kk)[2];
-                value *= inp.ARef() * inp.RRef();
-              } else if (var == "vel_z") {  // conserved var is rho-w
-                value = blk.ConsVarsNm1(ii, jj, kk)[3];
-                value *= inp.ARef() * inp.RRef();
-              } else if (var == "pressure") {  // conserved var is rho-E
-                value = blk.ConsVarsNm1(ii, jj, kk)[4];
-                value *= inp.ARef() * inp.ARef() * inp.RRef();
-              } else if (var == "tke") {  // conserved var is rho-tke
-                value = blk.ConsVarsNm1(ii, jj, kk)[5];
-                value *= inp.ARef() * inp.ARef() * inp.RRef();
-              } else if (var == "sdr") {  // conserved var is rho-sdr
-                value = blk.ConsVarsNm1(ii, jj, kk)[6];
-                value *= inp.ARef() * inp.ARef() * inp.RRef() * inp.RRef() / trans->MuRef();
-              } else {
-                cerr << "ERROR: Variable " << var
-                     << " to write to restart file is not defined!" << endl;
-                exit(EXIT_FAILURE);
+  // header size is known once the total number of chunks is known
+  int64_t numChunks = chunks.size();
+  MPI_Allreduce(MPI_IN_PLACE, &numChunks, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  const MPI_Offset headerSize = header.size() + sizeof(numChunks) +
+      numChunks * restartChunkBytes + sizeof(uint32_t);
+
+  // data of this processor comes after the data of the lower ranks
+  int64_t localBytes = data.size();
+  int64_t offset = 0;
+  MPI_Exscan(&localBytes, &offset, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  if (rank == 0) {  // result of exscan is undefined on rank 0
+    offset = 0;
+  }
+  offset += headerSize;
+
+  vector<char> index;
+  index.reserve(chunks.size() * restartChunkBytes);
+  for (auto &chunk : chunks) {
+    chunk.disp_ += offset;
+    AppendRestartChunk(index, chunk);
+  }
+
+  // gather chunk index on ROOT
+  auto numProcs = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+  int indexSize = index.size();
+  vector<int> indexSizes(numProcs, 0);
+  MPI_Gather(&indexSize, 1, MPI_INT, indexSizes.data(), 1, MPI_INT, ROOTP,
+             MPI_COMM_WORLD);
+  vector<int> indexDisps(numProcs, 0);
+  for (auto pp = 1; pp < numProcs; pp++) {
+    indexDisps[pp] = indexDisps[pp - 1] + indexSizes[pp - 1];
+  }
+  vector<char> allIndex;
+  if (rank == ROOTP) {
+    allIndex.resize(indexDisps.back() + indexSizes.back());
+  }
+  MPI_Gatherv(index.data(), indexSize, MPI_CHAR, allIndex.data(),
+              indexSizes.data(), indexDisps.data(), MPI_CHAR, ROOTP,
+              MPI_COMM_WORLD);
+
+  if (rank == ROOTP) {
+    AppendBytes(header, numChunks);
+    header.insert(header.end(), allIndex.begin(), allIndex.end());
+    AppendBytes(header, Crc32(header.data(), header.size()));
+  }
+
+  writer.Write(writeName, header, offset, std::move(data));
+}
+
+// function to check if a restart file is in the chunked format
+bool IsChunkedRestart(const string &restartName) {
+  ifstream fName(restartName, ios::in | ios::binary);
+  char magic[sizeof(restartMagic) - 1];
+  fName.read(magic, sizeof(magic));
+  return !fName.fail() && std::equal(magic, magic + sizeof(magic),
+                                     restartMagic);
+}
+
+/* Function to read a chunked restart file into the blocks of this processor.
+Every processor reads the header, and then seeks to the chunks that overlap
+its own blocks. The chunks are found from the location of the blocks in the
+parent blocks, so the file can be read with a different decomposition or number
+of processors than it was written with.
+*/
+void ReadRestartChunks(vector<procBlock> &vars, const string &restartName,
+                       const outputLayout &layout, input &inp,
+                       const unique_ptr<eos> &eqnState,
+                       const unique_ptr<thermodynamic> &thermo,
+                       const unique_ptr<transport> &trans,
+                       const unique_ptr<turbModel> &turb,
+                       genArray &residL2First) {
+  // vars -- procBlocks to read solution into
+  // restartName -- name of restart file
+  // layout -- location of procBlocks in parent blocks
+  // inp -- input variables
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- transport model
+  // turb -- turbulence model
+  // residL2First -- residuals to normalize by
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // open binary restart file
+  ifstream fName(restartName, ios::in | ios::binary);
+
+  // check to see if file opened correctly
+  if (fName.fail()) {
+    cerr << "ERROR: Error in ReadRestartChunks(). Restart file " << restartName
+         << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (rank == ROOTP) {
+    cout << "Reading restart file..." << endl;
+  }
+
+  // checksum of header
+  uint32_t crc = 0;
+  char magic[sizeof(restartMagic) - 1];
+  ReadBytes(fName, magic, crc);
+  if (!std::equal(magic, magic + sizeof(magic), restartMagic)) {
+    cerr << "ERROR: Restart file " << restartName
+         << " is not in the chunked restart format!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  auto version = 0;
+  ReadBytes(fName, version, crc);
+  if (version != restartVersion) {
+    cerr << "ERROR: Restart file version " << version
+         << " is not supported! Expected version " << restartVersion << "."
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // read the number of time levels in file
+  auto numSols = 0;
+  ReadBytes(fName, numSols, crc);
+
+  // iteration number
+  auto iterNum = 0;
+  ReadBytes(fName, iterNum, crc);
+  inp.SetIterationStart(iterNum);
+
+  // read the number of equations
+  auto numEqns = 0;
+  ReadBytes(fName, numEqns, crc);
+
+  if (rank == ROOTP) {
+    cout << "Number of time levels: " << numSols << endl;
+    cout << "Data from iteration: " << iterNum << endl;
+    cout << "Number of equations: " << numEqns << endl;
+    if (inp.IsMultilevelInTime() && numSols != 2) {
+      cerr << "WARNING: Using multilevel time integration scheme, but only one "
+           << "time level found in restart file" << endl;
+    }
+  }
+
+  // read the residuals to normalize by
+  auto numResid = 0;
+  ReadBytes(fName, numResid, crc);
+  for (auto rr = 0; rr < numResid && !fName.fail(); rr++) {
+    auto resid = 0.0;
+    ReadBytes(fName, resid, crc);
+    if (rr < NUMVARS) {
+      residL2First[rr] = resid;
+    }
+  }
+
+  // read the block sizes and check for match with grid
+  const auto &gridSizes = layout.BlockDims();
+  auto numBlks = 0;
+  ReadBytes(fName, numBlks, crc);
+  if (numBlks != static_cast<int>(gridSizes.size())) {
+    cerr << "ERROR: Number of blocks in restart file does not match grid!"
+         << endl;
+    cerr << "Found " << numBlks << " blocks in restart file and "
+         << gridSizes.size() << " blocks in grid." << endl;
+    exit(EXIT_FAILURE);
+  }
+  auto numVars = 0;
+  for (auto ii = 0; ii < numBlks; ii++) {
+    vector3d<int> dims;
+    for (auto dd = 0; dd < 3; dd++) {
+      ReadBytes(fName, dims[dd], crc);
+    }
+    ReadBytes(fName, numVars, crc);
+    if (dims != gridSizes[ii] || numVars != numEqns) {
+      cerr << "ERROR: Problem with restart file. Block size does not match "
+           << "grid, or number of variables in block does not match number of "
+           << "equations!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // read the variable names, and find where they go in the solution
+  vector<vector<int>> varIndex(numSols, vector<int>(numVars, 0));
+  for (auto ss = 0; ss < numSols; ss++) {
+    for (auto vv = 0; vv < numVars; vv++) {
+      auto length = 0;
+      ReadBytes(fName, length, crc);
+      string name(std::max(0, std::min(length, 256)), ' ');
+      fName.read(&name[0], name.size());
+      crc = Crc32(name.data(), name.size(), crc);
+      const auto &fields = restartFields[std::min(ss, 1)];
+      const auto field = std::find(fields.begin(), fields.end(), name);
+      if (field == fields.end()) {
+        cerr << "ERROR: Variable " << name
+             << " to read from restart file is not defined!" << endl;
+        exit(EXIT_FAILURE);
+      }
+      varIndex[ss][vv] = std::distance(fields.begin(), field);
+    }
+  }
+
+  // read the chunk index
+  int64_t numChunks = 0;
+  ReadBytes(fName, numChunks, crc);
+  vector<restartChunk> chunks(std::max(int64_t(0), numChunks));
+  for (auto &chunk : chunks) {
+    if (fName.fail()) {
+      break;
+    }
+    ReadBytes(fName, chunk.sol_, crc);
+    ReadBytes(fName, chunk.block_, crc);
+    for (auto dd = 0; dd < 3; dd++) {
+      ReadBytes(fName, chunk.start_[dd], crc);
+    }
+    for (auto dd = 0; dd < 3; dd++) {
+      ReadBytes(fName, chunk.size_[dd], crc);
+    }
+    ReadBytes(fName, chunk.codec_, crc);
+    ReadBytes(fName, chunk.disp_, crc);
+    ReadBytes(fName, chunk.bytes_, crc);
+    ReadBytes(fName, chunk.crc_, crc);
+  }
+  uint32_t headerCrc = 0;
+  fName.read(reinterpret_cast<char *>(&headerCrc), sizeof(headerCrc));
+  if (fName.fail() || headerCrc != crc) {
+    cerr << "ERROR: Header of restart file " << restartName
+         << " is corrupt or truncated!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // factors to make variables nondimensional
+  const auto scale = RestartScales(inp, trans);
+
+  // loop over blocks and read the chunks that overlap them
+  const auto readSols = inp.IsMultilevelInTime() ? std::min(numSols, 2) : 1;
+  vector<char> packed;
+  vector<double> values;
+  for (auto &blk : vars) {
+    const auto blkStart = layout.BlockStart(blk.GlobalPos());
+    const vector3d<int> blkEnd(blkStart[0] + blk.NumI(),
+                               blkStart[1] + blk.NumJ(),
+                               blkStart[2] + blk.NumK());
+    for (auto ss = 0; ss < readSols; ss++) {
+      multiArray3d<genArray> sol(blk.NumI(), blk.NumJ(), blk.NumK(), 0);
+      auto numCellsRead = 0LL;
+      for (auto &chunk : chunks) {
+        if (chunk.sol_ != ss || chunk.block_ != blk.ParentBlock()) {
+          continue;
+        }
+        // find overlap of chunk with block
+        vector3d<int> lo, hi;
+        auto overlap = true;
+        for (auto dd = 0; dd < 3; dd++) {
+          lo[dd] = std::max(chunk.start_[dd], blkStart[dd]);
+          hi[dd] = std::min(chunk.start_[dd] + chunk.size_[dd], blkEnd[dd]);
+          overlap = overlap && lo[dd] < hi[dd];
+        }
+        if (!overlap) {
+          continue;
+        }
+
+        // read chunk and check that it is intact
+        packed.resize(chunk.bytes_);
+        fName.seekg(chunk.disp_);
+        fName.read(packed.data(), packed.size());
+        if (fName.fail() ||
+            Crc32(packed.data(), packed.size()) != chunk.crc_) {
+          cerr << "ERROR: Data of block " << chunk.block_
+               << " in restart file " << restartName
+               << " is corrupt or truncated!" << endl;
+          exit(EXIT_FAILURE);
+        }
+        const auto numCells = static_cast<size_t>(chunk.size_[0]) *
+                              chunk.size_[1] * chunk.size_[2];
+        values.resize(numCells * numVars);
+        auto valid = false;
+        if (chunk.codec_ == 0) {
+          valid = packed.size() == values.size() * sizeof(double);
+          if (valid) {
+            std::copy(packed.begin(), packed.end(),
+                      reinterpret_cast<char *>(values.data()));
+          }
+        } else if (chunk.codec_ == 1) {
+          valid = DecompressDoubles(packed.data(), packed.size(),
+                                    values.data(), values.size());
+        } else {
+          cerr << "ERROR: Compression codec " << chunk.codec_
+               << " in restart file is not recognized!" << endl;
+          exit(EXIT_FAILURE);
+        }
+        if (!valid) {
+          cerr << "ERROR: Data of block " << chunk.block_
+               << " in restart file " << restartName
+               << " does not match its size!" << endl;
+          exit(EXIT_FAILURE);
+        }
+
+        // read nondimensional variables -- loop over overlapping cells
+        for (auto kk = lo[2]; kk < hi[2]; kk++) {
+          for (auto jj = lo[1]; jj < hi[1]; jj++) {
+            for (auto ii = lo[0]; ii < hi[0]; ii++) {
+              const auto cc = (static_cast<size_t>(kk - chunk.start_[2]) *
+                                   chunk.size_[1] + jj - chunk.start_[1]) *
+                                  chunk.size_[0] + ii - chunk.start_[0];
+              auto &value =
+                  sol(ii - blkStart[0], jj - blkStart[1], kk - blkStart[2]);
+              for (auto vv = 0; vv < numVars; vv++) {
+                const auto &var = varIndex[ss][vv];
+                value[var] = values[vv * numCells + cc] / scale[ss][var];
               }
+            }
+          }
+        }
+        numCellsRead += static_cast<long long>(hi[0] - lo[0]) *
+                        (hi[1] - lo[1]) * (hi[2] - lo[2]);
+      }
 
-              outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+      if (numCellsRead != sol.NumCells()) {
+        cerr << "ERROR: Restart file " << restartName
+             << " does not hold the whole solution of block "
+             << blk.ParentBlock() << "!" << endl;
+        exit(EXIT_FAILURE);
+      }
+
+      // assign to procBlock
+      if (ss == 0) {
+        multiArray3d<primVars> state(blk.NumI(), blk.NumJ(), blk.NumK(), 0);
+        for (auto kk = state.StartK(); kk < state.EndK(); kk++) {
+          for (auto jj = state.StartJ(); jj < state.EndJ(); jj++) {
+            for (auto ii = state.StartI(); ii < state.EndI(); ii++) {
+              state(ii, jj, kk) =
+                  primVars(sol(ii, jj, kk), true, eqnState, thermo, turb);
             }
           }
         }
+        blk.GetStatesFromRestart(state);
+      } else {
+        blk.GetSolNm1FromRestart(sol);
       }
     }
   }
 
+  // assign solution at time n to n-1 if file only has time n
+  if (inp.IsMultilevelInTime() && readSols != 2) {
+    AssignSolToTimeN(vars, eqnState, thermo);
+    AssignSolToTimeNm1(vars);
+  }
+
   // close restart file
-  outFile.close();
+  fName.close();
+  if (rank == ROOTP) {
+    cout << "Done with restart file" << endl << endl;
+  }
 }
 
+// function to read a restart file in the original format, where the cells of
+// the parent blocks are stored one after another with all variables of a cell
+// together; the whole file is read on ROOT and then decomposed
 void ReadRestart(vector<procBlock> &vars, const string &restartName,
                  const decomposition &decomp, input &inp,
                  const unique_ptr<eos> &eqnState,
@@ -729,28 +1584,46 @@ void ReadRestart(vector<procBlock> &vars, const string &restartName,
   cout << "Done with restart file" << endl << endl;
 }
 
-template<typename T>
-void WriteBlockDims(ofstream &outFile, const vector<T> &vars,
+// function to write out the number of blocks and the block dimensions
+void WriteBlockDims(vector<char> &buffer, const vector<vector3d<int>> &dims,
                     int numVars) {
+  // buffer -- buffer to add block dimensions to
+  // dims -- number of cells in each block
+  // numVars -- number of variables in each block (not written if 0)
+
   // write number of blocks to file
-  auto numBlks = static_cast<int>(vars.size());
-  outFile.write(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
+  AppendBytes(buffer, static_cast<int>(dims.size()));
 
   // loop over all blocks and write out imax, jmax, kmax, numVars
-  for (auto &blk : vars) {
-    auto dumInt = blk.NumI();
-    outFile.write(reinterpret_cast<char *>(&dumInt), sizeof(dumInt));
-    dumInt = blk.NumJ();
-    outFile.write(reinterpret_cast<char *>(&dumInt), sizeof(dumInt));
-    dumInt = blk.NumK();
-    outFile.write(reinterpret_cast<char *>(&dumInt), sizeof(dumInt));
-    
+  for (auto &blk : dims) {
+    AppendBytes(buffer, blk[0]);
+    AppendBytes(buffer, blk[1]);
+    AppendBytes(buffer, blk[2]);
+
     if (numVars > 0) {
-      outFile.write(reinterpret_cast<char *>(&numVars), sizeof(numVars));
+      AppendBytes(buffer, numVars);
     }
   }
 }
 
+/* Function to find the byte offset of each block in a file where the blocks
+are written one after another following a header. The last entry is the end of
+the last block.*/
+vector<MPI_Offset> BlockDisplacements(const vector<vector3d<int>> &dims,
+                                      const MPI_Offset &headerSize,
+                                      const int &numVars) {
+  // dims -- number of cells in each block
+  // headerSize -- number of bytes before first block
+  // numVars -- number of values written for each cell
+
+  vector<MPI_Offset> disp(dims.size() + 1, headerSize);
+  for (auto ii = 0U; ii < dims.size(); ii++) {
+    disp[ii + 1] = disp[ii] + static_cast<MPI_Offset>(dims[ii][0]) *
+        dims[ii][1] * dims[ii][2] * numVars * sizeof(double);
+  }
+  return disp;
+}
+
 
 // function to write out plot3d meta data for Paraview
 void WriteMeta(const input &inp, const int &iter) {
@@ -935,96 +1808,6 @@ void PrintResiduals(const input &inp, genArray &residL2First,
   os.unsetf(std::ios::fixed | std::ios::scientific);
 }
 
-/*Function to take in a vector of split procBlocks and return a vector of joined
- * procblocks (in their original configuration before grid decomposition).*/
-vector<procBlock> Recombine(const vector<procBlock> &vars,
-                            const decomposition &decomp) {
-  // vars -- vector of split procBlocks
-  // decomp -- decomposition
-
-  auto recombVars = vars;
-  vector<boundarySurface> dumSurf;
-  for (auto ii = decomp.NumSplits() - 1; ii >= 0; ii--) {
-    // recombine blocks and resize vector
-    recombVars[decomp.SplitHistBlkLower(ii)]
-        .Join(recombVars[decomp.SplitHistBlkUpper(ii)], decomp.SplitHistDir(ii),
-              dumSurf);
-    recombVars.resize(recombVars.size() - 1);
-  }
-
-  return recombVars;
-}
-
-/*Function to take in indices from the recombined procBlocks and determine which
- * split procBlock index the cell is associated with.*/
-int SplitBlockNumber(const vector<procBlock> &vars, const decomposition &decomp,
-                     const int &blk, const int &ii, const int &jj,
-                     const int &kk) {
-  // vars -- vector of recombined procblocks
-  // decomp -- decomposition data structure
-  // blk -- block number
-  // ii -- i index of cell in recombined block to find split block number
-  // jj -- j index of cell in recombined block to find split block number
-  // kk -- k index of cell in recombined block to find split block number
-
-  // Get block dimensions (both lower and upper extents)
-  vector<pair<vector3d<int>, vector3d<int>>> blkDims(vars.size());
-  vector3d<int> initialLower(0, 0, 0);
-  for (auto bb = 0U; bb < blkDims.size(); bb++) {
-    vector3d<int> dims(vars[bb].NumI(), vars[bb].NumJ(), vars[bb].NumK());
-    blkDims[bb].first = initialLower;
-    blkDims[bb].second = dims;
-  }
-
-  auto ind = blk;
-
-  // no splits, cell must be in parent block already
-  if (decomp.NumSplits() == 0) {
-    return ind;
-  } else {  // cell is in lower split already
-    for (auto ss = 0; ss < decomp.NumSplits(); ss++) {  // loop over all splits
-      // wrong parent block - split won't effect search so use dummy value
-      if (blk != decomp.ParentBlock(ss + vars.size())) {
-        pair<vector3d<int>, vector3d<int>> dumBlk(initialLower, initialLower);
-        blkDims.push_back(dumBlk);
-      } else {
-        // "split" blocks - change lower limits of block
-        if (decomp.SplitHistDir(ss) == "i") {
-          pair<vector3d<int>, vector3d<int>> splitBlk =
-              blkDims[decomp.SplitHistBlkLower(ss)];
-          splitBlk.first[0] += decomp.SplitHistIndex(ss);
-          blkDims.push_back(splitBlk);
-        } else if (decomp.SplitHistDir(ss) == "j") {
-          pair<vector3d<int>, vector3d<int>> splitBlk =
-              blkDims[decomp.SplitHistBlkLower(ss)];
-          splitBlk.first[1] += decomp.SplitHistIndex(ss);
-          blkDims.push_back(splitBlk);
-        } else {  // direction is k
-          pair<vector3d<int>, vector3d<int>> splitBlk =
-              blkDims[decomp.SplitHistBlkLower(ss)];
-          splitBlk.first[2] += decomp.SplitHistIndex(ss);
-          blkDims.push_back(splitBlk);
-        }
-
-        // test to see if block is in upper split
-        if (!(ii <= blkDims[decomp.SplitHistBlkUpper(ss)].second.X() &&
-              jj <= blkDims[decomp.SplitHistBlkUpper(ss)].second.Y() &&
-              kk <= blkDims[decomp.SplitHistBlkUpper(ss)].second.Z() &&
-              ii >= blkDims[decomp.SplitHistBlkUpper(ss)].first.X() &&
-              jj >= blkDims[decomp.SplitHistBlkUpper(ss)].first.Y() &&
-              kk >= blkDims[decomp.SplitHistBlkUpper(ss)].first.Z())) {
-          // cell not in upper split, but in lower split - found block index
-          return decomp.SplitHistBlkLower(ss);
-        } else {  // cell in upper split (and lower split)
-          ind = decomp.SplitHistBlkUpper(ss);
-        }
-      }
-    }
-  }
-
-  return ind;  // cell was in uppermost split for given parent block
-}
-
 multiArray3d<primVars> ReadSolFromRestart(
     ifstream &resFile, const input &inp, const unique_ptr<eos> &eqnState,
     const unique_ptr<thermodynamic> &thermo, const unique_ptr<transport> &trans,
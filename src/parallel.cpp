@@ -20,6 +20,7 @@
 #include <vector>  // vector
 #include <string>  // string
 #include <memory>  // make_unique
+#include <array>   // array
 #include "parallel.hpp"
 #include "output.hpp"
 #include "vector3d.hpp"            // vector3d
@@ -36,6 +37,7 @@ using std::min_element;
 using std::distance;
 using std::unique_ptr;
 using std::make_unique;
+using std::array;
 
 /* Function to return processor list for manual decomposition. Manual
 decomposition assumes that each block will reside on it's own processor.
@@ -404,7 +406,7 @@ vector<procBlock> SendProcBlocks(const vector<procBlock> &blocks,
       } else {  // send data to receiving processors
         // pack and send procBlock
         blocks[ii].PackSendGeomMPI(MPI_cellData, MPI_vec3d, MPI_vec3dMag,
-                                   MPI_wallData);
+                                   MPI_wallData, blocks[ii].Rank());
       }
     }
     //--------------------------------------------------------------------------
@@ -415,7 +417,7 @@ vector<procBlock> SendProcBlocks(const vector<procBlock> &blocks,
       // recv and unpack procBlock
       procBlock tempBlock;
       tempBlock.RecvUnpackGeomMPI(MPI_cellData, MPI_vec3d, MPI_vec3dMag,
-                                  MPI_wallData, inp);
+                                  MPI_wallData, inp, ROOTP);
 
       // add procBlock to output vector
       localBlocks[tempBlock.LocalPosition()] = tempBlock;
@@ -698,6 +700,51 @@ void decomposition::Split(const int &low, const int &ind, const string &dir) {
   localPos_.push_back(this->NumBlocksOnProc(rank_[low]) - 1);
 }
 
+/* Member function to split a grid the same way the decomposition split it.
+This is used to get the decomposed grid on processors that did not do the
+decomposition.*/
+void decomposition::DecompGrid(vector<plot3dBlock> &grid) const {
+  // grid -- grid blocks before decomposition; replaced by decomposed blocks
+
+  grid.resize(this->NumBlocks());
+  for (auto ii = 0; ii < this->NumSplits(); ++ii) {
+    const auto lower = this->SplitHistBlkLower(ii);
+    plot3dBlock lBlk, uBlk;
+    grid[lower].Split(this->SplitHistDir(ii), this->SplitHistIndex(ii), lBlk,
+                      uBlk);
+    grid[lower] = lBlk;
+    grid[this->SplitHistBlkUpper(ii)] = uBlk;
+  }
+}
+
+/* Member function to broadcast the decomposition from ROOT to all
+processors.*/
+void decomposition::Broadcast() {
+  auto sizes = array<int, 3>{static_cast<int>(rank_.size()), this->NumSplits(),
+                             numProcs_};
+  MPI_Bcast(sizes.data(), sizes.size(), MPI_INT, ROOTP, MPI_COMM_WORLD);
+
+  rank_.resize(sizes[0]);
+  parBlock_.resize(sizes[0]);
+  localPos_.resize(sizes[0]);
+  splitHistBlkLow_.resize(sizes[1]);
+  splitHistBlkUp_.resize(sizes[1]);
+  splitHistIndex_.resize(sizes[1]);
+  splitHistDir_.resize(sizes[1]);
+  numProcs_ = sizes[2];
+
+  MPI_Bcast(rank_.data(), sizes[0], MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(parBlock_.data(), sizes[0], MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(localPos_.data(), sizes[0], MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(splitHistBlkLow_.data(), sizes[1], MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+  MPI_Bcast(splitHistBlkUp_.data(), sizes[1], MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(splitHistIndex_.data(), sizes[1], MPI_INT, ROOTP, MPI_COMM_WORLD);
+  for (auto &dir : splitHistDir_) {
+    BroadcastString(dir);
+  }
+}
+
 // operator overload for << - allows use of cout, cerr, etc.
 ostream &operator<<(ostream &os, const decomposition &d) {
   // os -- stream to print to
@@ -869,3 +916,51 @@ void BroadcastViscFaces(const MPI_Datatype &MPI_vec3d,
   MPI_Bcast(&viscFaces[0], viscFaces.size(), MPI_vec3d, ROOTP,
             MPI_COMM_WORLD);
 }
+
+/* Function to broadcast the boundary conditions of all blocks from ROOT to all
+processors.*/
+void BroadcastBCs(vector<boundaryConditions> &bcs) {
+  // bcs -- boundary conditions for all blocks; only used on ROOT
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  auto numBCs = static_cast<int>(bcs.size());
+  MPI_Bcast(&numBCs, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  bcs.resize(numBCs);
+
+  // determine size of buffer on ROOT
+  auto bufSize = 0;
+  if (rank == ROOTP) {
+    for (auto &bc : bcs) {
+      auto tempSize = 0;
+      // 3 for number of surfaces; 8x for surface data and string sizes
+      MPI_Pack_size(3 + bc.NumSurfaces() * 8, MPI_INT, MPI_COMM_WORLD,
+                    &tempSize);
+      bufSize += tempSize;
+      for (auto jj = 0; jj < bc.NumSurfaces(); jj++) {
+        // add size for bc types (+1 for c_str end character)
+        MPI_Pack_size(bc.GetBCTypes(jj).size() + 1, MPI_CHAR, MPI_COMM_WORLD,
+                      &tempSize);
+        bufSize += tempSize;
+      }
+    }
+  }
+  MPI_Bcast(&bufSize, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+
+  // use unique_ptr to manage memory; use underlying pointer with MPI calls
+  auto unqBuffer = unique_ptr<char[]>(new char[bufSize]);
+  auto *buffer = unqBuffer.get();
+  auto position = 0;
+  if (rank == ROOTP) {
+    for (auto &bc : bcs) {
+      bc.PackBC(buffer, bufSize, position);
+    }
+  }
+  MPI_Bcast(buffer, bufSize, MPI_PACKED, ROOTP, MPI_COMM_WORLD);
+  if (rank != ROOTP) {
+    for (auto &bc : bcs) {
+      bc.UnpackBC(buffer, bufSize, position);
+    }
+  }
+}
@@ -19,6 +19,8 @@
 #include <cstdlib>
 #include <string>
 #include <vector>
+#include <memory>
+#include <algorithm>  // max, min
 #include "plot3d.hpp"
 
 using std::cout;
@@ -28,6 +30,7 @@ using std::vector;
 using std::ifstream;
 using std::ofstream;
 using std::ios;
+using std::make_shared;
 
 // plot 3d block member functions
 
@@ -361,99 +364,243 @@ multiArray3d<vector3d<double>> plot3dBlock::FaceCenterK() const {
 // function to read in a plot3d grid and assign it to a plot3dMesh data type
 vector<plot3dBlock> ReadP3dGrid(const string &gridName, const double &LRef,
                                 double &numCells) {
-  // open binary plot3d grid file
-  ifstream fName;
-  string fPostfix = ".xyz";
-  auto readName = gridName + fPostfix;
-  fName.open(readName, ios::in | ios::binary);
-
-  // check to see if file opened correctly
-  if (fName.fail()) {
-    cerr << "ERROR: Error in plot3d.cpp:ReadP3dGrid(). Grid file " << readName
-         << " did not open correctly!!!" << endl;
-    exit(EXIT_FAILURE);
-  }
+  // gridName -- name of grid file (without extension)
+  // LRef -- reference length to nondimensionalize grid by
+  // numCells -- total number of cells in grid
 
-  // read the number of plot3d blocks in the file
+  // open binary plot3d grid file and read header
   cout << "Reading grid file..." << endl << endl;
-  auto numBlks = 1;
-  fName.read(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
+  const plot3dGridFile file(gridName, LRef);
+  const auto numBlks = file.NumBlocks();
   cout << "Number of blocks: " << numBlks << endl << endl;
 
-  // read the number of i, j, k coordinates in each plot3d block
+  // print the number of i, j, k coordinates in each plot3d block
   cout << "Size of each block is..." << endl;
-  vector<vector3d<int>> blkSize(numBlks);
-  auto tempInt = 0;
   numCells = 0;
-
-  // loop over all blocks and fill i, j, k vectors with block sizes
   for (auto ii = 0; ii < numBlks; ii++) {
+    const auto size = file.BlockSize(ii);
     cout << "Block Number: " << ii << "     ";
-    fName.read(reinterpret_cast<char *>(&tempInt), sizeof(tempInt));
-    blkSize[ii][0] = tempInt;
-    cout << "I-DIM: " << tempInt << "     ";
-    fName.read(reinterpret_cast<char *>(&tempInt), sizeof(tempInt));
-    blkSize[ii][1] = tempInt;
-    cout << "J-DIM: " << tempInt << "     ";
-    fName.read(reinterpret_cast<char *>(&tempInt), sizeof(tempInt));
-    blkSize[ii][2] = tempInt;
-    cout << "K-DIM: " << tempInt << endl;
+    cout << "I-DIM: " << size[0] << "     ";
+    cout << "J-DIM: " << size[1] << "     ";
+    cout << "K-DIM: " << size[2] << endl;
 
     // calculate total number of cells (subtract 1 because number of cells is 1
     // less than number of points)
-    numCells +=
-        (blkSize[ii][0] - 1) * (blkSize[ii][1] - 1) * (blkSize[ii][2] - 1);
+    numCells += (size[0] - 1) * (size[1] - 1) * (size[2] - 1);
   }
   cout << endl;
 
   // read each block and add it to the vector of plot3dBlocks
-  auto tempDouble = 0.0;
   vector<plot3dBlock> mesh;
   mesh.reserve(numBlks);
-
   for (auto ii = 0; ii < numBlks; ii++) {
-    multiArray3d<vector3d<double>> coordinates(blkSize[ii][0], blkSize[ii][1],
-                                               blkSize[ii][2], 0);
-
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[0] = tempDouble / LRef;
-    }
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[1] = tempDouble / LRef;
-    }
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[2] = tempDouble / LRef;
-    }
-
-    // create single plot3dBlock and assign it appropriate location in vector
-    mesh.push_back(plot3dBlock(coordinates));
-
+    mesh.push_back(
+        plot3dBlock(file.ReadNodes(ii, {0, 0, 0}, file.BlockSize(ii))));
     cout << "Block " << ii << " read" << endl;
   }
 
   cout << endl << "Grid file read" << endl;
   cout << "Total number of cells is " << numCells << endl;
 
-  // close plot3d grid file
-  fName.close();
+  return mesh;
+}
+
 
+/* Function to open a binary plot3d grid file without reading the coordinates.
+The blocks returned only store where they are in the file, so they can be
+decomposed using their sizes and the few nodes needed to match up the
+connection boundaries. Each processor then reads only its own blocks with
+plot3dBlock::Read().
+*/
+vector<plot3dBlock> OpenP3dGrid(const string &gridName, const double &LRef) {
+  // gridName -- name of grid file (without extension)
+  // LRef -- reference length to nondimensionalize grid by
+
+  const auto file = make_shared<const plot3dGridFile>(gridName, LRef);
+  vector<plot3dBlock> mesh;
+  mesh.reserve(file->NumBlocks());
+  for (auto ii = 0; ii < file->NumBlocks(); ii++) {
+    mesh.push_back(plot3dBlock(file, ii));
+  }
   return mesh;
 }
 
+// constructor for plot3dGridFile -- open file and read header
+plot3dGridFile::plot3dGridFile(const string &gridName, const double &LRef)
+    : fileName_(gridName + ".xyz"), lRef_(LRef) {
+  // gridName -- name of grid file (without extension)
+  // LRef -- reference length to nondimensionalize grid by
+
+  file_.open(fileName_, ios::in | ios::binary);
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dGridFile::plot3dGridFile(). Grid file "
+         << fileName_ << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // header is the number of blocks and then the number of i, j, k nodes in
+  // each block; the x, y, z coordinates of each block follow in turn
+  auto numBlks = 1;
+  file_.read(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
+  blkSize_.resize(numBlks);
+  blkStart_.resize(numBlks);
+  for (auto &size : blkSize_) {
+    for (auto dd = 0; dd < 3; dd++) {
+      file_.read(reinterpret_cast<char *>(&size[dd]), sizeof(size[dd]));
+    }
+  }
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dGridFile::plot3dGridFile(). Could not read "
+         << "header of grid file " << fileName_ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  std::streamoff offset = file_.tellg();
+  for (auto ii = 0; ii < numBlks; ii++) {
+    blkStart_[ii] = offset;
+    offset += 3 * static_cast<std::streamoff>(blkSize_[ii][0]) *
+        blkSize_[ii][1] * blkSize_[ii][2] * sizeof(double);
+  }
+}
+
+// member function to get the file offset of one coordinate of a node
+std::streamoff plot3dGridFile::NodeOffset(const int &blk, const int &dim,
+                                          const int &ii, const int &jj,
+                                          const int &kk) const {
+  // blk -- block in grid file
+  // dim -- coordinate (0-x, 1-y, 2-z)
+  // ii -- i-index of node
+  // jj -- j-index of node
+  // kk -- k-index of node
+
+  const auto &size = blkSize_[blk];
+  const auto numNodes =
+      static_cast<std::streamoff>(size[0]) * size[1] * size[2];
+  const auto index = dim * numNodes +
+      (static_cast<std::streamoff>(kk) * size[1] + jj) * size[0] + ii;
+  return blkStart_[blk] + index * sizeof(double);
+}
+
+// member function to read the coordinates of one node
+vector3d<double> plot3dGridFile::Coords(const int &blk, const int &ii,
+                                        const int &jj, const int &kk) const {
+  // blk -- block in grid file
+  // ii -- i-index of node
+  // jj -- j-index of node
+  // kk -- k-index of node
+
+  vector3d<double> coords;
+  for (auto dd = 0; dd < 3; dd++) {
+    auto tempDouble = 0.0;
+    file_.seekg(this->NodeOffset(blk, dd, ii, jj, kk));
+    file_.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
+    coords[dd] = tempDouble / lRef_;
+  }
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dGridFile::Coords(). Could not read node "
+         << ii << ", " << jj << ", " << kk << " of block " << blk
+         << " from grid file " << fileName_ << endl;
+    exit(EXIT_FAILURE);
+  }
+  return coords;
+}
+
+/* Member function to read the nodes in a box of a block. Coordinates are
+stored one after another, each with i varying fastest, so the nodes of the box
+are read in as few pieces as its shape allows. A box that covers whole i-lines
+and j-lines of the block is read many k-planes at a time. A box that covers
+whole i-lines, or most of each i-line, is read a k-plane at a time; the nodes
+outside the box are read and skipped, which is faster than seeking to each
+i-line. Otherwise the box is read an i-line at a time. Each piece is scaled in
+its own pass over contiguous values, so the loop is vectorized by the compiler.
+*/
+multiArray3d<vector3d<double>> plot3dGridFile::ReadNodes(
+    const int &blk, const vector3d<int> &start,
+    const vector3d<int> &num) const {
+  // blk -- block in grid file
+  // start -- first node of box
+  // num -- number of nodes in box
+
+  // maximum number of values in a read, unless a single k-plane is larger
+  constexpr auto maxReadSize = 1 << 20;
+
+  // find number of i-lines of box read at once; consecutive i-lines are
+  // one i-line of the block apart in the file
+  const auto &size = blkSize_[blk];
+  const auto numLines = num[1] * num[2];
+  auto linesPerRead = 1;
+  if (num[0] == size[0] && num[1] == size[1]) {
+    const auto planeSize = num[0] * num[1];
+    linesPerRead = num[1] * std::max(1, maxReadSize / std::max(1, planeSize));
+  } else if (2 * num[0] >= size[0]) {
+    linesPerRead = num[1];
+  }
+
+  multiArray3d<vector3d<double>> coordinates(num[0], num[1], num[2], 0);
+  vector<double> values;
+  for (auto dd = 0; dd < 3; dd++) {
+    for (auto line = 0; line < numLines; line += linesPerRead) {
+      const auto numRead = std::min(linesPerRead, numLines - line);
+      values.resize(static_cast<size_t>(numRead - 1) * size[0] + num[0]);
+      const auto jj = line % num[1];
+      const auto kk = line / num[1];
+      file_.seekg(this->NodeOffset(blk, dd, start[0], start[1] + jj,
+                                   start[2] + kk));
+      file_.read(reinterpret_cast<char *>(values.data()),
+                 values.size() * sizeof(double));
+
+      // nondimensionalize
+      for (auto &val : values) {
+        val /= lRef_;
+      }
+
+      // i-lines are in the same order in the file and the box
+      auto node = line * num[0];
+      for (auto ll = 0; ll < numRead; ll++) {
+        const auto *lineValues = values.data() + ll * size[0];
+        for (auto ii = 0; ii < num[0]; ii++) {
+          coordinates(node++)[dd] = lineValues[ii];
+        }
+      }
+    }
+  }
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dGridFile::ReadNodes(). Could not read "
+         << "block " << blk << " from grid file " << fileName_ << endl;
+    exit(EXIT_FAILURE);
+  }
+  return coordinates;
+}
+
+// member function to get a plot3dBlock with its coordinates read from the grid
+// file
+plot3dBlock plot3dBlock::Read() const {
+  return this->IsRead()
+      ? *this
+      : plot3dBlock(file_->ReadNodes(fileBlock_, fileStart_, fileNum_));
+}
 
 /* Member function to split a plot3dBlock along a plane defined by a direction
-and an index.
+and an index. If the block has not been read yet, only its location in the grid
+file is split.
 */
 void plot3dBlock::Split(const string &dir, const int &ind, plot3dBlock &blk1,
                         plot3dBlock &blk2) const {
   // dir -- plane to split along, either i, j, or k
   // ind -- index (face) to split at (w/o counting ghost cells)
 
-  blk1 = plot3dBlock(coords_.Slice(dir, {coords_.Start(dir), ind + 1}));
-  blk2 = plot3dBlock(coords_.Slice(dir, {ind, coords_.End(dir)}));
+  if (this->IsRead()) {
+    blk1 = plot3dBlock(coords_.Slice(dir, {coords_.Start(dir), ind + 1}));
+    blk2 = plot3dBlock(coords_.Slice(dir, {ind, coords_.End(dir)}));
+    return;
+  }
+
+  const auto dd = (dir == "i") ? 0 : (dir == "j") ? 1 : 2;
+  blk1 = *this;
+  blk1.fileNum_[dd] = ind + 1;
+  blk2 = *this;
+  blk2.fileStart_[dd] += ind;
+  blk2.fileNum_[dd] -= ind;
 }
 
 /* Member function to join a plot3dBlock along a plane defined by a direction.
@@ -461,6 +608,12 @@ The calling instance will be the lower portion of the joined block,
 and the input instance will be the upper portion of the joined block.
 */
 void plot3dBlock::Join(const plot3dBlock &blk, const string &dir) {
+  if (!this->IsRead() || !blk.IsRead()) {
+    cerr << "ERROR: Error in plot3dBlock::Join(). Blocks must be read from "
+         << "the grid file before they are joined." << endl;
+    exit(EXIT_FAILURE);
+  }
+
   auto iTot = this->NumI();
   auto jTot = this->NumJ();
   auto kTot = this->NumK();
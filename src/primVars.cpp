@@ -37,35 +37,12 @@ using std::max;
 using std::min;
 using std::unique_ptr;
 
+// constructor from conserved or primative variables using abstract models
 primVars::primVars(const genArray &a, const bool &prim,
                    const unique_ptr<eos> &eqnState,
                    const unique_ptr<thermodynamic> &thermo,
-                   const unique_ptr<turbModel> &turb) {
-  // a -- array of conservative or primative variables
-  // prim -- flag that is true if variable a is primative variables
-  // eqnState -- equation of state
-  // thermo -- thermodynamic model
-  // turb -- turbulence model
-
-  if (prim) {  // genArray is primative variables
-    for (auto ii = 0; ii < NUMVARS; ii++) {
-      data_[ii] = a[ii];
-    }
-  } else {  // genArray is conserved variables
-    data_[0] = a[0];
-    data_[1] = a[1] / a[0];
-    data_[2] = a[2] / a[0];
-    data_[3] = a[3] / a[0];
-    const auto energy = a[4] / a[0];
-    data_[4] = eqnState->PressFromEnergy(thermo, data_[0], energy,
-                                         this->Velocity().Mag());
-    data_[5] = a[5] / a[0];
-    data_[6] = a[6] / a[0];
-  }
-
-  // Adjust turbulence variables to be above minimum if necessary
-  this->LimitTurb(turb);
-}
+                   const unique_ptr<turbModel> &turb)
+    : primVars(a, prim, *eqnState, *thermo, turb) {}
 
 // member function to initialize a state with nondimensional values
 void primVars::NondimensionalInitialize(const unique_ptr<eos> &eqnState,
@@ -175,7 +152,7 @@ Ui+1/2 = Ui + 0.25 * ((Ui - Ui-1) / dM) * ( (1-K) * L  + (1+K) * R * Linv )
 */
 primVars primVars::FaceReconMUSCL(const primVars &primUW2,
                                   const primVars &primDW1, const double &kappa,
-                                  const string &lim, const double &uw,
+                                  const limiterType &lim, const double &uw,
                                   const double &uw2, const double &dw) const {
   // primUW2 -- upwind cell furthest from the face at which the primative is
   //            being reconstructed.
@@ -183,6 +160,7 @@ primVars primVars::FaceReconMUSCL(const primVars &primUW2,
   //            being reconstructed.
   // primDW1 -- downwind cell.
   // kappa -- parameter that determines which scheme is implemented
+  // lim -- limiter to use
   // uw -- length of upwind cell
   // uw2 -- length of furthest upwind cell
   // dw -- length of downwind cell
@@ -199,18 +177,19 @@ primVars primVars::FaceReconMUSCL(const primVars &primUW2,
 
   primVars limiter;
   primVars invLimiter;
-  if (lim == "none") {
-    limiter = LimiterNone();
-    invLimiter = limiter;
-  } else if (lim == "vanAlbada") {
-    limiter = LimiterVanAlbada(r);
-    invLimiter = LimiterVanAlbada(1.0 / r);
-  } else if (lim == "minmod") {
-    limiter = LimiterMinmod(primUW1 - primUW2, primDW1 - primUW1, kappa);
-    invLimiter = limiter / r;
-  } else {
-    cerr << "ERROR: Limiter " << lim << " is not recognized!" << endl;
-    exit(EXIT_FAILURE);
+  switch (lim) {
+    case limiterType::none:
+      limiter = LimiterNone();
+      invLimiter = limiter;
+      break;
+    case limiterType::vanAlbada:
+      limiter = LimiterVanAlbada(r);
+      invLimiter = LimiterVanAlbada(1.0 / r);
+      break;
+    case limiterType::minmod:
+      limiter = LimiterMinmod(primUW1 - primUW2, primDW1 - primUW1, kappa);
+      invLimiter = limiter / r;
+      break;
   }
 
   // calculate reconstructed state at face using MUSCL method with limiter
@@ -226,30 +205,34 @@ primVars primVars::FaceReconWENO(const primVars &upwind2,
                                  const double &uw2, const double &uw3,
                                  const double &dw1, const double &dw2,
                                  const bool &isWenoZ) const {
-  // get candidate smaller stencils
-  const vector<double> cellWidth = {uw3, uw2, uw1, dw1, dw2};
-
-  constexpr auto degree = 2;
-  constexpr auto up1Loc = 2;
-  const auto coeffs0 = LagrangeCoeff(cellWidth, degree, 2, up1Loc);
-  const auto stencil0 = coeffs0[0] * upwind3 + coeffs0[1] * upwind2 +
-      coeffs0[2] * (*this);
-
-  const auto coeffs1 = LagrangeCoeff(cellWidth, degree, 1, up1Loc);
-  const auto stencil1 = coeffs1[0] * upwind2 + coeffs1[1] * (*this) +
-      coeffs1[2] * downwind1;
-
-  const auto coeffs2 = LagrangeCoeff(cellWidth, degree, 0, up1Loc);
-  const auto stencil2 = coeffs2[0] * (*this) + coeffs2[1] * downwind1 +
-      coeffs2[2] * downwind2;
+  const wenoCoeffs coeffs(uw1, uw2, uw3, dw1, dw2);
+  return this->FaceReconWENO(upwind2, upwind3, downwind1, downwind2, coeffs,
+                             uw1, uw2, uw3, dw1, dw2, isWenoZ);
+}
 
-  // get coefficients for large stencil
-  const auto fullCoeffs = LagrangeCoeff(cellWidth, 4, 2, up1Loc);
+// member function for higher order reconstruction via weno with
+// precalculated coefficients; only the smoothness indicators and nonlinear
+// weights are calculated here
+primVars primVars::FaceReconWENO(const primVars &upwind2,
+                                 const primVars &upwind3,
+                                 const primVars &downwind1,
+                                 const primVars &downwind2,
+                                 const wenoCoeffs &coeffs, const double &uw1,
+                                 const double &uw2, const double &uw3,
+                                 const double &dw1, const double &dw2,
+                                 const bool &isWenoZ) const {
+  // get candidate smaller stencils
+  const auto stencil0 = coeffs.Stencil(0, 0) * upwind3 +
+      coeffs.Stencil(0, 1) * upwind2 + coeffs.Stencil(0, 2) * (*this);
+  const auto stencil1 = coeffs.Stencil(1, 0) * upwind2 +
+      coeffs.Stencil(1, 1) * (*this) + coeffs.Stencil(1, 2) * downwind1;
+  const auto stencil2 = coeffs.Stencil(2, 0) * (*this) +
+      coeffs.Stencil(2, 1) * downwind1 + coeffs.Stencil(2, 2) * downwind2;
 
   // linear weights
-  const auto lw0 = fullCoeffs[0] / coeffs0[0];
-  const auto lw1 = fullCoeffs[4] / coeffs2[2];
-  const auto lw2 = 1.0 - lw0 - lw1;
+  const auto lw0 = coeffs.LinearWeight(0);
+  const auto lw1 = coeffs.LinearWeight(1);
+  const auto lw2 = coeffs.LinearWeight(2);
 
   const auto beta0 = Beta0(uw3, uw2, uw1, upwind3, upwind2, (*this));
   const auto beta1 = Beta1(uw2, uw1, dw1, upwind2, (*this), downwind1);
@@ -848,14 +831,7 @@ primVars primVars::UpdateWithConsVars(const unique_ptr<eos> &eqnState,
                                       const unique_ptr<thermodynamic> &thermo,
                                       const genArray &du,
                                       const unique_ptr<turbModel> &turb) const {
-  // eqnState -- equation of state
-  // du -- updates to conservative variables
-  // turb -- turbulence model
-
-  // convert primative to conservative and update
-  const auto consUpdate = this->ConsVars(eqnState, thermo) + du;
-
-  return primVars(consUpdate, false, eqnState, thermo, turb);
+  return this->UpdateWithConsVars(*eqnState, *thermo, du, turb);
 }
 
 bool primVars::IsZero() const {
@@ -897,34 +873,13 @@ void primVars::LimitTurb(const unique_ptr<turbModel> &turb) {
   data_[6] = max(data_[6], turb->OmegaMin());
 }
 
-/*Function to return the inviscid spectral radius for one direction (i, j, or k)
-given a cell state, equation of state, and 2 face area vectors
-
-L = 0.5 * (A1 + A2) * (|Vn| + SoS)
-
-In the above equation L is the spectral radius in either the i, j, or k
-direction. A1 and A2 are the two face areas in that direction. Vn is the
-cell velocity normal to that direction. SoS is the speed of sound at the cell
- */
+// member function to return the inviscid spectral radius for one direction
+// (i, j, or k) given a cell state, equation of state, and 2 face area vectors
 double primVars::InvCellSpectralRadius(const unitVec3dMag<double> &fAreaL,
                                        const unitVec3dMag<double> &fAreaR,
                                        const unique_ptr<thermodynamic> &thermo,
                                        const unique_ptr<eos> &eqnState) const {
-  // fAreaL -- face area of lower face in either i, j, or k direction
-  // fAreaR -- face area of upper face in either i, j, or k direction
-  // thermo -- thermodynamic model
-  // eqnState -- equation of state
-
-  // normalize face areas
-  const auto normAvg = (0.5 * (fAreaL.UnitVector() +
-                               fAreaR.UnitVector())).Normalize();
-  // average area magnitude
-  const auto fMag = 0.5 * (fAreaL.Mag() + fAreaR.Mag());
-
-  // return spectral radius
-  return (fabs(this->Velocity().DotProd(normAvg)) +
-          this->SoS(thermo, eqnState)) *
-         fMag;
+  return this->InvCellSpectralRadius(fAreaL, fAreaR, *thermo, *eqnState);
 }
 
 double primVars::InvFaceSpectralRadius(const unitVec3dMag<double> &fArea,
@@ -1058,30 +1013,6 @@ double primVars::FaceSpectralRadius(const unitVec3dMag<double> &fArea,
   return specRad;
 }
 
-
-// function to calculate the Roe averaged state
-primVars RoeAveragedState(const primVars &left, const primVars &right) {
-  // compute Rho averaged quantities
-  // density ratio
-  const auto denRatio = sqrt(right.Rho() / left.Rho());
-  // Roe averaged density
-  const auto rhoR = left.Rho() * denRatio;
-  // Roe averaged velocities - u, v, w
-  const auto uR = (left.U() + denRatio * right.U()) / (1.0 + denRatio);
-  const auto vR = (left.V() + denRatio * right.V()) / (1.0 + denRatio);
-  const auto wR = (left.W() + denRatio * right.W()) / (1.0 + denRatio);
-
-  // Roe averaged pressure
-  const auto pR = (left.P() + denRatio * right.P()) / (1.0 + denRatio);
-
-  // Roe averaged tke
-  const auto kR = (left.Tke() + denRatio * right.Tke()) / (1.0 + denRatio);
-  // Roe averaged specific dissipation (omega)
-  const auto omR = (left.Omega() + denRatio * right.Omega()) / (1.0 + denRatio);
-
-  return primVars(rhoR, uR, vR, wR, pR, kR, omR);
-}
-
 // return element by element squared values
 primVars primVars::Squared() const {
   return (*this) * (*this);
@@ -19,6 +19,8 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <limits>
+#include <chrono>               // steady_clock
 #include "procBlock.hpp"
 #include "plot3d.hpp"              // plot3d
 #include "eos.hpp"                 // equation of state
@@ -60,6 +62,7 @@ procBlock::procBlock(const plot3dBlock &blk, const int &numBlk,
   // inp -- input variables
 
   numGhosts_ = inp.NumberGhostLayers();
+  arrayPadding_ = inp.ArrayPadding();
   parBlock_ = numBlk;
 
   rank_ = r;
@@ -148,6 +151,8 @@ procBlock::procBlock(const plot3dBlock &blk, const int &numBlk,
     f1_ = {0, 0, 0, 0, 0.0};
     f2_ = {0, 0, 0, 0, 0.0};
   }
+
+  this->PadArrays();
 }
 
 // constructor -- allocate space for procBlock
@@ -163,6 +168,7 @@ procBlock::procBlock(const int &ni, const int &nj, const int &nk,
   // isTurbulent -- flag to determine if solution is turbulent
 
   numGhosts_ = numG;
+  arrayPadding_ = 0;
   parBlock_ = 0;
 
   rank_ = 0;
@@ -398,6 +404,62 @@ void procBlock::InitializeStates(const input &inp,
       }
     }
   }
+
+  // reassigned arrays need to be padded again
+  this->PadArrays();
+}
+
+// number of cells on each side of a face used in the inviscid flux stencil
+template <reconstruction R>
+constexpr int InviscidStencilReach() {
+  return (R == reconstruction::constant) ? 1 :
+      (R == reconstruction::muscl) ? 2 : 3;
+}
+
+// pass used for the faces of a line; the faces only need to be checked for
+// stencils using viscous wall ghost cells if there are viscous walls on the
+// boundaries in the direction of the faces
+facePass LineFacePass(const facePass &pass, const bool &hasWall) {
+  if (!hasWall || pass == facePass::interior ||
+      pass == facePass::inviscidBoundary) {
+    return facePass::inviscid;
+  }
+  return (pass == facePass::fusedBoundary) ? facePass::fused : pass;
+}
+
+// function to determine if a pass only calculates the inviscid fluxes on the
+// faces near the boundaries
+bool IsBoundaryFacePass(const facePass &pass) {
+  return pass == facePass::inviscidWall ||
+      pass == facePass::inviscidBoundary || pass == facePass::fusedBoundary;
+}
+
+// function to determine if a pass calculates the viscous fluxes
+bool IsFusedFacePass(const facePass &pass) {
+  return pass == facePass::fused || pass == facePass::fusedBoundary;
+}
+
+// function to determine if a boundary face is on one of the given surfaces;
+// all surfaces are on the same boundary, so the face is given by its indices
+// in the two directions tangent to the boundary (0 = i, 1 = j, 2 = k is the
+// direction normal to the boundary)
+bool OnSurface(const vector<boundarySurface> &surfs, const int &dir,
+               const int &ind1, const int &ind2) {
+  // surfs -- surfaces on boundary
+  // dir -- direction normal to boundary
+  // ind1 -- first tangent index of face (i for j/k-boundaries, j otherwise)
+  // ind2 -- second tangent index of face (k for i/j-boundaries, j otherwise)
+
+  for (const auto &surf : surfs) {
+    const auto in1 = (dir == 0) ? ind1 >= surf.JMin() && ind1 < surf.JMax() :
+        ind1 >= surf.IMin() && ind1 < surf.IMax();
+    const auto in2 = (dir == 2) ? ind2 >= surf.JMin() && ind2 < surf.JMax() :
+        ind2 >= surf.KMin() && ind2 < surf.KMax();
+    if (in1 && in2) {
+      return true;
+    }
+  }
+  return false;
 }
 
 /* Function to calculate the inviscid fluxes on the i-faces. All phyiscal
@@ -426,113 +488,243 @@ a cell basis instead of a face bases, it is only calculated for the upper cell
 (Ui+1 in this case). The spectral radius is added to the average wave speed
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
+
+The faces are processed one line at a time. In the fused pass the viscous
+fluxes for each line are calculated right after the inviscid fluxes, while the
+cells around the line are still in cache.
 */
-void procBlock::CalcInvFluxI(const unique_ptr<eos> &eqnState,
-                             const unique_ptr<thermodynamic> &thermo,
-                             const input &inp,
-                             const unique_ptr<turbModel> &turb,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcFaceFluxI(const unique_ptr<eos> &eqnState,
+                              const unique_ptr<thermodynamic> &thermo,
+                              const unique_ptr<transport> &trans,
+                              const input &inp,
+                              const unique_ptr<turbModel> &turb,
+                              const facePass &pass,
+                              implicitDiagonal &mainDiagonal) {
   // eqnState -- equation of state
   // thermo -- thermodynamic model
+  // trans -- viscous transport model
   // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
 
-  // loop over all physical i-faces
-  for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
-    for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
-        primVars faceStateLower, faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = state_(ii - 1, jj, kk).FaceReconConst();
-          faceStateUpper = state_(ii, jj, kk).FaceReconConst();
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = state_(ii - 1, jj, kk).FaceReconMUSCL(
-                state_(ii - 2, jj, kk), state_(ii, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii, jj, kk));
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
-                state_(ii + 1, jj, kk), state_(ii - 1, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthI_(ii, jj, kk),
-                cellWidthI_(ii + 1, jj, kk), cellWidthI_(ii - 1, jj, kk));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = state_(ii - 1, jj, kk).FaceReconWENO(
-                state_(ii - 2, jj, kk), state_(ii - 3, jj, kk),
-                state_(ii, jj, kk), state_(ii + 1, jj, kk),
-                cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii - 2, jj, kk),
-                cellWidthI_(ii - 3, jj, kk), cellWidthI_(ii, jj, kk),
-                cellWidthI_(ii + 1, jj, kk), inp.IsWenoZ());
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
-                state_(ii + 1, jj, kk), state_(ii + 2, jj, kk),
-                state_(ii - 1, jj, kk), state_(ii - 2, jj, kk),
-                cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk),
-                cellWidthI_(ii + 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii - 2, jj, kk), inp.IsWenoZ());
-          }
-        }
+  constexpr auto reach = InviscidStencilReach<R>();
 
-        // calculate inviscid flux at face
-        const inviscidFlux tempFlux =
-            InviscidFlux(faceStateLower, faceStateUpper, eqnState, thermo,
-                         this->FAreaUnitI(ii, jj, kk), inp.InviscidFlux());
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell
-        // at left boundary there is no left cell to add to
-        if (ii > fAreaI_.PhysStartI()) {
-          this->AddToResidual(tempFlux * this->FAreaMagI(ii, jj, kk),
-                              ii - 1, jj, kk);
-
-          // if using a block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, eqnState, thermo,
-                                        this->FAreaI(ii, jj, kk), true,
-                                        inp, turb);
-            mainDiagonal(ii - 1, jj, kk) += fluxJac;
-          }
+  // faces only need to be checked for stencils using viscous wall ghost cells
+  // if there are viscous walls on the i-boundaries
+  const auto walls = this->ViscousWalls(1);
+  if (pass == facePass::inviscidWall && walls.Empty()) {
+    return;
+  }
+  const auto linePass = LineFacePass(pass, !walls.Empty());
+
+  // face states, unit area vectors, and fluxes for a line of faces in the
+  // i-direction; the fluxes for the whole line are calculated at once so that
+  // the flux kernel can operate on several faces at a time
+  const auto iStart = fAreaI_.PhysStartI();
+  const auto iEnd = fAreaI_.PhysEndI();
+
+  // only the faces at the ends of the line use ghost cells
+  const auto lowerEnd = std::min(iStart + reach, iEnd);
+  const auto upperStart = std::max(iEnd - reach, lowerEnd);
+
+  // lines of i-faces only update the cells on the line, so the lines are
+  // divided among the threads
+#pragma omp parallel
+  {
+    inviscidFluxLine line(iEnd - iStart);
+
+    // loop over all physical i-faces
+#pragma omp for collapse(2) schedule(static)
+    for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
+      for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
+        if (pass == facePass::interior) {
+          this->CalcInvFluxLineI<R, F, E, T>(lowerEnd, upperStart, jj, kk,
+                                             eqnState, thermo, inp, turb,
+                                             linePass, walls, line,
+                                             mainDiagonal);
+        } else if (IsBoundaryFacePass(pass)) {
+          this->CalcInvFluxLineI<R, F, E, T>(iStart, lowerEnd, jj, kk,
+                                             eqnState, thermo, inp, turb,
+                                             linePass, walls, line,
+                                             mainDiagonal);
+          this->CalcInvFluxLineI<R, F, E, T>(upperStart, iEnd, jj, kk,
+                                             eqnState, thermo, inp, turb,
+                                             linePass, walls, line,
+                                             mainDiagonal);
+        } else {
+          this->CalcInvFluxLineI<R, F, E, T>(iStart, iEnd, jj, kk, eqnState,
+                                             thermo, inp, turb, linePass,
+                                             walls, line, mainDiagonal);
         }
-
-        // at right boundary there is no right cell to add to
-        if (ii < fAreaI_.PhysEndI() - 1) {
-          this->SubtractFromResidual(tempFlux *
-                                     this->FAreaMagI(ii, jj, kk),
-                                     ii, jj, kk);
-
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
-              fAreaI_(ii, jj, kk), fAreaI_(ii + 1, jj, kk), thermo, eqnState);
-
-          const auto turbInvSpecRad = isRANS_ ?
-              turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaI_(ii, jj, kk),
-                                        fAreaI_(ii + 1, jj, kk)): 0.0;
-
-          const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
-          specRadius_(ii, jj, kk) += specRad;
-
-          // if using a block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, eqnState, thermo,
-                                        this->FAreaI(ii, jj, kk), false,
-                                        inp, turb);
-            mainDiagonal(ii, jj, kk) -= fluxJac;
-          } else if (inp.IsImplicit()) {
-            mainDiagonal(ii, jj, kk) += fluxJacobian(specRad);
-          }
+        if (IsFusedFacePass(pass)) {
+          this->CalcViscFluxLineI(jj, kk, trans, thermo, eqnState, inp, turb,
+                                  mainDiagonal);
         }
       }
     }
   }
 }
 
+// member function to calculate the inviscid fluxes on the i-faces from iStart
+// to iEnd along a line of constant j and k
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcInvFluxLineI(const int &iStart, const int &iEnd,
+                                 const int &jj, const int &kk,
+                                 const unique_ptr<eos> &eqnState,
+                                 const unique_ptr<thermodynamic> &thermo,
+                                 const input &inp,
+                                 const unique_ptr<turbModel> &turb,
+                                 const facePass &pass,
+                                 const viscousWalls &walls,
+                                 inviscidFluxLine &line,
+                                 implicitDiagonal &mainDiagonal) {
+  // iStart -- first face in line
+  // iEnd -- one past last face in line
+  // jj -- j-index of line
+  // kk -- k-index of line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces to calculate
+  // walls -- viscous wall surfaces on the boundaries in direction of faces
+  // line -- storage for face states and fluxes along line
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  // concrete models chosen by the dispatcher; calls through these are
+  // statically dispatched
+  const auto &eosModel = static_cast<const E &>(*eqnState);
+  const auto &thermoModel = static_cast<const T &>(*thermo);
+
+  const auto kappa = inp.Kappa();
+  const auto limiter = inp.LimiterType();
+  constexpr auto reach = InviscidStencilReach<R>();
+
+  // reconstruct face states along line
+  line.Resize(iEnd - iStart);
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    primVars faceStateLower, faceStateUpper;
+
+    // use constant reconstruction (first order)
+    if (R == reconstruction::constant) {
+      faceStateLower = state_(ii - 1, jj, kk).FaceReconConst();
+      faceStateUpper = state_(ii, jj, kk).FaceReconConst();
+    } else {  // second order accuracy
+      if (R == reconstruction::muscl) {
+        faceStateLower = state_(ii - 1, jj, kk).FaceReconMUSCL(
+            state_(ii - 2, jj, kk), state_(ii, jj, kk),
+            kappa, limiter, cellWidthI_(ii - 1, jj, kk),
+            cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii, jj, kk));
+
+        faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
+            state_(ii + 1, jj, kk), state_(ii - 1, jj, kk),
+            kappa, limiter, cellWidthI_(ii, jj, kk),
+            cellWidthI_(ii + 1, jj, kk), cellWidthI_(ii - 1, jj, kk));
+
+      } else {  // using higher order reconstruction (weno, wenoz)
+        faceStateLower = state_(ii - 1, jj, kk).FaceReconWENO(
+            state_(ii - 2, jj, kk), state_(ii - 3, jj, kk),
+            state_(ii, jj, kk), state_(ii + 1, jj, kk),
+            wenoLowerI_(ii, jj, kk),
+            cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii - 2, jj, kk),
+            cellWidthI_(ii - 3, jj, kk), cellWidthI_(ii, jj, kk),
+            cellWidthI_(ii + 1, jj, kk), R == reconstruction::wenoZ);
+
+        faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
+            state_(ii + 1, jj, kk), state_(ii + 2, jj, kk),
+            state_(ii - 1, jj, kk), state_(ii - 2, jj, kk),
+            wenoUpperI_(ii, jj, kk),
+            cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk),
+            cellWidthI_(ii + 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
+            cellWidthI_(ii - 2, jj, kk), R == reconstruction::wenoZ);
+      }
+    }
+
+    line.Insert(ii - iStart, faceStateLower, faceStateUpper,
+                this->FAreaUnitI(ii, jj, kk));
+  }
+
+  // calculate inviscid flux at all faces in line
+  line.CalcFlux<F>(eosModel, thermoModel);
+
+  // faces whose stencil uses the slip wall ghost cells of a viscous wall are
+  // calculated in a separate pass before the ghost cells are overwritten; on a
+  // line of i-faces only the faces within reach of the ends of the line can
+  // use them, and the walls at the ends are the same for the whole line
+  const auto checkWall = pass != facePass::inviscid;
+  const auto lowerWall = checkWall && OnSurface(walls.lower_, 0, jj, kk);
+  const auto upperWall = checkWall && OnSurface(walls.upper_, 0, jj, kk);
+
+  // add flux contributions to residual
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    if (checkWall) {
+      const auto wallStencil =
+          (lowerWall && ii - reach < fAreaI_.PhysStartI()) ||
+          (upperWall && ii + reach > fAreaI_.PhysEndI() - 1);
+      if (wallStencil != (pass == facePass::inviscidWall)) {
+        continue;
+      }
+    }
+
+    const auto ff = ii - iStart;
+    const auto tempFlux = line.Flux<inviscidFlux>(ff);
+
+    // area vector points from left to right, so add to left cell, subtract
+    // from right cell
+    // at left boundary there is no left cell to add to
+    if (ii > fAreaI_.PhysStartI()) {
+      this->AddToResidual(tempFlux * this->FAreaMagI(ii, jj, kk),
+                          ii - 1, jj, kk);
+
+      // if using a block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        fluxJacobian fluxJac;
+        fluxJac.RusanovFluxJacobian(line.Lower<primVars>(ff),
+                                    eqnState, thermo,
+                                    this->FAreaI(ii, jj, kk), true,
+                                    inp, turb);
+        mainDiagonal.Block(ii - 1, jj, kk) += fluxJac;
+      }
+    }
+
+    // at right boundary there is no right cell to add to
+    if (ii < fAreaI_.PhysEndI() - 1) {
+      this->SubtractFromResidual(tempFlux *
+                                 this->FAreaMagI(ii, jj, kk),
+                                 ii, jj, kk);
+
+      // calculate component of wave speed. This is done on a cell by cell
+      // basis, so only at the upper faces
+      const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
+          fAreaI_(ii, jj, kk), fAreaI_(ii + 1, jj, kk), thermoModel,
+          eosModel);
+
+      const auto turbInvSpecRad = isRANS_ ?
+          turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaI_(ii, jj, kk),
+                                    fAreaI_(ii + 1, jj, kk)): 0.0;
+
+      const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
+      specRadius_(ii, jj, kk) += specRad;
+
+      // if using a block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        fluxJacobian fluxJac;
+        fluxJac.RusanovFluxJacobian(line.Upper<primVars>(ff),
+                                    eqnState, thermo,
+                                    this->FAreaI(ii, jj, kk), false,
+                                    inp, turb);
+        mainDiagonal.Block(ii, jj, kk) -= fluxJac;
+      } else if (inp.IsImplicit()) {
+        mainDiagonal.Scalar(ii, jj, kk) += specRad;
+      }
+    }
+  }
+}
+
 /* Function to calculate the inviscid fluxes on the j-faces. All physical
 (non-ghost) j-faces are looped over. The left and right states are
 calculated, and then the flux at the face is calculated. The flux at the
@@ -559,112 +751,232 @@ a cell basis instead of a face bases, it is only calculated for the upper cell
 (Uj+1 in this case). The spectral radius is added to the average wave speed
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
+
+The faces are processed one line at a time. In the fused pass the viscous
+fluxes for each line are calculated right after the inviscid fluxes, while the
+cells around the line are still in cache.
 */
-void procBlock::CalcInvFluxJ(const unique_ptr<eos> &eqnState,
-                             const unique_ptr<thermodynamic> &thermo,
-                             const input &inp,
-                             const unique_ptr<turbModel> &turb,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcFaceFluxJ(const unique_ptr<eos> &eqnState,
+                              const unique_ptr<thermodynamic> &thermo,
+                              const unique_ptr<transport> &trans,
+                              const input &inp,
+                              const unique_ptr<turbModel> &turb,
+                              const facePass &pass,
+                              implicitDiagonal &mainDiagonal) {
   // eqnState -- equation of state
   // thermo -- thermodynamic model
+  // trans -- viscous transport model
   // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
 
-  // loop over all physical j-faces
-  for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
-    for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
-        primVars faceStateLower, faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = state_(ii, jj - 1, kk).FaceReconConst();
-          faceStateUpper = state_(ii, jj, kk).FaceReconConst();
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = state_(ii, jj - 1, kk).FaceReconMUSCL(
-                state_(ii, jj - 2, kk), state_(ii, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj, kk));
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
-              state_(ii, jj + 1, kk), state_(ii, jj - 1, kk),
-              inp.Kappa(), inp.Limiter(), cellWidthJ_(ii, jj, kk),
-              cellWidthJ_(ii, jj + 1, kk), cellWidthJ_(ii, jj - 1, kk));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = state_(ii, jj - 1, kk).FaceReconWENO(
-                state_(ii, jj - 2, kk), state_(ii, jj - 3, kk),
-                state_(ii, jj, kk), state_(ii, jj + 1, kk),
-                cellWidthJ_(ii, jj - 1, kk), cellWidthJ_(ii, jj - 2, kk),
-                cellWidthJ_(ii, jj - 3, kk), cellWidthJ_(ii, jj, kk),
-                cellWidthJ_(ii, jj + 1, kk), inp.IsWenoZ());
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
-                state_(ii, jj + 1, kk), state_(ii, jj + 2, kk),
-                state_(ii, jj - 1, kk), state_(ii, jj - 2, kk),
-                cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk),
-                cellWidthJ_(ii, jj + 2, kk), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj - 2, kk), inp.IsWenoZ());
-          }
-        }
+  constexpr auto reach = InviscidStencilReach<R>();
 
-        // calculate inviscid flux at face
-        const inviscidFlux tempFlux =
-            InviscidFlux(faceStateLower, faceStateUpper, eqnState, thermo,
-                         this->FAreaUnitJ(ii, jj, kk), inp.InviscidFlux());
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell
-        // at left boundary no left cell to add to
-        if (jj > fAreaJ_.PhysStartJ()) {
-          this->AddToResidual(tempFlux * this->FAreaMagJ(ii, jj, kk),
-                              ii, jj - 1, kk);
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, eqnState, thermo,
-                                        this->FAreaJ(ii, jj, kk), true,
-                                        inp, turb);
-            mainDiagonal(ii, jj - 1, kk) += fluxJac;
-          }
+  // faces only need to be checked for stencils using viscous wall ghost cells
+  // if there are viscous walls on the j-boundaries
+  const auto walls = this->ViscousWalls(3);
+  if (pass == facePass::inviscidWall && walls.Empty()) {
+    return;
+  }
+  const auto linePass = LineFacePass(pass, !walls.Empty());
+
+  // face states, unit area vectors, and fluxes for a line of faces in the
+  // i-direction; the fluxes for the whole line are calculated at once so that
+  // the flux kernel can operate on several faces at a time
+  // j-faces update the cells on either side of them, so the lines of
+  // faces are split in the i-direction and each thread updates the cells in
+  // its own range of i; this keeps the order in which contributions are
+  // added to each cell the same as the serial loop
+#pragma omp parallel
+  {
+    auto iStart = 0;
+    auto iEnd = 0;
+    ThreadRange(fAreaJ_.PhysStartI(), fAreaJ_.PhysEndI(), iStart, iEnd);
+    inviscidFluxLine line(iEnd - iStart);
+
+    // loop over all physical j-faces
+    for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
+        if (iStart == iEnd) {
+          continue;
         }
-        // at right boundary no right cell to add to
-        if (jj < fAreaJ_.PhysEndJ() - 1) {
-          this->SubtractFromResidual(tempFlux *
-                                     this->FAreaMagJ(ii, jj, kk),
-                                     ii, jj, kk);
-
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
-              fAreaJ_(ii, jj, kk), fAreaJ_(ii, jj + 1, kk), thermo, eqnState);
-
-          const auto turbInvSpecRad = isRANS_ ?
-              turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
-                                        fAreaJ_(ii, jj + 1, kk)): 0.0;
-
-          const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
-          specRadius_(ii, jj, kk) += specRad;
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, eqnState, thermo,
-                                        this->FAreaJ(ii, jj, kk), false,
-                                        inp, turb);
-            mainDiagonal(ii, jj, kk) -= fluxJac;
-          } else if (inp.IsImplicit()) {
-            mainDiagonal(ii, jj, kk) += fluxJacobian(specRad);
-          }
+        // only the lines near the j-boundaries use ghost cells
+        const auto nearBoundary = jj < fAreaJ_.PhysStartJ() + reach ||
+            jj >= fAreaJ_.PhysEndJ() - reach;
+        if (nearBoundary ? pass != facePass::interior
+                         : !IsBoundaryFacePass(pass)) {
+          this->CalcInvFluxLineJ<R, F, E, T>(iStart, iEnd, jj, kk, eqnState,
+                                             thermo, inp, turb, linePass,
+                                             walls, line, mainDiagonal);
+        }
+        if (IsFusedFacePass(pass)) {
+          this->CalcViscFluxLineJ(iStart, iEnd, jj, kk, trans, thermo,
+                                  eqnState, inp, turb, mainDiagonal);
         }
       }
     }
   }
 }
 
+// member function to calculate the inviscid fluxes on the j-faces from iStart
+// to iEnd along a line of constant j and k
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcInvFluxLineJ(const int &iStart, const int &iEnd,
+                                 const int &jj, const int &kk,
+                                 const unique_ptr<eos> &eqnState,
+                                 const unique_ptr<thermodynamic> &thermo,
+                                 const input &inp,
+                                 const unique_ptr<turbModel> &turb,
+                                 const facePass &pass,
+                                 const viscousWalls &walls,
+                                 inviscidFluxLine &line,
+                                 implicitDiagonal &mainDiagonal) {
+  // iStart -- first face in line
+  // iEnd -- one past last face in line
+  // jj -- j-index of line
+  // kk -- k-index of line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces to calculate
+  // walls -- viscous wall surfaces on the boundaries in direction of faces
+  // line -- storage for face states and fluxes along line
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  // concrete models chosen by the dispatcher; calls through these are
+  // statically dispatched
+  const auto &eosModel = static_cast<const E &>(*eqnState);
+  const auto &thermoModel = static_cast<const T &>(*thermo);
+
+  const auto kappa = inp.Kappa();
+  const auto limiter = inp.LimiterType();
+  constexpr auto reach = InviscidStencilReach<R>();
+
+  // reconstruct face states along line
+  line.Resize(iEnd - iStart);
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    primVars faceStateLower, faceStateUpper;
+
+    // use constant reconstruction (first order)
+    if (R == reconstruction::constant) {
+      faceStateLower = state_(ii, jj - 1, kk).FaceReconConst();
+      faceStateUpper = state_(ii, jj, kk).FaceReconConst();
+    } else {  // second order accuracy
+      if (R == reconstruction::muscl) {
+        faceStateLower = state_(ii, jj - 1, kk).FaceReconMUSCL(
+            state_(ii, jj - 2, kk), state_(ii, jj, kk),
+            kappa, limiter, cellWidthJ_(ii, jj - 1, kk),
+            cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj, kk));
+
+        faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
+          state_(ii, jj + 1, kk), state_(ii, jj - 1, kk),
+          kappa, limiter, cellWidthJ_(ii, jj, kk),
+          cellWidthJ_(ii, jj + 1, kk), cellWidthJ_(ii, jj - 1, kk));
+
+      } else {  // using higher order reconstruction (weno, wenoz)
+        faceStateLower = state_(ii, jj - 1, kk).FaceReconWENO(
+            state_(ii, jj - 2, kk), state_(ii, jj - 3, kk),
+            state_(ii, jj, kk), state_(ii, jj + 1, kk),
+            wenoLowerJ_(ii, jj, kk),
+            cellWidthJ_(ii, jj - 1, kk), cellWidthJ_(ii, jj - 2, kk),
+            cellWidthJ_(ii, jj - 3, kk), cellWidthJ_(ii, jj, kk),
+            cellWidthJ_(ii, jj + 1, kk), R == reconstruction::wenoZ);
+
+        faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
+            state_(ii, jj + 1, kk), state_(ii, jj + 2, kk),
+            state_(ii, jj - 1, kk), state_(ii, jj - 2, kk),
+            wenoUpperJ_(ii, jj, kk),
+            cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk),
+            cellWidthJ_(ii, jj + 2, kk), cellWidthJ_(ii, jj - 1, kk),
+            cellWidthJ_(ii, jj - 2, kk), R == reconstruction::wenoZ);
+      }
+    }
+
+    line.Insert(ii - iStart, faceStateLower, faceStateUpper,
+                this->FAreaUnitJ(ii, jj, kk));
+  }
+
+  // calculate inviscid flux at all faces in line
+  line.CalcFlux<F>(eosModel, thermoModel);
+
+  // faces whose stencil uses the slip wall ghost cells of a viscous wall are
+  // calculated in a separate pass before the ghost cells are overwritten; on a
+  // line of j-faces this is only possible if the line is within reach of a
+  // j-boundary
+  const auto checkWall = pass != facePass::inviscid;
+  const auto nearLower = checkWall && jj - reach < fAreaJ_.PhysStartJ();
+  const auto nearUpper = checkWall && jj + reach > fAreaJ_.PhysEndJ() - 1;
+
+  // add flux contributions to residual
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    if (checkWall) {
+      const auto wallStencil =
+          (nearLower && OnSurface(walls.lower_, 1, ii, kk)) ||
+          (nearUpper && OnSurface(walls.upper_, 1, ii, kk));
+      if (wallStencil != (pass == facePass::inviscidWall)) {
+        continue;
+      }
+    }
+
+    const auto ff = ii - iStart;
+    const auto tempFlux = line.Flux<inviscidFlux>(ff);
+
+    // area vector points from left to right, so add to left cell, subtract
+    // from right cell
+    // at left boundary no left cell to add to
+    if (jj > fAreaJ_.PhysStartJ()) {
+      this->AddToResidual(tempFlux * this->FAreaMagJ(ii, jj, kk),
+                          ii, jj - 1, kk);
+
+      // if using block matrix on main diagonal, calculate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        fluxJacobian fluxJac;
+        fluxJac.RusanovFluxJacobian(line.Lower<primVars>(ff),
+                                    eqnState, thermo,
+                                    this->FAreaJ(ii, jj, kk), true,
+                                    inp, turb);
+        mainDiagonal.Block(ii, jj - 1, kk) += fluxJac;
+      }
+    }
+    // at right boundary no right cell to add to
+    if (jj < fAreaJ_.PhysEndJ() - 1) {
+      this->SubtractFromResidual(tempFlux *
+                                 this->FAreaMagJ(ii, jj, kk),
+                                 ii, jj, kk);
+
+      // calculate component of wave speed. This is done on a cell by cell
+      // basis, so only at the upper faces
+      const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
+          fAreaJ_(ii, jj, kk), fAreaJ_(ii, jj + 1, kk), thermoModel,
+          eosModel);
+
+      const auto turbInvSpecRad = isRANS_ ?
+          turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
+                                    fAreaJ_(ii, jj + 1, kk)): 0.0;
+
+      const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
+      specRadius_(ii, jj, kk) += specRad;
+
+      // if using block matrix on main diagonal, calculate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        fluxJacobian fluxJac;
+        fluxJac.RusanovFluxJacobian(line.Upper<primVars>(ff),
+                                    eqnState, thermo,
+                                    this->FAreaJ(ii, jj, kk), false,
+                                    inp, turb);
+        mainDiagonal.Block(ii, jj, kk) -= fluxJac;
+      } else if (inp.IsImplicit()) {
+        mainDiagonal.Scalar(ii, jj, kk) += specRad;
+      }
+    }
+  }
+}
+
 /* Function to calculate the inviscid fluxes on the k-faces. All phyiscal
 (non-ghost) k-faces are looped over. The left and right states are calculated,
 and then the flux at the face is calculated. The flux at the face contributes
@@ -691,111 +1003,403 @@ a cell basis instead of a face bases, it is only calculated for the upper cell
 (Uk+1 in this case). The spectral radius is added to the average wave speed
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
+
+The faces are processed one line at a time. In the fused pass the viscous
+fluxes for each line are calculated right after the inviscid fluxes, while the
+cells around the line are still in cache.
 */
-void procBlock::CalcInvFluxK(const unique_ptr<eos> &eqnState,
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcFaceFluxK(const unique_ptr<eos> &eqnState,
+                              const unique_ptr<thermodynamic> &thermo,
+                              const unique_ptr<transport> &trans,
+                              const input &inp,
+                              const unique_ptr<turbModel> &turb,
+                              const facePass &pass,
+                              implicitDiagonal &mainDiagonal) {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  constexpr auto reach = InviscidStencilReach<R>();
+
+  // faces only need to be checked for stencils using viscous wall ghost cells
+  // if there are viscous walls on the k-boundaries
+  const auto walls = this->ViscousWalls(5);
+  if (pass == facePass::inviscidWall && walls.Empty()) {
+    return;
+  }
+  const auto linePass = LineFacePass(pass, !walls.Empty());
+
+  // face states, unit area vectors, and fluxes for a line of faces in the
+  // i-direction; the fluxes for the whole line are calculated at once so that
+  // the flux kernel can operate on several faces at a time
+  // k-faces update the cells on either side of them, so the lines of
+  // faces are split in the i-direction and each thread updates the cells in
+  // its own range of i; this keeps the order in which contributions are
+  // added to each cell the same as the serial loop
+#pragma omp parallel
+  {
+    auto iStart = 0;
+    auto iEnd = 0;
+    ThreadRange(fAreaK_.PhysStartI(), fAreaK_.PhysEndI(), iStart, iEnd);
+    inviscidFluxLine line(iEnd - iStart);
+
+    // loop over all physical k-faces
+    for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
+      for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+        if (iStart == iEnd) {
+          continue;
+        }
+        // only the lines near the k-boundaries use ghost cells
+        const auto nearBoundary = kk < fAreaK_.PhysStartK() + reach ||
+            kk >= fAreaK_.PhysEndK() - reach;
+        if (nearBoundary ? pass != facePass::interior
+                         : !IsBoundaryFacePass(pass)) {
+          this->CalcInvFluxLineK<R, F, E, T>(iStart, iEnd, jj, kk, eqnState,
+                                             thermo, inp, turb, linePass,
+                                             walls, line, mainDiagonal);
+        }
+        if (IsFusedFacePass(pass)) {
+          this->CalcViscFluxLineK(iStart, iEnd, jj, kk, trans, thermo,
+                                  eqnState, inp, turb, mainDiagonal);
+        }
+      }
+    }
+  }
+}
+
+// member function to calculate the inviscid fluxes on the k-faces from iStart
+// to iEnd along a line of constant j and k
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcInvFluxLineK(const int &iStart, const int &iEnd,
+                                 const int &jj, const int &kk,
+                                 const unique_ptr<eos> &eqnState,
+                                 const unique_ptr<thermodynamic> &thermo,
+                                 const input &inp,
+                                 const unique_ptr<turbModel> &turb,
+                                 const facePass &pass,
+                                 const viscousWalls &walls,
+                                 inviscidFluxLine &line,
+                                 implicitDiagonal &mainDiagonal) {
+  // iStart -- first face in line
+  // iEnd -- one past last face in line
+  // jj -- j-index of line
+  // kk -- k-index of line
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces to calculate
+  // walls -- viscous wall surfaces on the boundaries in direction of faces
+  // line -- storage for face states and fluxes along line
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  // concrete models chosen by the dispatcher; calls through these are
+  // statically dispatched
+  const auto &eosModel = static_cast<const E &>(*eqnState);
+  const auto &thermoModel = static_cast<const T &>(*thermo);
+
+  const auto kappa = inp.Kappa();
+  const auto limiter = inp.LimiterType();
+  constexpr auto reach = InviscidStencilReach<R>();
+
+  // reconstruct face states along line
+  line.Resize(iEnd - iStart);
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    primVars faceStateLower, faceStateUpper;
+
+    // use constant reconstruction (first order)
+    if (R == reconstruction::constant) {
+      faceStateLower = state_(ii, jj, kk - 1).FaceReconConst();
+      faceStateUpper = state_(ii, jj, kk).FaceReconConst();
+    } else {  // second order accuracy
+      if (R == reconstruction::muscl) {
+        faceStateLower = state_(ii, jj, kk - 1).FaceReconMUSCL(
+            state_(ii, jj, kk - 2), state_(ii, jj, kk),
+            kappa, limiter, cellWidthK_(ii, jj, kk - 1),
+            cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk));
+
+        faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
+            state_(ii, jj, kk + 1), state_(ii, jj, kk - 1),
+            kappa, limiter, cellWidthK_(ii, jj, kk),
+            cellWidthK_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk - 1));
+
+      } else {  // using higher order reconstruction (weno, wenoz)
+        faceStateLower = state_(ii, jj, kk - 1).FaceReconWENO(
+            state_(ii, jj, kk - 2), state_(ii, jj, kk - 3),
+            state_(ii, jj, kk), state_(ii, jj, kk + 1),
+            wenoLowerK_(ii, jj, kk),
+            cellWidthK_(ii, jj, kk - 1), cellWidthK_(ii, jj, kk - 2),
+            cellWidthK_(ii, jj, kk - 3), cellWidthK_(ii, jj, kk),
+            cellWidthK_(ii, jj, kk + 1), R == reconstruction::wenoZ);
+
+        faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
+            state_(ii, jj, kk + 1), state_(ii, jj, kk + 2),
+            state_(ii, jj, kk - 1), state_(ii, jj, kk - 2),
+            wenoUpperK_(ii, jj, kk),
+            cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1),
+            cellWidthK_(ii, jj, kk + 2), cellWidthK_(ii, jj, kk - 1),
+            cellWidthK_(ii, jj, kk - 2), R == reconstruction::wenoZ);
+      }
+    }
+
+    line.Insert(ii - iStart, faceStateLower, faceStateUpper,
+                this->FAreaUnitK(ii, jj, kk));
+  }
+
+  // calculate inviscid flux at all faces in line
+  line.CalcFlux<F>(eosModel, thermoModel);
+
+  // faces whose stencil uses the slip wall ghost cells of a viscous wall are
+  // calculated in a separate pass before the ghost cells are overwritten; on a
+  // line of k-faces this is only possible if the line is within reach of a
+  // k-boundary
+  const auto checkWall = pass != facePass::inviscid;
+  const auto nearLower = checkWall && kk - reach < fAreaK_.PhysStartK();
+  const auto nearUpper = checkWall && kk + reach > fAreaK_.PhysEndK() - 1;
+
+  // add flux contributions to residual
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    if (checkWall) {
+      const auto wallStencil =
+          (nearLower && OnSurface(walls.lower_, 2, ii, jj)) ||
+          (nearUpper && OnSurface(walls.upper_, 2, ii, jj));
+      if (wallStencil != (pass == facePass::inviscidWall)) {
+        continue;
+      }
+    }
+
+    const auto ff = ii - iStart;
+    const auto tempFlux = line.Flux<inviscidFlux>(ff);
+
+    // area vector points from left to right, so add to left cell, subtract
+    // from right cell
+    // at left boundary no left cell to add to
+    if (kk > fAreaK_.PhysStartK()) {
+      this->AddToResidual(tempFlux *
+                          this->FAreaMagK(ii, jj, kk),
+                          ii, jj, kk - 1);
+
+      // if using block matrix on main diagonal, calculate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        fluxJacobian fluxJac;
+        fluxJac.RusanovFluxJacobian(line.Lower<primVars>(ff),
+                                    eqnState, thermo,
+                                    this->FAreaK(ii, jj, kk), true,
+                                    inp, turb);
+        mainDiagonal.Block(ii, jj, kk - 1) += fluxJac;
+      }
+    }
+    // at right boundary no right cell to add to
+    if (kk < fAreaK_.PhysEndK() - 1) {
+      this->SubtractFromResidual(tempFlux *
+                                 this->FAreaMagK(ii, jj, kk),
+                                 ii, jj, kk);
+
+      // calculate component of wave speed. This is done on a cell by cell
+      // basis, so only at the upper faces
+      const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
+          fAreaK_(ii, jj, kk), fAreaK_(ii, jj, kk + 1), thermoModel,
+          eosModel);
+
+      const auto turbInvSpecRad = isRANS_ ?
+          turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaK_(ii, jj, kk),
+                                    fAreaK_(ii, jj, kk + 1)) : 0.0;
+
+      const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
+      specRadius_(ii, jj, kk) += specRad;
+
+      // if using block matrix on main diagonal, calculate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        fluxJacobian fluxJac;
+        fluxJac.RusanovFluxJacobian(line.Upper<primVars>(ff),
+                                    eqnState, thermo,
+                                    this->FAreaK(ii, jj, kk), false,
+                                    inp, turb);
+        mainDiagonal.Block(ii, jj, kk) -= fluxJac;
+      } else if (inp.IsImplicit()) {
+        mainDiagonal.Scalar(ii, jj, kk) += specRad;
+      }
+    }
+  }
+}
+
+/* Function to calculate the fluxes on all faces of the procBlock. The face
+reconstruction and inviscid flux scheme are resolved from the input file once,
+and the i, j, and k face kernels specialized for them are called. This keeps
+the option checks out of the face loops. The pass determines which faces and
+fluxes are calculated. The inviscid pass calculates the inviscid fluxes on all
+faces. The fused pass also calculates the viscous fluxes, so each line of faces
+is swept once. The inviscid fluxes near viscous walls use the slip wall ghost
+cells, which are overwritten by the viscous ghost cells. Therefore in the fused
+pass they are skipped, and are calculated beforehand in the inviscidWall pass.
+*/
+void procBlock::CalcFaceFlux(const unique_ptr<eos> &eqnState,
                              const unique_ptr<thermodynamic> &thermo,
+                             const unique_ptr<transport> &trans,
                              const input &inp,
                              const unique_ptr<turbModel> &turb,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+                             const facePass &pass,
+                             implicitDiagonal &mainDiagonal) {
   // eqnState -- equation of state
   // thermo -- thermodynamic model
+  // trans -- viscous transport model
   // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
 
-  // loop over all physical k-faces
-  for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
-    for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
-        primVars faceStateLower, faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = state_(ii, jj, kk - 1).FaceReconConst();
-          faceStateUpper = state_(ii, jj, kk).FaceReconConst();
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = state_(ii, jj, kk - 1).FaceReconMUSCL(
-                state_(ii, jj, kk - 2), state_(ii, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk));
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
-                state_(ii, jj, kk + 1), state_(ii, jj, kk - 1),
-                inp.Kappa(), inp.Limiter(), cellWidthK_(ii, jj, kk),
-                cellWidthK_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk - 1));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = state_(ii, jj, kk - 1).FaceReconWENO(
-                state_(ii, jj, kk - 2), state_(ii, jj, kk - 3),
-                state_(ii, jj, kk), state_(ii, jj, kk + 1),
-                cellWidthK_(ii, jj, kk - 1), cellWidthK_(ii, jj, kk - 2),
-                cellWidthK_(ii, jj, kk - 3), cellWidthK_(ii, jj, kk),
-                cellWidthK_(ii, jj, kk + 1), inp.IsWenoZ());
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
-                state_(ii, jj, kk + 1), state_(ii, jj, kk + 2),
-                state_(ii, jj, kk - 1), state_(ii, jj, kk - 2),
-                cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1),
-                cellWidthK_(ii, jj, kk + 2), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk - 2), inp.IsWenoZ());
-          }
-        }
+  switch (inp.Reconstruction()) {
+    case reconstruction::constant:
+      this->CalcFaceFlux<reconstruction::constant>(eqnState, thermo, trans, inp,
+                                                   turb, pass, mainDiagonal);
+      break;
+    case reconstruction::muscl:
+      this->CalcFaceFlux<reconstruction::muscl>(eqnState, thermo, trans, inp,
+                                                turb, pass, mainDiagonal);
+      break;
+    case reconstruction::weno:
+      this->CalcFaceFlux<reconstruction::weno>(eqnState, thermo, trans, inp,
+                                               turb, pass, mainDiagonal);
+      break;
+    case reconstruction::wenoZ:
+      this->CalcFaceFlux<reconstruction::wenoZ>(eqnState, thermo, trans, inp,
+                                                turb, pass, mainDiagonal);
+      break;
+  }
+}
 
-        // calculate inviscid flux at face
-        const inviscidFlux tempFlux =
-            InviscidFlux(faceStateLower, faceStateUpper, eqnState, thermo,
-                         this->FAreaUnitK(ii, jj, kk), inp.InviscidFlux());
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell
-        // at left boundary no left cell to add to
-        if (kk > fAreaK_.PhysStartK()) {
-          this->AddToResidual(tempFlux *
-                              this->FAreaMagK(ii, jj, kk),
-                              ii, jj, kk - 1);
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, eqnState, thermo,
-                                        this->FAreaK(ii, jj, kk), true,
-                                        inp, turb);
-            mainDiagonal(ii, jj, kk - 1) += fluxJac;
-          }
-        }
-        // at right boundary no right cell to add to
-        if (kk < fAreaK_.PhysEndK() - 1) {
-          this->SubtractFromResidual(tempFlux *
-                                     this->FAreaMagK(ii, jj, kk),
-                                     ii, jj, kk);
-
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
-              fAreaK_(ii, jj, kk), fAreaK_(ii, jj, kk + 1), thermo, eqnState);
-
-          const auto turbInvSpecRad = isRANS_ ?
-              turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaK_(ii, jj, kk),
-                                        fAreaK_(ii, jj, kk + 1)) : 0.0;
-
-          const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
-          specRadius_(ii, jj, kk) += specRad;
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, eqnState, thermo,
-                                        this->FAreaK(ii, jj, kk), false,
-                                        inp, turb);
-            mainDiagonal(ii, jj, kk) -= fluxJac;
-          } else if (inp.IsImplicit()) {
-            mainDiagonal(ii, jj, kk) += fluxJacobian(specRad);
-          }
-        }
+template <reconstruction R>
+void procBlock::CalcFaceFlux(const unique_ptr<eos> &eqnState,
+                             const unique_ptr<thermodynamic> &thermo,
+                             const unique_ptr<transport> &trans,
+                             const input &inp,
+                             const unique_ptr<turbModel> &turb,
+                             const facePass &pass,
+                             implicitDiagonal &mainDiagonal) {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  if (inp.InviscidFluxScheme() == inviscidFluxScheme::roe) {
+    this->CalcFaceFlux<R, inviscidFluxScheme::roe>(eqnState, thermo, trans, inp,
+                                                   turb, pass, mainDiagonal);
+  } else {
+    this->CalcFaceFlux<R, inviscidFluxScheme::ausm>(eqnState, thermo, trans,
+                                                    inp, turb, pass,
+                                                    mainDiagonal);
+  }
+}
+
+/* Function to call the face kernels specialized for the concrete equation of
+state and thermodynamic model. The models are only known at run time, so they
+are resolved here once per block instead of through a virtual call for every
+face. The kernels then call the models directly, allowing them to be inlined.
+*/
+template <reconstruction R, inviscidFluxScheme F>
+void procBlock::CalcFaceFlux(const unique_ptr<eos> &eqnState,
+                             const unique_ptr<thermodynamic> &thermo,
+                             const unique_ptr<transport> &trans,
+                             const input &inp,
+                             const unique_ptr<turbModel> &turb,
+                             const facePass &pass,
+                             implicitDiagonal &mainDiagonal) {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  if (dynamic_cast<const idealGas *>(eqnState.get()) == nullptr) {
+    cerr << "ERROR: Error in procBlock::CalcFaceFlux(). Equation of state is "
+         << "not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (dynamic_cast<const caloricallyPerfect *>(thermo.get()) != nullptr) {
+    this->CalcFaceFluxIJK<R, F, idealGas, caloricallyPerfect>(
+        eqnState, thermo, trans, inp, turb, pass, mainDiagonal);
+  } else if (dynamic_cast<const thermallyPerfect *>(thermo.get()) != nullptr) {
+    this->CalcFaceFluxIJK<R, F, idealGas, thermallyPerfect>(
+        eqnState, thermo, trans, inp, turb, pass, mainDiagonal);
+  } else {
+    cerr << "ERROR: Error in procBlock::CalcFaceFlux(). Thermodynamic model is "
+         << "not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// member function to calculate the face fluxes in the i, j, and k directions;
+// the time spent in each direction is accumulated so that the sweeps can be
+// compared, for example with and without padding of the i-lines
+template <reconstruction R, inviscidFluxScheme F, typename E, typename T>
+void procBlock::CalcFaceFluxIJK(const unique_ptr<eos> &eqnState,
+                                const unique_ptr<thermodynamic> &thermo,
+                                const unique_ptr<transport> &trans,
+                                const input &inp,
+                                const unique_ptr<turbModel> &turb,
+                                const facePass &pass,
+                                implicitDiagonal &mainDiagonal) {
+  // eqnState -- equation of state
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // inp -- all input variables
+  // turb -- turbulence model
+  // pass -- faces and fluxes to calculate
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  using std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  const auto start = steady_clock::now();
+  this->CalcFaceFluxI<R, F, E, T>(eqnState, thermo, trans, inp, turb, pass,
+                                  mainDiagonal);
+  const auto endI = steady_clock::now();
+  this->CalcFaceFluxJ<R, F, E, T>(eqnState, thermo, trans, inp, turb, pass,
+                                  mainDiagonal);
+  const auto endJ = steady_clock::now();
+  this->CalcFaceFluxK<R, F, E, T>(eqnState, thermo, trans, inp, turb, pass,
+                                  mainDiagonal);
+  const auto endK = steady_clock::now();
+
+  faceFluxTime_[0] += seconds(endI - start).count();
+  faceFluxTime_[1] += seconds(endJ - endI).count();
+  faceFluxTime_[2] += seconds(endK - endJ).count();
+}
+
+// member function to find the viscous wall surfaces on the lower and upper
+// boundaries in a direction; the direction is given by the surface type of the
+// lower boundary (1 = i, 3 = j, 5 = k)
+viscousWalls procBlock::ViscousWalls(const int &surfType) const {
+  // surfType -- surface type of lower boundary in direction
+
+  viscousWalls walls;
+  for (auto ii = 0; ii < bc_.NumSurfaces(); ii++) {
+    if (bc_.GetBCTypes(ii) == "viscousWall") {
+      if (bc_.GetSurfaceType(ii) == surfType) {
+        walls.lower_.push_back(bc_.GetSurface(ii));
+      } else if (bc_.GetSurfaceType(ii) == surfType + 1) {
+        walls.upper_.push_back(bc_.GetSurface(ii));
       }
     }
   }
+  return walls;
 }
 
 /* Member function to calculate the local time step. (i,j,k) are cell indices.
@@ -828,7 +1432,13 @@ number, call function to do so.
 void procBlock::CalcBlockTimeStep(const input &inp) {
   // inp -- all input variables
 
+  if (inp.Dt() <= 0.0 && inp.CFL() <= 0.0) {
+    cerr << "ERROR: Neither dt or cfl was specified!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
   // loop over all physical cells - no ghost cells for dt variable
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = 0; kk < this->NumK(); kk++) {
     for (auto jj = 0; jj < this->NumJ(); jj++) {
       for (auto ii = 0; ii < this->NumI(); ii++) {
@@ -838,11 +1448,8 @@ void procBlock::CalcBlockTimeStep(const input &inp) {
           dt_(ii, jj, kk) = inp.Dt() * inp.ARef() / inp.LRef();
 
         // cfl specified, use local time stepping
-        } else if (inp.CFL() > 0.0) {
-          this->CalcCellDt(ii, jj, kk, inp.CFL());
         } else {
-          cerr << "ERROR: Neither dt or cfl was specified!" << endl;
-          exit(EXIT_FAILURE);
+          this->CalcCellDt(ii, jj, kk, inp.CFL());
         }
       }
     }
@@ -869,40 +1476,139 @@ void procBlock::UpdateBlock(const input &inputVars, const unique_ptr<eos> &eos,
   // l2 -- l-2 norm of residual
   // linf -- l-infinity norm of residual
 
+  if (dynamic_cast<const idealGas *>(eos.get()) == nullptr) {
+    cerr << "ERROR: Error in procBlock::UpdateBlock(). Equation of state is "
+         << "not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // use kernel specialized for the thermodynamic model
+  if (dynamic_cast<const caloricallyPerfect *>(thermo.get()) != nullptr) {
+    this->UpdateCells<idealGas, caloricallyPerfect>(inputVars, eos, thermo, du,
+                                                    turb, rr, l2, linf);
+  } else if (dynamic_cast<const thermallyPerfect *>(thermo.get()) != nullptr) {
+    this->UpdateCells<idealGas, thermallyPerfect>(inputVars, eos, thermo, du,
+                                                  turb, rr, l2, linf);
+  } else {
+    cerr << "ERROR: Error in procBlock::UpdateBlock(). Thermodynamic model is "
+         << "not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/* Member function to update all physical cells in the procBlock. This is
+templated on the concrete equation of state and thermodynamic model, so the
+conversions between primative and conserved variables are statically
+dispatched. The time integration method is resolved here once, and the cell
+loop specialized for it is called.
+*/
+template <typename E, typename T>
+void procBlock::UpdateCells(const input &inputVars, const unique_ptr<eos> &eos,
+                            const unique_ptr<thermodynamic> &thermo,
+                            const multiArray3d<genArray> &du,
+                            const unique_ptr<turbModel> &turb, const int &rr,
+                            genArray &l2, resid &linf) {
+  // inputVars -- all input variables
+  // eos -- equation of state
+  // thermo -- thermodynamic model
+  // du -- updates to conservative variables (only used in implicit solver)
+  // turb -- turbulence model
+  // rr -- nonlinear iteration number
+  // l2 -- l-2 norm of residual
+  // linf -- l-infinity norm of residual
+
+  switch (inputVars.TimeIntegrator()) {
+    // explicit euler time integration
+    case timeIntegrator::explicitEuler:
+      this->AdvanceCells<timeIntegrator::explicitEuler, E, T>(
+          eos, thermo, du, turb, rr, l2, linf);
+      break;
+    // 4-stage runge-kutta method (explicit)
+    case timeIntegrator::rk4:
+      this->AdvanceCells<timeIntegrator::rk4, E, T>(eos, thermo, du, turb,
+                                                    rr, l2, linf);
+      break;
+    // all implicit methods use update (du)
+    default:
+      this->AdvanceCells<timeIntegrator::implicitEuler, E, T>(
+          eos, thermo, du, turb, rr, l2, linf);
+      break;
+  }
+}
+
+// member function to advance all physical cells in the procBlock with the
+// given time integration method and accumulate the residual norms
+template <timeIntegrator TI, typename E, typename T>
+void procBlock::AdvanceCells(const unique_ptr<eos> &eos,
+                             const unique_ptr<thermodynamic> &thermo,
+                             const multiArray3d<genArray> &du,
+                             const unique_ptr<turbModel> &turb, const int &rr,
+                             genArray &l2, resid &linf) {
+  // eos -- equation of state
+  // thermo -- thermodynamic model
+  // du -- updates to conservative variables (only used in implicit solver)
+  // turb -- turbulence model
+  // rr -- nonlinear iteration number
+  // l2 -- l-2 norm of residual
+  // linf -- l-infinity norm of residual
+
+  // concrete models chosen by the dispatcher; calls through these are
+  // statically dispatched
+  const auto &eosModel = static_cast<const E &>(*eos);
+  const auto &thermoModel = static_cast<const T &>(*thermo);
+
+  // each thread accumulates its own residual norms; the first thread starts
+  // from the norms passed in so that a single thread gives the same result as
+  // the serial loop
+  const auto numThreads = MaxThreads();
+  vector<genArray> threadL2(numThreads, genArray(0.0));
+  vector<resid> threadLinf(numThreads, linf);
+  threadL2[0] = l2;
+
   // loop over all physical cells
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
     for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+      auto &l2Thread = threadL2[ThreadNum()];
+      auto &linfThread = threadLinf[ThreadNum()];
       for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
-        // explicit euler time integration
-        if (inputVars.TimeIntegration() == "explicitEuler") {
-          this->ExplicitEulerTimeAdvance(eos, thermo, turb, ii, jj, kk);
-        // 4-stage runge-kutta method (explicit)
-        } else if (inputVars.TimeIntegration() == "rk4") {
+        if (TI == timeIntegrator::explicitEuler) {
+          this->ExplicitEulerTimeAdvance(eosModel, thermoModel, turb, ii, jj,
+                                         kk);
+        } else if (TI == timeIntegrator::rk4) {
           // advance 1 RK stage
-          this->RK4TimeAdvance(consVarsN_(ii, jj, kk), eos, thermo, turb, ii,
-                               jj, kk, rr);
-        } else if (inputVars.IsImplicit()) {  // if implicit use update (du)
-          this->ImplicitTimeAdvance(du(ii, jj, kk), eos, thermo, turb, ii, jj,
-                                    kk);
-        } else {
-          cerr << "ERROR: Time integration scheme " <<
-              inputVars.TimeIntegration() << " is not recognized!" << endl;
+          this->RK4TimeAdvance(consVarsN_(ii, jj, kk), eosModel, thermoModel,
+                               turb, ii, jj, kk, rr);
+        } else {  // implicit methods use update (du)
+          this->ImplicitTimeAdvance(du(ii, jj, kk), eosModel, thermoModel,
+                                    turb, ii, jj, kk);
         }
 
         // accumulate l2 norm of residual
-        l2 = l2 + residual_(ii, jj, kk) * residual_(ii, jj, kk);
+        l2Thread = l2Thread + residual_(ii, jj, kk) * residual_(ii, jj, kk);
 
         // if any residual is larger than previous residual, a new linf
         // residual is found
         for (auto ll = 0; ll < NUMVARS; ll++) {
-          if (this->Residual(ii, jj, kk, ll) > linf.Linf()) {
-            linf.UpdateMax(this->Residual(ii, jj, kk, ll),
-                           parBlock_, ii, jj, kk, ll + 1);
+          if (this->Residual(ii, jj, kk, ll) > linfThread.Linf()) {
+            linfThread.UpdateMax(this->Residual(ii, jj, kk, ll),
+                                 parBlock_, ii, jj, kk, ll + 1);
           }
         }
       }
     }
   }
+
+  // combine norms in thread order; with a static schedule the threads own
+  // consecutive cells, so the linf location matches the serial loop
+  l2 = threadL2[0];
+  linf = threadLinf[0];
+  for (auto tt = 1; tt < numThreads; ++tt) {
+    l2 += threadL2[tt];
+    if (threadLinf[tt].Linf() > linf.Linf()) {
+      linf = threadLinf[tt];
+    }
+  }
 }
 
 /* Member function to advance the state vector to time n+1 using explicit Euler
@@ -914,10 +1620,11 @@ Un is the conserved variables at time n, Un+1 is the conserved variables at time
 n+1, dt_ is the cell's time step, V is the cell's volume, and R is the cell's
 residual.
  */
-void procBlock::ExplicitEulerTimeAdvance(
-    const unique_ptr<eos> &eqnState, const unique_ptr<thermodynamic> &thermo,
-    const unique_ptr<turbModel> &turb, const int &ii, const int &jj,
-    const int &kk) {
+template <typename E, typename T>
+void procBlock::ExplicitEulerTimeAdvance(const E &eqnState, const T &thermo,
+                                         const unique_ptr<turbModel> &turb,
+                                         const int &ii, const int &jj,
+                                         const int &kk) {
   // eqnState -- equation of state
   // thermo -- thermodynamic model
   // turb -- turbulence model
@@ -926,7 +1633,7 @@ void procBlock::ExplicitEulerTimeAdvance(
   // kk -- k-location of cell
 
   // Get conserved variables for current state (time n)
-  auto consVars = state_(ii, jj, kk).ConsVars(eqnState, thermo);
+  genArray consVars = state_(ii, jj, kk).ConsVars(eqnState, thermo);
   // calculate updated conserved variables
   consVars -= dt_(ii, jj, kk) / vol_(ii, jj, kk) * residual_(ii, jj, kk);
 
@@ -936,9 +1643,9 @@ void procBlock::ExplicitEulerTimeAdvance(
 
 // member function to advance the state vector to time n+1 (for implicit
 // methods)
-void procBlock::ImplicitTimeAdvance(const genArray &du,
-                                    const unique_ptr<eos> &eqnState,
-                                    const unique_ptr<thermodynamic> &thermo,
+template <typename E, typename T>
+void procBlock::ImplicitTimeAdvance(const genArray &du, const E &eqnState,
+                                    const T &thermo,
                                     const unique_ptr<turbModel> &turb,
                                     const int &ii, const int &jj,
                                     const int &kk) {
@@ -964,9 +1671,9 @@ Un is the conserved variables at time n, Un+1 is the conserved variables at time
 n+1, dt_ is the cell's time step, V is the cell's volume, alpha is the runge-kutta
 coefficient, and R is the cell's residual.
  */
-void procBlock::RK4TimeAdvance(const genArray &currState,
-                               const unique_ptr<eos> &eqnState,
-                               const unique_ptr<thermodynamic> &thermo,
+template <typename E, typename T>
+void procBlock::RK4TimeAdvance(const genArray &currState, const E &eqnState,
+                               const T &thermo,
                                const unique_ptr<turbModel> &turb,
                                const int &ii, const int &jj, const int &kk,
                                const int &rk) {
@@ -1021,6 +1728,19 @@ void procBlock::ResetTurbVars() {
   }
 }
 
+// member function to zero the variables accumulated during the residual
+// calculation
+void procBlock::ResetResidualVars() {
+  // Zero spectral radii, residuals, gradients, turbulence variables
+  this->ResetResidWS();
+  if (isViscous_) {
+    this->ResetGradients();
+    if (isTurbulent_) {
+      this->ResetTurbVars();
+    }
+  }
+}
+
 /* Member function to add the cell volume divided by the cell time step to the
 main diagonal of the time m minus time n term.
 
@@ -1076,7 +1796,7 @@ genArray procBlock::SolDeltaNm1(const int &ii, const int &jj, const int &kk,
   }
 }
 
-void procBlock::InvertDiagonal(multiArray3d<fluxJacobian> &mainDiagonal,
+void procBlock::FactorDiagonal(implicitDiagonal &mainDiagonal,
                                const input &inp) const {
   // mainDiagonal -- main diagonal in implicit operator
   // inp -- input variables
@@ -1094,10 +1814,8 @@ void procBlock::InvertDiagonal(multiArray3d<fluxJacobian> &mainDiagonal,
         }
 
         // add volume and time term
-        mainDiagonal(ii, jj, kk).MultiplyOnDiagonal(inp.MatrixRelaxation(),
-                                                    isRANS_);
-        mainDiagonal(ii, jj, kk).AddOnDiagonal(diagVolTime, isRANS_);
-        mainDiagonal(ii, jj, kk).Inverse(isRANS_);
+        mainDiagonal.Factor(ii, jj, kk, inp.MatrixRelaxation(), diagVolTime,
+                            isRANS_);
       }
     }
   }
@@ -1124,6 +1842,266 @@ void procBlock::AssignSolToTimeNm1() {
 }
 
 
+// member function to calculate the off diagonal contribution across a face to
+// the implicit update of the cell on the other side of the face; stored
+// operators are used if available
+genArray procBlock::FaceOffDiagonal(const int &ii, const int &jj,
+                                    const int &kk, const int &dir,
+                                    const bool &fromLower,
+                                    const multiArray3d<genArray> &x,
+                                    const unique_ptr<eos> &eqnState,
+                                    const input &inp,
+                                    const unique_ptr<thermodynamic> &thermo,
+                                    const unique_ptr<transport> &trans,
+                                    const unique_ptr<turbModel> &turb) const {
+  // ii -- i-location of face
+  // jj -- j-location of face
+  // kk -- k-location of face
+  // dir -- direction of face (0 = i, 1 = j, 2 = k)
+  // fromLower -- flag that is true if the contribution is from the cell on
+  //              the lower side of the face
+  // x -- implicit update
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // turb -- turbulence model
+
+  // cell on lower side of face
+  const auto il = dir == 0 ? ii - 1 : ii;
+  const auto jl = dir == 1 ? jj - 1 : jj;
+  const auto kl = dir == 2 ? kk - 1 : kk;
+
+  // off diagonal cell contributing to diagonal cell
+  const auto io = fromLower ? il : ii;
+  const auto jo = fromLower ? jl : jj;
+  const auto ko = fromLower ? kl : kk;
+  const auto id = fromLower ? ii : il;
+  const auto jd = fromLower ? jj : jl;
+  const auto kd = fromLower ? kk : kl;
+
+  const auto &fArea = dir == 0 ? fAreaI_(ii, jj, kk) :
+      (dir == 1 ? fAreaJ_(ii, jj, kk) : fAreaK_(ii, jj, kk));
+
+  if (!offDiagJacobian_.IsEmpty()) {
+    const auto &jacobian = fromLower ? offDiagJacobian_.Lower(dir, ii, jj, kk)
+        : offDiagJacobian_.Upper(dir, ii, jj, kk);
+    return jacobian.ArrayMult(x(io, jo, ko));
+  } else if (!offDiagSpecRad_.IsEmpty()) {
+    const auto &specRad = fromLower ? offDiagSpecRad_.Lower(dir, ii, jj, kk)
+        : offDiagSpecRad_.Upper(dir, ii, jj, kk);
+    return OffDiagonal(state_(io, jo, ko), state_(id, jd, kd), x(io, jo, ko),
+                       fArea, specRad, eqnState, thermo, turb, inp, fromLower);
+  } else {
+    // calculate projected center to center distance along face area
+    const auto projDist = this->ProjC2CDist(ii, jj, kk, dir);
+
+    return OffDiagonal(state_(io, jo, ko), state_(id, jd, kd), x(io, jo, ko),
+                       fArea, this->Viscosity(io, jo, ko),
+                       this->EddyViscosity(io, jo, ko), this->F1(io, jo, ko),
+                       projDist, this->VelGrad(io, jo, ko), eqnState, thermo,
+                       trans, turb, inp, fromLower);
+  }
+}
+
+// member function to calculate the contribution of the lower off diagonal
+// cells (i-1, j-1, k-1) to the implicit update at a cell
+genArray procBlock::LowerOffDiagonal(const int &ii, const int &jj,
+                                     const int &kk,
+                                     const multiArray3d<genArray> &x,
+                                     const unique_ptr<eos> &eqnState,
+                                     const input &inp,
+                                     const unique_ptr<thermodynamic> &thermo,
+                                     const unique_ptr<transport> &trans,
+                                     const unique_ptr<turbModel> &turb) const {
+  // ii -- i-location of cell
+  // jj -- j-location of cell
+  // kk -- k-location of cell
+  // x -- implicit update
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // turb -- turbulence model
+
+  genArray L(0.0);
+
+  // if i lower diagonal cell is in physical location there is a contribution
+  // from it
+  if (this->IsPhysical(ii - 1, jj, kk) ||
+      bc_.BCIsConnection(ii, jj, kk, 1)) {
+    L += this->FaceOffDiagonal(ii, jj, kk, 0, true, x, eqnState, inp, thermo,
+                               trans, turb);
+  }
+
+  // if j lower diagonal cell is in physical location there is a contribution
+  // from it
+  if (this->IsPhysical(ii, jj - 1, kk) ||
+      bc_.BCIsConnection(ii, jj, kk, 3)) {
+    L += this->FaceOffDiagonal(ii, jj, kk, 1, true, x, eqnState, inp, thermo,
+                               trans, turb);
+  }
+
+  // if k lower diagonal cell is in physical location there is a contribution
+  // from it
+  if (this->IsPhysical(ii, jj, kk - 1) ||
+      bc_.BCIsConnection(ii, jj, kk, 5)) {
+    L += this->FaceOffDiagonal(ii, jj, kk, 2, true, x, eqnState, inp, thermo,
+                               trans, turb);
+  }
+
+  return L;
+}
+
+// member function to calculate the contribution of the upper off diagonal
+// cells (i+1, j+1, k+1) to the implicit update at a cell
+genArray procBlock::UpperOffDiagonal(const int &ii, const int &jj,
+                                     const int &kk,
+                                     const multiArray3d<genArray> &x,
+                                     const unique_ptr<eos> &eqnState,
+                                     const input &inp,
+                                     const unique_ptr<thermodynamic> &thermo,
+                                     const unique_ptr<transport> &trans,
+                                     const unique_ptr<turbModel> &turb) const {
+  // ii -- i-location of cell
+  // jj -- j-location of cell
+  // kk -- k-location of cell
+  // x -- implicit update
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // turb -- turbulence model
+
+  genArray U(0.0);
+
+  // if i upper diagonal cell is in physical location there is a contribution
+  // from it
+  if (this->IsPhysical(ii + 1, jj, kk) ||
+      bc_.BCIsConnection(ii + 1, jj, kk, 2)) {
+    U += this->FaceOffDiagonal(ii + 1, jj, kk, 0, false, x, eqnState, inp,
+                               thermo, trans, turb);
+  }
+
+  // if j upper diagonal cell is in physical location there is a contribution
+  // from it
+  if (this->IsPhysical(ii, jj + 1, kk) ||
+      bc_.BCIsConnection(ii, jj + 1, kk, 4)) {
+    U += this->FaceOffDiagonal(ii, jj + 1, kk, 1, false, x, eqnState, inp,
+                               thermo, trans, turb);
+  }
+
+  // if k upper diagonal cell is in physical location there is a contribution
+  // from it
+  if (this->IsPhysical(ii, jj, kk + 1) ||
+      bc_.BCIsConnection(ii, jj, kk + 1, 6)) {
+    U += this->FaceOffDiagonal(ii, jj, kk + 1, 2, false, x, eqnState, inp,
+                               thermo, trans, turb);
+  }
+
+  return U;
+}
+
+// member function to allocate storage for the off diagonal operators if they
+// are stored across matrix sweeps
+void procBlock::AllocateOffDiagonals(const input &inp) {
+  // inp -- all input variables
+  if (!inp.StoreOffDiagonals()) {
+    return;
+  }
+  if (IsBlockOffDiagonal(inp)) {
+    offDiagJacobian_.ClearResize(
+        this->NumI(), this->NumJ(), this->NumK(),
+        fluxJacobian(inp.NumFlowEquations(), inp.NumTurbEquations()));
+  } else {
+    offDiagSpecRad_.ClearResize(this->NumI(), this->NumJ(), this->NumK(),
+                                uncoupledScalar());
+  }
+}
+
+// member function to return the approximate memory in bytes used by the
+// stored off diagonal operators; flux jacobians store their matrices inline
+double procBlock::OffDiagonalMemory() const {
+  return static_cast<double>(offDiagJacobian_.Size()) * sizeof(fluxJacobian) +
+      static_cast<double>(offDiagSpecRad_.Size()) * sizeof(uncoupledScalar);
+}
+
+// member function to calculate the off diagonal operators at each face; this
+// is done once per nonlinear iteration so that the matrix sweeps only need to
+// apply them
+void procBlock::CalcOffDiagonals(const unique_ptr<eos> &eqnState,
+                                 const input &inp,
+                                 const unique_ptr<thermodynamic> &thermo,
+                                 const unique_ptr<transport> &trans,
+                                 const unique_ptr<turbModel> &turb) {
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // thermo -- thermodynamic model
+  // trans -- viscous transport model
+  // turb -- turbulence model
+
+  if (offDiagJacobian_.IsEmpty() && offDiagSpecRad_.IsEmpty()) {
+    return;
+  }
+  const auto isBlock = !offDiagJacobian_.IsEmpty();
+
+  // calculate operator at face for contribution from off diagonal cell
+  auto calcOperator = [&](const int &ii, const int &jj, const int &kk,
+                          const int &dir, const int &io, const int &jo,
+                          const int &ko, const bool &fromLower) {
+    const auto &fArea = dir == 0 ? fAreaI_(ii, jj, kk) :
+        (dir == 1 ? fAreaJ_(ii, jj, kk) : fAreaK_(ii, jj, kk));
+    const auto projDist = this->ProjC2CDist(ii, jj, kk, dir);
+
+    if (isBlock) {
+      auto &jacobian = fromLower ? offDiagJacobian_.Lower(dir, ii, jj, kk) :
+          offDiagJacobian_.Upper(dir, ii, jj, kk);
+      jacobian = RusanovBlockJacobian(
+          state_(io, jo, ko), fArea, this->Viscosity(io, jo, ko),
+          this->EddyViscosity(io, jo, ko), this->F1(io, jo, ko), projDist,
+          eqnState, thermo, trans, turb, inp, fromLower,
+          this->VelGrad(io, jo, ko));
+    } else {
+      auto &specRad = fromLower ? offDiagSpecRad_.Lower(dir, ii, jj, kk) :
+          offDiagSpecRad_.Upper(dir, ii, jj, kk);
+      specRad = OffDiagonalSpecRad(
+          state_(io, jo, ko), fArea, this->Viscosity(io, jo, ko),
+          this->EddyViscosity(io, jo, ko), this->F1(io, jo, ko), projDist,
+          eqnState, thermo, trans, turb, inp, fromLower);
+    }
+  };
+
+  for (auto dd = 0; dd < 3; dd++) {
+    const auto numI = this->NumI() + (dd == 0 ? 1 : 0);
+    const auto numJ = this->NumJ() + (dd == 1 ? 1 : 0);
+    const auto numK = this->NumK() + (dd == 2 ? 1 : 0);
+
+#pragma omp parallel for collapse(2) schedule(static)
+    for (auto kk = 0; kk < numK; kk++) {
+      for (auto jj = 0; jj < numJ; jj++) {
+        for (auto ii = 0; ii < numI; ii++) {
+          // cell on lower side of face
+          const auto il = dd == 0 ? ii - 1 : ii;
+          const auto jl = dd == 1 ? jj - 1 : jj;
+          const auto kl = dd == 2 ? kk - 1 : kk;
+
+          // operators are only needed where they are used in the sweeps
+          if (this->IsPhysical(ii, jj, kk) &&
+              (this->IsPhysical(il, jl, kl) ||
+               bc_.BCIsConnection(ii, jj, kk, 2 * dd + 1))) {
+            calcOperator(ii, jj, kk, dd, il, jl, kl, true);
+          }
+          if (this->IsPhysical(il, jl, kl) &&
+              (this->IsPhysical(ii, jj, kk) ||
+               bc_.BCIsConnection(ii, jj, kk, 2 * dd + 2))) {
+            calcOperator(ii, jj, kk, dd, ii, jj, kk, false);
+          }
+        }
+      }
+    }
+  }
+}
+
 /* Member function to calculate update to solution implicitly using Lower-Upper
 Symmetric Gauss Seidel (LUSGS) method.
 
@@ -1228,331 +2206,223 @@ variabes (FD(Unj)) which is known due to sweeping along hyperplanes.
 
 For viscous simulations, the viscous contribution to the spectral radius K is
 used, and everything else remains the same.
+
+The cells on a hyperplane only depend on cells on the neighboring hyperplanes,
+so all cells on a hyperplane can be updated at the same time. The sweeps split
+the cells of each hyperplane among the threads, and the threads wait for each
+other before moving on to the next hyperplane. With a single thread the cells
+are visited in the same order as a serial sweep.
  */
-void procBlock::LUSGS_Forward(const vector<vector3d<int>> &reorder,
-                              multiArray3d<genArray> &x,
+void procBlock::LUSGS_Forward(multiArray3d<genArray> &x,
                               const unique_ptr<eos> &eqnState, const input &inp,
                               const unique_ptr<thermodynamic> &thermo,
                               const unique_ptr<transport> &trans,
                               const unique_ptr<turbModel> &turb,
-                              const multiArray3d<fluxJacobian> &aInv,
+                              const implicitDiagonal &aLU,
                               const int &sweep) const {
-  // reorder -- order of cells to visit (this should be ordered in hyperplanes)
   // x -- correction - added to solution at time n to get to time n+1 (assumed
   //      to be zero to start)
   // eqnState -- equation of state
   // inp -- all input variables
   // trans -- viscous transport model
   // turb -- turbulence model
-  // aInv -- inverse of main diagonal
+  // aLU -- LU factorization of main diagonal
   // sweep -- sweep number through domain
 
   const auto thetaInv = 1.0 / inp.Theta();
+  const auto numPlanes = hyperplanes_.NumPlanes();
+
+  // Only need to calculate contribution for U if matrix update has been
+  // initialized, or if this is not the first sweep through the domain.
+  // If the matrix is not initialized, the update x is 0 for the first
+  // sweep, so U is 0.
+  const auto calcUpper = sweep > 0 || inp.MatrixRequiresInitialization();
 
   //--------------------------------------------------------------------
   // forward sweep over all physical cells
-  for (auto nn = 0; nn < this->NumCells(); nn++) {
-    // indices for variables without ghost cells
-    const auto ii = reorder[nn].X();
-    const auto jj = reorder[nn].Y();
-    const auto kk = reorder[nn].Z();
-
-    // initialize term for contribution from lower/upper triangular matrix
-    genArray L(0.0);
-    genArray U(0.0);
-
-    // if i lower diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii - 1, jj, kk) ||
-        bc_.BCIsConnection(ii, jj, kk, 1)) {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
-
-      // update L matrix
-      L += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                       x(ii - 1 , jj, kk), fAreaI_(ii, jj, kk),
-                       this->Viscosity(ii - 1, jj, kk),
-                       this->EddyViscosity(ii - 1, jj, kk),
-                       this->F1(ii - 1, jj, kk), projDist,
-                       this->VelGrad(ii - 1, jj, kk),
-                       eqnState, thermo, trans, turb, inp, true);
-    }
-
-    // -----------------------------------------------------------------------
-    // if j lower diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj - 1, kk) ||
-        bc_.BCIsConnection(ii, jj, kk, 3)) {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
-
-      // update L matrix
-      L += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                       x(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
-                       this->Viscosity(ii, jj - 1, kk),
-                       this->EddyViscosity(ii, jj - 1, kk),
-                       this->F1(ii, jj - 1, kk), projDist,
-                       this->VelGrad(ii, jj - 1, kk),
-                       eqnState, thermo, trans, turb, inp, true);
-    }
-
-    // -----------------------------------------------------------------------
-    // if k lower diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj, kk - 1) ||
-        bc_.BCIsConnection(ii, jj, kk, 5)) {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
-
-      // update L matrix
-      L += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                       x(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
-                       this->Viscosity(ii, jj, kk - 1),
-                       this->EddyViscosity(ii, jj, kk - 1),
-                       this->F1(ii, jj, kk - 1), projDist,
-                       this->VelGrad(ii, jj, kk - 1),
-                       eqnState, thermo, trans, turb, inp, true);
-    }
-
-
-    // Only need to calculate contribution for U if matrix update has been
-    // initialized, or if this is not the first sweep through the domain.
-    // If the matrix is not initialized, the update x is 0 for the first
-    // sweep, so U is 0.
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      // -----------------------------------------------------------------------
-      // if i upper cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii + 1, jj, kk) ||
-          bc_.BCIsConnection(ii + 1, jj, kk, 2)) {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
-
-        // update U matrix
-        U += OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
-                         x(ii + 1 , jj, kk), fAreaI_(ii + 1, jj, kk),
-                         this->Viscosity(ii + 1, jj, kk),
-                         this->EddyViscosity(ii + 1, jj, kk),
-                         this->F1(ii + 1, jj, kk), projDist,
-                         this->VelGrad(ii + 1, jj, kk),
-                         eqnState, thermo, trans, turb, inp, false);
-      }
-
-      // -----------------------------------------------------------------------
-      // if j upper cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj + 1, kk) ||
-          bc_.BCIsConnection(ii, jj + 1, kk, 4)) {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
-
-        // update U matrix
-        U += OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
-                         x(ii, jj + 1, kk), fAreaJ_(ii, jj + 1, kk),
-                         this->Viscosity(ii, jj + 1, kk),
-                         this->EddyViscosity(ii, jj + 1, kk),
-                         this->F1(ii, jj + 1, kk), projDist,
-                         this->VelGrad(ii, jj + 1, kk),
-                         eqnState, thermo, trans, turb, inp, false);
-      }
-
-      // -----------------------------------------------------------------------
-      // if k lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj, kk + 1) ||
-          bc_.BCIsConnection(ii, jj, kk + 1, 6)) {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
-
-        // update U matrix
-        U += OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
-                         x(ii, jj, kk + 1), fAreaK_(ii, jj, kk + 1),
-                         this->Viscosity(ii, jj, kk + 1),
-                         this->EddyViscosity(ii, jj, kk + 1),
-                         this->F1(ii, jj, kk + 1), projDist,
-                         this->VelGrad(ii, jj, kk + 1),
-                         eqnState, thermo, trans, turb, inp, false);
-      }
+#pragma omp parallel
+  for (auto pp = 0; pp < numPlanes; pp++) {
+    const auto planeStart = hyperplanes_.PlaneStart(pp);
+    const auto planeEnd = hyperplanes_.PlaneEnd(pp);
+    // implicit barrier at end of loop before next hyperplane
+#pragma omp for schedule(static)
+    for (auto nn = planeStart; nn < planeEnd; nn++) {
+      // indices for variables without ghost cells
+      const auto ii = hyperplanes_[nn].X();
+      const auto jj = hyperplanes_[nn].Y();
+      const auto kk = hyperplanes_[nn].Z();
+
+      // contribution from lower/upper triangular matrix
+      const auto L = this->LowerOffDiagonal(ii, jj, kk, x, eqnState, inp,
+                                            thermo, trans, turb);
+      const auto U = calcUpper ?
+          this->UpperOffDiagonal(ii, jj, kk, x, eqnState, inp, thermo, trans,
+                                 turb) :
+          genArray(0.0);
+
+      // ---------------------------------------------------------------------
+      const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
+      const auto solDeltaMmN =
+          this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo);
+
+      // calculate intermediate update
+      // normal at lower boundaries needs to be reversed, so add instead
+      // of subtract L
+      x(ii, jj, kk) = aLU.Solve(ii, jj, kk, -thetaInv *
+                                residual_(ii, jj, kk) -
+                                solDeltaNm1 - solDeltaMmN + L - U);
     }
-    // -----------------------------------------------------------------------
-    const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
-    const auto solDeltaMmN =
-        this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo);
-
-    // calculate intermediate update
-    // normal at lower boundaries needs to be reversed, so add instead
-    // of subtract L
-    x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(-thetaInv *
-                                               residual_(ii, jj, kk) -
-                                               solDeltaNm1 - solDeltaMmN +
-                                               L - U);
   }  // end forward sweep
 }
 
 double procBlock::LUSGS_Backward(
-    const vector<vector3d<int>> &reorder, multiArray3d<genArray> &x,
-    const unique_ptr<eos> &eqnState, const input &inp,
+    multiArray3d<genArray> &x, const unique_ptr<eos> &eqnState,
+    const input &inp,
     const unique_ptr<thermodynamic> &thermo, const unique_ptr<transport> &trans,
-    const unique_ptr<turbModel> &turb, const multiArray3d<fluxJacobian> &aInv,
+    const unique_ptr<turbModel> &turb, const implicitDiagonal &aLU,
     const int &sweep) const {
-  // reorder -- order of cells to visit (this should be ordered in hyperplanes)
   // x -- correction - added to solution at time n to get to time n+1 (assumed
   //      to be zero to start)
   // eqnState -- equation of state
   // inp -- all input variables
   // trans -- viscous transport model
   // turb -- turbulence model
-  // aInv -- inverse of main diagonal
+  // aLU -- LU factorization of main diagonal
   // sweep -- sweep number through domain
 
   const auto thetaInv = 1.0 / inp.Theta();
+  const auto numPlanes = hyperplanes_.NumPlanes();
 
-  genArray l2Error(0.0);
+  // Only need to calculate contribution for L if matrix update has been
+  // initialized, or if this is not the first sweep through the domain.
+  // If the matrix is not initialized, then b - Lx^* was already solved for
+  // in the forward sweep, so L is not needed
+  const auto calcLower = sweep > 0 || inp.MatrixRequiresInitialization();
 
-  // backward sweep over all physical cells
-  for (auto nn = this->NumCells() - 1; nn >= 0; nn--) {
-    // indices for variables without ghost cells
-    const auto ii = reorder[nn].X();
-    const auto jj = reorder[nn].Y();
-    const auto kk = reorder[nn].Z();
-
-    // initialize term for contribution from upper/lower triangular matrix
-    genArray U(0.0);
-    genArray L(0.0);
-
-    // -----------------------------------------------------------------------
-    // if i upper diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii + 1, jj, kk) ||
-        bc_.BCIsConnection(ii + 1, jj, kk, 2)) {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
-
-      // update U matrix
-      U += OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
-                       x(ii + 1, jj, kk), fAreaI_(ii + 1, jj, kk),
-                       this->Viscosity(ii + 1, jj, kk),
-                       this->EddyViscosity(ii + 1, jj, kk),
-                       this->F1(ii + 1, jj, kk), projDist,
-                       this->VelGrad(ii + 1, jj, kk),
-                       eqnState, thermo, trans, turb, inp, false);
-    }
+  // each thread accumulates its own error, and they are combined in thread
+  // order
+  vector<genArray> threadError(MaxThreads(), genArray(0.0));
 
-    // -----------------------------------------------------------------------
-    // if j upper diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj + 1, kk) ||
-        bc_.BCIsConnection(ii, jj + 1, kk, 4)) {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
-
-      // update U matrix
-      U += OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
-                       x(ii, jj + 1, kk), fAreaJ_(ii, jj + 1, kk),
-                       this->Viscosity(ii, jj + 1, kk),
-                       this->EddyViscosity(ii, jj + 1, kk),
-                       this->F1(ii, jj + 1, kk), projDist,
-                       this->VelGrad(ii, jj + 1, kk),
-                       eqnState, thermo, trans, turb, inp, false);
-    }
+  // backward sweep over all physical cells
+#pragma omp parallel
+  for (auto pp = numPlanes - 1; pp >= 0; pp--) {
+    auto &l2Error = threadError[ThreadNum()];
+    const auto planeStart = hyperplanes_.PlaneStart(pp);
+    const auto planeEnd = hyperplanes_.PlaneEnd(pp);
+    // implicit barrier at end of loop before next hyperplane
+#pragma omp for schedule(static)
+    for (auto nn = planeEnd - 1; nn >= planeStart; nn--) {
+      // indices for variables without ghost cells
+      const auto ii = hyperplanes_[nn].X();
+      const auto jj = hyperplanes_[nn].Y();
+      const auto kk = hyperplanes_[nn].Z();
+
+      // contribution from upper/lower triangular matrix
+      const auto U = this->UpperOffDiagonal(ii, jj, kk, x, eqnState, inp,
+                                            thermo, trans, turb);
+
+      // ---------------------------------------------------------------------
+      // calculate update
+      auto xold = x(ii, jj, kk);
+      if (calcLower) {
+        const auto L = this->LowerOffDiagonal(ii, jj, kk, x, eqnState, inp,
+                                              thermo, trans, turb);
+        const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
+        const auto solDeltaMmN =
+            this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo);
 
-    // -----------------------------------------------------------------------
-    // if k upper diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj, kk + 1) ||
-        bc_.BCIsConnection(ii, jj, kk + 1, 6)) {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
-
-      // update U matrix
-      U += OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
-                       x(ii, jj, kk + 1), fAreaK_(ii, jj, kk + 1),
-                       this->Viscosity(ii, jj, kk + 1),
-                       this->EddyViscosity(ii, jj, kk + 1),
-                       this->F1(ii, jj, kk + 1), projDist,
-                       this->VelGrad(ii, jj, kk + 1),
-                       eqnState, thermo, trans, turb, inp, false);
+        x(ii, jj, kk) = aLU.Solve(ii, jj, kk, -thetaInv *
+                                  residual_(ii, jj, kk) -
+                                  solDeltaNm1 - solDeltaMmN + L - U);
+      } else {
+        x(ii, jj, kk) -= aLU.Solve(ii, jj, kk, U);
+      }
+      const auto error = x(ii, jj, kk) - xold;
+      l2Error += error * error;
     }
+  }  // end backward sweep
 
+  genArray l2Error(0.0);
+  for (auto &error : threadError) {
+    l2Error += error;
+  }
+  return l2Error.Sum();
+}
 
-    // Only need to calculate contribution for L if matrix update has been
-    // initialized, or if this is not the first sweep through the domain.
-    // If the matrix is not initialized, then b - Lx^* was already solved for
-    // in the forward sweep, so L is not needed
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      // -----------------------------------------------------------------------
-      // if i lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii - 1, jj, kk) ||
-          bc_.BCIsConnection(ii, jj, kk, 1)) {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
-
-        // update U matrix
-        L += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                         x(ii - 1, jj, kk), fAreaI_(ii, jj, kk),
-                         this->Viscosity(ii - 1, jj, kk),
-                         this->EddyViscosity(ii - 1, jj, kk),
-                         this->F1(ii - 1, jj, kk), projDist,
-                         this->VelGrad(ii - 1, jj, kk),
-                         eqnState, thermo, trans, turb, inp, true);
-      }
+/* Member function to calculate the implicit update with a multicolor
+(red-black) Gauss-Seidel sweep. The cells are colored by the parity of their
+hyperplane (i+j+k), so all of the neighbors of a cell have the other color.
+All cells of one color are updated at the same time using the latest values of
+the cells of the other color, so the threads only need to wait for each other
+between colors. Since the lower and upper neighbors are both known, the full
+off diagonal contribution is used for every cell. This converges more slowly per
+sweep than the LUSGS method, but has far fewer synchronization points.
+ */
+double procBlock::MulticolorGS(multiArray3d<genArray> &x,
+                               const unique_ptr<eos> &eqnState,
+                               const input &inp,
+                               const unique_ptr<thermodynamic> &thermo,
+                               const unique_ptr<transport> &trans,
+                               const unique_ptr<turbModel> &turb,
+                               const implicitDiagonal &aLU) const {
+  // x -- correction - added to solution at time n to get to time n+1
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // trans -- viscous transport model
+  // turb -- turbulence model
+  // aLU -- LU factorization of main diagonal
 
-      // -----------------------------------------------------------------------
-      // if j lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj - 1, kk) ||
-          bc_.BCIsConnection(ii, jj, kk, 3)) {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
-
-        // update U matrix
-        L += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                         x(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
-                         this->Viscosity(ii, jj - 1, kk),
-                         this->EddyViscosity(ii, jj - 1, kk),
-                         this->F1(ii, jj - 1, kk), projDist,
-                         this->VelGrad(ii, jj - 1, kk),
-                         eqnState, thermo, trans, turb, inp, true);
-      }
+  const auto thetaInv = 1.0 / inp.Theta();
+  const auto numPlanes = hyperplanes_.NumPlanes();
+
+  // each thread accumulates its own error, and they are combined in thread
+  // order
+  vector<genArray> threadError(MaxThreads(), genArray(0.0));
+
+#pragma omp parallel
+  {
+    auto &l2Error = threadError[ThreadNum()];
+    for (auto color = 0; color < 2; color++) {
+      for (auto pp = color; pp < numPlanes; pp += 2) {
+        const auto planeStart = hyperplanes_.PlaneStart(pp);
+        const auto planeEnd = hyperplanes_.PlaneEnd(pp);
+        // cells of the same color are independent, so no need to wait
+        // between hyperplanes
+#pragma omp for schedule(static) nowait
+        for (auto nn = planeStart; nn < planeEnd; nn++) {
+          // indices for variables without ghost cells
+          const auto ii = hyperplanes_[nn].X();
+          const auto jj = hyperplanes_[nn].Y();
+          const auto kk = hyperplanes_[nn].Z();
+
+          // contribution from neighboring cells
+          const auto L = this->LowerOffDiagonal(ii, jj, kk, x, eqnState, inp,
+                                                thermo, trans, turb);
+          const auto U = this->UpperOffDiagonal(ii, jj, kk, x, eqnState, inp,
+                                                thermo, trans, turb);
+
+          const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
+          const auto solDeltaMmN =
+              this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo);
 
-      // -----------------------------------------------------------------------
-      // if k lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj, kk - 1) ||
-          bc_.BCIsConnection(ii, jj, kk, 5)) {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
-
-        // update U matrix
-        L += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                         x(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
-                         this->Viscosity(ii, jj, kk - 1),
-                         this->EddyViscosity(ii, jj, kk - 1),
-                         this->F1(ii, jj, kk - 1), projDist,
-                         this->VelGrad(ii, jj, kk - 1),
-                         eqnState, thermo, trans, turb, inp, true);
+          // calculate update
+          auto xold = x(ii, jj, kk);
+          x(ii, jj, kk) = aLU.Solve(ii, jj, kk, -thetaInv *
+                                    residual_(ii, jj, kk) -
+                                    solDeltaNm1 - solDeltaMmN + L - U);
+          const auto error = x(ii, jj, kk) - xold;
+          l2Error += error * error;
+        }
       }
+      // all cells of this color must be updated before the next color
+#pragma omp barrier
     }
-    // -----------------------------------------------------------------------
-    const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
-    const auto solDeltaMmN =
-        this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo);
-
-    // calculate update
-    auto xold = x(ii, jj, kk);
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(-thetaInv *
-                                                 residual_(ii, jj, kk) -
-                                                 solDeltaNm1 - solDeltaMmN +
-                                                 L - U);
-    } else {
-      x(ii, jj, kk) -= aInv(ii, jj, kk).ArrayMult(U);
-    }
-    const auto error = x(ii, jj, kk) - xold;
-    l2Error += error * error;
-  }  // end backward sweep
+  }
 
+  genArray l2Error(0.0);
+  for (auto &error : threadError) {
+    l2Error += error;
+  }
   return l2Error.Sum();
 }
 
@@ -1564,14 +2434,14 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
                         const unique_ptr<thermodynamic> &thermo,
                         const unique_ptr<transport> &trans,
                         const unique_ptr<turbModel> &turb,
-                        const multiArray3d<fluxJacobian> &aInv) const {
+                        const implicitDiagonal &aLU) const {
   // x -- correction - added to solution at time n to get to time n+1 (assumed
   //                   to be zero to start)
   // eqnState -- equation of state
   // inp -- all input variables
   // trans -- viscous transport model
   // turb -- turbulence model
-  // aInv -- inverse of main diagonal
+  // aLU -- LU factorization of main diagonal
 
   const auto thetaInv = 1.0 / inp.Theta();
 
@@ -1592,17 +2462,9 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // contribution from it
         if (this->IsPhysical(ii - 1, jj, kk) ||
             bc_.BCIsConnection(ii, jj, kk, 1)) {
-          // calculate projected center to center distance
-          const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
-
-          // update off diagonal
-          offDiagonal += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                                     xold(ii - 1, jj, kk), fAreaI_(ii, jj, kk),
-                                     this->Viscosity(ii - 1, jj, kk),
-                                     this->EddyViscosity(ii - 1, jj, kk),
-                                     this->F1(ii - 1, jj, kk), projDist,
-                                     this->VelGrad(ii - 1, jj, kk),
-                                     eqnState, thermo, trans, turb, inp, true);
+          offDiagonal += this->FaceOffDiagonal(ii, jj, kk, 0, true, xold,
+                                                eqnState, inp, thermo, trans,
+                                                turb);
         }
 
         // --------------------------------------------------------------
@@ -1610,17 +2472,9 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // constribution from it
         if (this->IsPhysical(ii, jj - 1, kk) ||
             bc_.BCIsConnection(ii, jj, kk, 3)) {
-          // calculate projected center to center distance
-          const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
-
-          // update off diagonal
-          offDiagonal += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                                     xold(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
-                                     this->Viscosity(ii, jj - 1 , kk),
-                                     this->EddyViscosity(ii, jj - 1 , kk),
-                                     this->F1(ii, jj - 1 , kk), projDist,
-                                     this->VelGrad(ii, jj - 1, kk),
-                                     eqnState, thermo, trans, turb, inp, true);
+          offDiagonal += this->FaceOffDiagonal(ii, jj, kk, 1, true, xold,
+                                                eqnState, inp, thermo, trans,
+                                                turb);
         }
 
         // --------------------------------------------------------------
@@ -1628,17 +2482,9 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // contribution from it
         if (this->IsPhysical(ii, jj, kk - 1) ||
             bc_.BCIsConnection(ii, jj, kk, 5)) {
-          // calculate projected center to center distance
-          const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
-
-          // update off diagonal
-          offDiagonal += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                                     xold(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
-                                     this->Viscosity(ii, jj, kk - 1),
-                                     this->EddyViscosity(ii, jj, kk - 1),
-                                     this->F1(ii, jj, kk - 1), projDist,
-                                     this->VelGrad(ii, jj, kk - 1),
-                                     eqnState, thermo, trans, turb, inp, true);
+          offDiagonal += this->FaceOffDiagonal(ii, jj, kk, 2, true, xold,
+                                                eqnState, inp, thermo, trans,
+                                                turb);
         }
 
         // --------------------------------------------------------------
@@ -1646,18 +2492,9 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // contribution from it
         if (this->IsPhysical(ii + 1, jj, kk) ||
             bc_.BCIsConnection(ii + 1, jj, kk, 2)) {
-          // calculate projected center to center distance
-          const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
-
-          // update off diagonal
-          offDiagonal -= OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
-                                     xold(ii + 1, jj, kk),
-                                     fAreaI_(ii + 1, jj, kk),
-                                     this->Viscosity(ii + 1, jj, kk),
-                                     this->EddyViscosity(ii + 1, jj, kk),
-                                     this->F1(ii + 1, jj, kk), projDist,
-                                     this->VelGrad(ii + 1, jj, kk),
-                                     eqnState, thermo, trans, turb, inp, false);
+          offDiagonal -= this->FaceOffDiagonal(ii + 1, jj, kk, 0, false, xold,
+                                                eqnState, inp, thermo, trans,
+                                                turb);
         }
 
         // --------------------------------------------------------------
@@ -1665,18 +2502,9 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // contribution from it
         if (this->IsPhysical(ii, jj + 1, kk) ||
             bc_.BCIsConnection(ii, jj + 1, kk, 4)) {
-          // calculate projected center to center distance
-          const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
-
-          // update off diagonal
-          offDiagonal -= OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
-                                     xold(ii, jj + 1, kk),
-                                     fAreaJ_(ii, jj + 1, kk),
-                                     this->Viscosity(ii, jj + 1, kk),
-                                     this->EddyViscosity(ii, jj + 1, kk),
-                                     this->F1(ii, jj + 1, kk), projDist,
-                                     this->VelGrad(ii, jj + 1, kk),
-                                     eqnState, thermo, trans, turb, inp, false);
+          offDiagonal -= this->FaceOffDiagonal(ii, jj + 1, kk, 1, false, xold,
+                                                eqnState, inp, thermo, trans,
+                                                turb);
         }
 
         // --------------------------------------------------------------
@@ -1684,18 +2512,9 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // contribution from it
         if (this->IsPhysical(ii, jj, kk + 1) ||
             bc_.BCIsConnection(ii, jj, kk + 1, 6)) {
-          // calculate projected center to center distance
-          const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
-
-          // update off diagonal
-          offDiagonal -= OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
-                                     xold(ii, jj, kk + 1),
-                                     fAreaK_(ii, jj, kk + 1),
-                                     this->Viscosity(ii, jj, kk + 1),
-                                     this->EddyViscosity(ii, jj, kk + 1),
-                                     this->F1(ii, jj, kk + 1), projDist,
-                                     this->VelGrad(ii, jj, kk + 1),
-                                     eqnState, thermo, trans, turb, inp, false);
+          offDiagonal -= this->FaceOffDiagonal(ii, jj, kk + 1, 2, false, xold,
+                                                eqnState, inp, thermo, trans,
+                                                turb);
         }
 
         // --------------------------------------------------------------
@@ -1704,7 +2523,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
             this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo);
 
         // calculate update
-        x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(
+        x(ii, jj, kk) = aLU.Solve(ii, jj, kk,
             -thetaInv * residual_(ii, jj, kk) - solDeltaNm1 - solDeltaMmN
             + offDiagonal);
 
@@ -1721,11 +2540,11 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
 multiArray3d<genArray> procBlock::InitializeMatrixUpdate(
     const input &inp, const unique_ptr<eos> &eqnState,
     const unique_ptr<thermodynamic> &thermo,
-    const multiArray3d<fluxJacobian> &aInv) const {
+    const implicitDiagonal &aLU) const {
   // inp -- input variables
   // eqnState -- equation of state
   // thermo -- thermodynamic model
-  // aInv -- inverse of main diagonal
+  // aLU -- LU factorization of main diagonal
 
   // allocate multiarray for update
   multiArray3d<genArray> x(this->NumI(), this->NumJ(), this->NumK(), numGhosts_,
@@ -1738,7 +2557,7 @@ multiArray3d<genArray> procBlock::InitializeMatrixUpdate(
       for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
         for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
           // calculate update
-          x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(
+          x(ii, jj, kk) = aLU.Solve(ii, jj, kk,
               -thetaInv * residual_(ii, jj, kk) -
               this->SolDeltaNm1(ii, jj, kk, inp) -
               this->SolDeltaMmN(ii, jj, kk, inp, eqnState, thermo));
@@ -1863,7 +2682,7 @@ void procBlock::CalcViscFluxI(const unique_ptr<transport> &trans,
                               const unique_ptr<thermodynamic> &thermo,
                               const unique_ptr<eos> &eqnState, const input &inp,
                               const unique_ptr<turbModel> &turb,
-                              multiArray3d<fluxJacobian> &mainDiagonal) {
+                              implicitDiagonal &mainDiagonal) {
   // trans -- viscous transport model
   // thermo -- thermodynamic model
   // eqnState -- equation of state
@@ -1874,224 +2693,263 @@ void procBlock::CalcViscFluxI(const unique_ptr<transport> &trans,
   // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
   //                 implicit solver
 
+  // loop over all physical i-faces; lines of i-faces only update the cells
+  // on the line, so the lines are divided among the threads
+#pragma omp parallel for collapse(2) schedule(static)
+  for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
+    for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
+      this->CalcViscFluxLineI(jj, kk, trans, thermo, eqnState, inp, turb,
+                              mainDiagonal);
+    }
+  }
+}
+
+// member function to calculate the viscous fluxes on the i-faces along a line
+// of constant j and k
+void procBlock::CalcViscFluxLineI(const int &jj, const int &kk,
+                                  const unique_ptr<transport> &trans,
+                                  const unique_ptr<thermodynamic> &thermo,
+                                  const unique_ptr<eos> &eqnState,
+                                  const input &inp,
+                                  const unique_ptr<turbModel> &turb,
+                                  implicitDiagonal &mainDiagonal) {
+  // jj -- j-index of line
+  // kk -- k-index of line
+  // trans -- viscous transport model
+  // thermo -- thermodynamic model
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
+  //                 implicit solver
+
   const auto viscCoeff = inp.ViscousCFLCoefficient();
+  const auto viscRecon = inp.ViscousReconstruction();
+  const auto cellGrads = inp.IsCellGradients();
   constexpr auto sixth = 1.0 / 6.0;
 
-  // loop over all physical i-faces
-  for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
-    for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
-        // calculate gradients
-        tensor<double> velGrad;
-        vector3d<double> tempGrad, tkeGrad, omegaGrad;
-        this->CalcGradsI(ii, jj, kk, velGrad, tempGrad, tkeGrad, omegaGrad);
-
-        // declare variables needed throughout function
-        primVars state;
-        auto f1 = 0.0;
-        auto f2 = 0.0;
-        auto mu = 0.0;
-        auto mut = 0.0;
-        viscousFlux tempViscFlux;
-
-        // get surface info it at boundary
-        auto surfType = 0;
-        if (ii == fAreaI_.PhysStartI()) {
-          surfType = 1;
-        } else if (ii == fAreaI_.PhysEndI() - 1) {
-          surfType = 2;
-        }
-        const auto isBoundary = (surfType > 0) ? true : false;
-        auto isWallLawBoundary = false;
-        auto isLowReBoundary = false;
-        auto wallDataInd = 0;
-
-        if (isBoundary) {
-          // get boundary surface information
-          const auto surf = bc_.GetBCSurface(ii, jj, kk, surfType);
-          if (surf.BCType() == "viscousWall") {
-            wallDataInd = this->WallDataIndex(surf);
-            isWallLawBoundary =
-                wallData_[wallDataInd].IsWallLaw() &&
-                !wallData_[wallDataInd].SwitchToLowRe(ii, jj, kk);
-            isLowReBoundary = !isWallLawBoundary;
-          }
-        }
+  for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
+    // calculate gradients; boundary faces always use the face control
+    // volume because the ghost cells do not have cell gradients
+    tensor<double> velGrad;
+    vector3d<double> tempGrad, tkeGrad, omegaGrad;
+    if (cellGrads && ii > fAreaI_.PhysStartI() && ii < fAreaI_.PhysEndI() - 1) {
+      this->FaceGradsFromCells(ii - 1, jj, kk, ii, jj, kk, velGrad, tempGrad,
+                               tkeGrad, omegaGrad);
+    } else {
+      this->CalcGradsI(ii, jj, kk, velGrad, tempGrad, tkeGrad, omegaGrad);
+    }
 
-        if (isWallLawBoundary) {
-          // wall law wall boundary
-          f1 = 1.0;
-          f2 = 1.0;
-          mu = wallData_[wallDataInd].WallViscosity(ii, jj, kk) *
-               trans->InvNondimScaling();
-          mut = wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk) *
-                trans->InvNondimScaling();
-          state = wallData_[wallDataInd].WallState(ii, jj, kk, eqnState);
-          tempViscFlux.CalcWallLawFlux(
-              wallData_[wallDataInd].WallShearStress(ii, jj, kk),
-              wallData_[wallDataInd].WallHeatFlux(ii, jj, kk),
-              wallData_[wallDataInd].WallViscosity(ii, jj, kk),
-              wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk),
-              wallData_[wallDataInd].WallVelocity(),
-              this->FAreaUnitI(ii, jj, kk), tkeGrad, omegaGrad, turb);
-        } else {  // not boundary, or low Re wall boundary
-          auto wDist = 0.0;
-          if (inp.ViscousFaceReconstruction() == "central") {
-            // get cell widths
-            const vector<double> cellWidth = {cellWidthI_(ii - 1, jj, kk),
-                                              cellWidthI_(ii, jj, kk)};
-
-            // Get state at face
-            state = FaceReconCentral(state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                                     cellWidth);
-            state.LimitTurb(turb);
-
-            // Get wall distance at face
-            wDist = FaceReconCentral(wallDist_(ii - 1, jj, kk),
-                                     wallDist_(ii, jj, kk), cellWidth);
-
-            // Get viscosity at face
-            mu = FaceReconCentral(viscosity_(ii - 1, jj, kk),
-                                  viscosity_(ii, jj, kk), cellWidth);
-
-          } else {  // use 4th order reconstruction
-            // get cell widths
-            const vector<double> cellWidth = {
-                cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk)};
-
-            // Get state at face
-            state = FaceReconCentral4th(
-                state_(ii - 2, jj, kk), state_(ii - 1, jj, kk),
-                state_(ii, jj, kk), state_(ii + 1, jj, kk), cellWidth);
-            state.LimitTurb(turb);
-
-            // Get wall distance at face
-            wDist = FaceReconCentral4th(
-                wallDist_(ii - 2, jj, kk), wallDist_(ii - 1, jj, kk),
-                wallDist_(ii, jj, kk), wallDist_(ii + 1, jj, kk), cellWidth);
-
-            // Get viscosity at face
-            mu = FaceReconCentral4th(
-                viscosity_(ii - 2, jj, kk), viscosity_(ii - 1, jj, kk),
-                viscosity_(ii, jj, kk), viscosity_(ii + 1, jj, kk), cellWidth);
-          }
+    // declare variables needed throughout function
+    primVars state;
+    auto f1 = 0.0;
+    auto f2 = 0.0;
+    auto mu = 0.0;
+    auto mut = 0.0;
+    viscousFlux tempViscFlux;
+
+    // get surface info it at boundary
+    auto surfType = 0;
+    if (ii == fAreaI_.PhysStartI()) {
+      surfType = 1;
+    } else if (ii == fAreaI_.PhysEndI() - 1) {
+      surfType = 2;
+    }
+    const auto isBoundary = (surfType > 0) ? true : false;
+    auto isWallLawBoundary = false;
+    auto isLowReBoundary = false;
+    auto wallDataInd = 0;
+
+    if (isBoundary) {
+      // get boundary surface information
+      const auto surf = bc_.GetBCSurface(ii, jj, kk, surfType);
+      if (surf.BCType() == "viscousWall") {
+        wallDataInd = this->WallDataIndex(surf);
+        isWallLawBoundary =
+            wallData_[wallDataInd].IsWallLaw() &&
+            !wallData_[wallDataInd].SwitchToLowRe(ii, jj, kk);
+        isLowReBoundary = !isWallLawBoundary;
+      }
+    }
 
-          // calculate turbulent eddy viscosity and blending coefficients
-          if (isTurbulent_) {
-            // calculate length scale
-            const auto lengthScale =
-                0.5 * (cellWidthI_(ii - 1, jj, kk) + cellWidthI_(ii, jj, kk));
-            turb->EddyViscAndBlending(state, velGrad, tkeGrad, omegaGrad, mu,
-                                      wDist, trans, lengthScale, mut, f1, f2);
-          }
+    if (isWallLawBoundary) {
+      // wall law wall boundary
+      f1 = 1.0;
+      f2 = 1.0;
+      mu = wallData_[wallDataInd].WallViscosity(ii, jj, kk) *
+           trans->InvNondimScaling();
+      mut = wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk) *
+            trans->InvNondimScaling();
+      state = wallData_[wallDataInd].WallState(ii, jj, kk, eqnState);
+      tempViscFlux.CalcWallLawFlux(
+          wallData_[wallDataInd].WallShearStress(ii, jj, kk),
+          wallData_[wallDataInd].WallHeatFlux(ii, jj, kk),
+          wallData_[wallDataInd].WallViscosity(ii, jj, kk),
+          wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk),
+          wallData_[wallDataInd].WallVelocity(),
+          this->FAreaUnitI(ii, jj, kk), tkeGrad, omegaGrad, turb);
+    } else {  // not boundary, or low Re wall boundary
+      auto wDist = 0.0;
+      if (viscRecon == viscousReconstruction::central) {
+        // get cell widths
+        const vector<double> cellWidth = {cellWidthI_(ii - 1, jj, kk),
+                                          cellWidthI_(ii, jj, kk)};
+
+        // Get state at face
+        state = FaceReconCentral(state_(ii - 1, jj, kk), state_(ii, jj, kk),
+                                 cellWidth);
+        state.LimitTurb(turb);
+
+        // Get wall distance at face
+        wDist = FaceReconCentral(wallDist_(ii - 1, jj, kk),
+                                 wallDist_(ii, jj, kk), cellWidth);
+
+        // Get viscosity at face
+        mu = FaceReconCentral(viscosity_(ii - 1, jj, kk),
+                              viscosity_(ii, jj, kk), cellWidth);
+
+      } else {  // use 4th order reconstruction
+        // get precalculated reconstruction coefficients
+        const auto &coeffs = central4thI_(ii, jj, kk);
+
+        // Get state at face
+        state = FaceReconCentral4th(
+            state_(ii - 2, jj, kk), state_(ii - 1, jj, kk),
+            state_(ii, jj, kk), state_(ii + 1, jj, kk), coeffs);
+        state.LimitTurb(turb);
+
+        // Get wall distance at face
+        wDist = FaceReconCentral4th(
+            wallDist_(ii - 2, jj, kk), wallDist_(ii - 1, jj, kk),
+            wallDist_(ii, jj, kk), wallDist_(ii + 1, jj, kk), coeffs);
+
+        // Get viscosity at face
+        mu = FaceReconCentral4th(
+            viscosity_(ii - 2, jj, kk), viscosity_(ii - 1, jj, kk),
+            viscosity_(ii, jj, kk), viscosity_(ii + 1, jj, kk), coeffs);
+      }
 
-          if (isLowReBoundary) {
-            // calculate viscous flux
-            auto wVars = tempViscFlux.CalcWallFlux(
-                velGrad, trans, thermo, eqnState, tempGrad,
-                this->FAreaUnitI(ii, jj, kk), tkeGrad, omegaGrad, turb, state,
-                mu, mut, f1);
-            auto y = (surfType == 1) ? wallDist_(ii, jj, kk)
-                                     : wallDist_(ii - 1, jj, kk);
-            wVars.yplus_ = y * wVars.frictionVelocity_ * wVars.density_ /
-                           (wVars.viscosity_ + wVars.turbEddyVisc_);
-            wallData_[wallDataInd](ii, jj, kk) = wVars;
-          } else {
-            // calculate viscous flux
-            tempViscFlux.CalcFlux(velGrad, trans, thermo, eqnState, tempGrad,
-                                  this->FAreaUnitI(ii, jj, kk), tkeGrad,
-                                  omegaGrad, turb, state, mu, mut, f1);
-          }
-        }
+      // calculate turbulent eddy viscosity and blending coefficients
+      if (isTurbulent_) {
+        // calculate length scale
+        const auto lengthScale =
+            0.5 * (cellWidthI_(ii - 1, jj, kk) + cellWidthI_(ii, jj, kk));
+        turb->EddyViscAndBlending(state, velGrad, tkeGrad, omegaGrad, mu,
+                                  wDist, trans, lengthScale, mut, f1, f2);
+      }
 
-        // calculate projected center to center distance
-        const auto c2cDist = this->ProjC2CDist(ii, jj, kk, "i");
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell but viscous fluxes are subtracted from inviscid
-        // fluxes, so sign is reversed
-        // at left boundary there is no left cell to add to
-        if (ii > fAreaI_.PhysStartI()) {
-          this->SubtractFromResidual(tempViscFlux *
-                                     this->FAreaMagI(ii, jj, kk),
-                                     ii - 1, jj, kk);
-
-          // store gradients
-          velocityGrad_(ii - 1, jj, kk) += sixth * velGrad;
-          temperatureGrad_(ii - 1, jj, kk) += sixth * tempGrad;
-          if (isTurbulent_) {
-            eddyViscosity_(ii - 1, jj, kk) += sixth * mut;
-            if (isRANS_) {
-              tkeGrad_(ii - 1, jj, kk) += sixth * tkeGrad;
-              omegaGrad_(ii - 1, jj, kk) += sixth * omegaGrad;
-              f1_(ii - 1, jj, kk) += sixth * f1;
-              f2_(ii - 1, jj, kk) += sixth * f2;
-            }
-          }
+      if (isLowReBoundary) {
+        // calculate viscous flux
+        auto wVars = tempViscFlux.CalcWallFlux(
+            velGrad, trans, thermo, eqnState, tempGrad,
+            this->FAreaUnitI(ii, jj, kk), tkeGrad, omegaGrad, turb, state,
+            mu, mut, f1);
+        auto y = (surfType == 1) ? wallDist_(ii, jj, kk)
+                                 : wallDist_(ii - 1, jj, kk);
+        wVars.yplus_ = y * wVars.frictionVelocity_ * wVars.density_ /
+                       (wVars.viscosity_ + wVars.turbEddyVisc_);
+        wallData_[wallDataInd](ii, jj, kk) = wVars;
+      } else {
+        // calculate viscous flux
+        tempViscFlux.CalcFlux(velGrad, trans, thermo, eqnState, tempGrad,
+                              this->FAreaUnitI(ii, jj, kk), tkeGrad,
+                              omegaGrad, turb, state, mu, mut, f1);
+      }
+    }
 
-          // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            // using mu, mut, and f1 at face
-            fluxJacobian fluxJac;
-            fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
-                                      thermo, this->FAreaI(ii, jj, kk), c2cDist,
-                                      turb, inp, true, velGrad);
-            mainDiagonal(ii - 1, jj, kk) -= fluxJac;
-          }
+    // calculate projected center to center distance
+    const auto c2cDist = this->ProjC2CDist(ii, jj, kk, "i");
+
+    // area vector points from left to right, so add to left cell, subtract
+    // from right cell but viscous fluxes are subtracted from inviscid
+    // fluxes, so sign is reversed
+    // at left boundary there is no left cell to add to
+    if (ii > fAreaI_.PhysStartI()) {
+      this->SubtractFromResidual(tempViscFlux *
+                                 this->FAreaMagI(ii, jj, kk),
+                                 ii - 1, jj, kk);
+
+      // store gradients; cell gradients are already stored
+      if (!cellGrads) {
+        velocityGrad_(ii - 1, jj, kk) += sixth * velGrad;
+        temperatureGrad_(ii - 1, jj, kk) += sixth * tempGrad;
+        if (isRANS_) {
+          tkeGrad_(ii - 1, jj, kk) += sixth * tkeGrad;
+          omegaGrad_(ii - 1, jj, kk) += sixth * omegaGrad;
         }
-        // at right boundary there is no right cell to add to
-        if (ii < fAreaI_.PhysEndI() - 1) {
-          this->AddToResidual(tempViscFlux *
-                              this->FAreaMagI(ii, jj, kk),
-                              ii, jj, kk);
-
-          // store gradients
-          velocityGrad_(ii, jj, kk) += sixth * velGrad;
-          temperatureGrad_(ii, jj, kk) += sixth * tempGrad;
-          if (isTurbulent_) {
-            eddyViscosity_(ii, jj, kk) += sixth * mut;
-            if (isRANS_) {
-              tkeGrad_(ii, jj, kk) += sixth * tkeGrad;
-              omegaGrad_(ii, jj, kk) += sixth * omegaGrad;
-              f1_(ii, jj, kk) += sixth * f1;
-              f2_(ii, jj, kk) += sixth * f2;
-            }
-          }
+      }
+      if (isTurbulent_) {
+        eddyViscosity_(ii - 1, jj, kk) += sixth * mut;
+        if (isRANS_) {
+          f1_(ii - 1, jj, kk) += sixth * f1;
+          f2_(ii - 1, jj, kk) += sixth * f2;
+        }
+      }
 
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto viscSpecRad =
-              state_(ii, jj, kk)
-                  .ViscCellSpectralRadius(fAreaI_(ii, jj, kk),
-                                          fAreaI_(ii + 1, jj, kk), thermo,
-                                          eqnState, trans, vol_(ii, jj, kk),
-                                          viscosity_(ii, jj, kk), mut, turb);
-
-          const auto turbViscSpecRad = isRANS_ ?
-              turb->ViscCellSpecRad(state_(ii, jj, kk), fAreaI_(ii, jj, kk),
-                                    fAreaI_(ii + 1, jj, kk),
-                                    viscosity_(ii, jj, kk),
-                                    trans, vol_(ii, jj, kk), mut, f1)
-              : 0.0;
-
-          const uncoupledScalar specRad(viscSpecRad, turbViscSpecRad);
-          specRadius_(ii, jj, kk) += specRad * viscCoeff;
-
-          // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            // using mu, mut, and f1 at face
-            fluxJacobian fluxJac;
-            fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
-                                      thermo, this->FAreaI(ii, jj, kk), c2cDist,
-                                      turb, inp, false, velGrad);
-            mainDiagonal(ii, jj, kk) += fluxJac;
-          } else if (inp.IsImplicit()) {
-            // factor 2 because visc spectral radius is not halved (Blazek 6.53)
-            mainDiagonal(ii, jj, kk) += fluxJacobian(2.0 * specRad);
-          }
+      // if using block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        // using mu, mut, and f1 at face
+        fluxJacobian fluxJac;
+        fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
+                                  thermo, this->FAreaI(ii, jj, kk), c2cDist,
+                                  turb, inp, true, velGrad);
+        mainDiagonal.Block(ii - 1, jj, kk) -= fluxJac;
+      }
+    }
+    // at right boundary there is no right cell to add to
+    if (ii < fAreaI_.PhysEndI() - 1) {
+      this->AddToResidual(tempViscFlux *
+                          this->FAreaMagI(ii, jj, kk),
+                          ii, jj, kk);
+
+      // store gradients; cell gradients are already stored
+      if (!cellGrads) {
+        velocityGrad_(ii, jj, kk) += sixth * velGrad;
+        temperatureGrad_(ii, jj, kk) += sixth * tempGrad;
+        if (isRANS_) {
+          tkeGrad_(ii, jj, kk) += sixth * tkeGrad;
+          omegaGrad_(ii, jj, kk) += sixth * omegaGrad;
         }
       }
+      if (isTurbulent_) {
+        eddyViscosity_(ii, jj, kk) += sixth * mut;
+        if (isRANS_) {
+          f1_(ii, jj, kk) += sixth * f1;
+          f2_(ii, jj, kk) += sixth * f2;
+        }
+      }
+
+      // calculate component of wave speed. This is done on a cell by cell
+      // basis, so only at the upper faces
+      const auto viscSpecRad =
+          state_(ii, jj, kk)
+              .ViscCellSpectralRadius(fAreaI_(ii, jj, kk),
+                                      fAreaI_(ii + 1, jj, kk), thermo,
+                                      eqnState, trans, vol_(ii, jj, kk),
+                                      viscosity_(ii, jj, kk), mut, turb);
+
+      const auto turbViscSpecRad = isRANS_ ?
+          turb->ViscCellSpecRad(state_(ii, jj, kk), fAreaI_(ii, jj, kk),
+                                fAreaI_(ii + 1, jj, kk),
+                                viscosity_(ii, jj, kk),
+                                trans, vol_(ii, jj, kk), mut, f1)
+          : 0.0;
+
+      const uncoupledScalar specRad(viscSpecRad, turbViscSpecRad);
+      specRadius_(ii, jj, kk) += specRad * viscCoeff;
+
+      // if using block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        // using mu, mut, and f1 at face
+        fluxJacobian fluxJac;
+        fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
+                                  thermo, this->FAreaI(ii, jj, kk), c2cDist,
+                                  turb, inp, false, velGrad);
+        mainDiagonal.Block(ii, jj, kk) += fluxJac;
+      } else if (inp.IsImplicit()) {
+        // factor 2 because visc spectral radius is not halved (Blazek 6.53)
+        mainDiagonal.Scalar(ii, jj, kk) += 2.0 * specRad;
+      }
     }
   }
 }
@@ -2171,7 +3029,7 @@ void procBlock::CalcViscFluxJ(const unique_ptr<transport> &trans,
                               const unique_ptr<thermodynamic> &thermo,
                               const unique_ptr<eos> &eqnState, const input &inp,
                               const unique_ptr<turbModel> &turb,
-                              multiArray3d<fluxJacobian> &mainDiagonal) {
+                              implicitDiagonal &mainDiagonal) {
   // trans -- viscous transport model
   // thermo -- thermodynamic model
   // eqnState -- equation of state
@@ -2182,226 +3040,275 @@ void procBlock::CalcViscFluxJ(const unique_ptr<transport> &trans,
   // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
   //                 implicit solver
 
+  // j-faces update the cells on either side of them, so the lines of
+  // faces are split in the i-direction among the threads
+#pragma omp parallel
+  {
+    auto iStart = 0;
+    auto iEnd = 0;
+    ThreadRange(fAreaJ_.PhysStartI(), fAreaJ_.PhysEndI(), iStart, iEnd);
+
+    // loop over all physical j-faces
+    for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
+        this->CalcViscFluxLineJ(iStart, iEnd, jj, kk, trans, thermo,
+                                eqnState, inp, turb, mainDiagonal);
+      }
+    }
+  }
+}
+
+// member function to calculate the viscous fluxes on the j-faces from iStart
+// to iEnd along a line of constant j and k
+void procBlock::CalcViscFluxLineJ(const int &iStart, const int &iEnd,
+                                  const int &jj, const int &kk,
+                                  const unique_ptr<transport> &trans,
+                                  const unique_ptr<thermodynamic> &thermo,
+                                  const unique_ptr<eos> &eqnState,
+                                  const input &inp,
+                                  const unique_ptr<turbModel> &turb,
+                                  implicitDiagonal &mainDiagonal) {
+  // iStart -- first face in line
+  // iEnd -- one past last face in line
+  // jj -- j-index of line
+  // kk -- k-index of line
+  // trans -- viscous transport model
+  // thermo -- thermodynamic model
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
+  //                 implicit solver
+
   const auto viscCoeff = inp.ViscousCFLCoefficient();
+  const auto viscRecon = inp.ViscousReconstruction();
+  const auto cellGrads = inp.IsCellGradients();
   constexpr auto sixth = 1.0 / 6.0;
 
-  // loop over all physical j-faces
-  for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
-    for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
-        // calculate gradients
-        tensor<double> velGrad;
-        vector3d<double> tempGrad, tkeGrad, omegaGrad;
-        this->CalcGradsJ(ii, jj, kk, velGrad, tempGrad, tkeGrad, omegaGrad);
-
-        // declare variables needed throughout function
-        primVars state;
-        auto f1 = 0.0;
-        auto f2 = 0.0;
-        auto mu = 0.0;
-        auto mut = 0.0;
-        viscousFlux tempViscFlux;
-
-        // get surface info if at boundary
-        auto surfType = 0;
-        if (jj == fAreaJ_.PhysStartJ()) {
-          surfType = 3;
-        } else if (jj == fAreaJ_.PhysEndJ() - 1) {
-          surfType = 4;
-        }
-        const auto isBoundary = (surfType > 0) ? true : false;
-        auto isWallLawBoundary = false;
-        auto isLowReBoundary = false;
-        auto wallDataInd = 0;
-
-        if (isBoundary) {
-          // get boundary surface information
-          const auto surf = bc_.GetBCSurface(ii, jj, kk, surfType);
-          if (surf.BCType() == "viscousWall") {
-            wallDataInd = this->WallDataIndex(surf);
-            isWallLawBoundary =
-                wallData_[wallDataInd].IsWallLaw() &&
-                !wallData_[wallDataInd].SwitchToLowRe(ii, jj, kk);
-            isLowReBoundary = !isWallLawBoundary;
-          }
-        }
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    // calculate gradients; boundary faces always use the face control
+    // volume because the ghost cells do not have cell gradients
+    tensor<double> velGrad;
+    vector3d<double> tempGrad, tkeGrad, omegaGrad;
+    if (cellGrads && jj > fAreaJ_.PhysStartJ() && jj < fAreaJ_.PhysEndJ() - 1) {
+      this->FaceGradsFromCells(ii, jj - 1, kk, ii, jj, kk, velGrad, tempGrad,
+                               tkeGrad, omegaGrad);
+    } else {
+      this->CalcGradsJ(ii, jj, kk, velGrad, tempGrad, tkeGrad, omegaGrad);
+    }
 
-        if (isWallLawBoundary) {
-          // wall law wall boundary
-          f1 = 1.0;
-          f2 = 1.0;
-          mu = wallData_[wallDataInd].WallViscosity(ii, jj, kk) *
-               trans->InvNondimScaling();
-          mut = wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk) *
-                trans->InvNondimScaling();
-          state = wallData_[wallDataInd].WallState(ii, jj, kk, eqnState);
-          tempViscFlux.CalcWallLawFlux(
-              wallData_[wallDataInd].WallShearStress(ii, jj, kk),
-              wallData_[wallDataInd].WallHeatFlux(ii, jj, kk),
-              wallData_[wallDataInd].WallViscosity(ii, jj, kk),
-              wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk),
-              wallData_[wallDataInd].WallVelocity(),
-              this->FAreaUnitJ(ii, jj, kk), tkeGrad, omegaGrad, turb);
-        } else {  // not boundary, or low Re wall boundary
-          auto wDist = 0.0;
-          if (inp.ViscousFaceReconstruction() == "central") {
-            // get cell widths
-            const vector<double> cellWidth = {cellWidthJ_(ii, jj - 1, kk),
-                                              cellWidthJ_(ii, jj, kk)};
-
-            // Get velocity at face
-            state = FaceReconCentral(state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                                     cellWidth);
-            state.LimitTurb(turb);
-
-            // Get wall distance at face
-            wDist = FaceReconCentral(wallDist_(ii, jj - 1, kk),
-                                     wallDist_(ii, jj, kk), cellWidth);
-
-            // Get wall distance at face
-            mu = FaceReconCentral(viscosity_(ii, jj - 1, kk),
-                                  viscosity_(ii, jj, kk), cellWidth);
-
-          } else {  // use 4th order reconstruction
-            // get cell widths
-            const vector<double> cellWidth = {
-                cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk)};
-
-            // Get velocity at face
-            state = FaceReconCentral4th(
-                state_(ii, jj - 2, kk), state_(ii, jj - 1, kk),
-                state_(ii, jj, kk), state_(ii, jj + 1, kk), cellWidth);
-            state.LimitTurb(turb);
-
-            // Get wall distance at face
-            wDist = FaceReconCentral4th(
-                wallDist_(ii, jj - 2, kk), wallDist_(ii, jj - 1, kk),
-                wallDist_(ii, jj, kk), wallDist_(ii, jj + 1, kk), cellWidth);
-
-            // Get wall distance at face
-            mu = FaceReconCentral4th(
-                viscosity_(ii, jj - 2, kk), viscosity_(ii, jj - 1, kk),
-                viscosity_(ii, jj, kk), viscosity_(ii, jj + 1, kk), cellWidth);
-          }
+    // declare variables needed throughout function
+    primVars state;
+    auto f1 = 0.0;
+    auto f2 = 0.0;
+    auto mu = 0.0;
+    auto mut = 0.0;
+    viscousFlux tempViscFlux;
+
+    // get surface info if at boundary
+    auto surfType = 0;
+    if (jj == fAreaJ_.PhysStartJ()) {
+      surfType = 3;
+    } else if (jj == fAreaJ_.PhysEndJ() - 1) {
+      surfType = 4;
+    }
+    const auto isBoundary = (surfType > 0) ? true : false;
+    auto isWallLawBoundary = false;
+    auto isLowReBoundary = false;
+    auto wallDataInd = 0;
+
+    if (isBoundary) {
+      // get boundary surface information
+      const auto surf = bc_.GetBCSurface(ii, jj, kk, surfType);
+      if (surf.BCType() == "viscousWall") {
+        wallDataInd = this->WallDataIndex(surf);
+        isWallLawBoundary =
+            wallData_[wallDataInd].IsWallLaw() &&
+            !wallData_[wallDataInd].SwitchToLowRe(ii, jj, kk);
+        isLowReBoundary = !isWallLawBoundary;
+      }
+    }
 
-          // calculate turbulent eddy viscosity and blending coefficients
-          if (isTurbulent_) {
-            // calculate length scale
-            const auto lengthScale =
-                0.5 * (cellWidthJ_(ii, jj - 1, kk) + cellWidthJ_(ii, jj, kk));
-            turb->EddyViscAndBlending(state, velGrad, tkeGrad, omegaGrad, mu,
-                                      wDist, trans, lengthScale, mut, f1, f2);
-          }
+    if (isWallLawBoundary) {
+      // wall law wall boundary
+      f1 = 1.0;
+      f2 = 1.0;
+      mu = wallData_[wallDataInd].WallViscosity(ii, jj, kk) *
+           trans->InvNondimScaling();
+      mut = wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk) *
+            trans->InvNondimScaling();
+      state = wallData_[wallDataInd].WallState(ii, jj, kk, eqnState);
+      tempViscFlux.CalcWallLawFlux(
+          wallData_[wallDataInd].WallShearStress(ii, jj, kk),
+          wallData_[wallDataInd].WallHeatFlux(ii, jj, kk),
+          wallData_[wallDataInd].WallViscosity(ii, jj, kk),
+          wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk),
+          wallData_[wallDataInd].WallVelocity(),
+          this->FAreaUnitJ(ii, jj, kk), tkeGrad, omegaGrad, turb);
+    } else {  // not boundary, or low Re wall boundary
+      auto wDist = 0.0;
+      if (viscRecon == viscousReconstruction::central) {
+        // get cell widths
+        const vector<double> cellWidth = {cellWidthJ_(ii, jj - 1, kk),
+                                          cellWidthJ_(ii, jj, kk)};
+
+        // Get velocity at face
+        state = FaceReconCentral(state_(ii, jj - 1, kk), state_(ii, jj, kk),
+                                 cellWidth);
+        state.LimitTurb(turb);
+
+        // Get wall distance at face
+        wDist = FaceReconCentral(wallDist_(ii, jj - 1, kk),
+                                 wallDist_(ii, jj, kk), cellWidth);
+
+        // Get wall distance at face
+        mu = FaceReconCentral(viscosity_(ii, jj - 1, kk),
+                              viscosity_(ii, jj, kk), cellWidth);
+
+      } else {  // use 4th order reconstruction
+        // get precalculated reconstruction coefficients
+        const auto &coeffs = central4thJ_(ii, jj, kk);
+
+        // Get velocity at face
+        state = FaceReconCentral4th(
+            state_(ii, jj - 2, kk), state_(ii, jj - 1, kk),
+            state_(ii, jj, kk), state_(ii, jj + 1, kk), coeffs);
+        state.LimitTurb(turb);
+
+        // Get wall distance at face
+        wDist = FaceReconCentral4th(
+            wallDist_(ii, jj - 2, kk), wallDist_(ii, jj - 1, kk),
+            wallDist_(ii, jj, kk), wallDist_(ii, jj + 1, kk), coeffs);
+
+        // Get wall distance at face
+        mu = FaceReconCentral4th(
+            viscosity_(ii, jj - 2, kk), viscosity_(ii, jj - 1, kk),
+            viscosity_(ii, jj, kk), viscosity_(ii, jj + 1, kk), coeffs);
+      }
 
-          if (isLowReBoundary) {
-            // calculate viscous flux
-            auto wVars = tempViscFlux.CalcWallFlux(
-                velGrad, trans, thermo, eqnState, tempGrad,
-                this->FAreaUnitJ(ii, jj, kk), tkeGrad, omegaGrad, turb, state,
-                mu, mut, f1);
-            auto y = (surfType == 3) ? wallDist_(ii, jj, kk)
-                                     : wallDist_(ii, jj - 1, kk);
-            wVars.yplus_ = y * wVars.frictionVelocity_ * wVars.density_ /
-                           (wVars.viscosity_ + wVars.turbEddyVisc_);
-            wallData_[wallDataInd](ii, jj, kk) = wVars;
-          } else {
-            // calculate viscous flux
-            tempViscFlux.CalcFlux(velGrad, trans, thermo, eqnState, tempGrad,
-                                  this->FAreaUnitJ(ii, jj, kk), tkeGrad,
-                                  omegaGrad, turb, state, mu, mut, f1);
-          }
-        }
+      // calculate turbulent eddy viscosity and blending coefficients
+      if (isTurbulent_) {
+        // calculate length scale
+        const auto lengthScale =
+            0.5 * (cellWidthJ_(ii, jj - 1, kk) + cellWidthJ_(ii, jj, kk));
+        turb->EddyViscAndBlending(state, velGrad, tkeGrad, omegaGrad, mu,
+                                  wDist, trans, lengthScale, mut, f1, f2);
+      }
 
-        // calculate projected center to center distance
-        const auto c2cDist = this->ProjC2CDist(ii, jj, kk, "j");
-
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell but viscous fluxes are subtracted from inviscid
-        // fluxes, so sign is reversed
-        // at left boundary there is no left cell to add to
-        if (jj > fAreaJ_.PhysStartJ()) {
-          this->SubtractFromResidual(tempViscFlux *
-                                     this->FAreaMagJ(ii, jj, kk),
-                                     ii, jj - 1, kk);
-
-          // store gradients
-          velocityGrad_(ii, jj - 1, kk) += sixth * velGrad;
-          temperatureGrad_(ii, jj - 1, kk) += sixth * tempGrad;
-          if (isTurbulent_) {
-            eddyViscosity_(ii, jj - 1, kk) += sixth * mut;
-            if (isRANS_) {
-              tkeGrad_(ii, jj - 1, kk) += sixth * tkeGrad;
-              omegaGrad_(ii, jj - 1, kk) += sixth * omegaGrad;
-              f1_(ii, jj - 1, kk) += sixth * f1;
-              f2_(ii, jj - 1, kk) += sixth * f2;
-            }
-          }
+      if (isLowReBoundary) {
+        // calculate viscous flux
+        auto wVars = tempViscFlux.CalcWallFlux(
+            velGrad, trans, thermo, eqnState, tempGrad,
+            this->FAreaUnitJ(ii, jj, kk), tkeGrad, omegaGrad, turb, state,
+            mu, mut, f1);
+        auto y = (surfType == 3) ? wallDist_(ii, jj, kk)
+                                 : wallDist_(ii, jj - 1, kk);
+        wVars.yplus_ = y * wVars.frictionVelocity_ * wVars.density_ /
+                       (wVars.viscosity_ + wVars.turbEddyVisc_);
+        wallData_[wallDataInd](ii, jj, kk) = wVars;
+      } else {
+        // calculate viscous flux
+        tempViscFlux.CalcFlux(velGrad, trans, thermo, eqnState, tempGrad,
+                              this->FAreaUnitJ(ii, jj, kk), tkeGrad,
+                              omegaGrad, turb, state, mu, mut, f1);
+      }
+    }
 
-          // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            // using mu, mut, and f1 at face
-            fluxJacobian fluxJac;
-            fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
-                                      thermo, this->FAreaJ(ii, jj, kk), c2cDist,
-                                      turb, inp, true, velGrad);
-            mainDiagonal(ii, jj - 1, kk) -= fluxJac;
-          }
+    // calculate projected center to center distance
+    const auto c2cDist = this->ProjC2CDist(ii, jj, kk, "j");
+
+
+    // area vector points from left to right, so add to left cell, subtract
+    // from right cell but viscous fluxes are subtracted from inviscid
+    // fluxes, so sign is reversed
+    // at left boundary there is no left cell to add to
+    if (jj > fAreaJ_.PhysStartJ()) {
+      this->SubtractFromResidual(tempViscFlux *
+                                 this->FAreaMagJ(ii, jj, kk),
+                                 ii, jj - 1, kk);
+
+      // store gradients; cell gradients are already stored
+      if (!cellGrads) {
+        velocityGrad_(ii, jj - 1, kk) += sixth * velGrad;
+        temperatureGrad_(ii, jj - 1, kk) += sixth * tempGrad;
+        if (isRANS_) {
+          tkeGrad_(ii, jj - 1, kk) += sixth * tkeGrad;
+          omegaGrad_(ii, jj - 1, kk) += sixth * omegaGrad;
         }
-        // at right boundary there is no right cell to add to
-        if (jj < fAreaJ_.PhysEndJ() - 1) {
-          this->AddToResidual(tempViscFlux *
-                              this->FAreaMagJ(ii, jj, kk),
-                              ii, jj, kk);
-
-          // store gradients
-          velocityGrad_(ii, jj, kk) += sixth * velGrad;
-          temperatureGrad_(ii, jj, kk) += sixth * tempGrad;
-          if (isTurbulent_) {
-            eddyViscosity_(ii, jj, kk) += sixth * mut;
-            if (isRANS_) {
-              tkeGrad_(ii, jj, kk) += sixth * tkeGrad;
-              omegaGrad_(ii, jj, kk) += sixth * omegaGrad;
-              f1_(ii, jj, kk) += sixth * f1;
-              f2_(ii, jj, kk) += sixth * f2;
-            }
-          }
+      }
+      if (isTurbulent_) {
+        eddyViscosity_(ii, jj - 1, kk) += sixth * mut;
+        if (isRANS_) {
+          f1_(ii, jj - 1, kk) += sixth * f1;
+          f2_(ii, jj - 1, kk) += sixth * f2;
+        }
+      }
 
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto viscSpecRad =
-              state_(ii, jj, kk)
-                  .ViscCellSpectralRadius(fAreaJ_(ii, jj, kk),
-                                          fAreaJ_(ii, jj + 1, kk), thermo,
-                                          eqnState, trans, vol_(ii, jj, kk),
-                                          viscosity_(ii, jj, kk), mut, turb);
-
-          const auto turbViscSpecRad = isRANS_ ?
-              turb->ViscCellSpecRad(state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
-                                    fAreaJ_(ii, jj + 1, kk),
-                                    viscosity_(ii, jj, kk),
-                                    trans, vol_(ii, jj, kk), mut, f1)
-              : 0.0;
-
-          const uncoupledScalar specRad(viscSpecRad, turbViscSpecRad);
-          specRadius_(ii, jj, kk) += specRad * viscCoeff;
-
-
-          // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            // using mu, mut, and f1 at face
-            fluxJacobian fluxJac;
-            fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
-                                      thermo, this->FAreaJ(ii, jj, kk), c2cDist,
-                                      turb, inp, false, velGrad);
-            mainDiagonal(ii, jj, kk) += fluxJac;
-          } else if (inp.IsImplicit()) {
-            // factor 2 because visc spectral radius is not halved (Blazek 6.53)
-            mainDiagonal(ii, jj, kk) += fluxJacobian(2.0 * specRad);
-          }
+      // if using block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        // using mu, mut, and f1 at face
+        fluxJacobian fluxJac;
+        fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
+                                  thermo, this->FAreaJ(ii, jj, kk), c2cDist,
+                                  turb, inp, true, velGrad);
+        mainDiagonal.Block(ii, jj - 1, kk) -= fluxJac;
+      }
+    }
+    // at right boundary there is no right cell to add to
+    if (jj < fAreaJ_.PhysEndJ() - 1) {
+      this->AddToResidual(tempViscFlux *
+                          this->FAreaMagJ(ii, jj, kk),
+                          ii, jj, kk);
+
+      // store gradients; cell gradients are already stored
+      if (!cellGrads) {
+        velocityGrad_(ii, jj, kk) += sixth * velGrad;
+        temperatureGrad_(ii, jj, kk) += sixth * tempGrad;
+        if (isRANS_) {
+          tkeGrad_(ii, jj, kk) += sixth * tkeGrad;
+          omegaGrad_(ii, jj, kk) += sixth * omegaGrad;
         }
       }
+      if (isTurbulent_) {
+        eddyViscosity_(ii, jj, kk) += sixth * mut;
+        if (isRANS_) {
+          f1_(ii, jj, kk) += sixth * f1;
+          f2_(ii, jj, kk) += sixth * f2;
+        }
+      }
+
+      // calculate component of wave speed. This is done on a cell by cell
+      // basis, so only at the upper faces
+      const auto viscSpecRad =
+          state_(ii, jj, kk)
+              .ViscCellSpectralRadius(fAreaJ_(ii, jj, kk),
+                                      fAreaJ_(ii, jj + 1, kk), thermo,
+                                      eqnState, trans, vol_(ii, jj, kk),
+                                      viscosity_(ii, jj, kk), mut, turb);
+
+      const auto turbViscSpecRad = isRANS_ ?
+          turb->ViscCellSpecRad(state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
+                                fAreaJ_(ii, jj + 1, kk),
+                                viscosity_(ii, jj, kk),
+                                trans, vol_(ii, jj, kk), mut, f1)
+          : 0.0;
+
+      const uncoupledScalar specRad(viscSpecRad, turbViscSpecRad);
+      specRadius_(ii, jj, kk) += specRad * viscCoeff;
+
+
+      // if using block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        // using mu, mut, and f1 at face
+        fluxJacobian fluxJac;
+        fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
+                                  thermo, this->FAreaJ(ii, jj, kk), c2cDist,
+                                  turb, inp, false, velGrad);
+        mainDiagonal.Block(ii, jj, kk) += fluxJac;
+      } else if (inp.IsImplicit()) {
+        // factor 2 because visc spectral radius is not halved (Blazek 6.53)
+        mainDiagonal.Scalar(ii, jj, kk) += 2.0 * specRad;
+      }
     }
   }
 }
@@ -2480,7 +3387,7 @@ void procBlock::CalcViscFluxK(const unique_ptr<transport> &trans,
                               const unique_ptr<thermodynamic> &thermo,
                               const unique_ptr<eos> &eqnState, const input &inp,
                               const unique_ptr<turbModel> &turb,
-                              multiArray3d<fluxJacobian> &mainDiagonal) {
+                              implicitDiagonal &mainDiagonal) {
   // trans -- viscous transport model
   // thermo -- thermodynamic model
   // eqnState -- equation of state
@@ -2491,225 +3398,274 @@ void procBlock::CalcViscFluxK(const unique_ptr<transport> &trans,
   // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
   //                 implicit solver
 
+  // k-faces update the cells on either side of them, so the lines of
+  // faces are split in the i-direction among the threads
+#pragma omp parallel
+  {
+    auto iStart = 0;
+    auto iEnd = 0;
+    ThreadRange(fAreaK_.PhysStartI(), fAreaK_.PhysEndI(), iStart, iEnd);
+
+    // loop over all physical k-faces
+    for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
+      for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+        this->CalcViscFluxLineK(iStart, iEnd, jj, kk, trans, thermo,
+                                eqnState, inp, turb, mainDiagonal);
+      }
+    }
+  }
+}
+
+// member function to calculate the viscous fluxes on the k-faces from iStart
+// to iEnd along a line of constant j and k
+void procBlock::CalcViscFluxLineK(const int &iStart, const int &iEnd,
+                                  const int &jj, const int &kk,
+                                  const unique_ptr<transport> &trans,
+                                  const unique_ptr<thermodynamic> &thermo,
+                                  const unique_ptr<eos> &eqnState,
+                                  const input &inp,
+                                  const unique_ptr<turbModel> &turb,
+                                  implicitDiagonal &mainDiagonal) {
+  // iStart -- first face in line
+  // iEnd -- one past last face in line
+  // jj -- j-index of line
+  // kk -- k-index of line
+  // trans -- viscous transport model
+  // thermo -- thermodynamic model
+  // eqnState -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
+  //                 implicit solver
+
   const auto viscCoeff = inp.ViscousCFLCoefficient();
+  const auto viscRecon = inp.ViscousReconstruction();
+  const auto cellGrads = inp.IsCellGradients();
   constexpr auto sixth = 1.0 / 6.0;
 
-  // loop over all physical k-faces
-  for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
-    for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
-        // calculate gradients
-        tensor<double> velGrad;
-        vector3d<double> tempGrad, tkeGrad, omegaGrad;
-        this->CalcGradsK(ii, jj, kk, velGrad, tempGrad, tkeGrad, omegaGrad);
-
-        // declare variables needed throughout function
-        primVars state;
-        auto f1 = 0.0;
-        auto f2 = 0.0;
-        auto mu = 0.0;
-        auto mut = 0.0;
-        viscousFlux tempViscFlux;
-
-        // get surface info if at boundary
-        auto surfType = 0;
-        if (kk == fAreaK_.PhysStartK()) {
-          surfType = 5;
-        } else if (kk == fAreaK_.PhysEndK() - 1) {
-          surfType = 6;
-        }
-        const auto isBoundary = (surfType > 0) ? true : false;
-        auto isWallLawBoundary = false;
-        auto isLowReBoundary = false;
-        auto wallDataInd = 0;
-
-        if (isBoundary) {
-          // get boundary surface information
-          const auto surf = bc_.GetBCSurface(ii, jj, kk, surfType);
-          if (surf.BCType() == "viscousWall") {
-            wallDataInd = this->WallDataIndex(surf);
-            isWallLawBoundary =
-                wallData_[wallDataInd].IsWallLaw() &&
-                !wallData_[wallDataInd].SwitchToLowRe(ii, jj, kk);
-            isLowReBoundary = !isWallLawBoundary;
-          }
-        }
+  for (auto ii = iStart; ii < iEnd; ii++) {
+    // calculate gradients; boundary faces always use the face control
+    // volume because the ghost cells do not have cell gradients
+    tensor<double> velGrad;
+    vector3d<double> tempGrad, tkeGrad, omegaGrad;
+    if (cellGrads && kk > fAreaK_.PhysStartK() && kk < fAreaK_.PhysEndK() - 1) {
+      this->FaceGradsFromCells(ii, jj, kk - 1, ii, jj, kk, velGrad, tempGrad,
+                               tkeGrad, omegaGrad);
+    } else {
+      this->CalcGradsK(ii, jj, kk, velGrad, tempGrad, tkeGrad, omegaGrad);
+    }
 
-        if (isWallLawBoundary) {
-          // wall law wall boundary
-          f1 = 1.0;
-          f2 = 1.0;
-          mu = wallData_[wallDataInd].WallViscosity(ii, jj, kk) *
-               trans->InvNondimScaling();
-          mut = wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk) *
-                trans->InvNondimScaling();
-          state = wallData_[wallDataInd].WallState(ii, jj, kk, eqnState);
-          tempViscFlux.CalcWallLawFlux(
-              wallData_[wallDataInd].WallShearStress(ii, jj, kk),
-              wallData_[wallDataInd].WallHeatFlux(ii, jj, kk),
-              wallData_[wallDataInd].WallViscosity(ii, jj, kk),
-              wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk),
-              wallData_[wallDataInd].WallVelocity(),
-              this->FAreaUnitK(ii, jj, kk), tkeGrad, omegaGrad, turb);
-        } else {  // not boundary, or low Re wall boundary
-          auto wDist = 0.0;
-          if (inp.ViscousFaceReconstruction() == "central") {
-            // get cell widths
-            const vector<double> cellWidth = {cellWidthK_(ii, jj, kk - 1),
-                                              cellWidthK_(ii, jj, kk)};
-
-            // Get state at face
-            state = FaceReconCentral(state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                                     cellWidth);
-            state.LimitTurb(turb);
-
-            // Get wall distance at face
-            wDist = FaceReconCentral(wallDist_(ii, jj, kk - 1),
-                                     wallDist_(ii, jj, kk), cellWidth);
-
-            // Get wall distance at face
-            mu = FaceReconCentral(viscosity_(ii, jj, kk - 1),
-                                  viscosity_(ii, jj, kk), cellWidth);
-
-          } else {  // use 4th order reconstruction
-            // get cell widths
-            const vector<double> cellWidth = {
-                cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1)};
-
-            // Get state at face
-            state = FaceReconCentral4th(
-                state_(ii, jj, kk - 2), state_(ii, jj, kk - 1),
-                state_(ii, jj, kk), state_(ii, jj, kk + 1), cellWidth);
-            state.LimitTurb(turb);
-
-            // Get wall distance at face
-            wDist = FaceReconCentral4th(
-                wallDist_(ii, jj, kk - 2), wallDist_(ii, jj, kk - 1),
-                wallDist_(ii, jj, kk), wallDist_(ii, jj, kk + 1), cellWidth);
-
-            // Get wall distance at face
-            mu = FaceReconCentral4th(
-                viscosity_(ii, jj, kk - 2), viscosity_(ii, jj, kk - 1),
-                viscosity_(ii, jj, kk), viscosity_(ii, jj, kk + 1), cellWidth);
-          }
+    // declare variables needed throughout function
+    primVars state;
+    auto f1 = 0.0;
+    auto f2 = 0.0;
+    auto mu = 0.0;
+    auto mut = 0.0;
+    viscousFlux tempViscFlux;
+
+    // get surface info if at boundary
+    auto surfType = 0;
+    if (kk == fAreaK_.PhysStartK()) {
+      surfType = 5;
+    } else if (kk == fAreaK_.PhysEndK() - 1) {
+      surfType = 6;
+    }
+    const auto isBoundary = (surfType > 0) ? true : false;
+    auto isWallLawBoundary = false;
+    auto isLowReBoundary = false;
+    auto wallDataInd = 0;
+
+    if (isBoundary) {
+      // get boundary surface information
+      const auto surf = bc_.GetBCSurface(ii, jj, kk, surfType);
+      if (surf.BCType() == "viscousWall") {
+        wallDataInd = this->WallDataIndex(surf);
+        isWallLawBoundary =
+            wallData_[wallDataInd].IsWallLaw() &&
+            !wallData_[wallDataInd].SwitchToLowRe(ii, jj, kk);
+        isLowReBoundary = !isWallLawBoundary;
+      }
+    }
 
-          // calculate turbulent eddy viscosity and blending coefficients
-          if (isTurbulent_) {
-            // calculate length scale
-            const auto lengthScale =
-                0.5 * (cellWidthK_(ii, jj, kk - 1) + cellWidthK_(ii, jj, kk));
-            turb->EddyViscAndBlending(state, velGrad, tkeGrad, omegaGrad, mu,
-                                      wDist, trans, lengthScale, mut, f1, f2);
-          }
+    if (isWallLawBoundary) {
+      // wall law wall boundary
+      f1 = 1.0;
+      f2 = 1.0;
+      mu = wallData_[wallDataInd].WallViscosity(ii, jj, kk) *
+           trans->InvNondimScaling();
+      mut = wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk) *
+            trans->InvNondimScaling();
+      state = wallData_[wallDataInd].WallState(ii, jj, kk, eqnState);
+      tempViscFlux.CalcWallLawFlux(
+          wallData_[wallDataInd].WallShearStress(ii, jj, kk),
+          wallData_[wallDataInd].WallHeatFlux(ii, jj, kk),
+          wallData_[wallDataInd].WallViscosity(ii, jj, kk),
+          wallData_[wallDataInd].WallEddyViscosity(ii, jj, kk),
+          wallData_[wallDataInd].WallVelocity(),
+          this->FAreaUnitK(ii, jj, kk), tkeGrad, omegaGrad, turb);
+    } else {  // not boundary, or low Re wall boundary
+      auto wDist = 0.0;
+      if (viscRecon == viscousReconstruction::central) {
+        // get cell widths
+        const vector<double> cellWidth = {cellWidthK_(ii, jj, kk - 1),
+                                          cellWidthK_(ii, jj, kk)};
+
+        // Get state at face
+        state = FaceReconCentral(state_(ii, jj, kk - 1), state_(ii, jj, kk),
+                                 cellWidth);
+        state.LimitTurb(turb);
+
+        // Get wall distance at face
+        wDist = FaceReconCentral(wallDist_(ii, jj, kk - 1),
+                                 wallDist_(ii, jj, kk), cellWidth);
+
+        // Get wall distance at face
+        mu = FaceReconCentral(viscosity_(ii, jj, kk - 1),
+                              viscosity_(ii, jj, kk), cellWidth);
+
+      } else {  // use 4th order reconstruction
+        // get precalculated reconstruction coefficients
+        const auto &coeffs = central4thK_(ii, jj, kk);
+
+        // Get state at face
+        state = FaceReconCentral4th(
+            state_(ii, jj, kk - 2), state_(ii, jj, kk - 1),
+            state_(ii, jj, kk), state_(ii, jj, kk + 1), coeffs);
+        state.LimitTurb(turb);
+
+        // Get wall distance at face
+        wDist = FaceReconCentral4th(
+            wallDist_(ii, jj, kk - 2), wallDist_(ii, jj, kk - 1),
+            wallDist_(ii, jj, kk), wallDist_(ii, jj, kk + 1), coeffs);
+
+        // Get wall distance at face
+        mu = FaceReconCentral4th(
+            viscosity_(ii, jj, kk - 2), viscosity_(ii, jj, kk - 1),
+            viscosity_(ii, jj, kk), viscosity_(ii, jj, kk + 1), coeffs);
+      }
 
-          if (isLowReBoundary) {
-            // calculate viscous flux
-            auto wVars = tempViscFlux.CalcWallFlux(
-                velGrad, trans, thermo, eqnState, tempGrad,
-                this->FAreaUnitK(ii, jj, kk), tkeGrad, omegaGrad, turb, state,
-                mu, mut, f1);
-            auto y = (surfType == 5) ? wallDist_(ii, jj, kk)
-                                     : wallDist_(ii, jj, kk - 1);
-            wVars.yplus_ = y * wVars.frictionVelocity_ * wVars.density_ /
-                           (wVars.viscosity_ + wVars.turbEddyVisc_);
-            wallData_[wallDataInd](ii, jj, kk) = wVars;
-          } else {
-            // calculate viscous flux
-            tempViscFlux.CalcFlux(velGrad, trans, thermo, eqnState, tempGrad,
-                                  this->FAreaUnitK(ii, jj, kk), tkeGrad,
-                                  omegaGrad, turb, state, mu, mut, f1);
-          }
-        }
+      // calculate turbulent eddy viscosity and blending coefficients
+      if (isTurbulent_) {
+        // calculate length scale
+        const auto lengthScale =
+            0.5 * (cellWidthK_(ii, jj, kk - 1) + cellWidthK_(ii, jj, kk));
+        turb->EddyViscAndBlending(state, velGrad, tkeGrad, omegaGrad, mu,
+                                  wDist, trans, lengthScale, mut, f1, f2);
+      }
 
-        // calculate projected center to center distance
-        const auto c2cDist = this->ProjC2CDist(ii, jj, kk, "k");
-
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell but viscous fluxes are subtracted from inviscid
-        // fluxes, so sign is reversed
-        // at left boundary there is no left cell to add to
-        if (kk > fAreaK_.PhysStartK()) {
-          this->SubtractFromResidual(tempViscFlux *
-                                     this->FAreaMagK(ii, jj, kk),
-                                     ii, jj, kk - 1);
-
-          // store gradients
-          velocityGrad_(ii, jj, kk - 1) += sixth * velGrad;
-          temperatureGrad_(ii, jj, kk - 1) += sixth * tempGrad;
-          if (isTurbulent_) {
-            eddyViscosity_(ii, jj, kk - 1) += sixth * mut;
-            if (isRANS_) {
-              tkeGrad_(ii, jj, kk - 1) += sixth * tkeGrad;
-              omegaGrad_(ii, jj, kk - 1) += sixth * omegaGrad;
-              f1_(ii, jj, kk - 1) += sixth * f1;
-              f2_(ii, jj, kk - 1) += sixth * f2;
-            }
-          }
+      if (isLowReBoundary) {
+        // calculate viscous flux
+        auto wVars = tempViscFlux.CalcWallFlux(
+            velGrad, trans, thermo, eqnState, tempGrad,
+            this->FAreaUnitK(ii, jj, kk), tkeGrad, omegaGrad, turb, state,
+            mu, mut, f1);
+        auto y = (surfType == 5) ? wallDist_(ii, jj, kk)
+                                 : wallDist_(ii, jj, kk - 1);
+        wVars.yplus_ = y * wVars.frictionVelocity_ * wVars.density_ /
+                       (wVars.viscosity_ + wVars.turbEddyVisc_);
+        wallData_[wallDataInd](ii, jj, kk) = wVars;
+      } else {
+        // calculate viscous flux
+        tempViscFlux.CalcFlux(velGrad, trans, thermo, eqnState, tempGrad,
+                              this->FAreaUnitK(ii, jj, kk), tkeGrad,
+                              omegaGrad, turb, state, mu, mut, f1);
+      }
+    }
 
-          // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            // using mu, mut, and f1 at face
-            fluxJacobian fluxJac;
-            fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
-                                      thermo, this->FAreaK(ii, jj, kk), c2cDist,
-                                      turb, inp, true, velGrad);
-            mainDiagonal(ii, jj, kk - 1) -= fluxJac;
-          }
+    // calculate projected center to center distance
+    const auto c2cDist = this->ProjC2CDist(ii, jj, kk, "k");
+
+
+    // area vector points from left to right, so add to left cell, subtract
+    // from right cell but viscous fluxes are subtracted from inviscid
+    // fluxes, so sign is reversed
+    // at left boundary there is no left cell to add to
+    if (kk > fAreaK_.PhysStartK()) {
+      this->SubtractFromResidual(tempViscFlux *
+                                 this->FAreaMagK(ii, jj, kk),
+                                 ii, jj, kk - 1);
+
+      // store gradients; cell gradients are already stored
+      if (!cellGrads) {
+        velocityGrad_(ii, jj, kk - 1) += sixth * velGrad;
+        temperatureGrad_(ii, jj, kk - 1) += sixth * tempGrad;
+        if (isRANS_) {
+          tkeGrad_(ii, jj, kk - 1) += sixth * tkeGrad;
+          omegaGrad_(ii, jj, kk - 1) += sixth * omegaGrad;
         }
-        // at right boundary there is no right cell to add to
-        if (kk < fAreaK_.PhysEndK() - 1) {
-          this->AddToResidual(tempViscFlux *
-                              this->FAreaMagK(ii, jj, kk),
-                              ii, jj, kk);
-
-          // store gradients
-          velocityGrad_(ii, jj, kk) += sixth * velGrad;
-          temperatureGrad_(ii, jj, kk) += sixth * tempGrad;
-          if (isTurbulent_) {
-            eddyViscosity_(ii, jj, kk) += sixth * mut;
-            if (isRANS_) {
-              tkeGrad_(ii, jj, kk) += sixth * tkeGrad;
-              omegaGrad_(ii, jj, kk) += sixth * omegaGrad;
-              f1_(ii, jj, kk) += sixth * f1;
-              f2_(ii, jj, kk) += sixth * f2;
-            }
-          }
+      }
+      if (isTurbulent_) {
+        eddyViscosity_(ii, jj, kk - 1) += sixth * mut;
+        if (isRANS_) {
+          f1_(ii, jj, kk - 1) += sixth * f1;
+          f2_(ii, jj, kk - 1) += sixth * f2;
+        }
+      }
 
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto viscSpecRad =
-              state_(ii, jj, kk)
-                  .ViscCellSpectralRadius(fAreaK_(ii, jj, kk),
-                                          fAreaK_(ii, jj, kk + 1), thermo,
-                                          eqnState, trans, vol_(ii, jj, kk),
-                                          viscosity_(ii, jj, kk), mut, turb);
-
-          const auto turbViscSpecRad = isRANS_ ?
-              turb->ViscCellSpecRad(state_(ii, jj, kk), fAreaK_(ii, jj, kk),
-                                    fAreaK_(ii, jj, kk + 1),
-                                    viscosity_(ii, jj, kk),
-                                    trans, vol_(ii, jj, kk), mut, f1)
-              : 0.0;
-
-          const uncoupledScalar specRad(viscSpecRad, turbViscSpecRad);
-          specRadius_(ii, jj, kk) += specRad * viscCoeff;
-
-          // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            // using mu, mut, and f1 at face
-            fluxJacobian fluxJac;
-            fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
-                                      thermo, this->FAreaK(ii, jj, kk), c2cDist,
-                                      turb, inp, false, velGrad);
-            mainDiagonal(ii, jj, kk) += fluxJac;
-          } else if (inp.IsImplicit()) {
-            // factor 2 because visc spectral radius is not halved (Blazek 6.53)
-            mainDiagonal(ii, jj, kk) += fluxJacobian(2.0 * specRad);
-          }
+      // if using block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        // using mu, mut, and f1 at face
+        fluxJacobian fluxJac;
+        fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
+                                  thermo, this->FAreaK(ii, jj, kk), c2cDist,
+                                  turb, inp, true, velGrad);
+        mainDiagonal.Block(ii, jj, kk - 1) -= fluxJac;
+      }
+    }
+    // at right boundary there is no right cell to add to
+    if (kk < fAreaK_.PhysEndK() - 1) {
+      this->AddToResidual(tempViscFlux *
+                          this->FAreaMagK(ii, jj, kk),
+                          ii, jj, kk);
+
+      // store gradients; cell gradients are already stored
+      if (!cellGrads) {
+        velocityGrad_(ii, jj, kk) += sixth * velGrad;
+        temperatureGrad_(ii, jj, kk) += sixth * tempGrad;
+        if (isRANS_) {
+          tkeGrad_(ii, jj, kk) += sixth * tkeGrad;
+          omegaGrad_(ii, jj, kk) += sixth * omegaGrad;
         }
       }
+      if (isTurbulent_) {
+        eddyViscosity_(ii, jj, kk) += sixth * mut;
+        if (isRANS_) {
+          f1_(ii, jj, kk) += sixth * f1;
+          f2_(ii, jj, kk) += sixth * f2;
+        }
+      }
+
+      // calculate component of wave speed. This is done on a cell by cell
+      // basis, so only at the upper faces
+      const auto viscSpecRad =
+          state_(ii, jj, kk)
+              .ViscCellSpectralRadius(fAreaK_(ii, jj, kk),
+                                      fAreaK_(ii, jj, kk + 1), thermo,
+                                      eqnState, trans, vol_(ii, jj, kk),
+                                      viscosity_(ii, jj, kk), mut, turb);
+
+      const auto turbViscSpecRad = isRANS_ ?
+          turb->ViscCellSpecRad(state_(ii, jj, kk), fAreaK_(ii, jj, kk),
+                                fAreaK_(ii, jj, kk + 1),
+                                viscosity_(ii, jj, kk),
+                                trans, vol_(ii, jj, kk), mut, f1)
+          : 0.0;
+
+      const uncoupledScalar specRad(viscSpecRad, turbViscSpecRad);
+      specRadius_(ii, jj, kk) += specRad * viscCoeff;
+
+      // if using block matrix on main diagonal, accumulate flux jacobian
+      if (inp.IsBlockMatrix()) {
+        // using mu, mut, and f1 at face
+        fluxJacobian fluxJac;
+        fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, trans,
+                                  thermo, this->FAreaK(ii, jj, kk), c2cDist,
+                                  turb, inp, false, velGrad);
+        mainDiagonal.Block(ii, jj, kk) += fluxJac;
+      } else if (inp.IsImplicit()) {
+        // factor 2 because visc spectral radius is not halved (Blazek 6.53)
+        mainDiagonal.Scalar(ii, jj, kk) += 2.0 * specRad;
+      }
     }
   }
 }
@@ -3774,14 +4730,6 @@ void procBlock::SwapStateSlice(const connection &inter, procBlock &blk) {
   state_.SwapSlice(inter, blk.state_);
 }
 
-void procBlock::SwapTurbSlice(const connection &inter, procBlock &blk) {
-  // inter -- connection boundary information
-  // blk -- second block involved in connection boundary
-
-  f1_.SwapSlice(inter, blk.f1_);
-  f2_.SwapSlice(inter, blk.f2_);
-}
-
 void procBlock::SwapWallDistSlice(const connection &inter, procBlock &blk) {
   // inter -- connection boundary information
   // blk -- second block involved in connection boundary
@@ -3804,54 +4752,81 @@ void procBlock::SwapEddyViscAndGradientSlice(const connection &inter,
   if (isRANS_) {
     tkeGrad_.SwapSlice(inter, blk.tkeGrad_);
     omegaGrad_.SwapSlice(inter, blk.omegaGrad_);
+    f1_.SwapSlice(inter, blk.f1_);
+    f2_.SwapSlice(inter, blk.f2_);
   }
 }
 
 
-/* Function to swap slice using MPI. This is similar to the SwapSlice
-function, but is called when the neighboring procBlocks are on different
-processors.
+/* Functions to pack slices to send to a connection partner on another
+processor, and to unpack the slices received from it into the ghost cells. The
+exchange itself is done by the haloExchange.
 */
-void procBlock::SwapStateSliceMPI(const connection &inter, const int &rank,
-                                  const MPI_Datatype &MPI_cellData) {
-  // inter -- connection boundary information
-  // rank -- processor rank
-  // MPI_cellData -- MPI datatype for passing primVars, genArray
+void procBlock::PackStateSlice(haloExchange &halo, const int &cc) const {
+  // halo -- exchange for connection boundaries
+  // cc -- connection index
 
-  state_.SwapSliceMPI(inter, rank, MPI_cellData);
+  halo.Pack(haloField::state, cc, state_);
 }
 
-void procBlock::SwapTurbSliceMPI(const connection &inter, const int &rank) {
-  // inter -- connection boundary information
-  // rank -- processor rank
+void procBlock::UnpackStateSlice(haloExchange &halo, const int &cc) {
+  // halo -- exchange for connection boundaries
+  // cc -- connection index
 
-  f1_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 2);
-  f2_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 3);
+  halo.Unpack(haloField::state, cc, state_);
 }
 
-void procBlock::SwapWallDistSliceMPI(const connection &inter, const int &rank) {
-  // inter -- connection boundary information
-  // rank -- processor rank
+void procBlock::PackWallDistSlice(haloExchange &halo, const int &cc) const {
+  // halo -- exchange for connection boundaries
+  // cc -- connection index
 
-  wallDist_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 1);
+  halo.Pack(haloField::wallDist, cc, wallDist_);
 }
 
-void procBlock::SwapEddyViscAndGradientSliceMPI(
-    const connection &inter, const int &rank,
-    const MPI_Datatype &MPI_tensorDouble, const MPI_Datatype &MPI_vec3d) {
-  // inter -- connection boundary information
-  // rank -- processor rank
+void procBlock::UnpackWallDistSlice(haloExchange &halo, const int &cc) {
+  // halo -- exchange for connection boundaries
+  // cc -- connection index
+
+  halo.Unpack(haloField::wallDist, cc, wallDist_);
+}
+
+void procBlock::PackEddyViscAndGradientSlice(haloExchange &halo,
+                                             const int &cc) const {
+  // halo -- exchange for connection boundaries
+  // cc -- connection index
+
+  if (isViscous_) {
+    halo.Pack(haloField::velocityGrad, cc, velocityGrad_);
+    halo.Pack(haloField::temperatureGrad, cc, temperatureGrad_);
+  }
+  if (isTurbulent_) {
+    halo.Pack(haloField::eddyViscosity, cc, eddyViscosity_);
+  }
+  if (isRANS_) {
+    halo.Pack(haloField::tkeGrad, cc, tkeGrad_);
+    halo.Pack(haloField::omegaGrad, cc, omegaGrad_);
+    halo.Pack(haloField::f1, cc, f1_);
+    halo.Pack(haloField::f2, cc, f2_);
+  }
+}
+
+void procBlock::UnpackEddyViscAndGradientSlice(haloExchange &halo,
+                                               const int &cc) {
+  // halo -- exchange for connection boundaries
+  // cc -- connection index
 
   if (isViscous_) {
-    velocityGrad_.SwapSliceMPI(inter, rank, MPI_tensorDouble, 1);
-    temperatureGrad_.SwapSliceMPI(inter, rank, MPI_vec3d, 2);
+    halo.Unpack(haloField::velocityGrad, cc, velocityGrad_);
+    halo.Unpack(haloField::temperatureGrad, cc, temperatureGrad_);
   }
   if (isTurbulent_) {
-    eddyViscosity_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 1);
+    halo.Unpack(haloField::eddyViscosity, cc, eddyViscosity_);
   }
   if (isRANS_) {
-    tkeGrad_.SwapSliceMPI(inter, rank, MPI_vec3d, 3);
-    omegaGrad_.SwapSliceMPI(inter, rank, MPI_vec3d, 4);
+    halo.Unpack(haloField::tkeGrad, cc, tkeGrad_);
+    halo.Unpack(haloField::omegaGrad, cc, omegaGrad_);
+    halo.Unpack(haloField::f1, cc, f1_);
+    halo.Unpack(haloField::f2, cc, f2_);
   }
 }
 
@@ -4776,17 +5751,19 @@ void procBlock::PutStateSlice(const multiArray3d<primVars> &slice,
 void procBlock::PackSendGeomMPI(const MPI_Datatype &MPI_cellData,
                                 const MPI_Datatype &MPI_vec3d,
                                 const MPI_Datatype &MPI_vec3dMag,
-                                const MPI_Datatype &MPI_wallData) const {
+                                const MPI_Datatype &MPI_wallData,
+                                const int &dest) const {
   // MPI_cellData -- MPI data type for cell data
   // MPI_vec3d -- MPI data type for a vector3d
   // MPI_vec3dMag -- MPI data type for a unitVect3dMag
   // MPI_vec3dMag -- MPI data type for a wallData
+  // dest -- processor to send to
 
   // determine size of buffer to send
   auto sendBufSize = 0;
   auto tempSize = 0;
   // adding 3 more ints for block dimensions
-  MPI_Pack_size(8, MPI_INT, MPI_COMM_WORLD,
+  MPI_Pack_size(9, MPI_INT, MPI_COMM_WORLD,
                 &tempSize);  // add size for ints in class procBlock
   sendBufSize += tempSize;
   MPI_Pack_size(5, MPI_CXX_BOOL, MPI_COMM_WORLD,
@@ -4863,6 +5840,8 @@ void procBlock::PackSendGeomMPI(const MPI_Datatype &MPI_cellData,
            MPI_COMM_WORLD);
   MPI_Pack(&numGhosts_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
            MPI_COMM_WORLD);
+  MPI_Pack(&arrayPadding_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
+           MPI_COMM_WORLD);
   MPI_Pack(&parBlock_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
            MPI_COMM_WORLD);
   MPI_Pack(&rank_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
@@ -4913,7 +5892,7 @@ void procBlock::PackSendGeomMPI(const MPI_Datatype &MPI_cellData,
   }
 
   // send buffer to appropriate processor
-  MPI_Send(sendBuffer, sendBufSize, MPI_PACKED, rank_, 2,
+  MPI_Send(sendBuffer, sendBufSize, MPI_PACKED, dest, 2,
            MPI_COMM_WORLD);
 }
 
@@ -4921,18 +5900,19 @@ void procBlock::RecvUnpackGeomMPI(const MPI_Datatype &MPI_cellData,
                                   const MPI_Datatype &MPI_vec3d,
                                   const MPI_Datatype &MPI_vec3dMag,
                                   const MPI_Datatype &MPI_wallData,
-                                  const input &inp) {
+                                  const input &inp, const int &source) {
   // MPI_cellData -- MPI data type for cell data
   // MPI_vec3d -- MPI data type for a vector3d
   // MPI_vec3dMag -- MPI data type for a unitVect3dMag
   // MPI_wallData --  MPI data type for a wallData
   // input -- input variables
+  // source -- processor to receive from
 
   MPI_Status status;  // allocate MPI_Status structure
 
   // probe message to get correct data size
   auto recvBufSize = 0;
-  MPI_Probe(ROOTP, 2, MPI_COMM_WORLD, &status);
+  MPI_Probe(source, 2, MPI_COMM_WORLD, &status);
   // use MPI_CHAR because sending buffer was allocated with chars
   MPI_Get_count(&status, MPI_CHAR, &recvBufSize);
 
@@ -4941,8 +5921,8 @@ void procBlock::RecvUnpackGeomMPI(const MPI_Datatype &MPI_cellData,
   auto unqRecvBuffer = unique_ptr<char>(new char[recvBufSize]);
   auto *recvBuffer = unqRecvBuffer.get();
 
-  // receive message from ROOT
-  MPI_Recv(recvBuffer, recvBufSize, MPI_PACKED, ROOTP, 2, MPI_COMM_WORLD,
+  // receive message from source processor
+  MPI_Recv(recvBuffer, recvBufSize, MPI_PACKED, source, 2, MPI_COMM_WORLD,
            &status);
 
   auto numI = 0, numJ = 0, numK = 0;
@@ -4956,6 +5936,8 @@ void procBlock::RecvUnpackGeomMPI(const MPI_Datatype &MPI_cellData,
              MPI_INT, MPI_COMM_WORLD);
   MPI_Unpack(recvBuffer, recvBufSize, &position, &numGhosts_, 1,
              MPI_INT, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &arrayPadding_, 1,
+             MPI_INT, MPI_COMM_WORLD);
   MPI_Unpack(recvBuffer, recvBufSize, &position, &parBlock_, 1, MPI_INT,
              MPI_COMM_WORLD);
   MPI_Unpack(recvBuffer, recvBufSize, &position, &rank_, 1, MPI_INT,
@@ -5081,6 +6063,51 @@ void procBlock::CleanResizeVecs(const int &numI, const int &numJ,
     f1_.ClearResize(numI, numJ, numK, numGhosts);
     f2_.ClearResize(numI, numJ, numK, numGhosts);
   }
+
+  this->PadArrays();
+}
+
+/*Member function to pad the i-lines of the cell and face arrays in the
+ * procBlock with the number of elements specified in the input file. Padding
+ * keeps the j and k strides of the arrays from being powers of two, which
+ * causes cache conflicts when sweeping in the j and k directions.*/
+void procBlock::PadArrays() {
+  state_.PadI(arrayPadding_);
+  residual_.PadI(arrayPadding_);
+
+  fAreaI_.PadI(arrayPadding_);
+  fAreaJ_.PadI(arrayPadding_);
+  fAreaK_.PadI(arrayPadding_);
+  center_.PadI(arrayPadding_);
+  fCenterI_.PadI(arrayPadding_);
+  fCenterJ_.PadI(arrayPadding_);
+  fCenterK_.PadI(arrayPadding_);
+  cellWidthI_.PadI(arrayPadding_);
+  cellWidthJ_.PadI(arrayPadding_);
+  cellWidthK_.PadI(arrayPadding_);
+
+  specRadius_.PadI(arrayPadding_);
+  vol_.PadI(arrayPadding_);
+  dt_.PadI(arrayPadding_);
+  wallDist_.PadI(arrayPadding_);
+  temperature_.PadI(arrayPadding_);
+
+  if (isViscous_) {
+    velocityGrad_.PadI(arrayPadding_);
+    temperatureGrad_.PadI(arrayPadding_);
+    viscosity_.PadI(arrayPadding_);
+  }
+
+  if (isTurbulent_) {
+    eddyViscosity_.PadI(arrayPadding_);
+  }
+
+  if (isRANS_) {
+    tkeGrad_.PadI(arrayPadding_);
+    omegaGrad_.PadI(arrayPadding_);
+    f1_.PadI(arrayPadding_);
+    f2_.PadI(arrayPadding_);
+  }
 }
 
 /*Member function to receive and unpack procBlock state data. This is used to
@@ -5513,6 +6540,12 @@ procBlock procBlock::Split(const string &dir, const int &ind, const int &num,
   blk2.fCenterJ_.Fill(fCenterJ_.Slice(dir, {ind, fCenterJ_.End(dir)}));
   blk2.fCenterK_.Fill(fCenterK_.Slice(dir, {ind, fCenterK_.End(dir)}));
 
+  // pad arrays of split blocks to match parent
+  blk1.arrayPadding_ = arrayPadding_;
+  blk1.PadArrays();
+  blk2.arrayPadding_ = arrayPadding_;
+  blk2.PadArrays();
+
   // assign boundary conditions
   blk1.bc_ = bound1;
   blk1.wallData_ = wallData_;
@@ -5802,6 +6835,8 @@ void procBlock::Join(const procBlock &blk, const string &dir,
     blk.fCenterK_.Slice(dir, {blk.fCenterK_.PhysStart(dir) + kFaceFac,
             blk.fCenterK_.End(dir)}));
 
+  newBlk.arrayPadding_ = arrayPadding_;
+  newBlk.PadArrays();
   *this = newBlk;
 }
 
@@ -6171,17 +7206,152 @@ void procBlock::CalcGradsK(const int &ii, const int &jj, const int &kk,
   }
 }
 
+/* Member function to calculate the gradients at the cell centers with the
+Green-Gauss method. The values at the cell faces are the average of the
+adjacent cells. This is an alternative to calculating the gradients on an
+alternate control volume around each face (CalcGradsI/J/K), which touches each
+cell many times per iteration. The gradients are stored directly in the
+gradient arrays, and the face gradients for the viscous fluxes are constructed
+from them in FaceGradsFromCells.
+*/
+void procBlock::CalcCellGrads() {
+#pragma omp parallel for collapse(2) schedule(static)
+  for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+    for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+      for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+        // area vectors of cell faces
+        const auto ail = fAreaI_(ii, jj, kk).Vector();
+        const auto aiu = fAreaI_(ii + 1, jj, kk).Vector();
+        const auto ajl = fAreaJ_(ii, jj, kk).Vector();
+        const auto aju = fAreaJ_(ii, jj + 1, kk).Vector();
+        const auto akl = fAreaK_(ii, jj, kk).Vector();
+        const auto aku = fAreaK_(ii, jj, kk + 1).Vector();
+        const auto &vol = vol_(ii, jj, kk);
+
+        // velocity gradient
+        const auto vel = state_(ii, jj, kk).Velocity();
+        velocityGrad_(ii, jj, kk) = VectorGradGG(
+            0.5 * (vel + state_(ii - 1, jj, kk).Velocity()),
+            0.5 * (vel + state_(ii + 1, jj, kk).Velocity()),
+            0.5 * (vel + state_(ii, jj - 1, kk).Velocity()),
+            0.5 * (vel + state_(ii, jj + 1, kk).Velocity()),
+            0.5 * (vel + state_(ii, jj, kk - 1).Velocity()),
+            0.5 * (vel + state_(ii, jj, kk + 1).Velocity()),
+            ail, aiu, ajl, aju, akl, aku, vol);
+
+        // temperature gradient
+        const auto &temp = temperature_(ii, jj, kk);
+        temperatureGrad_(ii, jj, kk) = ScalarGradGG(
+            0.5 * (temp + temperature_(ii - 1, jj, kk)),
+            0.5 * (temp + temperature_(ii + 1, jj, kk)),
+            0.5 * (temp + temperature_(ii, jj - 1, kk)),
+            0.5 * (temp + temperature_(ii, jj + 1, kk)),
+            0.5 * (temp + temperature_(ii, jj, kk - 1)),
+            0.5 * (temp + temperature_(ii, jj, kk + 1)),
+            ail, aiu, ajl, aju, akl, aku, vol);
+
+        if (isRANS_) {
+          // tke gradient
+          const auto tke = state_(ii, jj, kk).Tke();
+          tkeGrad_(ii, jj, kk) = ScalarGradGG(
+              0.5 * (tke + state_(ii - 1, jj, kk).Tke()),
+              0.5 * (tke + state_(ii + 1, jj, kk).Tke()),
+              0.5 * (tke + state_(ii, jj - 1, kk).Tke()),
+              0.5 * (tke + state_(ii, jj + 1, kk).Tke()),
+              0.5 * (tke + state_(ii, jj, kk - 1).Tke()),
+              0.5 * (tke + state_(ii, jj, kk + 1).Tke()),
+              ail, aiu, ajl, aju, akl, aku, vol);
+
+          // omega gradient
+          const auto omg = state_(ii, jj, kk).Omega();
+          omegaGrad_(ii, jj, kk) = ScalarGradGG(
+              0.5 * (omg + state_(ii - 1, jj, kk).Omega()),
+              0.5 * (omg + state_(ii + 1, jj, kk).Omega()),
+              0.5 * (omg + state_(ii, jj - 1, kk).Omega()),
+              0.5 * (omg + state_(ii, jj + 1, kk).Omega()),
+              0.5 * (omg + state_(ii, jj, kk - 1).Omega()),
+              0.5 * (omg + state_(ii, jj, kk + 1).Omega()),
+              ail, aiu, ajl, aju, akl, aku, vol);
+        }
+      }
+    }
+  }
+}
+
+/* Member function to construct the gradients at a face from the gradients at
+the cell centers on either side of it. The cell gradients are averaged, and
+then the component along the line connecting the cell centers is replaced with
+the difference of the cell values divided by the distance between them.
+
+grad_f = grad_avg + (dU/ds - grad_avg . e) e
+
+Here e is the unit vector from the lower to the upper cell center and ds is
+the distance between them. The correction couples the two cells directly and
+prevents the odd/even decoupling that results from averaging alone.
+*/
+void procBlock::FaceGradsFromCells(const int &il, const int &jl,
+                                   const int &kl, const int &iu,
+                                   const int &ju, const int &ku,
+                                   tensor<double> &velGrad,
+                                   vector3d<double> &tGrad,
+                                   vector3d<double> &tkeGrad,
+                                   vector3d<double> &omegaGrad) const {
+  // il -- i-index of cell on lower side of face
+  // jl -- j-index of cell on lower side of face
+  // kl -- k-index of cell on lower side of face
+  // iu -- i-index of cell on upper side of face
+  // ju -- j-index of cell on upper side of face
+  // ku -- k-index of cell on upper side of face
+  // velGrad -- tensor to store velocity gradient
+  // tGrad -- vector3d to store temperature gradient
+  // tkeGrad -- vector3d to store tke gradient
+  // omegaGrad -- vector3d to store omega gradient
+
+  const auto dist = center_(iu, ju, ku) - center_(il, jl, kl);
+  const auto invDs = 1.0 / dist.Mag();
+  const auto e = dist * invDs;
+
+  // velocity gradient; row r of tensor is derivative with respect to x_r
+  velGrad = 0.5 * (velocityGrad_(il, jl, kl) + velocityGrad_(iu, ju, ku));
+  const auto dVel = (state_(iu, ju, ku).Velocity() -
+                     state_(il, jl, kl).Velocity()) * invDs -
+      velGrad.Transpose().MatMult(e);
+  velGrad += tensor<double>(e.X() * dVel, e.Y() * dVel, e.Z() * dVel);
+
+  // scalar gradients
+  auto CorrectScalar = [&](const vector3d<double> &gl,
+                           const vector3d<double> &gu, const double &vl,
+                           const double &vu) {
+    const auto avg = 0.5 * (gl + gu);
+    return avg + ((vu - vl) * invDs - avg.DotProd(e)) * e;
+  };
+
+  tGrad = CorrectScalar(temperatureGrad_(il, jl, kl),
+                        temperatureGrad_(iu, ju, ku),
+                        temperature_(il, jl, kl), temperature_(iu, ju, ku));
+
+  if (isRANS_) {
+    tkeGrad = CorrectScalar(tkeGrad_(il, jl, kl), tkeGrad_(iu, ju, ku),
+                            state_(il, jl, kl).Tke(),
+                            state_(iu, ju, ku).Tke());
+    omegaGrad = CorrectScalar(omegaGrad_(il, jl, kl), omegaGrad_(iu, ju, ku),
+                              state_(il, jl, kl).Omega(),
+                              state_(iu, ju, ku).Omega());
+  }
+}
+
 // Member function to calculate the source terms and add them to the residual
 void procBlock::CalcSrcTerms(const unique_ptr<transport> &trans,
                              const unique_ptr<turbModel> &turb,
                              const input &inp,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+                             implicitDiagonal &mainDiagonal) {
   // trans -- unique_ptr<transport>'s law for viscosity
   // turb -- turbulence model
   // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
   //                 implicit solver
 
   // loop over all physical cells - no ghost cells needed for source terms
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = 0; kk < this->NumK(); kk++) {
     for (auto jj = 0; jj < this->NumJ(); jj++) {
       for (auto ii = 0; ii < this->NumI(); ii++) {
@@ -6211,10 +7381,10 @@ void procBlock::CalcSrcTerms(const unique_ptr<transport> &trans,
 
         // add contribution of source spectral radius to flux jacobian
         if (inp.IsBlockMatrix()) {
-          mainDiagonal(ii, jj, kk).SubtractFromTurbJacobian(srcJac);
+          mainDiagonal.Block(ii, jj, kk).SubtractFromTurbJacobian(srcJac);
         } else if (inp.IsImplicit()) {
-          const uncoupledScalar srcJacScalar(0.0, turbSpecRad);
-          mainDiagonal(ii, jj, kk) -= fluxJacobian(srcJacScalar);
+          mainDiagonal.Scalar(ii, jj, kk).SubtractFromTurbVariable(
+              turbSpecRad);
         }
       }
     }
@@ -6283,6 +7453,20 @@ void procBlock::CalcWallDistance(const kdtree &tree) {
   }
 }
 
+// member function to start the residual calculation with the inviscid fluxes
+// on the interior faces; these don't use any ghost cells, so they can be
+// calculated while the ghost cells at connection boundaries are exchanged
+void procBlock::CalcResidualInterior(const unique_ptr<transport> &trans,
+                                     const unique_ptr<thermodynamic> &thermo,
+                                     const unique_ptr<eos> &eos,
+                                     const input &inp,
+                                     const unique_ptr<turbModel> &turb,
+                                     implicitDiagonal &mainDiagonal) {
+  this->ResetResidualVars();
+  this->CalcFaceFlux(eos, thermo, trans, inp, turb, facePass::interior,
+                     mainDiagonal);
+}
+
 // member function to calculate the residual (RHS) excluding any contributions
 // from source terms
 void procBlock::CalcResidualNoSource(const unique_ptr<transport> &trans,
@@ -6290,20 +7474,50 @@ void procBlock::CalcResidualNoSource(const unique_ptr<transport> &trans,
                                      const unique_ptr<eos> &eos,
                                      const input &inp,
                                      const unique_ptr<turbModel> &turb,
-                                     multiArray3d<fluxJacobian> &mainDiagonal) {
-  // Zero spectral radii, residuals, gradients, turbulence variables
-  this->ResetResidWS();
-  if (isViscous_) {
-    this->ResetGradients();
-    if (isTurbulent_) {
-      this->ResetTurbVars();
+                                     implicitDiagonal &mainDiagonal,
+                                     const bool &interiorDone) {
+  // trans -- viscous transport model
+  // thermo -- thermodynamic model
+  // eos -- equation of state
+  // inp -- input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS
+  // interiorDone -- flag for interior faces done by CalcResidualInterior
+
+  if (!interiorDone) {
+    this->ResetResidualVars();
+  }
+
+  if (isViscous_ && inp.IsFusedFaceFlux()) {
+    // Calculate inviscid fluxes that use the slip wall ghost cells at viscous
+    // walls before they are overwritten
+    this->CalcFaceFlux(eos, thermo, trans, inp, turb, facePass::inviscidWall,
+                       mainDiagonal);
+
+    // Determine ghost cell values for viscous fluxes
+    this->AssignViscousGhostCells(inp, eos, thermo, trans, turb);
+
+    // Update temperature and viscosity
+    this->UpdateAuxillaryVariables(eos, trans);
+
+    // Calculate cell centered gradients for viscous fluxes
+    if (inp.IsCellGradients()) {
+      this->CalcCellGrads();
     }
+
+    // Calculate remaining inviscid fluxes and viscous fluxes in one pass
+    this->CalcFaceFlux(eos, thermo, trans, inp, turb,
+                       interiorDone ? facePass::fusedBoundary
+                                    : facePass::fused,
+                       mainDiagonal);
+    return;
   }
 
   // Calculate inviscid fluxes
-  this->CalcInvFluxI(eos, thermo, inp, turb, mainDiagonal);
-  this->CalcInvFluxJ(eos, thermo, inp, turb, mainDiagonal);
-  this->CalcInvFluxK(eos, thermo, inp, turb, mainDiagonal);
+  this->CalcFaceFlux(eos, thermo, trans, inp, turb,
+                     interiorDone ? facePass::inviscidBoundary
+                                  : facePass::inviscid,
+                     mainDiagonal);
 
   // If viscous change ghost cells and calculate viscous fluxes
   if (isViscous_) {
@@ -6313,6 +7527,11 @@ void procBlock::CalcResidualNoSource(const unique_ptr<transport> &trans,
     // Update temperature and viscosity
     this->UpdateAuxillaryVariables(eos, trans);
 
+    // Calculate cell centered gradients for viscous fluxes
+    if (inp.IsCellGradients()) {
+      this->CalcCellGrads();
+    }
+
     // Calculate viscous fluxes
     this->CalcViscFluxI(trans, thermo, eos, inp, turb, mainDiagonal);
     this->CalcViscFluxJ(trans, thermo, eos, inp, turb, mainDiagonal);
@@ -6451,24 +7670,41 @@ double procBlock::ProjC2CDist(const int &ii, const int &jj, const int &kk,
   // kk -- cell face index in k-direction
   // dir -- direction of face (i, j, or k)
 
-  auto projDist = 0.0;
-  // always subtract "higher" center from "lower" center because area vector
-  // points from lower to higher
   if (dir == "i") {
-    const auto c2cVec = this->Center(ii, jj, kk) - this->Center(ii - 1, jj, kk);
-    projDist = c2cVec.DotProd(this->FAreaUnitI(ii, jj, kk));
+    return this->ProjC2CDist(ii, jj, kk, 0);
   } else if (dir == "j") {
-    const auto c2cVec = this->Center(ii, jj, kk) - this->Center(ii, jj - 1, kk);
-    projDist = c2cVec.DotProd(this->FAreaUnitJ(ii, jj, kk));
+    return this->ProjC2CDist(ii, jj, kk, 1);
   } else if (dir == "k") {
-    const auto c2cVec = this->Center(ii, jj, kk) - this->Center(ii, jj, kk - 1);
-    projDist = c2cVec.DotProd(this->FAreaUnitK(ii, jj, kk));
+    return this->ProjC2CDist(ii, jj, kk, 2);
   } else {
     cerr << "ERROR: Error in procBlock::ProjC2CDist(). Direction " << dir
          << " is not recognized. Please choose i, j, or k." << endl;
     exit(EXIT_FAILURE);
   }
-  return projDist;
+}
+
+// member function to calculate the center to center distance across a cell face
+// projected along that face's area vector; the direction of the face is given
+// as an index (0 = i, 1 = j, 2 = k)
+double procBlock::ProjC2CDist(const int &ii, const int &jj, const int &kk,
+                              const int &dir) const {
+  // ii -- cell face index in i-direction
+  // jj -- cell face index in j-direction
+  // kk -- cell face index in k-direction
+  // dir -- direction of face (0 = i, 1 = j, 2 = k)
+
+  // always subtract "higher" center from "lower" center because area vector
+  // points from lower to higher
+  if (dir == 0) {
+    const auto c2cVec = this->Center(ii, jj, kk) - this->Center(ii - 1, jj, kk);
+    return c2cVec.DotProd(this->FAreaUnitI(ii, jj, kk));
+  } else if (dir == 1) {
+    const auto c2cVec = this->Center(ii, jj, kk) - this->Center(ii, jj - 1, kk);
+    return c2cVec.DotProd(this->FAreaUnitJ(ii, jj, kk));
+  } else {
+    const auto c2cVec = this->Center(ii, jj, kk) - this->Center(ii, jj, kk - 1);
+    return c2cVec.DotProd(this->FAreaUnitK(ii, jj, kk));
+  }
 }
 
 // member function to write the contents of a given variable to a given file
@@ -6538,6 +7774,118 @@ void procBlock::CalcCellWidths() {
 }
 
 
+/* Member function to calculate the coefficients for the higher order face
+reconstructions. The coefficients only depend on the cell widths, so they are
+calculated once after the cell widths and stored for each physical face. This
+keeps the Lagrange polynomial evaluations out of the face loops. The WENO
+coefficients are stored for the reconstruction of both the lower and upper
+states at each face.
+*/
+void procBlock::CalcReconCoeffs(const input &inp) {
+  // inp -- all input variables
+
+  if (inp.Reconstruction() == reconstruction::weno ||
+      inp.Reconstruction() == reconstruction::wenoZ) {
+    wenoLowerI_ = {this->NumI() + 1, this->NumJ(), this->NumK(), 0};
+    wenoUpperI_ = {this->NumI() + 1, this->NumJ(), this->NumK(), 0};
+    wenoLowerJ_ = {this->NumI(), this->NumJ() + 1, this->NumK(), 0};
+    wenoUpperJ_ = {this->NumI(), this->NumJ() + 1, this->NumK(), 0};
+    wenoLowerK_ = {this->NumI(), this->NumJ(), this->NumK() + 1, 0};
+    wenoUpperK_ = {this->NumI(), this->NumJ(), this->NumK() + 1, 0};
+
+    for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
+      for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
+        for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
+          wenoLowerI_(ii, jj, kk) = {
+              cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii - 2, jj, kk),
+              cellWidthI_(ii - 3, jj, kk), cellWidthI_(ii, jj, kk),
+              cellWidthI_(ii + 1, jj, kk)};
+          wenoUpperI_(ii, jj, kk) = {
+              cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk),
+              cellWidthI_(ii + 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
+              cellWidthI_(ii - 2, jj, kk)};
+        }
+      }
+    }
+
+    for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
+        for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+          wenoLowerJ_(ii, jj, kk) = {
+              cellWidthJ_(ii, jj - 1, kk), cellWidthJ_(ii, jj - 2, kk),
+              cellWidthJ_(ii, jj - 3, kk), cellWidthJ_(ii, jj, kk),
+              cellWidthJ_(ii, jj + 1, kk)};
+          wenoUpperJ_(ii, jj, kk) = {
+              cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk),
+              cellWidthJ_(ii, jj + 2, kk), cellWidthJ_(ii, jj - 1, kk),
+              cellWidthJ_(ii, jj - 2, kk)};
+        }
+      }
+    }
+
+    for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
+      for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+        for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+          wenoLowerK_(ii, jj, kk) = {
+              cellWidthK_(ii, jj, kk - 1), cellWidthK_(ii, jj, kk - 2),
+              cellWidthK_(ii, jj, kk - 3), cellWidthK_(ii, jj, kk),
+              cellWidthK_(ii, jj, kk + 1)};
+          wenoUpperK_(ii, jj, kk) = {
+              cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1),
+              cellWidthK_(ii, jj, kk + 2), cellWidthK_(ii, jj, kk - 1),
+              cellWidthK_(ii, jj, kk - 2)};
+        }
+      }
+    }
+  }
+
+  if (isViscous_ &&
+      inp.ViscousReconstruction() == viscousReconstruction::centralFourth) {
+    central4thI_ = {this->NumI() + 1, this->NumJ(), this->NumK(), 0};
+    central4thJ_ = {this->NumI(), this->NumJ() + 1, this->NumK(), 0};
+    central4thK_ = {this->NumI(), this->NumJ(), this->NumK() + 1, 0};
+
+    for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
+      for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
+        for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
+          central4thI_(ii, jj, kk) = {
+              cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
+              cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk)};
+        }
+      }
+    }
+
+    for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
+        for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+          central4thJ_(ii, jj, kk) = {
+              cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj - 1, kk),
+              cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk)};
+        }
+      }
+    }
+
+    for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
+      for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+        for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+          central4thK_(ii, jj, kk) = {
+              cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk - 1),
+              cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1)};
+        }
+      }
+    }
+  }
+}
+
+// member function to order the cells by hyperplane for the implicit sweeps;
+// the ordering only depends on the block size, so it is calculated once
+void procBlock::CalcHyperplanes(const input &inp) {
+  // inp -- all input variables
+  if (inp.IsImplicit() && inp.MatrixUsesHyperplanes()) {
+    hyperplanes_ = {this->NumI(), this->NumJ(), this->NumK()};
+  }
+}
+
 void procBlock::GetStatesFromRestart(const multiArray3d<primVars> &restart) {
   state_.Insert(restart.RangeI(), restart.RangeJ(), restart.RangeK(), restart);
 }
@@ -0,0 +1,85 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <vector>   // vector
+#include <cmath>    // abs
+#include "reconCoeffs.hpp"
+#include "utility.hpp"  // LagrangeCoeff
+
+using std::vector;
+
+// function to determine if all cells in a stencil have the same width
+bool IsUniformStencil(const vector<double> &cellWidth) {
+  constexpr auto tol = 1.0e-12;
+  for (auto &width : cellWidth) {
+    if (std::abs(width - cellWidth[0]) > tol * cellWidth[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// constructor for WENO coefficients from widths of cells in stencil
+wenoCoeffs::wenoCoeffs(const double &uw1, const double &uw2,
+                       const double &uw3, const double &dw1,
+                       const double &dw2) : wenoCoeffs() {
+  // uw1 -- width of cell reconstructing from
+  // uw2 -- width of first upwind cell
+  // uw3 -- width of second upwind cell
+  // dw1 -- width of first downwind cell
+  // dw2 -- width of second downwind cell
+
+  const vector<double> cellWidth = {uw3, uw2, uw1, dw1, dw2};
+  if (IsUniformStencil(cellWidth)) {
+    return;
+  }
+
+  constexpr auto degree = 2;
+  constexpr auto up1Loc = 2;
+  for (auto ss = 0; ss < 3; ++ss) {
+    const auto coeffs = LagrangeCoeff(cellWidth, degree, 2 - ss, up1Loc);
+    for (auto cc = 0; cc < 3; ++cc) {
+      stencil_[ss][cc] = coeffs[cc];
+    }
+  }
+
+  // get coefficients for large stencil to calculate linear weights
+  const auto fullCoeffs = LagrangeCoeff(cellWidth, 4, 2, up1Loc);
+  linearWeights_[0] = fullCoeffs[0] / stencil_[0][0];
+  linearWeights_[1] = fullCoeffs[4] / stencil_[2][2];
+  linearWeights_[2] = 1.0 - linearWeights_[0] - linearWeights_[1];
+}
+
+// constructor for 4th order central coefficients from widths of cells in
+// stencil
+central4thCoeffs::central4thCoeffs(const double &uw2, const double &uw1,
+                                   const double &dw1, const double &dw2)
+    : central4thCoeffs() {
+  // uw2 -- width of second upwind cell
+  // uw1 -- width of first upwind cell
+  // dw1 -- width of first downwind cell
+  // dw2 -- width of second downwind cell
+
+  const vector<double> cellWidth = {uw2, uw1, dw1, dw2};
+  if (IsUniformStencil(cellWidth)) {
+    return;
+  }
+
+  const auto coeffs = LagrangeCoeff(cellWidth, 3, 1, 1);
+  for (auto cc = 0; cc < 4; ++cc) {
+    coeffs_[cc] = coeffs[cc];
+  }
+}
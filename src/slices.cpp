@@ -15,6 +15,7 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>. */
 
 #include <iostream>
+#include "mpi.h"      // parallelism
 #include "slices.hpp"
 #include "procBlock.hpp"
 #include "range.hpp"  // range
@@ -171,3 +172,102 @@ geomSlice::geomSlice(const procBlock &blk, const range &ir, const range &jr,
     }
   }
 }
+
+// function to get the number of doubles in an array of geometry data
+template <typename T>
+int NumDoubles(const multiArray3d<T> &arr) {
+  return arr.Size() * sizeof(T) / sizeof(double);
+}
+
+// member function to get the size of the buffer needed to pack a geomSlice
+int geomSlice::PackSize() const {
+  auto bufSize = 0;
+  auto tempSize = 0;
+  MPI_Pack_size(4, MPI_INT, MPI_COMM_WORLD,
+                &tempSize);  // add size for dimensions and parent block
+  bufSize += tempSize;
+  const auto numDoubles = NumDoubles(center_) + NumDoubles(fAreaI_) +
+      NumDoubles(fAreaJ_) + NumDoubles(fAreaK_) + NumDoubles(fCenterI_) +
+      NumDoubles(fCenterJ_) + NumDoubles(fCenterK_) + NumDoubles(vol_);
+  MPI_Pack_size(numDoubles, MPI_DOUBLE, MPI_COMM_WORLD,
+                &tempSize);  // add size for geometry
+  bufSize += tempSize;
+  return bufSize;
+}
+
+/*Member function to pack a geomSlice into a buffer so that it can be sent with
+ * MPI.*/
+void geomSlice::PackGeomSlice(char *(&sendBuffer), const int &sendBufSize,
+                              int &position) const {
+  // sendBuffer -- buffer to pack data into
+  // sendBufSize -- size of buffer
+  // position -- location within buffer
+
+  const auto numI = this->NumI();
+  const auto numJ = this->NumJ();
+  const auto numK = this->NumK();
+  MPI_Pack(&numI, 1, MPI_INT, sendBuffer, sendBufSize, &position,
+           MPI_COMM_WORLD);
+  MPI_Pack(&numJ, 1, MPI_INT, sendBuffer, sendBufSize, &position,
+           MPI_COMM_WORLD);
+  MPI_Pack(&numK, 1, MPI_INT, sendBuffer, sendBufSize, &position,
+           MPI_COMM_WORLD);
+  MPI_Pack(&parBlock_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
+           MPI_COMM_WORLD);
+
+  MPI_Pack(&(*std::begin(center_)), NumDoubles(center_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fAreaI_)), NumDoubles(fAreaI_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fAreaJ_)), NumDoubles(fAreaJ_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fAreaK_)), NumDoubles(fAreaK_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fCenterI_)), NumDoubles(fCenterI_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fCenterJ_)), NumDoubles(fCenterJ_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fCenterK_)), NumDoubles(fCenterK_), MPI_DOUBLE,
+           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(vol_)), NumDoubles(vol_), MPI_DOUBLE, sendBuffer,
+           sendBufSize, &position, MPI_COMM_WORLD);
+}
+
+/*Member function to unpack data from a buffer into a geomSlice. Used with MPI
+ * receive*/
+void geomSlice::UnpackGeomSlice(char *(&recvBuffer), const int &recvBufSize,
+                                int &position) {
+  // recvBuffer -- buffer to unpack data from
+  // recvBufSize -- size of buffer
+  // position -- location within buffer
+
+  auto numI = 0, numJ = 0, numK = 0, parBlock = 0;
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &numI, 1, MPI_INT,
+             MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &numJ, 1, MPI_INT,
+             MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &numK, 1, MPI_INT,
+             MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &parBlock, 1, MPI_INT,
+             MPI_COMM_WORLD);
+
+  // resize slice
+  (*this) = geomSlice(numI, numJ, numK, parBlock);
+
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(center_)),
+             NumDoubles(center_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fAreaI_)),
+             NumDoubles(fAreaI_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fAreaJ_)),
+             NumDoubles(fAreaJ_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fAreaK_)),
+             NumDoubles(fAreaK_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fCenterI_)),
+             NumDoubles(fCenterI_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fCenterJ_)),
+             NumDoubles(fCenterJ_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fCenterK_)),
+             NumDoubles(fCenterK_), MPI_DOUBLE, MPI_COMM_WORLD);
+  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(vol_)),
+             NumDoubles(vol_), MPI_DOUBLE, MPI_COMM_WORLD);
+}
@@ -15,6 +15,9 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>. */
 
 #include <iostream>     // cout
+#include <algorithm>    // max
+#include <cmath>        // abs
+#include <utility>      // move
 #include "thermodynamic.hpp"
 #include "utility.hpp"  // FindRoot
 
@@ -24,12 +27,17 @@ using std::cerr;
 
 // Member functions for thermodynamic class
 
-double caloricallyPerfect::TemperatureFromSpecEnergy(const double& e) const {
-  const auto t = 1.0;  // cpg has constant Cv, so value of t is meaningless
-  return e / this->Cv(t);
+// derivative of Cv with respect to temperature
+double thermallyPerfect::CvDerivative(const double& t) const {
+  const auto tv = this->ThetaV(t);
+  const auto ratio = tv / sinh(tv);
+  // write coth in terms of exp(-2 tv) so it does not overflow at low t
+  const auto x = exp(-2.0 * tv);
+  const auto coth = (1.0 + x) / (1.0 - x);
+  return -2.0 * nonDimR_ * ratio * ratio * (1.0 - tv * coth) / t;
 }
 
-double thermallyPerfect::TemperatureFromSpecEnergy(const double& e) const {
+double thermallyPerfect::TemperatureFromSpecEnergyRoot(const double& e) const {
   auto temperature = 0.0;
   auto func = [&](const double& t) {
     temperature = t;
@@ -37,6 +45,89 @@ double thermallyPerfect::TemperatureFromSpecEnergy(const double& e) const {
     return e - this->SpecEnergy(t);
   };
   FindRoot(func, 1.0e-8, 1.0e4, 1.0e-8);
-  
+
   return temperature;
-}
\ No newline at end of file
+}
+
+// Newton's method to machine precision from an initial guess; used to
+// construct and check the tables
+double thermallyPerfect::TemperatureFromSpecEnergyNewton(const double& e,
+                                                         double t) const {
+  constexpr auto maxIter = 50;
+  for (auto ii = 0; ii < maxIter; ++ii) {
+    const auto dt = (this->SpecEnergy(t) - e) / this->CvExact(t);
+    t -= dt;
+    if (std::abs(dt) <= 1.0e-15 * t) {
+      break;
+    }
+  }
+  return t;
+}
+
+/* Member function to tabulate T(e) and Cv(T) over the given nondimensional
+temperature range. The number of table intervals is doubled until the
+interpolated values at the midpoints between all samples are within the
+relative tolerance of the exact values. Tabulated values of T(e) can be
+polished with Newton iterations on the exact energy. Cp and gamma are
+calculated from the tabulated Cv so that Cp - Cv = R is retained.
+*/
+void thermallyPerfect::BuildTables(const double& tMin, const double& tMax,
+                                   const double& tol, const int& newtonIter) {
+  // tMin -- minimum nondimensional temperature in table
+  // tMax -- maximum nondimensional temperature in table
+  // tol -- relative tolerance of interpolated values
+  // newtonIter -- Newton iterations to polish tabulated temperature
+
+  constexpr auto minIntervals = 64;
+  constexpr auto maxIntervals = 1 << 20;
+
+  // relative error of table at midpoints between samples
+  auto tableError = [](const monotoneCubicTable &table, const auto &exact) {
+    const auto dx = (table.XMax() - table.XMin()) / table.NumIntervals();
+    auto error = 0.0;
+    for (auto ii = 0; ii < table.NumIntervals(); ++ii) {
+      const auto x = table.XMin() + (ii + 0.5) * dx;
+      const auto val = exact(x);
+      error = std::max(error, std::abs(table.Value(x) - val) / std::abs(val));
+    }
+    return error;
+  };
+
+  // Cv(T) table
+  auto cvFn = [&](const double& t) { return this->CvExact(t); };
+  auto dcvFn = [&](const double& t) { return this->CvDerivative(t); };
+  auto numInt = minIntervals;
+  auto cvTable = monotoneCubicTable(tMin, tMax, numInt, cvFn, dcvFn);
+  while (tableError(cvTable, cvFn) > tol && numInt < maxIntervals) {
+    numInt *= 2;
+    cvTable = monotoneCubicTable(tMin, tMax, numInt, cvFn, dcvFn);
+  }
+  if (tableError(cvTable, cvFn) > tol) {
+    cerr << "WARNING: Cv table did not reach tolerance of " << tol
+         << " with " << numInt << " intervals." << endl;
+  }
+
+  // T(e) table; dT/de = 1 / Cv
+  const auto eMin = this->SpecEnergy(tMin);
+  const auto eMax = this->SpecEnergy(tMax);
+  // exact temperature from a linear guess between the end points
+  auto tFn = [&](const double& e) {
+    const auto guess = tMin + (e - eMin) / (eMax - eMin) * (tMax - tMin);
+    return this->TemperatureFromSpecEnergyNewton(e, guess);
+  };
+  auto dtFn = [&](const double& e) { return 1.0 / this->CvExact(tFn(e)); };
+  numInt = minIntervals;
+  auto tTable = monotoneCubicTable(eMin, eMax, numInt, tFn, dtFn);
+  while (tableError(tTable, tFn) > tol && numInt < maxIntervals) {
+    numInt *= 2;
+    tTable = monotoneCubicTable(eMin, eMax, numInt, tFn, dtFn);
+  }
+  if (tableError(tTable, tFn) > tol) {
+    cerr << "WARNING: Temperature table did not reach tolerance of " << tol
+         << " with " << numInt << " intervals." << endl;
+  }
+
+  cv_ = std::move(cvTable);
+  tFromE_ = std::move(tTable);
+  newtonIterations_ = newtonIter;
+}
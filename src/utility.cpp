@@ -20,6 +20,9 @@
 #include <string>
 #include <memory>
 #include <numeric>
+#ifdef _OPENMP
+#include <omp.h>                  // omp_get_max_threads, omp_get_thread_num
+#endif
 #include "utility.hpp"
 #include "procBlock.hpp"
 #include "eos.hpp"                 // equation of state
@@ -30,9 +33,13 @@
 #include "turbulence.hpp"
 #include "slices.hpp"
 #include "fluxJacobian.hpp"
+#include "implicitDiagonal.hpp"
 #include "kdtree.hpp"
 #include "resid.hpp"
 #include "primVars.hpp"
+#include "blockTasks.hpp"
+#include "haloExchange.hpp"
+#include "macros.hpp"
 
 using std::cout;
 using std::endl;
@@ -256,70 +263,241 @@ void SwapGeomSlice(connection &inter, procBlock &blk1, procBlock &blk2) {
 }
 
 
-/* Function to populate ghost cells with proper cell states for inviscid flow
-calculation. This function operates on the entire grid and uses connection
-boundaries to pass the correct data between grid blocks.
+/* Function to swap the geometry at all connection boundaries when the blocks
+are spread across the processors. The connections are swapped in the rounds of
+a haloExchange, so the result is the same as calling SwapGeomSlice for each
+connection in order with all of the blocks on one processor. The slices sent
+to another processor are taken before the connections on this processor are
+swapped, and the slices received are put in after, as in HaloExchangeTasks.
+Each processor only updates the borders of its own side of a connection, so the
+borders are combined at the end to give all processors the same connections.
+*/
+void SwapGeomSlices(vector<connection> &connections, vector<procBlock> &blks,
+                    const int &rank, const int &numGhosts) {
+  // connections -- all connections in domain
+  // blks -- procBlocks on this processor
+  // rank -- processor rank
+  // numGhosts -- number of ghost cell layers
+
+  // messages between two processors in a round are sent and received in
+  // connection order, so they match up without unique tags
+  const auto tag = 3;
+  const haloExchange rounds(connections, rank, numGhosts);
+
+  for (auto rr = 0; rr < rounds.NumRounds(); rr++) {
+    const auto &conns = rounds.RoundConnections(rr);
+
+    // send slices of connections with other processors
+    vector<vector<char>> sendBufs;
+    vector<MPI_Request> sendReqs;
+    sendBufs.reserve(conns.size());
+    sendReqs.reserve(conns.size());
+    for (const auto &cc : conns) {
+      if (rounds.IsLocal(cc)) {
+        continue;
+      }
+      const auto &conn = connections[cc];
+      const auto isFirst = conn.RankFirst() == rank;
+      const auto &blk = blks[rounds.LocalBlock(cc)];
+
+      auto is = 0, ie = 0;
+      auto js = 0, je = 0;
+      auto ks = 0, ke = 0;
+      if (isFirst) {
+        conn.FirstSliceIndices(is, ie, js, je, ks, ke, blk.NumGhosts());
+      } else {
+        conn.SecondSliceIndices(is, ie, js, je, ks, ke, blk.NumGhosts());
+      }
+      const auto geom = geomSlice(blk, {is, ie}, {js, je}, {ks, ke});
+
+      const auto sendBufSize = geom.PackSize();
+      sendBufs.emplace_back(sendBufSize);
+      auto *sendBuffer = sendBufs.back().data();
+      auto position = 0;
+      geom.PackGeomSlice(sendBuffer, sendBufSize, position);
+
+      sendReqs.emplace_back();
+      const auto peer = isFirst ? conn.RankSecond() : conn.RankFirst();
+      MPI_Isend(sendBuffer, position, MPI_PACKED, peer, tag, MPI_COMM_WORLD,
+                &sendReqs.back());
+    }
+
+    // swap connections on this processor
+    for (const auto &cc : conns) {
+      if (rounds.IsLocal(cc)) {
+        auto &conn = connections[cc];
+        SwapGeomSlice(conn, blks[conn.LocalBlockFirst()],
+                      blks[conn.LocalBlockSecond()]);
+      }
+    }
+
+    // receive slices of connections with other processors and put them in
+    for (const auto &cc : conns) {
+      if (rounds.IsLocal(cc)) {
+        continue;
+      }
+      auto &conn = connections[cc];
+      const auto isFirst = conn.RankFirst() == rank;
+      auto &blk = blks[rounds.LocalBlock(cc)];
+      const auto peer = isFirst ? conn.RankSecond() : conn.RankFirst();
+
+      MPI_Status status;
+      auto recvBufSize = 0;
+      MPI_Probe(peer, tag, MPI_COMM_WORLD, &status);
+      MPI_Get_count(&status, MPI_PACKED, &recvBufSize);
+      vector<char> recvBuf(recvBufSize);
+      auto *recvBuffer = recvBuf.data();
+      MPI_Recv(recvBuffer, recvBufSize, MPI_PACKED, peer, tag, MPI_COMM_WORLD,
+               &status);
+
+      geomSlice geom;
+      auto position = 0;
+      geom.UnpackGeomSlice(recvBuffer, recvBufSize, position);
+
+      // partner slice has the same number of ghost layers
+      auto inter = conn;
+      inter.AdjustForSlice(isFirst, blk.NumGhosts());
+      const auto adjEdge = blk.PutGeomSlice(geom, inter, blk.NumGhosts());
+      for (auto ii = 0U; ii < adjEdge.size(); ii++) {
+        if (adjEdge[ii] && isFirst) {
+          conn.UpdateBorderFirst(ii);
+        } else if (adjEdge[ii]) {
+          conn.UpdateBorderSecond(ii);
+        }
+      }
+    }
+
+    MPI_Waitall(sendReqs.size(), sendReqs.data(), MPI_STATUSES_IGNORE);
+  }
+
+  // combine connection borders from all processors
+  vector<int> borders(8 * connections.size(), 0);
+  for (auto cc = 0U; cc < connections.size(); cc++) {
+    const auto &conn = connections[cc];
+    borders[8 * cc] = conn.Dir1StartInterBorderFirst();
+    borders[8 * cc + 1] = conn.Dir1EndInterBorderFirst();
+    borders[8 * cc + 2] = conn.Dir2StartInterBorderFirst();
+    borders[8 * cc + 3] = conn.Dir2EndInterBorderFirst();
+    borders[8 * cc + 4] = conn.Dir1StartInterBorderSecond();
+    borders[8 * cc + 5] = conn.Dir1EndInterBorderSecond();
+    borders[8 * cc + 6] = conn.Dir2StartInterBorderSecond();
+    borders[8 * cc + 7] = conn.Dir2EndInterBorderSecond();
+  }
+  MPI_Allreduce(MPI_IN_PLACE, borders.data(), borders.size(), MPI_INT, MPI_LOR,
+                MPI_COMM_WORLD);
+  for (auto cc = 0U; cc < connections.size(); cc++) {
+    for (auto ii = 0; ii < 4; ii++) {
+      if (borders[8 * cc + ii]) {
+        connections[cc].UpdateBorderFirst(ii);
+      }
+      if (borders[8 * cc + 4 + ii]) {
+        connections[cc].UpdateBorderSecond(ii);
+      }
+    }
+  }
+}
+
+/* Function to create the tasks to populate ghost cells with proper cell
+states for inviscid flow calculation. This function operates on the entire grid
+and uses connection boundaries to pass the correct data between grid blocks.
+The overlap function creates tasks to run while the ghost cells at connection
+boundaries are exchanged with other processors. This must be called from
+within RunBlockTasks.
 */
 void GetBoundaryConditions(vector<procBlock> &states, const input &inp,
                            const unique_ptr<eos> &eqnState,
                            const unique_ptr<thermodynamic> &thermo,
                            const unique_ptr<transport> &trans,
                            const unique_ptr<turbModel> &turb,
-                           vector<connection> &connections, const int &rank,
-                           const MPI_Datatype &MPI_cellData) {
+                           haloExchange &halo,
+                           const function<void()> &overlap) {
   // states -- vector of all procBlocks in the solution domain
   // inp -- all input variables
   // eqnState -- equation of state
   // thermo -- thermodynamic model
   // trans -- viscous transport model
-  // connections -- vector of connection boundary types
-  // rank -- processor rank
-  // MPI_cellData -- data type to pass primVars, genArray
+  // halo -- exchange for connection boundaries
+  // overlap -- function to create tasks to run during the exchange
 
   // loop over all blocks and assign inviscid ghost cells
-  for (auto &state : states) {
-    state.AssignInviscidGhostCells(inp, eqnState, thermo, trans, turb);
+  for (auto bb = 0U; bb < states.size(); bb++) {
+    BlockTask(states[bb], [&, bb]() {
+      states[bb].AssignInviscidGhostCells(inp, eqnState, thermo, trans, turb);
+    });
   }
 
-  // loop over connections and swap ghost cells where needed
-  for (auto &conn : connections) {
-    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
-      // both sides of connection on this processor, swap w/o mpi
-      states[conn.LocalBlockFirst()].SwapStateSlice(
-          conn, states[conn.LocalBlockSecond()]);
-    } else if (conn.RankFirst() == rank) {
-      // rank matches rank of first side of connection, swap over mpi
-      states[conn.LocalBlockFirst()].SwapStateSliceMPI(conn, rank, MPI_cellData);
-    } else if (conn.RankSecond() == rank) {
-      // rank matches rank of second side of connection, swap over mpi
-      states[conn.LocalBlockSecond()].SwapStateSliceMPI(conn, rank, MPI_cellData);
-    }
-    // if rank doesn't match either side of connection, then do nothing and
-    // move on to the next connection
-  }
+  // swap ghost cells at connection boundaries
+  HaloExchangeTasks(
+      states, halo, {haloField::state},
+      [&](const int &cc, const int &bb) {
+        states[bb].PackStateSlice(halo, cc);
+      },
+      [&](const int &cc, const int &first, const int &second) {
+        states[first].SwapStateSlice(halo.Connection(cc), states[second]);
+      },
+      [&](const int &cc, const int &bb) {
+        states[bb].UnpackStateSlice(halo, cc);
+      },
+      overlap);
 
   // loop over all blocks and get ghost cell edge data
-  for (auto &state : states) {
-    state.AssignInviscidGhostCellsEdge(inp, eqnState, thermo, trans, turb);
+  for (auto bb = 0U; bb < states.size(); bb++) {
+    BlockTask(states[bb], [&, bb]() {
+      states[bb].AssignInviscidGhostCellsEdge(inp, eqnState, thermo, trans,
+                                              turb);
+    });
   }
 }
 
 
+// function to add the face centers of cells on viscous walls of a block
+void AddViscousFaceCenters(const procBlock &blk,
+                           vector<vector3d<double>> &faceCenters) {
+  // blk -- procBlock to get face centers from
+  // faceCenters -- face centers to add to
+
+  const auto &bc = blk.BC();
+  for (auto bb = 0; bb < bc.NumSurfaces(); bb++) {  // loop over surfaces
+    if (bc.GetBCTypes(bb) == "viscousWall") {
+      // only store face center if surface is viscous wall
+
+      if (bc.GetSurfaceType(bb) <= 2) {  // i-surface
+        const auto ii = bc.GetIMin(bb);  // imin and imax are the same
+
+        for (auto jj = bc.GetJMin(bb); jj < bc.GetJMax(bb); jj++) {
+          for (auto kk = bc.GetKMin(bb); kk < bc.GetKMax(bb); kk++) {
+            faceCenters.push_back(blk.FCenterI(ii, jj, kk));
+          }
+        }
+      } else if (bc.GetSurfaceType(bb) <= 4) {  // j-surface
+        const auto jj = bc.GetJMin(bb);  // jmin and jmax are the same
+
+        for (auto ii = bc.GetIMin(bb); ii < bc.GetIMax(bb); ii++) {
+          for (auto kk = bc.GetKMin(bb); kk < bc.GetKMax(bb); kk++) {
+            faceCenters.push_back(blk.FCenterJ(ii, jj, kk));
+          }
+        }
+      } else {  // k-surface
+        const auto kk = bc.GetKMin(bb);  // kmin and kmax are the same
+
+        for (auto ii = bc.GetIMin(bb); ii < bc.GetIMax(bb); ii++) {
+          for (auto jj = bc.GetJMin(bb); jj < bc.GetJMax(bb); jj++) {
+            faceCenters.push_back(blk.FCenterK(ii, jj, kk));
+          }
+        }
+      }
+    }
+  }
+}
+
 // function to get face centers of cells on viscous walls
 vector<vector3d<double>> GetViscousFaceCenters(const vector<procBlock> &blks) {
   // blks -- vector of all procBlocks in simulation
 
-  // get vector of BCs
-  vector<boundaryConditions> bcs;
-  bcs.reserve(blks.size());
-  for (auto &blk : blks) {
-    bcs.push_back(blk.BC());
-  }
-
   // determine number of faces with viscous wall BC
   auto nFaces = 0;
-  for (auto &bc : bcs) {
-    nFaces += bc.NumViscousFaces();
+  for (auto &blk : blks) {
+    nFaces += blk.BC().NumViscousFaces();
   }
 
   // allocate vector for face centers
@@ -327,41 +505,44 @@ vector<vector3d<double>> GetViscousFaceCenters(const vector<procBlock> &blks) {
   faceCenters.reserve(nFaces);
 
   // store viscous face centers
-  auto aa = 0;
-  for (auto &bc : bcs) {  // loop over BCs for each block
-    for (auto bb = 0; bb < bc.NumSurfaces(); bb++) {  // loop over surfaces
-      if (bc.GetBCTypes(bb) == "viscousWall") {
-        // only store face center if surface is viscous wall
-
-        if (bc.GetSurfaceType(bb) <= 2) {  // i-surface
-          const auto ii = bc.GetIMin(bb);  // imin and imax are the same
-
-          for (auto jj = bc.GetJMin(bb); jj < bc.GetJMax(bb); jj++) {
-            for (auto kk = bc.GetKMin(bb); kk < bc.GetKMax(bb); kk++) {
-              faceCenters.push_back(blks[aa].FCenterI(ii, jj, kk));
-            }
-          }
-        } else if (bc.GetSurfaceType(bb) <= 4) {  // j-surface
-          const auto jj = bc.GetJMin(bb);  // jmin and jmax are the same
-
-          for (auto ii = bc.GetIMin(bb); ii < bc.GetIMax(bb); ii++) {
-            for (auto kk = bc.GetKMin(bb); kk < bc.GetKMax(bb); kk++) {
-              faceCenters.push_back(blks[aa].FCenterJ(ii, jj, kk));
-            }
-          }
-        } else {  // k-surface
-          const auto kk = bc.GetKMin(bb);  // kmin and kmax are the same
+  for (auto &blk : blks) {
+    AddViscousFaceCenters(blk, faceCenters);
+  }
+  return faceCenters;
+}
 
-          for (auto ii = bc.GetIMin(bb); ii < bc.GetIMax(bb); ii++) {
-            for (auto jj = bc.GetJMin(bb); jj < bc.GetJMax(bb); jj++) {
-              faceCenters.push_back(blks[aa].FCenterK(ii, jj, kk));
-            }
-          }
-        }
-      }
-    }
-    aa++;
+/* Function to get the face centers of cells on viscous walls when the blocks
+are spread across the processors. The face centers are put in the same order as
+GetViscousFaceCenters would put them for all blocks, and every processor gets
+all of the face centers.
+*/
+vector<vector3d<double>> GatherViscousFaceCenters(
+    const vector<procBlock> &localBlks, const int &numBlks) {
+  // localBlks -- procBlocks on this processor
+  // numBlks -- number of procBlocks on all processors
+
+  // determine number of faces with viscous wall BC in each block
+  vector<int> nFaces(numBlks, 0);
+  for (auto &blk : localBlks) {
+    nFaces[blk.GlobalPos()] = blk.BC().NumViscousFaces();
+  }
+  MPI_Allreduce(MPI_IN_PLACE, nFaces.data(), numBlks, MPI_INT, MPI_SUM,
+                MPI_COMM_WORLD);
+  vector<int> offset(numBlks + 1, 0);
+  std::partial_sum(nFaces.begin(), nFaces.end(), offset.begin() + 1);
+
+  // each block fills its part, the rest stay zero so the sum over all
+  // processors has all face centers
+  vector<vector3d<double>> faceCenters(offset.back());
+  for (auto &blk : localBlks) {
+    vector<vector3d<double>> blkFaces;
+    blkFaces.reserve(nFaces[blk.GlobalPos()]);
+    AddViscousFaceCenters(blk, blkFaces);
+    std::copy(blkFaces.begin(), blkFaces.end(),
+              faceCenters.begin() + offset[blk.GlobalPos()]);
   }
+  MPI_Allreduce(MPI_IN_PLACE, faceCenters.data(), 3 * faceCenters.size(),
+                MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
   return faceCenters;
 }
 
@@ -396,22 +577,47 @@ void ExplicitUpdate(vector<procBlock> &blocks, const input &inp,
                     genArray &residL2, resid &residLinf) {
   // create dummy update (not used in explicit update)
   multiArray3d<genArray> du(1, 1, 1, 0);
+
+  // residual norms are accumulated for each block and combined in block order
+  vector<genArray> blockL2(blocks.size(), genArray(0.0));
+  vector<resid> blockLinf(blocks.size());
+
   // loop over all blocks and update
-  for (auto &block : blocks) {
-    block.UpdateBlock(inp, eqnState, thermo, trans, du, turb, mm, residL2,
-                      residLinf);
+  RunBlockTasks(blocks.size(), [&]() {
+    for (auto bb = 0U; bb < blocks.size(); bb++) {
+      BlockTask(blocks[bb], [&, bb]() {
+        blocks[bb].UpdateBlock(inp, eqnState, thermo, trans, du, turb, mm,
+                               blockL2[bb], blockLinf[bb]);
+      });
+    }
+  });
+  CombineResiduals(blockL2, blockLinf, residL2, residLinf);
+}
+
+// function to combine the residual norms of each block in block order
+void CombineResiduals(const vector<genArray> &blockL2,
+                      const vector<resid> &blockLinf, genArray &residL2,
+                      resid &residLinf) {
+  // blockL2 -- l2 norm of residual for each block
+  // blockLinf -- linf norm of residual for each block
+  // residL2 -- l2 norm of residual for all blocks
+  // residLinf -- linf norm of residual for all blocks
+  for (auto bb = 0U; bb < blockL2.size(); bb++) {
+    residL2 += blockL2[bb];
+    if (blockLinf[bb].Linf() > residLinf.Linf()) {
+      residLinf = blockLinf[bb];
+    }
   }
 }
 
 double ImplicitUpdate(vector<procBlock> &blocks,
-                      vector<multiArray3d<fluxJacobian>> &mainDiagonal,
+                      vector<implicitDiagonal> &mainDiagonal,
                       const input &inp, const unique_ptr<eos> &eqnState,
                       const unique_ptr<thermodynamic> &thermo,
                       const unique_ptr<transport> &trans,
                       const unique_ptr<turbModel> &turb, const int &mm,
                       genArray &residL2, resid &residLinf,
-                      const vector<connection> &connections, const int &rank,
-                      const MPI_Datatype &MPI_cellData) {
+                      haloExchange &halo) {
   // blocks -- vector of procBlocks on current processor
   // mainDiagonal -- main diagonal of A matrix for all blocks on processor
   // inp -- input variables
@@ -422,212 +628,219 @@ double ImplicitUpdate(vector<procBlock> &blocks,
   // mm -- nonlinear iteration
   // residL2 -- L2 residual
   // residLinf -- L infinity residual
+  // halo -- exchange for connection boundaries
 
-  // initialize matrix error
-  auto matrixError = 0.0;
+  const auto numBlocks = blocks.size();
 
-  const auto numG = blocks[0].NumGhosts();
+  // matrix error and residual norms are accumulated for each block and
+  // combined in block order
+  vector<double> blockError(numBlocks, 0.0);
+  vector<genArray> blockL2(numBlocks, genArray(0.0));
+  vector<resid> blockLinf(numBlocks);
 
-  // add volume and time term and calculate inverse of main diagonal
-  for (auto bb = 0U; bb < blocks.size(); bb++) {
-    blocks[bb].InvertDiagonal(mainDiagonal[bb], inp);
-  }
+  const auto isLUSGS = inp.MatrixSolver() == "lusgs" ||
+      inp.MatrixSolver() == "blusgs";
+  const auto isMulticolor = inp.MatrixSolver() == "mcgs" ||
+      inp.MatrixSolver() == "bmcgs";
 
   // initialize matrix update
-  vector<multiArray3d<genArray>> du(blocks.size());
-  for (auto bb = 0U; bb < blocks.size(); bb++) {
-    du[bb] = blocks[bb].InitializeMatrixUpdate(inp, eqnState, thermo,
-                                               mainDiagonal[bb]);
-  }
-
-  // Solve Ax=b with supported solver
-  if (inp.MatrixSolver() == "lusgs" || inp.MatrixSolver() == "blusgs") {
-    // calculate order by hyperplanes for each block
-    vector<vector<vector3d<int>>> reorder(blocks.size());
-    for (auto bb = 0U; bb < blocks.size(); bb++) {
-      reorder[bb] = HyperplaneReorder(blocks[bb].NumI(), blocks[bb].NumJ(),
-                                      blocks[bb].NumK());
+  vector<multiArray3d<genArray>> du(numBlocks);
+
+  // the work on each block is done as tasks which depend on the update du for
+  // that block; the connection swaps depend on the updates for both blocks
+  RunBlockTasks(numBlocks, [&]() {
+    for (auto bb = 0U; bb < numBlocks; bb++) {
+      BlockTask(du[bb], [&, bb]() {
+        // add volume and time term and factor main diagonal
+        blocks[bb].FactorDiagonal(mainDiagonal[bb], inp);
+
+        // calculate off diagonal operators if they are stored
+        blocks[bb].CalcOffDiagonals(eqnState, inp, thermo, trans, turb);
+
+        // initialize matrix update
+        du[bb] = blocks[bb].InitializeMatrixUpdate(inp, eqnState, thermo,
+                                                   mainDiagonal[bb]);
+      });
     }
 
-    // start sweeps through domain
-    for (auto ii = 0; ii < inp.MatrixSweeps(); ii++) {
-      // swap updates for ghost cells
-      SwapImplicitUpdate(du, connections, rank, MPI_cellData, numG);
-
-      // forward lu-sgs sweep
-      for (auto bb = 0U; bb < blocks.size(); bb++) {
-        blocks[bb].LUSGS_Forward(reorder[bb], du[bb], eqnState, inp, thermo,
-                                 trans, turb, mainDiagonal[bb], ii);
-      }
+    // Solve Ax=b with supported solver
+    if (isLUSGS) {
+      // start sweeps through domain
+      for (auto ii = 0; ii < inp.MatrixSweeps(); ii++) {
+        // swap updates for ghost cells
+        SwapImplicitUpdate(du, halo);
+
+        // forward lu-sgs sweep
+        for (auto bb = 0U; bb < numBlocks; bb++) {
+          BlockTask(du[bb], [&, bb, ii]() {
+            blocks[bb].LUSGS_Forward(du[bb], eqnState, inp, thermo, trans,
+                                     turb, mainDiagonal[bb], ii);
+          });
+        }
 
-      // swap updates for ghost cells
-      SwapImplicitUpdate(du, connections, rank, MPI_cellData, numG);
+        // swap updates for ghost cells
+        SwapImplicitUpdate(du, halo);
 
-      // backward lu-sgs sweep
-      for (auto bb = 0U; bb < blocks.size(); bb++) {
-        matrixError += blocks[bb].LUSGS_Backward(reorder[bb], du[bb], eqnState,
-                                                 inp, thermo, trans, turb,
-                                                 mainDiagonal[bb], ii);
+        // backward lu-sgs sweep
+        for (auto bb = 0U; bb < numBlocks; bb++) {
+          BlockTask(du[bb], [&, bb, ii]() {
+            blockError[bb] += blocks[bb].LUSGS_Backward(
+                du[bb], eqnState, inp, thermo, trans, turb, mainDiagonal[bb],
+                ii);
+          });
+        }
       }
-    }
-  } else if (inp.MatrixSolver() == "dplur" || inp.MatrixSolver() == "bdplur") {
-    for (auto ii = 0; ii < inp.MatrixSweeps(); ii++) {
-      // swap updates for ghost cells
-      SwapImplicitUpdate(du, connections, rank, MPI_cellData, numG);
-
-      for (auto bb = 0U; bb < blocks.size(); bb++) {
-        // Calculate correction (du)
-        matrixError += blocks[bb].DPLUR(du[bb], eqnState, inp, thermo, trans,
-                                        turb, mainDiagonal[bb]);
+    } else if (isMulticolor) {
+      // each sweep does two red-black passes so that it costs about the same
+      // as a forward and backward lu-sgs sweep
+      for (auto ii = 0; ii < 2 * inp.MatrixSweeps(); ii++) {
+        // swap updates for ghost cells
+        SwapImplicitUpdate(du, halo);
+
+        for (auto bb = 0U; bb < numBlocks; bb++) {
+          BlockTask(du[bb], [&, bb]() {
+            blockError[bb] += blocks[bb].MulticolorGS(
+                du[bb], eqnState, inp, thermo, trans, turb, mainDiagonal[bb]);
+          });
+        }
       }
+    } else if (inp.MatrixSolver() == "dplur" ||
+               inp.MatrixSolver() == "bdplur") {
+      for (auto ii = 0; ii < inp.MatrixSweeps(); ii++) {
+        // swap updates for ghost cells
+        SwapImplicitUpdate(du, halo);
+
+        for (auto bb = 0U; bb < numBlocks; bb++) {
+          // Calculate correction (du)
+          BlockTask(du[bb], [&, bb]() {
+            blockError[bb] += blocks[bb].DPLUR(du[bb], eqnState, inp, thermo,
+                                               trans, turb, mainDiagonal[bb]);
+          });
+        }
+      }
+    } else {
+      cerr << "ERROR: Matrix solver " << inp.MatrixSolver() <<
+          " is not recognized!" << endl;
+      cerr << "Please choose lusgs, blusgs, mcgs, bmcgs, dplur, or bdplur."
+           << endl;
+      exit(EXIT_FAILURE);
     }
-  } else {
-    cerr << "ERROR: Matrix solver " << inp.MatrixSolver() <<
-        " is not recognized!" << endl;
-    cerr << "Please choose lusgs, blusgs, dplur, or bdplur." << endl;
-    exit(EXIT_FAILURE);
-  }
 
-  // Update blocks and reset main diagonal
-  for (auto bb = 0U; bb < blocks.size(); bb++) {
-    // Update solution
-    blocks[bb].UpdateBlock(inp, eqnState, thermo, trans, du[bb], turb, mm,
-                           residL2, residLinf);
+    // Update blocks and reset main diagonal
+    for (auto bb = 0U; bb < numBlocks; bb++) {
+      BlockTask(du[bb], [&, bb]() {
+        // Update solution
+        blocks[bb].UpdateBlock(inp, eqnState, thermo, trans, du[bb], turb, mm,
+                               blockL2[bb], blockLinf[bb]);
+
+        // Assign time n to time n-1 at end of nonlinear iterations
+        if (inp.IsMultilevelInTime() && mm == inp.NonlinearIterations() - 1) {
+          blocks[bb].AssignSolToTimeNm1();
+        }
 
-    // Assign time n to time n-1 at end of nonlinear iterations
-    if (inp.IsMultilevelInTime() && mm == inp.NonlinearIterations() - 1) {
-      blocks[bb].AssignSolToTimeNm1();
+        // zero flux jacobians
+        mainDiagonal[bb].Zero();
+      });
     }
+  });
 
-    // zero flux jacobians
-    mainDiagonal[bb].Zero();
+  CombineResiduals(blockL2, blockLinf, residL2, residLinf);
+  auto matrixError = 0.0;
+  for (auto &error : blockError) {
+    matrixError += error;
   }
 
   return matrixError;
 }
 
 void SwapImplicitUpdate(vector<multiArray3d<genArray>> &du,
-                        const vector<connection> &connections, const int &rank,
-                        const MPI_Datatype &MPI_cellData,
-                        const int &numGhosts) {
+                        haloExchange &halo) {
   // du -- implicit update in conservative variables
-  // conn -- connection boundary conditions
-  // rank -- processor rank
-  // MPI_cellData -- datatype to pass primVars or genArray
-  // numGhosts -- number of ghost cells
-
-  // loop over all connections and swap connection updates when necessary
-  for (auto &conn : connections) {
-    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
-      // both sides of connection are on this processor, swap w/o mpi
-      du[conn.LocalBlockFirst()].SwapSlice(conn, du[conn.LocalBlockSecond()]);
-    } else if (conn.RankFirst() == rank) {
-      // rank matches rank of first side of connection, swap over mpi
-      du[conn.LocalBlockFirst()].SwapSliceMPI(conn, rank, MPI_cellData);
-    } else if (conn.RankSecond() == rank) {
-      // rank matches rank of second side of connection, swap over mpi
-      du[conn.LocalBlockSecond()].SwapSliceMPI(conn, rank, MPI_cellData);
-    }
-    // if rank doesn't match either side of connection, then do nothing and
-    // move on to the next connection
-  }
+  // halo -- exchange for connection boundaries
+
+  // swap connection updates; the swaps are created as tasks, so this must be
+  // called from within RunBlockTasks
+  HaloExchangeTasks(
+      du, halo, {haloField::update},
+      [&](const int &cc, const int &bb) {
+        halo.Pack(haloField::update, cc, du[bb]);
+      },
+      [&](const int &cc, const int &first, const int &second) {
+        du[first].SwapSlice(halo.Connection(cc), du[second]);
+      },
+      [&](const int &cc, const int &bb) {
+        halo.Unpack(haloField::update, cc, du[bb]);
+      });
 }
 
 
-void SwapTurbVars(vector<procBlock> &states,
-                  const vector<connection> &connections, const int &rank,
-                  const int &numGhosts) {
+void SwapEddyViscAndGradients(vector<procBlock> &states, const input &inp,
+                              haloExchange &halo) {
   // states -- vector of all procBlocks in the solution domain
-  // conn -- connection boundary conditions
-  // rank -- processor rank
-  // numGhosts -- number of ghost cells
-
-  // loop over all connections and swap connection updates when necessary
-  for (auto &conn : connections) {
-    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
-      // both sides of connection are on this processor, swap w/o mpi
-      states[conn.LocalBlockFirst()].SwapTurbSlice(
-          conn, states[conn.LocalBlockSecond()]);
-    } else if (conn.RankFirst() == rank) {
-      // rank matches rank of first side of connection, swap over mpi
-      states[conn.LocalBlockFirst()].SwapTurbSliceMPI(conn, rank);
-    } else if (conn.RankSecond() == rank) {
-      // rank matches rank of second side of connection, swap over mpi
-      states[conn.LocalBlockSecond()].SwapTurbSliceMPI(conn, rank);
-    }
-    // if rank doesn't match either side of connection, then do nothing and
-    // move on to the next connection
+  // inp -- input variables
+  // halo -- exchange for connection boundaries
+
+  // fields that are exchanged depend on the equation set; they are all sent in
+  // one message to each neighboring processor
+  vector<haloField> fields;
+  if (inp.IsViscous()) {
+    fields.push_back(haloField::velocityGrad);
+    fields.push_back(haloField::temperatureGrad);
   }
-}
-
-void SwapEddyViscAndGradients(vector<procBlock> &states,
-                              const vector<connection> &connections,
-                              const int &rank,
-                              const MPI_Datatype &MPI_tensorDouble,
-                              const MPI_Datatype &MPI_vec3d,
-                              const int &numGhosts) {
-  // states -- vector of all procBlocks in the solution domain
-  // conn -- connection boundary conditions
-  // rank -- processor rank
-  // MPI_tensorDouble -- MPI datatype for tensor<double>
-  // MPI_vec3d -- MPI datatype for vector3d<double>
-  // numGhosts -- number of ghost cells
-
-  // loop over all connections and swap connection updates when necessary
-  for (auto &conn : connections) {
-    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
-      // both sides of connection are on this processor, swap w/o mpi
-      states[conn.LocalBlockFirst()].SwapEddyViscAndGradientSlice(
-          conn, states[conn.LocalBlockSecond()]);
-    } else if (conn.RankFirst() == rank) {
-      // rank matches rank of first side of connection, swap over mpi
-      states[conn.LocalBlockFirst()].SwapEddyViscAndGradientSliceMPI(
-          conn, rank, MPI_tensorDouble, MPI_vec3d);
-    } else if (conn.RankSecond() == rank) {
-      // rank matches rank of second side of connection, swap over mpi
-      states[conn.LocalBlockSecond()].SwapEddyViscAndGradientSliceMPI(
-          conn, rank, MPI_tensorDouble, MPI_vec3d);
-    }
-    // if rank doesn't match either side of connection, then do nothing and
-    // move on to the next connection
+  if (inp.IsTurbulent()) {
+    fields.push_back(haloField::eddyViscosity);
   }
+  if (inp.IsRANS()) {
+    fields.push_back(haloField::tkeGrad);
+    fields.push_back(haloField::omegaGrad);
+    fields.push_back(haloField::f1);
+    fields.push_back(haloField::f2);
+  }
+  if (fields.empty()) {
+    return;
+  }
+
+  // swap eddy viscosity, gradients, and turbulence variables; the swaps are
+  // created as tasks, so this must be called from within RunBlockTasks
+  HaloExchangeTasks(
+      states, halo, fields,
+      [&](const int &cc, const int &bb) {
+        states[bb].PackEddyViscAndGradientSlice(halo, cc);
+      },
+      [&](const int &cc, const int &first, const int &second) {
+        states[first].SwapEddyViscAndGradientSlice(halo.Connection(cc),
+                                                   states[second]);
+      },
+      [&](const int &cc, const int &bb) {
+        states[bb].UnpackEddyViscAndGradientSlice(halo, cc);
+      });
 }
 
-void SwapWallDist(vector<procBlock> &states,
-                  const vector<connection> &connections, const int &rank,
-                  const int &numGhosts) {
+void SwapWallDist(vector<procBlock> &states, haloExchange &halo) {
   // states -- vector of all procBlocks in the solution domain
-  // conn -- connection boundary conditions
-  // rank -- processor rank
-  // numGhosts -- number of ghost cells
-
-  // loop over all connections and swap connection updates when necessary
-  for (auto &conn : connections) {
-    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
-      // both sides of connection are on this processor, swap w/o mpi
-      states[conn.LocalBlockFirst()].SwapWallDistSlice(
-          conn, states[conn.LocalBlockSecond()]);
-    } else if (conn.RankFirst() == rank) {
-      // rank matches rank of first side of connection, swap over mpi
-      states[conn.LocalBlockFirst()].SwapWallDistSliceMPI(conn, rank);
-    } else if (conn.RankSecond() == rank) {
-      // rank matches rank of second side of connection, swap over mpi
-      states[conn.LocalBlockSecond()].SwapWallDistSliceMPI(conn, rank);
-    }
-    // if rank doesn't match either side of connection, then do nothing and
-    // move on to the next connection
-  }
+  // halo -- exchange for connection boundaries
+
+  RunBlockTasks(states.size(), [&]() {
+    HaloExchangeTasks(
+        states, halo, {haloField::wallDist},
+        [&](const int &cc, const int &bb) {
+          states[bb].PackWallDistSlice(halo, cc);
+        },
+        [&](const int &cc, const int &first, const int &second) {
+          states[first].SwapWallDistSlice(halo.Connection(cc), states[second]);
+        },
+        [&](const int &cc, const int &bb) {
+          states[bb].UnpackWallDistSlice(halo, cc);
+        });
+  });
 }
 
 void CalcResidual(vector<procBlock> &states,
-                  vector<multiArray3d<fluxJacobian>> &mainDiagonal,
+                  vector<implicitDiagonal> &mainDiagonal,
                   const unique_ptr<transport> &trans,
                   const unique_ptr<thermodynamic> &thermo,
                   const unique_ptr<eos> &eqnState, const input &inp,
-                  const unique_ptr<turbModel> &turb,
-                  const vector<connection> &connections, const int &rank,
-                  const MPI_Datatype &MPI_tensorDouble,
-                  const MPI_Datatype &MPI_vec3d) {
+                  const unique_ptr<turbModel> &turb, haloExchange &halo) {
   // states -- vector of all procBlocks on processor
   // mainDiagonal -- main diagonal of A matrix for implicit solve
   // trans -- viscous transport model
@@ -635,84 +848,108 @@ void CalcResidual(vector<procBlock> &states,
   // eqnState -- equation of state
   // inp -- input variables
   // turb -- turbulence model
-  // connections -- connection boundary conditions
-  // rank -- processor rank
-  // MPI_tensorDouble -- MPI datatype for tensor<double>
-  // MPI_vec3d -- MPI datatype for vector3d<double>
-
-  for (auto bb = 0U; bb < states.size(); bb++) {
-    // calculate residual
-    states[bb].CalcResidualNoSource(trans, thermo, eqnState, inp, turb,
-                                    mainDiagonal[bb]);
-  }
-  // swap mut & gradients calculated during residual calculation
-  SwapEddyViscAndGradients(states, connections, rank, MPI_tensorDouble,
-                           MPI_vec3d, inp.NumberGhostLayers());
-
-  if (inp.IsRANS()) {
-    // swap turbulence variables calculated during residual calculation
-    SwapTurbVars(states, connections, rank, inp.NumberGhostLayers());
+  // halo -- exchange for connection boundaries
+
+  // when ghost cells are exchanged with other processors, the fluxes on the
+  // interior faces are calculated while the messages are in flight, and the
+  // rest of the residual after the ghost cells are received
+  const auto overlap = halo.NumMessages() > 0;
+
+  RunBlockTasks(states.size(), [&]() {
+    // get boundary conditions for all blocks
+    GetBoundaryConditions(states, inp, eqnState, thermo, trans, turb, halo,
+                          [&]() {
+      if (overlap) {
+        for (auto bb = 0U; bb < states.size(); bb++) {
+          BlockTask(states[bb], [&, bb]() {
+            states[bb].CalcResidualInterior(trans, thermo, eqnState, inp, turb,
+                                            mainDiagonal[bb]);
+          });
+        }
+      }
+    });
 
     for (auto bb = 0U; bb < states.size(); bb++) {
-      // calculate source terms for residual
-      states[bb].CalcSrcTerms(trans, turb, inp, mainDiagonal[bb]);
+      // calculate residual
+      BlockTask(states[bb], [&, bb]() {
+        states[bb].CalcResidualNoSource(trans, thermo, eqnState, inp, turb,
+                                        mainDiagonal[bb], overlap);
+      });
     }
-  }
+    // swap mut, gradients, and turbulence variables calculated during
+    // residual calculation
+    SwapEddyViscAndGradients(states, inp, halo);
+
+    if (inp.IsRANS()) {
+      for (auto bb = 0U; bb < states.size(); bb++) {
+        // calculate source terms for residual
+        BlockTask(states[bb], [&, bb]() {
+          states[bb].CalcSrcTerms(trans, turb, inp, mainDiagonal[bb]);
+        });
+      }
+    }
+  });
 }
 
 void CalcTimeStep(vector<procBlock> &states, const input &inp) {
   // states -- vector of all procBlocks on processor
   // inp -- input variables
 
-  for (auto &state : states) {
-    // calculate time step
-    state.CalcBlockTimeStep(inp);
-  }
+  RunBlockTasks(states.size(), [&]() {
+    for (auto bb = 0U; bb < states.size(); bb++) {
+      // calculate time step
+      BlockTask(states[bb], [&, bb]() { states[bb].CalcBlockTimeStep(inp); });
+    }
+  });
 }
 
 
-// function to reorder the block by hyperplanes
-/* A hyperplane is a plane of i+j+k=constant within an individual block. The
-LUSGS solver must sweep along these hyperplanes to avoid
-calculating a flux jacobian. Ex. The solver must visit all points on hyperplane
-1 before visiting any points on hyperplane 2.
-*/
-vector<vector3d<int>> HyperplaneReorder(const int &imax, const int &jmax,
-                                        const int &kmax) {
-  // total number of hyperplanes in a given block
-  const auto numPlanes = imax + jmax + kmax - 2;
-  vector<vector3d<int>> reorder;
-  reorder.reserve(imax * jmax * kmax);
-
-  for (auto pp = 0; pp < numPlanes; pp++) {
-    for (auto kk = 0; kk < kmax; kk++) {
-      for (auto jj = 0; jj < jmax; jj++) {
-        for (auto ii = 0; ii < imax; ii++) {
-          if (ii + jj + kk == pp) {  // if sum of ii, jj, and kk equals pp than
-                                     // point is on hyperplane pp
-            reorder.push_back(vector3d<int>(ii, jj, kk));
-          }
-        }
-      }
+void ResizeArrays(const vector<procBlock> &states, const input &inp,
+                  vector<implicitDiagonal> &jac) {
+  // states -- all states on processor
+  // sol -- vector of solutions to be resized
+  // jac -- vector of flux jacobians to be resized
+
+  // scalar solvers only need the spectral radius on the main diagonal
+  for (auto bb = 0U; bb < states.size(); bb++) {
+    if (inp.IsBlockMatrix()) {
+      jac[bb].ClearResize(states[bb].NumI(), states[bb].NumJ(),
+                          states[bb].NumK(),
+                          fluxJacobian(inp.NumFlowEquations(),
+                                       inp.NumTurbEquations()));
+    } else {
+      jac[bb].ClearResize(states[bb].NumI(), states[bb].NumJ(),
+                          states[bb].NumK(), uncoupledScalar());
     }
   }
-
-  return reorder;
 }
 
-void ResizeArrays(const vector<procBlock> &states, const input &inp,
-                  vector<multiArray3d<fluxJacobian>> &jac) {
+// function to allocate the stored off diagonal operators and report the
+// memory they use
+void AllocateOffDiagonals(vector<procBlock> &states, const input &inp,
+                          const int &rank) {
   // states -- all states on processor
-  // sol -- vector of solutions to be resized
-  // jac -- vector of flux jacobians to be resized
+  // inp -- input variables
+  // rank -- processor rank
 
-  const auto fluxJac = inp.IsBlockMatrix() ?
-      fluxJacobian(inp.NumFlowEquations(), inp.NumTurbEquations()) :
-      fluxJacobian(1, 1);
+  auto localMemory = 0.0;
+  for (auto &state : states) {
+    state.AllocateOffDiagonals(inp);
+    localMemory += state.OffDiagonalMemory();
+  }
 
-  for (auto bb = 0U; bb < states.size(); bb++) {
-    jac[bb].ClearResize(states[bb].NumI(), states[bb].NumJ(), states[bb].NumK(),
-                        0, fluxJac);
+  auto totalMemory = 0.0;
+  auto maxMemory = 0.0;
+  MPI_Reduce(&localMemory, &totalMemory, 1, MPI_DOUBLE, MPI_SUM, ROOTP,
+             MPI_COMM_WORLD);
+  MPI_Reduce(&localMemory, &maxMemory, 1, MPI_DOUBLE, MPI_MAX, ROOTP,
+             MPI_COMM_WORLD);
+
+  if (rank == ROOTP) {
+    constexpr auto bytesPerMB = 1024.0 * 1024.0;
+    cout << "Stored off diagonal operators use " << totalMemory / bytesPerMB
+         << " MB total and " << maxMemory / bytesPerMB
+         << " MB on the largest processor" << endl << endl;
   }
 }
 
@@ -933,4 +1170,45 @@ kdtree CalcTreeFromCloud(const string &fname, const input &inp,
 
   // create kd tree
   return kdtree(points);
-}
\ No newline at end of file
+}
+// function to get the number of threads available to a parallel region; this
+// is 1 when compiled without OpenMP
+int MaxThreads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// function to get the number of the calling thread within its team
+int ThreadNum() {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+// function to split the range [start, end) into contiguous pieces, one for
+// each thread in the team, and return the piece for the calling thread; the
+// piece is empty if there are more threads than entries
+void ThreadRange(const int &start, const int &end, int &threadStart,
+                 int &threadEnd) {
+  // start -- start of range to split
+  // end -- one past end of range to split
+  // threadStart -- start of piece for calling thread
+  // threadEnd -- one past end of piece for calling thread
+#ifdef _OPENMP
+  const auto numThreads = omp_get_num_threads();
+  const auto tid = omp_get_thread_num();
+#else
+  constexpr auto numThreads = 1;
+  constexpr auto tid = 0;
+#endif
+  const auto len = end - start;
+  const auto base = len / numThreads;
+  const auto extra = len % numThreads;
+  threadStart = start + tid * base + std::min(tid, extra);
+  threadEnd = threadStart + base + (tid < extra ? 1 : 0);
+}
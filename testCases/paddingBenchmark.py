@@ -0,0 +1,144 @@
+#   This file is part of aither.
+#   Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+#
+#   Aither is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation, either version 3 of the License, or
+#   (at your option) any later version.
+#
+#   Aither is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+#   This script times the face flux sweeps on a single block whose i-lines
+#   (including ghost cells) are a power of two long, with and without the
+#   arrayPadding option. The case is inviscid and explicit, so the sweeps are
+#   the inviscid flux kernels. The solver reports the time spent on the i, j,
+#   and k faces separately; the j and k stencils stride by whole i-lines and
+#   planes, so they are the ones padding is meant to help.
+
+import os
+import optparse
+import struct
+import subprocess
+import sys
+
+def WriteGrid(fname, numCells):
+    # uniform cube with numCells cells on each side in plot3d format
+    numNodes = numCells + 1
+    with open(fname, "wb") as fout:
+        fout.write(struct.pack("i", 1))
+        fout.write(struct.pack("3i", numNodes, numNodes, numNodes))
+        spacing = 1.0 / numCells
+        line = [ii * spacing for ii in range(numNodes)]
+        for dd in range(3):
+            for kk in range(numNodes):
+                for jj in range(numNodes):
+                    if dd == 0:
+                        vals = line
+                    elif dd == 1:
+                        vals = [line[jj]] * numNodes
+                    else:
+                        vals = [line[kk]] * numNodes
+                    fout.write(struct.pack("%dd" % numNodes, *vals))
+
+def WriteInput(fname, numCells, iterations, padding):
+    n = numCells
+    with open(fname, "w") as fout:
+        fout.write("gridName: box\n")
+        fout.write("equationSet: euler\n")
+        fout.write("timeIntegration: explicitEuler\n")
+        fout.write("cflStart: 0.4\n")
+        fout.write("cflMax: 0.4\n")
+        fout.write("faceReconstruction: thirdOrder\n")
+        fout.write("limiter: vanAlbada\n")
+        fout.write("iterations: %d\n" % iterations)
+        fout.write("outputFrequency: %d\n" % (iterations + 1))
+        fout.write("arrayPadding: %d\n" % padding)
+        fout.write("referenceTemperature: 288.0\n")
+        fout.write("referenceDensity: 1.2256\n")
+        fout.write("initialConditions: <icState(tag=-1; pressure=101300; "
+                   "density=1.2256; velocity=[100, 20, 10])>\n")
+        fout.write("boundaryStates: <characteristic(tag=1; pressure=101300; "
+                   "density=1.2256; velocity=[100, 20, 10])>\n")
+        fout.write("boundaryConditions: 1\n")
+        fout.write("2 2 2\n")
+        fout.write("characteristic 0 0 0 %d 0 %d 1\n" % (n, n))
+        fout.write("characteristic %d %d 0 %d 0 %d 1\n" % (n, n, n, n))
+        fout.write("characteristic 0 %d 0 0 0 %d 1\n" % (n, n))
+        fout.write("characteristic 0 %d %d %d 0 %d 1\n" % (n, n, n, n))
+        fout.write("characteristic 0 %d 0 %d 0 0 1\n" % (n, n))
+        fout.write("characteristic 0 %d 0 %d %d %d 1\n" % (n, n, n, n))
+
+def RunTime(options, numCells, iterations, padding):
+    WriteInput("box.inp", numCells, iterations, padding)
+    cmd = options.mpirunPath + " -np 1 " + options.aitherPath + \
+          " box.inp > box.out"
+    returnCode = subprocess.call(cmd, shell=True)
+    if returnCode != 0:
+        print("ERROR: Simulation terminated with errors")
+        sys.exit(1)
+    # face flux time in each direction is reported at the end of the run
+    with open("box.out", "r") as fin:
+        for line in fin:
+            if line.startswith("Face Flux Time (i, j, k):"):
+                times = line.split(":")[1].replace("seconds", "").split(",")
+                return [float(tt) / iterations for tt in times]
+    print("ERROR: Face flux time not found in output")
+    sys.exit(1)
+
+
+def main():
+    # Set up options
+    parser = optparse.OptionParser()
+    parser.add_option("-a", "--aitherPath", action="store", dest="aitherPath",
+                      default="aither",
+                      help="Path to aither executable. Default = aither")
+    parser.add_option("-m", "--mpirunPath", action="store",
+                      dest="mpirunPath", default="mpirun",
+                      help="Path to mpirun. Default = mpirun")
+    parser.add_option("-n", "--numCells", action="store", type="int",
+                      dest="numCells", default=60,
+                      help="Cells on each side of block. Default = 60, so "
+                      "i-lines with 2 ghost layers are 64 long")
+    parser.add_option("-i", "--iterations", action="store", type="int",
+                      dest="iterations", default=20,
+                      help="Iterations to time. Default = 20")
+    parser.add_option("-p", "--paddings", action="store", dest="paddings",
+                      default="0,1,8",
+                      help="Comma separated paddings to time. Default = 0,1,8")
+    parser.add_option("-r", "--repeats", action="store", type="int",
+                      dest="repeats", default=3,
+                      help="Times to repeat each run. Default = 3")
+
+    options, remainder = parser.parse_args()
+    options.aitherPath = os.path.abspath(options.aitherPath) \
+        if os.path.exists(options.aitherPath) else options.aitherPath
+
+    runDirectory = "paddingBenchmark"
+    if not os.path.exists(runDirectory):
+        os.mkdir(runDirectory)
+    os.chdir(runDirectory)
+    WriteGrid("box.xyz", options.numCells)
+
+    # the solver only times the face flux sweeps, so grid reading and setting
+    # up the block are not counted
+    paddings = [int(pad) for pad in options.paddings.split(",")]
+    print("block: %d^3 cells, iterations: %d" % (options.numCells,
+                                                 options.iterations))
+    print("seconds per iteration for face fluxes, best of %d" %
+          options.repeats)
+    for pad in paddings:
+        times = [RunTime(options, options.numCells, options.iterations, pad)
+                 for rr in range(options.repeats)]
+        best = [min(tt[dd] for tt in times) for dd in range(3)]
+        print("arrayPadding: %d  i-faces: %.4f  j-faces: %.4f  k-faces: %.4f"
+              % (pad, best[0], best[1], best[2]))
+
+
+if __name__ == "__main__":
+    main()
@@ -39,6 +39,7 @@ class regressionTest:
         self.percentTolerance = 0.01
         self.isRestart = False
         self.restartFile = "none"
+        self.inputOptions = {}
 
     def SetRegressionCase(self, name):
         self.caseName = name
@@ -79,6 +80,11 @@ class regressionTest:
     def SetRestartFile(self, resFile):
         self.restartFile = resFile
 
+    # set an input file option for the test; it replaces the option if it is
+    # already in the input file, and is added to the input file otherwise
+    def SetInputOption(self, key, value):
+        self.inputOptions[key] = value
+
     def ReturnToHomeDirectory(self):
         os.chdir(self.location)
 
@@ -109,20 +115,29 @@ class regressionTest:
     def GetResiduals(self):
         return self.residuals
         
-    # change input file to have number of iterations specified for test
+    # change input file to have number of iterations and options specified
+    # for test; the original input file is kept so that several tests can be
+    # run from the same directory
     def ModifyInputFile(self):
         fname = self.caseName + ".inp"
         fnameBackup = fname + ".old"
-        shutil.move(fname, fnameBackup)
+        if not os.path.exists(fnameBackup):
+            shutil.move(fname, fnameBackup)
+        options = dict(self.inputOptions)
         with open(fname, "w") as fout:
             with open(fnameBackup, "r") as fin:
                 for line in fin:
+                    key = line.split(":")[0].strip()
                     if "iterations:" in line:
                         fout.write("iterations: " + str(self.iterations) + "\n")
                     elif "outputFrequency:" in line:
                         fout.write("outputFrequency: " + str(self.iterations) + "\n")
+                    elif key in options:
+                        fout.write(key + ": " + str(options.pop(key)) + "\n")
                     else:
                         fout.write(line)
+            for key, value in options.items():
+                fout.write(key + ": " + str(value) + "\n")
 
     # modify the input file and run the test
     def RunCase(self):
@@ -216,11 +231,32 @@ def main():
     subCyl.SetResiduals([1.5371e-1, 1.4991e-1, 1.5910e-1, 8.2250e-1, 1.5297e-1])
     subCyl.SetIgnoreIndices(3)
     subCyl.SetMpirunPath(options.mpirunPath)
+    # check the SIMD roe flux kernel against the face by face flux at startup
+    subCyl.SetInputOption("inviscidFluxCheck", 10000)
 
     # run regression case
     passed = subCyl.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # subsonic cylinder with threads
+    # laminar, inviscid, lu-sgs swept by hyperplane on 2 threads
+    subCylThreads = regressionTest()
+    subCylThreads.SetRegressionCase("subsonicCylinder")
+    subCylThreads.SetAitherPath(options.aitherPath)
+    subCylThreads.SetRunDirectory("subsonicCylinder")
+    subCylThreads.SetNumberOfProcessors(1)
+    subCylThreads.SetNumberOfIterations(numIterations)
+    subCylThreads.SetResiduals(subCyl.GetResiduals())
+    subCylThreads.SetIgnoreIndices(3)
+    subCylThreads.SetMpirunPath(options.mpirunPath)
+    # hyperplane sweeps give the same result for any number of threads
+    subCylThreads.SetInputOption("numThreads", 2)
+
+    # run regression case
+    passed = subCylThreads.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # multi-block subsonic cylinder
     # laminar, inviscid, lusgs, multi-block, ausmpw+
@@ -234,11 +270,108 @@ def main():
                            2.2955e-01])
     multiCyl.SetIgnoreIndices(3)
     multiCyl.SetMpirunPath(options.mpirunPath)
+    # check the SIMD ausm flux kernel against the face by face flux at startup
+    multiCyl.SetInputOption("inviscidFluxCheck", 10000)
 
     # run regression case
     passed = multiCyl.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with threads
+    # laminar, inviscid, lusgs, multi-block, ausmpw+, 2 threads per processor
+    multiCylThreads = regressionTest()
+    multiCylThreads.SetRegressionCase("multiblockCylinder")
+    multiCylThreads.SetAitherPath(options.aitherPath)
+    multiCylThreads.SetRunDirectory("multiblockCylinder")
+    multiCylThreads.SetNumberOfProcessors(maxProcs)
+    multiCylThreads.SetNumberOfIterations(numIterations)
+    multiCylThreads.SetResiduals(multiCyl.GetResiduals())
+    multiCylThreads.SetIgnoreIndices(3)
+    multiCylThreads.SetMpirunPath(options.mpirunPath)
+    # residuals do not depend on the number of threads
+    multiCylThreads.SetInputOption("numThreads", 2)
+
+    # run regression case
+    passed = multiCylThreads.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with distributed startup
+    # laminar, inviscid, lusgs, multi-block, ausmpw+, blocks set up on their
+    # own processors
+    multiCylDist = regressionTest()
+    multiCylDist.SetRegressionCase("multiblockCylinder")
+    multiCylDist.SetAitherPath(options.aitherPath)
+    multiCylDist.SetRunDirectory("multiblockCylinder")
+    multiCylDist.SetNumberOfProcessors(maxProcs)
+    multiCylDist.SetNumberOfIterations(numIterations)
+    multiCylDist.SetResiduals(multiCyl.GetResiduals())
+    multiCylDist.SetIgnoreIndices(3)
+    multiCylDist.SetMpirunPath(options.mpirunPath)
+    # distributed startup is bit identical to setting up blocks on root
+    multiCylDist.SetInputOption("startupMethod", "distributed")
+
+    # run regression case
+    passed = multiCylDist.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with asynchronous output
+    # laminar, inviscid, lusgs, multi-block, ausmpw+, nonblocking writes
+    multiCylAsync = regressionTest()
+    multiCylAsync.SetRegressionCase("multiblockCylinder")
+    multiCylAsync.SetAitherPath(options.aitherPath)
+    multiCylAsync.SetRunDirectory("multiblockCylinder")
+    multiCylAsync.SetNumberOfProcessors(maxProcs)
+    multiCylAsync.SetNumberOfIterations(numIterations)
+    multiCylAsync.SetResiduals(multiCyl.GetResiduals())
+    multiCylAsync.SetIgnoreIndices(3)
+    multiCylAsync.SetMpirunPath(options.mpirunPath)
+    multiCylAsync.SetInputOption("outputMethod", "asynchronous")
+
+    # run regression case
+    passed = multiCylAsync.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with all parallel options
+    # laminar, inviscid, lusgs, multi-block, ausmpw+, 2 threads per processor,
+    # distributed startup, asynchronous output, xor compressed restart files
+    multiCylAll = regressionTest()
+    multiCylAll.SetRegressionCase("multiblockCylinder")
+    multiCylAll.SetAitherPath(options.aitherPath)
+    multiCylAll.SetRunDirectory("multiblockCylinder")
+    multiCylAll.SetNumberOfProcessors(maxProcs)
+    multiCylAll.SetNumberOfIterations(numIterations)
+    multiCylAll.SetResiduals(multiCyl.GetResiduals())
+    multiCylAll.SetIgnoreIndices(3)
+    multiCylAll.SetMpirunPath(options.mpirunPath)
+    multiCylAll.SetInputOption("numThreads", 2)
+    multiCylAll.SetInputOption("startupMethod", "distributed")
+    multiCylAll.SetInputOption("outputMethod", "asynchronous")
+    multiCylAll.SetInputOption("restartCompression", "xor")
+    multiCylAll.SetInputOption("restartFrequency", numIterationsRestart)
+
+    # run regression case
+    passed = multiCylAll.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder restart with all parallel options
+    # the cfl ramp starts over on restart, so the residuals differ from the
+    # uninterrupted run
+    multiCylAllRestart = multiCylAll
+    multiCylAllRestart.SetNumberOfIterations(numIterationsRestart)
+    multiCylAllRestart.SetResiduals([4.0824e-01, 2.2614e-01, 2.9770e-01,
+                                     1.2206e+00, 4.0531e-01])
+    multiCylAllRestart.SetRestart(True)
+    multiCylAllRestart.SetRestartFile("multiblockCylinder_50.rst")
+
+    # run regression case
+    passed = multiCylAllRestart.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # sod shock tube
     # laminar, inviscid, bdf2, weno
@@ -269,6 +402,37 @@ def main():
     passed = shockTubeRestart.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # sod shock tube with compressed restarts
+    # laminar, inviscid, bdf2, weno, xor compressed restart files
+    shockTubeXor = regressionTest()
+    shockTubeXor.SetRegressionCase("shockTube")
+    shockTubeXor.SetAitherPath(options.aitherPath)
+    shockTubeXor.SetRunDirectory("shockTube")
+    shockTubeXor.SetNumberOfProcessors(1)
+    shockTubeXor.SetNumberOfIterations(numIterations)
+    shockTubeXor.SetResiduals(shockTube.GetResiduals())
+    shockTubeXor.SetIgnoreIndices(2)
+    shockTubeXor.SetIgnoreIndices(3)
+    shockTubeXor.SetMpirunPath(options.mpirunPath)
+    shockTubeXor.SetInputOption("restartCompression", "xor")
+
+    # run regression case
+    passed = shockTubeXor.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # sod shock tube restart from compressed restart file
+    # laminar, inviscid, bdf2, weno, xor compressed restart files
+    shockTubeXorRestart = shockTubeXor
+    shockTubeXorRestart.SetNumberOfIterations(numIterationsRestart)
+    shockTubeXorRestart.SetRestart(True)
+    shockTubeXorRestart.SetRestartFile("shockTube_50.rst")
+
+    # run regression case
+    passed = shockTubeXorRestart.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # supersonic wedge
     # laminar, inviscid, explicit euler
@@ -303,6 +467,25 @@ def main():
     passed = transBump.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # transonic bump in channel with multicolor gauss-seidel
+    # laminar, inviscid, mcgs on 2 threads
+    transBumpMcgs = regressionTest()
+    transBumpMcgs.SetRegressionCase("transonicBump")
+    transBumpMcgs.SetAitherPath(options.aitherPath)
+    transBumpMcgs.SetRunDirectory("transonicBump")
+    transBumpMcgs.SetNumberOfProcessors(1)
+    transBumpMcgs.SetNumberOfIterations(numIterations)
+    transBumpMcgs.SetResiduals([2.4423e-2, 1.5135e-2, 9.3966e-3, 1.0000, 1.8063e-2])
+    transBumpMcgs.SetIgnoreIndices(3)
+    transBumpMcgs.SetMpirunPath(options.mpirunPath)
+    transBumpMcgs.SetInputOption("matrixSolver", "mcgs")
+    transBumpMcgs.SetInputOption("numThreads", 2)
+
+    # run regression case
+    passed = transBumpMcgs.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # viscous flat plate
     # laminar, viscous, lu-sgs
@@ -323,6 +506,46 @@ def main():
     passed = viscPlate.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # viscous flat plate with fused face flux passes
+    # laminar, viscous, lu-sgs, fused inviscid/viscous face fluxes
+    viscPlateFused = regressionTest()
+    viscPlateFused.SetRegressionCase("viscousFlatPlate")
+    viscPlateFused.SetAitherPath(options.aitherPath)
+    viscPlateFused.SetRunDirectory("viscousFlatPlate")
+    viscPlateFused.SetNumberOfProcessors(maxProcs)
+    viscPlateFused.SetNumberOfIterations(numIterations)
+    viscPlateFused.SetResiduals(viscPlate.GetResiduals())
+    viscPlateFused.SetIgnoreIndices(3)
+    viscPlateFused.SetMpirunPath(options.mpirunPath)
+    # fused and separate passes give the same residuals
+    viscPlateFused.SetInputOption("faceFluxPasses", "fused")
+
+    # run regression case
+    passed = viscPlateFused.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # viscous flat plate with cell centered gradients
+    # laminar, viscous, lu-sgs, cell gradients
+    viscPlateCell = regressionTest()
+    viscPlateCell.SetRegressionCase("viscousFlatPlate")
+    viscPlateCell.SetAitherPath(options.aitherPath)
+    viscPlateCell.SetRunDirectory("viscousFlatPlate")
+    viscPlateCell.SetNumberOfProcessors(maxProcs)
+    viscPlateCell.SetNumberOfIterations(numIterations)
+    if viscPlateCell.Processors() == 2:
+        viscPlateCell.SetResiduals([7.7240e-2, 2.4713e-1, 5.6563e-2, 4.3790e-2, 7.9343e-2])
+    else:
+        viscPlateCell.SetResiduals([7.6467e-2, 2.4714e-1, 4.0110e-2, 4.3855e-2, 7.9239e-2])
+    viscPlateCell.SetIgnoreIndices(3)
+    viscPlateCell.SetMpirunPath(options.mpirunPath)
+    viscPlateCell.SetInputOption("viscousGradients", "cell")
+
+    # run regression case
+    passed = viscPlateCell.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # turbulent flat plate
     # viscous, lu-sgs, k-w wilcox
@@ -406,6 +629,30 @@ def main():
     passed = wallLaw.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # wall law with block multicolor gauss-seidel
+    # wall law bc, turbulent, bmcgs on 2 threads
+    wallLawBmcgs = regressionTest()
+    wallLawBmcgs.SetRegressionCase("wallLaw")
+    wallLawBmcgs.SetAitherPath(options.aitherPath)
+    wallLawBmcgs.SetRunDirectory("wallLaw")
+    wallLawBmcgs.SetNumberOfProcessors(maxProcs)
+    wallLawBmcgs.SetNumberOfIterations(numIterationsShort)
+    if wallLawBmcgs.Processors() == 2:
+        wallLawBmcgs.SetResiduals([6.8281e-01, 1.6287e-01, 2.9350e-01, 9.2855e-01,
+                                   7.0975e-01, 6.0530e-02, 6.7546e-05])
+    else:
+        wallLawBmcgs.SetResiduals([6.7590e-01, 1.5766e-01, 2.9380e-01, 9.2836e-01,
+                                   7.0268e-01, 6.0530e-02, 6.7535e-05])
+    wallLawBmcgs.SetIgnoreIndices(1)
+    wallLawBmcgs.SetMpirunPath(options.mpirunPath)
+    wallLawBmcgs.SetInputOption("matrixSolver", "bmcgs")
+    wallLawBmcgs.SetInputOption("numThreads", 2)
+
+    # run regression case
+    passed = wallLawBmcgs.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # thermally perfect gas
     # turbulent, thermally perfect, supersonic